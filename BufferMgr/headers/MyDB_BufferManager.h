@@ -13,6 +13,7 @@
 #ifndef BUFFER_MGR_H
 #define BUFFER_MGR_H
 
+#include <atomic>
 #include "CheckLRU.h"
 #include "Lock.h"
 #include <map>
@@ -78,6 +79,10 @@ public:
 	// un-pins the specified page
 	void unpin (MyDB_PagePtr unpinMe);
 
+	// pins a page that is not pinned, reading it in if it is not buffered; returns
+	// false (and does nothing) if the page was already pinned
+	bool pin (MyDB_PagePtr pinMe);
+
 	// creates an LRU buffer manager... params are as follows:
 	// 1) the size of each page is pageSize 
 	// 2) the number of pages managed by the buffer manager is numPages;
@@ -90,9 +95,21 @@ public:
 
 	// returns the page size
 	size_t getPageSize ();
+
+	// returns the number of pages that the buffer holds
+	size_t getNumPages ();
+
+	// the total number of bytes read from and written to table files so far (not
+	// counting the temp file); for compressed tables, this is the compressed size
+	size_t getBytesRead ();
+	size_t getBytesWritten ();
 	
 private:
 
+	// the byte counts
+	atomic <size_t> bytesRead;
+	atomic <size_t> bytesWritten;
+
 	// tells us the LRU number of each of the pages
 	set <MyDB_PagePtr, CheckLRU> lastUsed;
 
@@ -136,6 +153,10 @@ private:
 	// this is the lock for the buffer manager
 	pthread_mutex_t myLock;
 
+	// signalled whenever a page has been read in from disk; a thread that wants a page that
+	// another thread is reading in (see MyDB_Page :: beingRead) waits on this
+	pthread_cond_t readDone;
+
 	// this tells the buffer manager that the current thread has recently accessed
 	// the memory location indicated, and so the associated page cannot be expelled
 	void setCannotExpell (void *setMe);
@@ -160,6 +181,12 @@ private:
 	// removes all traces of the page from the buffer manager
 	void killPage (MyDB_PagePtr killMe);
 
+	// read the page's bytes from the given file into the given RAM, and write them back to
+	// its file... if the page's table is compressed, these compress and decompress the page.
+	// readPage is called without the lock held, so it only uses pread
+	void readPage (MyDB_PagePtr readMe, int fd, void *into);
+	void writePage (MyDB_PagePtr writeMe);
+
 };
 
 #endif
@@ -85,6 +85,10 @@ private:
 	// tells us if this page needs to be written back
 	bool isDirty;	
 
+	// true while the buffer manager is reading this page in from disk, which it does
+	// without holding its lock; until then, the page has no bytes
+	bool beingRead;
+
 	// pointer to the parent buffer manager
 	MyDB_BufferManager& parent;		
 
@@ -0,0 +1,82 @@
+
+#ifndef PAGE_COMPRESSOR_H
+#define PAGE_COMPRESSOR_H
+
+#include "MyDB_CompressionType.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// this marks the start of a page that was compressed when it was written to disk; a
+// page that is stored as-is starts with its page type, which is never this value
+#define COMPRESSED_PAGE_MAGIC 0x5a42444d
+
+// the size of the first read done for a page in a compressed table... if the page was
+// compressed to fewer bytes than this, there is only the one read
+#define COMPRESSED_FIRST_READ 4096
+
+// this converts the pages of a table to and from a column-wise compressed format.  It
+// only knows the layout that MyDB_PageReaderWriter uses: a header of two size_t's (the
+// page type and the number of bytes used) followed by records, each of which is a short
+// giving its size, followed by fields that each start with a short giving their size.
+// On a compressed page, the values of each field are stored together: fixed-size fields
+// of 1, 2, 4 or 8 bytes are treated as integers and can be delta, run-length or
+// frame-of-reference encoded (bit-packed); other fields are stored either raw or
+// run-length encoded.  The encoding is chosen separately for each column on each page.
+//
+// A compressed page on disk is COMPRESSED_PAGE_MAGIC (4 bytes), the total number of
+// bytes written (4 bytes), and then the compressed data.  Anything after the last
+// record on a page is not stored, and comes back as zeros
+class MyDB_PageCompressor {
+
+public:
+
+	// compresses the given page into the output, including the magic number and the
+	// length.  Returns false (and the page should be written as-is) if the page does
+	// not have the expected layout, or if it would not get any smaller
+	static bool compress (void *page, size_t pageSize, MyDB_CompressionType scheme, vector <char> &output);
+
+	// decompresses a page written by compress into the given page; input points at
+	// the magic number.  Returns false if the input is not a valid compressed page
+	static bool decompress (char *input, size_t inputSize, void *page, size_t pageSize);
+
+	// returns the total number of bytes in the compressed page at input, or 0 if it
+	// does not start with COMPRESSED_PAGE_MAGIC
+	static size_t compressedSize (char *input, size_t bytesAvailable);
+
+private:
+
+	// the encodings for one column
+	enum ColumnEncoding {RawInts, FrameOfReference, Delta, RunLengthInts, RawBytes, RunLengthBytes};
+
+	// one column of the page, as it is found in the records
+	struct Column {
+		bool isInt;
+		int width;
+		vector <int64_t> ints;
+		vector <pair <char *, int>> fields;
+	};
+
+	// encode one column using the given encoding
+	static void encodeInts (Column &col, ColumnEncoding encoding, vector <char> &output);
+	static void encodeBytes (Column &col, ColumnEncoding encoding, vector <char> &output);
+
+	// decode one column; byte fields are left pointing into the input.  Returns false on an error
+	static bool decodeColumn (char *&input, char *end, size_t numRecs, Column &col);
+
+	// the encodings that are tried for a column, given the table's scheme
+	static vector <ColumnEncoding> candidates (Column &col, MyDB_CompressionType scheme);
+
+	// helpers to write and read pieces of the compressed format
+	static void putVarint (vector <char> &output, uint64_t val);
+	static bool getVarint (char *&input, char *end, uint64_t &val);
+	static uint64_t zigzag (int64_t val);
+	static int64_t unzigzag (uint64_t val);
+	static int bitsNeeded (uint64_t val);
+	static void packBits (vector <char> &output, vector <uint64_t> &vals, int numBits);
+	static bool unpackBits (char *&input, char *end, size_t numVals, int numBits, vector <uint64_t> &vals);
+};
+
+#endif
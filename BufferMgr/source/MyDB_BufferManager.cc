@@ -17,6 +17,7 @@
 #include <iostream>
 #include "MyDB_BufferManager.h"
 #include "MyDB_Page.h"
+#include "MyDB_PageCompressor.h"
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
@@ -28,6 +29,73 @@ size_t MyDB_BufferManager :: getPageSize () {
 	return pageSize;
 }
 
+size_t MyDB_BufferManager :: getNumPages () {
+	return numPages;
+}
+
+size_t MyDB_BufferManager :: getBytesRead () {
+	return bytesRead;
+}
+
+size_t MyDB_BufferManager :: getBytesWritten () {
+	return bytesWritten;
+}
+
+void MyDB_BufferManager :: readPage (MyDB_PagePtr readMe, int fd, void *into) {
+
+	off_t where = readMe->pos * pageSize;
+	if (readMe->myTable == nullptr || readMe->myTable->getCompression () == NoCompression) {
+		pread (fd, into, pageSize, where);
+		if (readMe->myTable != nullptr)
+			bytesRead += pageSize;
+		return;
+	}
+
+	// read the start of the page, which tells us if it was compressed
+	size_t firstRead = pageSize < COMPRESSED_FIRST_READ ? pageSize : COMPRESSED_FIRST_READ;
+	ssize_t numRead = pread (fd, into, firstRead, where);
+	if (numRead < 0)
+		numRead = 0;
+	bytesRead += numRead;
+
+	size_t compressedSize = MyDB_PageCompressor :: compressedSize ((char *) into, numRead);
+
+	// it was not, so just get the rest of it
+	if (compressedSize == 0) {
+		if ((size_t) numRead == firstRead && firstRead < pageSize)
+			bytesRead += pread (fd, ((char *) into) + firstRead, pageSize - firstRead, where + firstRead);
+		return;
+	}
+
+	// it was, so get the rest of the compressed bytes and decompress them into the page
+	vector <char> compressed (compressedSize);
+	size_t haveNow = compressedSize < (size_t) numRead ? compressedSize : numRead;
+	memcpy (&compressed[0], into, haveNow);
+	if (haveNow < compressedSize)
+		bytesRead += pread (fd, &compressed[haveNow], compressedSize - haveNow, where + haveNow);
+
+	if (!MyDB_PageCompressor :: decompress (&compressed[0], compressedSize, into, pageSize)) {
+		cout << "Page " << readMe->pos << " of " << readMe->myTable->getStorageLoc () << " is corrupt.\n";
+		exit (1);
+	}
+}
+
+void MyDB_BufferManager :: writePage (MyDB_PagePtr writeMe) {
+
+	int fd = fds[writeMe->myTable];
+	off_t where = writeMe->pos * pageSize;
+	vector <char> compressed;
+	if (writeMe->myTable != nullptr && MyDB_PageCompressor :: compress (writeMe->bytes, pageSize, 
+		writeMe->myTable->getCompression (), compressed)) {
+		pwrite (fd, &compressed[0], compressed.size (), where);
+		bytesWritten += compressed.size ();
+	} else {
+		pwrite (fd, writeMe->bytes, pageSize, where);
+		if (writeMe->myTable != nullptr)
+			bytesWritten += pageSize;
+	}
+}
+
 MyDB_PageHandle MyDB_BufferManager :: getPage (MyDB_TablePtr whichTable, long i) {
 		
 	Lock temp (getLock ());
@@ -224,8 +292,7 @@ void MyDB_BufferManager :: kickOutPage () {
 
 	// write it back if necessary
 	if (page->isDirty) {
-		lseek (fds[page->myTable], page->pos * pageSize, SEEK_SET);
-		write (fds[page->myTable], page->bytes, pageSize);
+		writePage (page);
 		page->isDirty = false;
 	}
 
@@ -290,9 +357,16 @@ void MyDB_BufferManager :: access (MyDB_PagePtr updateMe) {
 		}
 	}
 
+	void *ram;
+	int fd;
+
 	{
 		Lock temp (getLock ());
 
+		// if another thread is reading this page in, wait until it is done
+		while (updateMe->beingRead)
+			pthread_cond_wait (&readDone, getLock ());
+
 		// first, see if it is currently in the LRU list; if it is, update it
 		if (lastUsed.count (updateMe) == 1) {
 
@@ -307,13 +381,12 @@ void MyDB_BufferManager :: access (MyDB_PagePtr updateMe) {
 
 			return;
 		} 
-	}
-
-	// the file descriptor to read from
-	int fd;
 
-	{
-		Lock temp (getLock ());
+		// not in the LRU list, but buffered, means that the page is pinned
+		if (updateMe->bytes != nullptr) {
+			setCannotExpell (updateMe->bytes);
+			return;
+		}
 
 		// not in the LRU list means that we don't have its contents buffered
 		// see if there is space
@@ -326,31 +399,39 @@ void MyDB_BufferManager :: access (MyDB_PagePtr updateMe) {
 			exit (1);
 		}
 
-		// get some RAM for the page
-		updateMe->bytes = availableRam[availableRam.size () - 1]; 
-		setCannotExpell (updateMe->bytes);
-		updateMe->numBytes = pageSize;
+		// get some RAM for the page; it is not given to the page until it has been read,
+		// so no other thread can use the bytes before then, and since it is in neither
+		// the LRU list nor the available RAM, it cannot be given to anyone else
+		ram = availableRam[availableRam.size () - 1]; 
 		availableRam.pop_back ();
+		updateMe->beingRead = true;
+		fd = fds[updateMe->myTable];
+	}
+
+	// the read is done without the lock, so that threads can read different pages at once
+	readPage (updateMe, fd, ram);
 
-		// note that the page is now thread pinned
-		setCannotExpell (updateMe->bytes);
+	Lock temp (getLock ());
 
-		// change the LRU info
-		updateMe->timeTick = ++lastTimeTick;
-		lastUsed.insert (updateMe);
+	// the page is now thread pinned
+	updateMe->bytes = ram;
+	updateMe->numBytes = pageSize;
+	setCannotExpell (updateMe->bytes);
 
-		fd = fds[updateMe->myTable];
-	}
+	// change the LRU info
+	updateMe->timeTick = ++lastTimeTick;
+	lastUsed.insert (updateMe);
 
-	// and read it
-	lseek (fd, updateMe->pos * pageSize, SEEK_SET);
-	read (fd, updateMe->bytes, pageSize);
+	// and let anyone who is waiting for the page have it
+	updateMe->beingRead = false;
+	pthread_cond_broadcast (&readDone);
 }
 
 MyDB_PageHandle MyDB_BufferManager :: getPinnedPage (MyDB_TablePtr whichTable, long i) {
 
-	int fdToRead = -1;	
 	MyDB_PagePtr returnVal;
+	void *ram;
+	int fd;
 
 	{
 		Lock temp (getLock ());
@@ -380,37 +461,50 @@ MyDB_PageHandle MyDB_BufferManager :: getPinnedPage (MyDB_TablePtr whichTable, l
 		// in this case, we do
 		} else {
 	
-			// get him out of the LRU list if he is there
+			// if another thread is reading him in, wait until it is done
 			returnVal = allPages [whichPage];
+			while (returnVal->beingRead)
+				pthread_cond_wait (&readDone, getLock ());
+
+			// get him out of the LRU list if he is there
 			if (lastUsed.count (returnVal) != 0) {
 				auto page = *(lastUsed.find (returnVal));
 		       		lastUsed.erase (page);
 			}
 		}
 
-		// see if we need to get his data
-		if (returnVal->bytes == nullptr) {
+		// the LRU list is ordered by time tick, so a pinned page cannot keep its old one (another
+		// page could be given the same tick, and then be found in its place); as in pin (), it
+		// is never seen as having been used too long ago
+		returnVal->timeTick = -1;
+
+		// see if we have his data
+		if (returnVal->bytes != nullptr)
+			return make_shared <MyDB_PageHandleBase> (returnVal);
 
-			// see if there is space to make a pinned page
-			if (availableRam.size () == 0)
-				kickOutPage ();
+		// see if there is space to make a pinned page
+		if (availableRam.size () == 0)
+			kickOutPage ();
 	
-			// if there is no space, we cannot do anything
-			if (availableRam.size () == 0) 
-				return nullptr;
+		// if there is no space, we cannot do anything
+		if (availableRam.size () == 0) 
+			return nullptr;
 	
-			// set up the return val
-			returnVal->bytes = availableRam[availableRam.size () - 1];
-			returnVal->numBytes = pageSize;
-			availableRam.pop_back ();
-			fdToRead = fds[returnVal->myTable];
-		}
-
+		// as in access (), the RAM is not given to the page until it has been read
+		ram = availableRam[availableRam.size () - 1];
+		availableRam.pop_back ();
+		returnVal->beingRead = true;
+		fd = fds[returnVal->myTable];
 	}
 
-	if (fdToRead != -1) {
-		lseek (fdToRead, returnVal->pos * pageSize, SEEK_SET);
-		read (fdToRead, returnVal->bytes, pageSize);
+	readPage (returnVal, fd, ram);
+
+	{
+		Lock temp (getLock ());
+		returnVal->bytes = ram;
+		returnVal->numBytes = pageSize;
+		returnVal->beingRead = false;
+		pthread_cond_broadcast (&readDone);
 	}
 
 	// get outta here
@@ -448,6 +542,21 @@ void MyDB_BufferManager :: unpin (MyDB_PagePtr unpinMe) {
 	lastUsed.insert (unpinMe);
 }
 
+bool MyDB_BufferManager :: pin (MyDB_PagePtr pinMe) {
+
+	// access leaves the page buffered, and thread pinned, so it cannot go away before
+	// it is taken out of the LRU list
+	access (pinMe);
+	Lock temp (getLock ());
+	if (lastUsed.count (pinMe) == 0)
+		return false;
+	lastUsed.erase (pinMe);
+
+	// like any other pinned page, it is never seen as having been used too long ago
+	pinMe->timeTick = -1;
+	return true;
+}
+
 MyDB_BufferManager :: MyDB_BufferManager (size_t pageSizeIn, size_t numPagesIn, string tempFileIn) {
 
 	// remember the inputs
@@ -468,10 +577,15 @@ MyDB_BufferManager :: MyDB_BufferManager (size_t pageSizeIn, size_t numPagesIn,
 
 	// initialize the mutex
 	pthread_mutex_init (&myLock, nullptr);
+	pthread_cond_init (&readDone, nullptr);
 
 	// position in temp file
 	lastTempPos = 0;
 
+	// nothing read or written yet
+	bytesRead = 0;
+	bytesWritten = 0;
+
 	// the number of pages; we add some extra pages just to be safe
 	numPages = numPagesIn + 10;
 
@@ -493,8 +607,7 @@ MyDB_BufferManager :: ~MyDB_BufferManager () {
 
 			// write it back if necessary
 			if (page.second->isDirty) {
-				lseek (fds[page.second->myTable], page.second->pos * pageSize, SEEK_SET);
-				write (fds[page.second->myTable], page.second->bytes, pageSize);
+				writePage (page.second);
 			}
 
 			free (page.second->bytes);
@@ -509,6 +622,7 @@ MyDB_BufferManager :: ~MyDB_BufferManager () {
 
 	// get rid of the lock
 	pthread_mutex_destroy (&myLock);
+	pthread_cond_destroy (&readDone);
 	
 	// finally, close the files
 	for (auto fd : fds) {
@@ -33,6 +33,7 @@ MyDB_Page :: MyDB_Page (MyDB_TablePtr myTableIn, size_t iin, MyDB_BufferManager
 	parent (parentIn), myTable (myTableIn), pos (iin) { 
 	bytes = nullptr;
 	isDirty = false;	
+	beingRead = false;
 	pthread_mutex_init (&myMutex, nullptr);
 	refCount = 0;
 	timeTick = -1;
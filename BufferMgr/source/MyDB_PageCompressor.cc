@@ -0,0 +1,444 @@
+
+#ifndef PAGE_COMPRESSOR_C
+#define PAGE_COMPRESSOR_C
+
+#include <algorithm>
+#include <cstring>
+#include "MyDB_PageCompressor.h"
+
+using namespace std;
+
+bool MyDB_PageCompressor :: compress (void *page, size_t pageSize, MyDB_CompressionType scheme, vector <char> &output) {
+
+	char *bytes = (char *) page;
+	size_t headerSize = 2 * sizeof (size_t);
+	if (scheme == NoCompression || pageSize < headerSize)
+		return false;
+
+	size_t bytesUsed = *((size_t *) (bytes + sizeof (size_t)));
+	if (bytesUsed < headerSize || bytesUsed > pageSize)
+		return false;
+
+	// break the page up into columns, making sure that every record has the same number of fields
+	vector <Column> cols;
+	size_t numRecs = 0;
+	for (size_t pos = headerSize; pos < bytesUsed; numRecs++) {
+
+		if (pos + sizeof (short) > bytesUsed)
+			return false;
+		short recSize = *((short *) (bytes + pos));
+		if (recSize < (short) sizeof (short) || pos + recSize > bytesUsed)
+			return false;
+
+		size_t whichCol = 0;
+		for (size_t fieldPos = pos + sizeof (short); fieldPos < pos + recSize; whichCol++) {
+			if (fieldPos + sizeof (short) > pos + recSize)
+				return false;
+			short fieldSize = *((short *) (bytes + fieldPos));
+			if (fieldSize < (short) sizeof (short) || fieldPos + fieldSize > pos + recSize)
+				return false;
+
+			if (numRecs == 0)
+				cols.push_back (Column ());
+			else if (whichCol >= cols.size ())
+				return false;
+			cols[whichCol].fields.push_back (make_pair (bytes + fieldPos + sizeof (short), fieldSize - (int) sizeof (short)));
+			fieldPos += fieldSize;
+		}
+
+		if (whichCol != cols.size ())
+			return false;
+		pos += recSize;
+	}
+
+	// fields that always have 1, 2, 4, or 8 bytes are treated as integers
+	for (auto &col : cols) {
+		col.width = col.fields[0].second;
+		col.isInt = (col.width == 1 || col.width == 2 || col.width == 4 || col.width == 8);
+		for (auto &f : col.fields) {
+			if (f.second != col.width) {
+				col.isInt = false;
+				break;
+			}
+		}
+
+		if (!col.isInt)
+			continue;
+
+		// ints are sign extended; shorts and chars are not
+		for (auto &f : col.fields) {
+			if (col.width == 1)
+				col.ints.push_back (*((uint8_t *) f.first));
+			else if (col.width == 2)
+				col.ints.push_back (*((uint16_t *) f.first));
+			else if (col.width == 4)
+				col.ints.push_back (*((int32_t *) f.first));
+			else
+				col.ints.push_back (*((int64_t *) f.first));
+		}
+	}
+
+	// leave room for the magic number and the size, and then copy the page header as-is
+	output.clear ();
+	output.resize (2 * sizeof (uint32_t));
+	output.insert (output.end (), bytes, bytes + headerSize);
+	putVarint (output, numRecs);
+	putVarint (output, cols.size ());
+
+	// for each column, use whichever of the candidate encodings is smallest
+	vector <char> best, temp;
+	for (auto &col : cols) {
+		best.clear ();
+		bool first = true;
+		for (ColumnEncoding encoding : candidates (col, scheme)) {
+			temp.clear ();
+			temp.push_back ((char) encoding);
+			if (col.isInt)
+				encodeInts (col, encoding, temp);
+			else
+				encodeBytes (col, encoding, temp);
+			if (first || temp.size () < best.size ()) {
+				best.swap (temp);
+				first = false;
+			}
+		}
+		output.insert (output.end (), best.begin (), best.end ());
+	}
+
+	// no point in doing this if we did not save anything
+	if (output.size () >= pageSize)
+		return false;
+
+	*((uint32_t *) &output[0]) = COMPRESSED_PAGE_MAGIC;
+	*((uint32_t *) &output[sizeof (uint32_t)]) = (uint32_t) output.size ();
+	return true;
+}
+
+size_t MyDB_PageCompressor :: compressedSize (char *input, size_t bytesAvailable) {
+	if (bytesAvailable < 2 * sizeof (uint32_t) || *((uint32_t *) input) != COMPRESSED_PAGE_MAGIC)
+		return 0;
+	return *((uint32_t *) (input + sizeof (uint32_t)));
+}
+
+bool MyDB_PageCompressor :: decompress (char *input, size_t inputSize, void *page, size_t pageSize) {
+
+	char *bytes = (char *) page;
+	size_t headerSize = 2 * sizeof (size_t);
+	if (compressedSize (input, inputSize) != inputSize || inputSize < 2 * sizeof (uint32_t) + headerSize ||
+		pageSize < headerSize)
+		return false;
+
+	char *end = input + inputSize;
+	input += 2 * sizeof (uint32_t);
+	memcpy (bytes, input, headerSize);
+	size_t bytesUsed = *((size_t *) (bytes + sizeof (size_t)));
+	input += headerSize;
+
+	uint64_t numRecs, numCols;
+	if (!getVarint (input, end, numRecs) || !getVarint (input, end, numCols) || numCols > pageSize)
+		return false;
+
+	vector <Column> cols (numCols);
+	for (auto &col : cols) {
+		if (!decodeColumn (input, end, numRecs, col))
+			return false;
+	}
+
+	// and put the records back together
+	size_t pos = headerSize;
+	for (size_t i = 0; i < numRecs; i++) {
+
+		size_t recStart = pos;
+		pos += sizeof (short);
+		if (pos > pageSize)
+			return false;
+
+		for (auto &col : cols) {
+			int len = col.isInt ? col.width : col.fields[i].second;
+			if (pos + sizeof (short) + len > pageSize)
+				return false;
+			*((short *) (bytes + pos)) = (short) (sizeof (short) + len);
+			pos += sizeof (short);
+			if (col.isInt)
+				memcpy (bytes + pos, &col.ints[i], len);
+			else
+				memcpy (bytes + pos, col.fields[i].first, len);
+			pos += len;
+		}
+		*((short *) (bytes + recStart)) = (short) (pos - recStart);
+	}
+
+	if (pos != bytesUsed)
+		return false;
+
+	memset (bytes + pos, 0, pageSize - pos);
+	return true;
+}
+
+vector <MyDB_PageCompressor :: ColumnEncoding> MyDB_PageCompressor :: candidates (Column &col, MyDB_CompressionType scheme) {
+
+	vector <ColumnEncoding> returnVal;
+	if (col.isInt) {
+		returnVal.push_back (RawInts);
+		if (scheme == AdaptiveCompression || scheme == FrameOfReferenceCompression)
+			returnVal.push_back (FrameOfReference);
+		if (scheme == AdaptiveCompression || scheme == DeltaCompression)
+			returnVal.push_back (Delta);
+		if (scheme == AdaptiveCompression || scheme == RunLengthCompression)
+			returnVal.push_back (RunLengthInts);
+	} else {
+		returnVal.push_back (RawBytes);
+		if (scheme == AdaptiveCompression || scheme == RunLengthCompression)
+			returnVal.push_back (RunLengthBytes);
+	}
+	return returnVal;
+}
+
+void MyDB_PageCompressor :: encodeInts (Column &col, ColumnEncoding encoding, vector <char> &output) {
+
+	output.push_back ((char) col.width);
+	vector <int64_t> &ints = col.ints;
+
+	if (encoding == RawInts) {
+		for (auto &f : col.fields) {
+			output.insert (output.end (), f.first, f.first + col.width);
+		}
+
+	// store the smallest value, and then the bit-packed offset of each value from it
+	} else if (encoding == FrameOfReference) {
+		int64_t low = ints[0];
+		for (int64_t v : ints) {
+			if (v < low)
+				low = v;
+		}
+		vector <uint64_t> offsets;
+		uint64_t high = 0;
+		for (int64_t v : ints) {
+			offsets.push_back ((uint64_t) v - (uint64_t) low);
+			high |= offsets.back ();
+		}
+		putVarint (output, zigzag (low));
+		output.push_back ((char) bitsNeeded (high));
+		packBits (output, offsets, bitsNeeded (high));
+
+	// store the first value, and then the differences, frame-of-reference encoded
+	} else if (encoding == Delta) {
+		putVarint (output, zigzag (ints[0]));
+		int64_t low = 0;
+		vector <int64_t> deltas;
+		for (size_t i = 1; i < ints.size (); i++) {
+			deltas.push_back ((int64_t) ((uint64_t) ints[i] - (uint64_t) ints[i - 1]));
+			if (i == 1 || deltas.back () < low)
+				low = deltas.back ();
+		}
+		vector <uint64_t> offsets;
+		uint64_t high = 0;
+		for (int64_t d : deltas) {
+			offsets.push_back ((uint64_t) d - (uint64_t) low);
+			high |= offsets.back ();
+		}
+		putVarint (output, zigzag (low));
+		output.push_back ((char) bitsNeeded (high));
+		packBits (output, offsets, bitsNeeded (high));
+
+	// store (value, run length) pairs
+	} else {
+		vector <pair <int64_t, uint64_t>> runs;
+		for (int64_t v : ints) {
+			if (!runs.empty () && runs.back ().first == v)
+				runs.back ().second++;
+			else
+				runs.push_back (make_pair (v, 1));
+		}
+		putVarint (output, runs.size ());
+		for (auto &r : runs) {
+			putVarint (output, zigzag (r.first));
+			putVarint (output, r.second);
+		}
+	}
+}
+
+void MyDB_PageCompressor :: encodeBytes (Column &col, ColumnEncoding encoding, vector <char> &output) {
+
+	if (encoding == RawBytes) {
+		for (auto &f : col.fields) {
+			putVarint (output, f.second);
+			output.insert (output.end (), f.first, f.first + f.second);
+		}
+
+	// store (run length, value) pairs
+	} else {
+		vector <pair <pair <char *, int>, uint64_t>> runs;
+		for (auto &f : col.fields) {
+			if (!runs.empty () && runs.back ().first.second == f.second &&
+				memcmp (runs.back ().first.first, f.first, f.second) == 0)
+				runs.back ().second++;
+			else
+				runs.push_back (make_pair (f, 1));
+		}
+		putVarint (output, runs.size ());
+		for (auto &r : runs) {
+			putVarint (output, r.second);
+			putVarint (output, r.first.second);
+			output.insert (output.end (), r.first.first, r.first.first + r.first.second);
+		}
+	}
+}
+
+bool MyDB_PageCompressor :: decodeColumn (char *&input, char *end, size_t numRecs, Column &col) {
+
+	if (input >= end)
+		return false;
+	ColumnEncoding encoding = (ColumnEncoding) *(input++);
+
+	// the byte encodings point right into the input
+	if (encoding == RawBytes || encoding == RunLengthBytes) {
+		col.isInt = false;
+		uint64_t numRuns = numRecs, runLen = 1, len;
+		if (encoding == RunLengthBytes && !getVarint (input, end, numRuns))
+			return false;
+		for (uint64_t i = 0; i < numRuns; i++) {
+			if ((encoding == RunLengthBytes && !getVarint (input, end, runLen)) || !getVarint (input, end, len) ||
+				len > (uint64_t) (end - input) || runLen > numRecs - col.fields.size ())
+				return false;
+			for (uint64_t j = 0; j < runLen; j++) {
+				col.fields.push_back (make_pair (input, (int) len));
+			}
+			input += len;
+		}
+		return col.fields.size () == numRecs;
+	}
+
+	if (input >= end)
+		return false;
+	col.isInt = true;
+	col.width = *(input++);
+	if (col.width != 1 && col.width != 2 && col.width != 4 && col.width != 8)
+		return false;
+
+	if (encoding == RawInts) {
+		if ((uint64_t) (end - input) < numRecs * col.width)
+			return false;
+		for (size_t i = 0; i < numRecs; i++) {
+			int64_t v = 0;
+			memcpy (&v, input, col.width);
+			col.ints.push_back (v);
+			input += col.width;
+		}
+
+	} else if (encoding == FrameOfReference || encoding == Delta) {
+
+		uint64_t first = 0, low;
+		if (encoding == Delta && !getVarint (input, end, first))
+			return false;
+		size_t numPacked = (encoding == Delta) ? numRecs - 1 : numRecs;
+		if (numRecs == 0 || !getVarint (input, end, low) || input >= end)
+			return false;
+		int numBits = *(input++);
+		vector <uint64_t> offsets;
+		if (numBits < 0 || numBits > 64 || !unpackBits (input, end, numPacked, numBits, offsets))
+			return false;
+
+		if (encoding == FrameOfReference) {
+			for (uint64_t o : offsets) {
+				col.ints.push_back ((int64_t) (o + (uint64_t) unzigzag (low)));
+			}
+		} else {
+			col.ints.push_back (unzigzag (first));
+			for (uint64_t o : offsets) {
+				col.ints.push_back ((int64_t) ((uint64_t) col.ints.back () + o + (uint64_t) unzigzag (low)));
+			}
+		}
+
+	} else if (encoding == RunLengthInts) {
+		uint64_t numRuns, val, runLen;
+		if (!getVarint (input, end, numRuns))
+			return false;
+		for (uint64_t i = 0; i < numRuns; i++) {
+			if (!getVarint (input, end, val) || !getVarint (input, end, runLen) || runLen > numRecs - col.ints.size ())
+				return false;
+			col.ints.insert (col.ints.end (), runLen, unzigzag (val));
+		}
+
+	} else {
+		return false;
+	}
+
+	return col.ints.size () == numRecs;
+}
+
+void MyDB_PageCompressor :: putVarint (vector <char> &output, uint64_t val) {
+	while (val >= 0x80) {
+		output.push_back ((char) (val | 0x80));
+		val >>= 7;
+	}
+	output.push_back ((char) val);
+}
+
+bool MyDB_PageCompressor :: getVarint (char *&input, char *end, uint64_t &val) {
+	val = 0;
+	for (int shift = 0; input < end && shift < 64; shift += 7) {
+		uint8_t next = *(input++);
+		val |= (uint64_t) (next & 0x7f) << shift;
+		if ((next & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+uint64_t MyDB_PageCompressor :: zigzag (int64_t val) {
+	return ((uint64_t) val << 1) ^ (uint64_t) (val >> 63);
+}
+
+int64_t MyDB_PageCompressor :: unzigzag (uint64_t val) {
+	return (int64_t) (val >> 1) ^ -(int64_t) (val & 1);
+}
+
+int MyDB_PageCompressor :: bitsNeeded (uint64_t val) {
+	return (val == 0) ? 0 : 64 - __builtin_clzll (val);
+}
+
+void MyDB_PageCompressor :: packBits (vector <char> &output, vector <uint64_t> &vals, int numBits) {
+
+	size_t start = output.size ();
+	output.resize (start + (vals.size () * numBits + 7) / 8, 0);
+	uint8_t *dest = (uint8_t *) &output[start];
+
+	// write each value a byte-sized chunk at a time
+	size_t bit = 0;
+	for (uint64_t v : vals) {
+		for (int done = 0; done < numBits; ) {
+			int inByte = bit & 7;
+			int take = min (8 - inByte, numBits - done);
+			dest[bit >> 3] |= (uint8_t) (((v >> done) & ((1u << take) - 1)) << inByte);
+			done += take;
+			bit += take;
+		}
+	}
+}
+
+bool MyDB_PageCompressor :: unpackBits (char *&input, char *end, size_t numVals, int numBits, vector <uint64_t> &vals) {
+
+	size_t numBytes = (numVals * numBits + 7) / 8;
+	if ((size_t) (end - input) < numBytes)
+		return false;
+
+	uint8_t *src = (uint8_t *) input;
+	size_t bit = 0;
+	for (size_t i = 0; i < numVals; i++) {
+		uint64_t v = 0;
+		for (int done = 0; done < numBits; ) {
+			int inByte = bit & 7;
+			int take = min (8 - inByte, numBits - done);
+			v |= (uint64_t) ((src[bit >> 3] >> inByte) & ((1u << take) - 1)) << done;
+			done += take;
+			bit += take;
+		}
+		vals.push_back (v);
+	}
+
+	input += numBytes;
+	return true;
+}
+
+#endif
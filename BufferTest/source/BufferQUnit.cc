@@ -271,6 +271,87 @@ int main () {
 	}
 	cout << "COMPLETE" << endl << flush;
 	QUNIT_IS_TRUE(flag9);
+
+	// compressed pages: write pages laid out the way MyDB_PageReaderWriter lays them out,
+	// force them out to disk, and make sure that they come back the same, with fewer
+	// bytes moved
+	const char *schemes[] = {"compressed", "delta", "rle", "for"};
+	size_t pageSize = 16384;
+	for (int s = 0; s < 4; s++) {
+		bool flag10 = true;
+		cout << "TEST 10 (" << schemes[s] << ")..." << flush;
+		vector <vector <char>> expected (16, vector <char> (pageSize, 0));
+		size_t bytesWritten;
+		{
+			cout << "create manager..." << flush;
+			MyDB_BufferManager myMgr(pageSize, 4, "tempDSFSD");
+			MyDB_TablePtr table1 = make_shared <MyDB_Table>("table1", "fileCompressed");
+			vector <string> options;
+			options.push_back (schemes[s]);
+			table1->setOptions (options);
+			cout << "write bytes..." << flush;
+			const char *strs[] = {"NONE", "TAKE BACK RETURN", "COLLECT COD"};
+			for (int i = 0; i < 16; i++) {
+
+				// each record is a sorted int, a constant int, a double, and a string
+				char *bytes = &expected[i][0];
+				size_t used = 2 * sizeof (size_t);
+				for (int j = 0; used + 60 < pageSize; j++) {
+					size_t recStart = used;
+					used += sizeof (short);
+					*((short *) (bytes + used)) = 6;
+					*((int *) (bytes + used + 2)) = i * 1000 + j;
+					used += 6;
+					*((short *) (bytes + used)) = 6;
+					*((int *) (bytes + used + 2)) = -7;
+					used += 6;
+					*((short *) (bytes + used)) = 10;
+					*((double *) (bytes + used + 2)) = j / 3.0;
+					used += 10;
+					const char *str = strs[(j / 5) % 3];
+					*((short *) (bytes + used)) = 2 + strlen (str) + 1;
+					strcpy (bytes + used + 2, str); 
+					used += 2 + strlen (str) + 1;
+					*((short *) (bytes + recStart)) = used - recStart;
+				}
+				*((size_t *) bytes) = 0;
+				*((size_t *) (bytes + sizeof (size_t))) = used;
+
+				// the last page is not a record page, so it has to be written as-is
+				if (i == 15)
+					memset (bytes, 'Z', pageSize);
+
+				MyDB_PageHandle page = myMgr.getPage(table1, i);
+				memcpy (page->getBytes (), bytes, pageSize);
+				page->wroteBytes ();
+			}
+			cout << "read bytes..." << flush;
+			for (int i = 0; i < 16; i++) {
+				MyDB_PageHandle page = myMgr.getPage(table1, i);
+				if (memcmp (page->getBytes (), &expected[i][0], pageSize) != 0) flag10 = false;
+			}
+			bytesWritten = myMgr.getBytesWritten ();
+			cout << "shutdown manager..." << flush;
+		}
+		{
+			cout << "reread bytes..." << flush;
+			MyDB_BufferManager myMgr(pageSize, 4, "tempDSFSD");
+			MyDB_TablePtr table1 = make_shared <MyDB_Table>("table1", "fileCompressed");
+			vector <string> options;
+			options.push_back (schemes[s]);
+			table1->setOptions (options);
+			for (int i = 0; i < 16; i++) {
+				MyDB_PageHandle page = myMgr.getPage(table1, i);
+				if (memcmp (page->getBytes (), &expected[i][0], pageSize) != 0) flag10 = false;
+			}
+			cout << "read " << myMgr.getBytesRead () << " bytes for " << 16 * pageSize << "..." << flush;
+			if (myMgr.getBytesRead () >= 16 * pageSize) flag10 = false;
+		}
+		unlink ("fileCompressed");
+		cout << "COMPLETE" << endl << flush;
+		QUNIT_IS_TRUE(flag10);
+		QUNIT_IS_TRUE(bytesWritten < 16 * pageSize);
+	}
 }
 
 #endif
@@ -132,6 +132,54 @@ public:
 	}	
 };
 
+// a string attribute whose values are stored as codes in a dictionary... as far as
+// type checking goes, this is just a string
+class MyDB_DictAttType;
+typedef shared_ptr <MyDB_DictAttType> MyDB_DictAttTypePtr;
+
+class MyDB_DictAttType : public MyDB_StringAttType {
+
+public: 
+
+	MyDB_DictAttType (MyDB_DictionaryPtr myDictionaryIn) {
+		myDictionary = myDictionaryIn;
+	}
+
+	MyDB_AttValPtr createAtt () {
+		return make_shared <MyDB_DictAttVal> (myDictionary);
+	}	
+
+	MyDB_DictionaryPtr &getDictionary () {
+		return myDictionary;
+	}
+
+private:
+
+	MyDB_DictionaryPtr myDictionary;
+};
+
+// the type of a string literal in a computation; it remembers the literal, so that
+// a computation can do work such as dictionary lookups once, when it is compiled
+class MyDB_StringLiteralAttType;
+typedef shared_ptr <MyDB_StringLiteralAttType> MyDB_StringLiteralAttTypePtr;
+
+class MyDB_StringLiteralAttType : public MyDB_StringAttType {
+
+public: 
+
+	MyDB_StringLiteralAttType (string literalIn) {
+		literal = literalIn;
+	}
+
+	string &getLiteral () {
+		return literal;
+	}
+
+private:
+
+	string literal;
+};
+
 class MyDB_BoolAttType : public MyDB_AttType {
 
 public: 
@@ -0,0 +1,10 @@
+
+#ifndef COMPRESSION_TYPE_H
+#define COMPRESSION_TYPE_H
+
+// this lists all of the ways that the pages of a table can be compressed on disk;
+// AdaptiveCompression picks the smallest encoding for each column on each page
+enum MyDB_CompressionType {NoCompression, AdaptiveCompression, DeltaCompression, RunLengthCompression, 
+	FrameOfReferenceCompression};
+
+#endif
@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include "MyDB_Catalog.h"
+#include "MyDB_CompressionType.h"
 #include "MyDB_Schema.h"
 #include "MyDB_Table.h"
 #include <memory>
@@ -78,7 +79,8 @@ public:
 	void setRootLocation (int toMe);
 	int getRootLocation ();
 
-        // get the distinct value count for an attribute
+        // get the distinct value count for an attribute (-1 if there is no such attribute,
+        // or if the table has not been loaded, so that it has not been counted)
         size_t getDistinctValues (string forMe);
         size_t getDistinctValues (int forMe);
 
@@ -89,8 +91,24 @@ public:
         void setTupleCount (size_t toMe);
         size_t getTupleCount ();
 
+	// get/set the storage options given when the table was created (ex: "dictionary")
+	vector <string> &getOptions ();
+	void setOptions (vector <string> &toMe);
+	bool hasOption (string option);
+
+	// true if the given string is a storage option that we know how to handle
+	static bool isKnownOption (string option);
+
+	// the on-disk page compression given by the options ("compressed", "delta", "rle", 
+	// or "for"); NoCompression if there is none.  If there is more than one, the first wins
+	MyDB_CompressionType getCompression ();
+	static bool isCompressionOption (string option);
+
 private:
 
+	// the storage options
+	vector <string> options;
+
 	// the distinct value counts
 	vector <size_t> allCounts;
 
@@ -41,6 +41,16 @@ void MyDB_Schema :: addAtt (string tableName, pair <string, MyDB_AttTypePtr> att
 	}
 	catalog->putStringList (tableName + ".attList", myAtts);
 	catalog->putString (tableName + "." + attToAdd.first + ".type", attToAdd.second->toString ());
+
+	// if the att is dictionary encoded, remember the dictionary; an empty list means no dictionary
+	MyDB_DictAttTypePtr dictType = dynamic_pointer_cast <MyDB_DictAttType> (attToAdd.second);
+	if (dictType != nullptr) {
+		catalog->putStringList (tableName + "." + attToAdd.first + ".dictionary", dictType->getDictionary ()->toCatalogList ());
+	} else {
+		vector <string> empty;
+		if (catalog->getStringList (tableName + "." + attToAdd.first + ".dictionary", empty))
+			catalog->putStringList (tableName + "." + attToAdd.first + ".dictionary", vector <string> ());
+	}
 }
 
 
@@ -60,7 +70,13 @@ void MyDB_Schema :: fromCatalog (string tableName, MyDB_CatalogPtr catalog) {
 		} else if (attType == "double") {
 			allAtts.push_back (make_pair (s, make_shared <MyDB_DoubleAttType> ()));
 		} else if (attType == "string") {
-			allAtts.push_back (make_pair (s, make_shared <MyDB_StringAttType> ()));
+			vector <string> dictionary;
+			catalog->getStringList (tableName + "." + s + ".dictionary", dictionary);
+			if (dictionary.size () > 0) {
+				allAtts.push_back (make_pair (s, make_shared <MyDB_DictAttType> (MyDB_Dictionary :: fromCatalogList (dictionary))));
+			} else {
+				allAtts.push_back (make_pair (s, make_shared <MyDB_StringAttType> ()));
+			}
 		} else if (attType == "bool") {
 			allAtts.push_back (make_pair (s, make_shared <MyDB_BoolAttType> ()));
 		} else {
@@ -11,6 +11,7 @@ MyDB_Table :: MyDB_Table (string name, string storageLocIn) {
 	fileType = "heap";
 	sortAtt = "none";
 	rootLocation = -1;
+	count = 0;
 }
 
 MyDB_Table :: MyDB_Table (string name, string storageLocIn, MyDB_SchemaPtr mySchemaIn) {
@@ -21,6 +22,7 @@ MyDB_Table :: MyDB_Table (string name, string storageLocIn, MyDB_SchemaPtr mySch
 	fileType = "heap";
 	sortAtt = "none";
 	rootLocation = -1;
+	count = 0;
 }
 
 MyDB_Table :: MyDB_Table (string name, string storageLocIn, MyDB_SchemaPtr mySchemaIn, string fileTypeIn, string sortAttIn) {
@@ -31,6 +33,7 @@ MyDB_Table :: MyDB_Table (string name, string storageLocIn, MyDB_SchemaPtr mySch
 	fileType = fileTypeIn;
 	sortAtt = sortAttIn;
 	rootLocation = -1;
+	count = 0;
 }
 
 MyDB_Table :: ~MyDB_Table () {}
@@ -41,7 +44,7 @@ string &MyDB_Table :: getName () {
 
 size_t MyDB_Table :: getDistinctValues (string forMe) {
 	auto res = mySchema->getAttByName (forMe);
-	if (res.first != -1)
+	if (res.first != -1 && res.first < (int) allCounts.size ())
 		return allCounts[res.first];
 	else
 		return -1;
@@ -71,6 +74,44 @@ int MyDB_Table :: getRootLocation () {
 	return rootLocation;
 }
 
+vector <string> &MyDB_Table :: getOptions () {
+	return options;
+}
+
+void MyDB_Table :: setOptions (vector <string> &toMe) {
+	options = toMe;
+}
+
+bool MyDB_Table :: hasOption (string option) {
+	for (string &s : options) {
+		if (s == option)
+			return true;
+	}
+	return false;
+}
+
+bool MyDB_Table :: isKnownOption (string option) {
+	return option == "dictionary" || isCompressionOption (option);
+}
+
+bool MyDB_Table :: isCompressionOption (string option) {
+	return option == "compressed" || option == "delta" || option == "rle" || option == "for";
+}
+
+MyDB_CompressionType MyDB_Table :: getCompression () {
+	for (string &s : options) {
+		if (s == "compressed")
+			return AdaptiveCompression;
+		else if (s == "delta")
+			return DeltaCompression;
+		else if (s == "rle")
+			return RunLengthCompression;
+		else if (s == "for")
+			return FrameOfReferenceCompression;
+	}
+	return NoCompression;
+}
+
 string &MyDB_Table :: getFileType () {
 	return fileType;
 }
@@ -146,6 +187,10 @@ bool MyDB_Table :: fromCatalog (string tableNameIn, MyDB_CatalogPtr catalog) {
 	// get the number of tuples
 	catalog->getInt (tableName + ".numTuples", count);
 
+	// get the storage options
+	options.clear ();
+	catalog->getStringList (tableName + ".options", options);
+
 	return true;
 }
 
@@ -191,6 +236,9 @@ void MyDB_Table :: putInCatalog (MyDB_CatalogPtr catalog) {
 	// remember the last page in the file
         catalog->putInt (tableName + ".lastPage", last);
 
+	// and the storage options
+	catalog->putStringList (tableName + ".options", options);
+
 	// and add the schema in 
 	mySchema->putInCatalog (tableName, catalog);	
 }
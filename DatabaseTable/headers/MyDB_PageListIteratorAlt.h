@@ -43,11 +43,26 @@ public:
 	MyDB_PageListIteratorAlt (vector <MyDB_PageReaderWriter> &forUs);
 	~MyDB_PageListIteratorAlt ();
 
+	// a constructor for an iterator that, if prefetch is true, keeps the page it is on and the
+	// page after it pinned, so that neither can be bought out while the list is being read
+	// (this is what lets a merge read from many lists at once without thrashing the buffer).
+	// Each page is let go once the iterator has moved past it, so that if no one else has it,
+	// an anonymous page goes back to the buffer manager as soon as it has been read
+	MyDB_PageListIteratorAlt (vector <MyDB_PageReaderWriter> &forUs, bool prefetch);
+
 private:
 
+	// pins the given page, if there is one, and lets go of the given page
+	void fetch (int whichPage);
+	void release (int whichPage);
+
 	MyDB_RecordIteratorAltPtr myIter;
 	vector <MyDB_PageReaderWriter> forUs;
 	int curPage;
+
+	// whether the pages are pinned as they are reached, and which ones this iterator pinned
+	bool prefetch;
+	vector <bool> pinned;
 };
 
 #endif
@@ -14,6 +14,7 @@
 #define PAGE_RW_H
 
 #include <memory>
+#include "MyDB_NormalizedKey.h"
 #include "MyDB_PageType.h"
 #include "MyDB_RecordIterator.h"
 #include "MyDB_RecordIteratorAlt.h"
@@ -58,6 +59,13 @@ public:
 	// gets an instance of an alternatie iterator over a list of pages
 	friend MyDB_RecordIteratorAltPtr getIteratorAlt (vector <MyDB_PageReaderWriter> &forUs);
 
+	// pins the page, reading it in if it is not in the buffer; this returns false (and does
+	// nothing) if the page is already pinned, in which case unpin should not be called for it
+	bool pin ();
+
+	// un-pins the page
+	void unpin ();
+
 	// appends a record to this page... return false is the append fails because
 	// there is not enough space on the page; otherwise, return true
 	bool append (MyDB_RecordPtr appendMe);
@@ -83,22 +91,69 @@ public:
 	// like the above, except that the sorting is done in place, on the page
 	void sortInPlace (function <bool ()> comparator, MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs);
 
+	// like the two above, except that the records are put in order by their normalized keys
+	// (see MyDB_NormalizedKey), which must have been built over lhs; the comparator is then
+	// only used to break ties between keys that are not exact, so it must give the same order.
+	// If key is null, the comparator is used for everything
+	MyDB_PageReaderWriterPtr sort (MyDB_NormalizedKeyPtr key, function <bool ()> comparator,
+		MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs);
+	void sortInPlace (MyDB_NormalizedKeyPtr key, function <bool ()> comparator, MyDB_RecordPtr lhs,
+		MyDB_RecordPtr rhs);
+
+	// sorts the records on all of the pages in sortUs together, as one list (on their normalized
+	// keys, if key is not null, as above), and writes them out in order onto anonymous pages
+	// from parent, which are returned.  The pages in sortUs must all be pinned, since the sort
+	// works on pointers to the records where they are; each record is then copied just once
+	friend vector <MyDB_PageReaderWriter> sortAcrossPages (vector <MyDB_PageReaderWriter> &sortUs, 
+		MyDB_BufferManager &parent, MyDB_NormalizedKeyPtr key, function <bool ()> comparator, 
+		MyDB_RecordPtr lhs, MyDB_RecordPtr rhs);
+
+	// replaces the contents of this page with those of another page of the same size
+	void copyFrom (MyDB_PageReaderWriter &fromMe);
+
 	// returns the page size
 	size_t getPageSize ();
 
-	// returns the actual bytes
+	// returns the actual bytes; anything written to them directly is not seen by the
+	// table's zone map, so the page should also be written through one of the above
 	void *getBytes ();
 
 private:
 
+	friend class MyDB_TableReaderWriter;
+
+	// marks the page dirty; if the page came from a table that keeps a zone map, the
+	// zone map no longer knows what is on the page (nor does its saved copy)
+	void wroteBytes ();
+
+	// called by the table when it gives the page out, so that writing it can be noticed
+	void watchWrites (MyDB_ZoneMapPtr zoneMapIn, size_t whichPageIn);
+
+	// appends the record whose bytes are at rec (which start with its size) as is; returns
+	// false if there is not enough space on the page
+	bool appendBytes (void *rec);
+
 	// this is the page that we are messing with
 	MyDB_PageHandle myPage;	
 	
 	// this is our buffer manager
 	size_t pageSize;
+
+	// the zone map of the table that this page came from, if the first write to the page
+	// has not been seen yet, and which page of the table this is
+	MyDB_ZoneMapPtr zoneMap;
+	size_t whichPage;
 };
 
 // gets an instance of an alternatie iterator over a list of pages
 MyDB_RecordIteratorAltPtr getIteratorAlt (vector <MyDB_PageReaderWriter> &forUs);
 
+// see the friend declaration above
+vector <MyDB_PageReaderWriter> sortAcrossPages (vector <MyDB_PageReaderWriter> &sortUs, MyDB_BufferManager &parent,
+	MyDB_NormalizedKeyPtr key, function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs);
+
+// the same, except that the page being read and the one after it are kept pinned (see
+// MyDB_PageListIteratorAlt), and pages are let go as soon as they have been read
+MyDB_RecordIteratorAltPtr getPrefetchingIteratorAlt (vector <MyDB_PageReaderWriter> &forUs);
+
 #endif
@@ -32,7 +32,7 @@ public:
 
         // advance to the next record... returns true if there is a next record, and
         // false if there are no more records to iterate over.  Not that this cannot
-        // be called until after getCurrent () has been called
+        // be called until after getCurrent () (or getCurrentPointer ()) has been called
         bool advance () override;
 
 	// destructor and contructor
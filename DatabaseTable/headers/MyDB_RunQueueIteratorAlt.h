@@ -13,9 +13,7 @@
 #ifndef RUN_Q_ITER_ALT_H
 #define RUN_Q_ITER_ALT_H
 
-#include "IteratorComparator.h"
 #include "MyDB_RecordIteratorAlt.h"
-#include "MyDB_RunQueueIteratorAlt.h"
 #include "MyDB_PageRecIteratorAlt.h"
 #include "MyDB_PageReaderWriter.h"
 #include "MyDB_Record.h"
@@ -25,6 +23,17 @@ using namespace std;
 class MyDB_RunQueueIteratorAlt;
 typedef shared_ptr <MyDB_RunQueueIteratorAlt> MyDB_RunQueueIteratorAltPtr;
 
+// this merges a set of sorted runs.  It is a tournament (loser) tree: each internal node of a
+// binary tree over the runs remembers the run that lost the comparison there, so once the run
+// with the smallest record advances, only the log k nodes on the way from its leaf to the root
+// are looked at again, with one comparison each.  There are two ways to compare runs:
+//
+// 1) with a comparator over two records (as built by buildRecordComparator); the current record
+//    of a run is then loaded into lhs or rhs when it is compared, unless it is already there
+//
+// 2) with a computation over the records (as given to buildRecordComparator); the value of the
+//    computation for the current record of each run is found once, when the run advances, and
+//    kept, so the comparisons are made directly on the kept values (ints, doubles, or strings)
 class MyDB_RunQueueIteratorAlt : public MyDB_RecordIteratorAlt {
 
 public:
@@ -46,18 +55,53 @@ public:
 	// build an iterator that uses the given comparator, over the two records
 	MyDB_RunQueueIteratorAlt (function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs);
 
-	// get access to the internal queue, for building it up
-	inline priority_queue <MyDB_RecordIteratorAltPtr,
-        vector <MyDB_RecordIteratorAltPtr>, IteratorComparator> &getQ () {
-        	return pq;
-	}
+	// build an iterator over runs of records with the given schema, that orders the records
+	// by the value of the computation sortOn
+	MyDB_RunQueueIteratorAlt (MyDB_SchemaPtr schema, string sortOn);
+
+	// adds a run; it must already have been advanced to its first record.  All of the runs
+	// have to be added before the first call to advance ()
+	void addRun (MyDB_RecordIteratorAltPtr addMe);
+
+	// the number of runs that have been added
+	int getNumRuns ();
 
 	~MyDB_RunQueueIteratorAlt ();
 
 private:
 
-	priority_queue <MyDB_RecordIteratorAltPtr, vector <MyDB_RecordIteratorAltPtr>, IteratorComparator> pq;
+	// true if the current record of run a comes before the current record of run b;
+	// a run that is used up comes after everything
+	bool beats (int a, int b);
+
+	// the run has a new current record
+	void loadRun (int whichRun);
+
+	vector <MyDB_RecordIteratorAltPtr> runs;
+	vector <bool> done;
+
+	// the loser at each internal node (node i has children 2i and 2i + 1, and run j is at
+	// node numRuns + j), and the overall winner
+	vector <int> losers;
+	int winner;
 	bool firstTime;
+
+	// comparing with a comparator: which run's current record is in lhs and in rhs (or -1);
+	// this is only trusted during a single call to advance ()
+	function <bool ()> comparator;
+	MyDB_RecordPtr lhs;
+	MyDB_RecordPtr rhs;
+	int inLHS;
+	int inRHS;
+
+	// comparing with kept values: the record, compiled computation, and value for each run,
+	// and whether the values are ints ('i'), doubles ('d'), or strings ('s')
+	MyDB_SchemaPtr schema;
+	string sortOn;
+	char keyType;
+	vector <MyDB_RecordPtr> runRecs;
+	vector <valFunc> keyFuncs;
+	vector <MyDB_Value> keys;
 };
 
 #endif
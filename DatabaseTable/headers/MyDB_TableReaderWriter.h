@@ -19,6 +19,8 @@
 #include "MyDB_RecordIterator.h"
 #include "MyDB_RecordIteratorAlt.h"
 #include "MyDB_Table.h"
+#include "MyDB_ZoneMap.h"
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -27,6 +29,8 @@ using namespace std;
 class MyDB_PageReaderWriter;
 class MyDB_TableReaderWriter;
 typedef shared_ptr <MyDB_TableReaderWriter> MyDB_TableReaderWriterPtr;
+class MyDB_TableRecIteratorAlt;
+typedef shared_ptr <MyDB_TableRecIteratorAlt> MyDB_TableRecIteratorAltPtr;
 
 class MyDB_TableReaderWriter {
 
@@ -55,10 +59,21 @@ public:
 	// highPage inclusive
 	MyDB_RecordIteratorAltPtr getIteratorAlt (int lowPage, int highPage);
 
+	// gets an alternate iterator over the table that uses the per-page zone maps to
+	// skip over pages that cannot contain any record accepted by the given predicate
+	// (encoded as in MyDB_Record :: compileComputation).  The iterator can still
+	// return records that are not accepted, so the caller must check the predicate
+	MyDB_TableRecIteratorAltPtr getFilteredIteratorAlt (string selectionPredicate);
+	MyDB_TableRecIteratorAltPtr getFilteredIteratorAlt (MyDB_CompNodePtr selectionPredicate);
+
 	// load a text file into this table... this returns a pair where the first
 	// entry is a list of (approximate) distinct value counts for each of the
 	// attributes in the table, and the second entry is the number of tuples that
-	// have been loaded into the table
+	// have been loaded into the table.  The zone map for the table is written
+	// alongside the table, into getZoneMapFile ().  If the table has the
+	// "dictionary" option, this also decides which string atts are dictionary
+	// encoded, changing their types in the table's schema... so records obtained
+	// from getEmptyRecord () before the load should not be used after it
 	pair <vector <size_t>, size_t> loadFromTextFile (string fromMe);
 
 	// dump the contents of this table into a text file
@@ -73,6 +88,12 @@ public:
 	// access the last page in the file
 	MyDB_PageReaderWriter last ();
 
+	// adds an empty page to the end of the file for the caller to write records into
+	// directly, setting whichPage to its number.  Several threads (see executeThreads) can
+	// do this at once, each filling its own pages, as long as nothing else is appended to
+	// the table until they are done.  The zone map does not track the new page
+	MyDB_PageReaderWriter addPage (size_t &whichPage);
+
 	// get the number of pages in the file
 	int getNumPages ();
 
@@ -85,14 +106,37 @@ public:
 	// gets the table object for this guy
 	MyDB_TablePtr getTable ();
 
+	// gets the min/max summaries of the pages in this table; this is a nullptr if
+	// the table does not keep them (for example, if it is a B+-Tree)
+	MyDB_ZoneMapPtr getZoneMap ();
+
+	// the file the zone map is stored in
+	string getZoneMapFile ();
+
 private:
 
+	// makes a pass through the text file, and gives every string att with few
+	// enough distinct values a dictionary
+	void chooseDictionaries (string fName);
+
+	// called before the table is written to.  The zone map file describes the table as it
+	// was when loadFromTextFile wrote it, and is not kept up to date, so the first write
+	// after that removes it; otherwise, a later reload could skip pages using old ranges
+	void forgetZoneMapFile ();
+
+	// a page of the table is being given out; if it is written, it is no longer tracked by the
+	// zone map, and the zone map file is removed
+	void watchWrites (MyDB_PageReaderWriter &givenOut, size_t whichPage);
+
 	friend class MyDB_PageReaderWriter;
 	friend class MyDB_BPlusTreeReaderWriter;
 	MyDB_TablePtr forMe;
 	MyDB_BufferManagerPtr myBuffer;
 	shared_ptr <MyDB_PageReaderWriter> lastPage;
-	
+	MyDB_ZoneMapPtr zoneMap;
+
+	// held while addPage is adding a page
+	mutex addPageLock;
 };
 
 #endif
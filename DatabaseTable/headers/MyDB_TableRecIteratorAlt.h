@@ -17,6 +17,7 @@
 #include "MyDB_Record.h"
 #include "MyDB_TableReaderWriter.h"
 #include "MyDB_Table.h"
+#include "MyDB_ZoneMap.h"
 
 class MyDB_TableRecIteratorAlt : public MyDB_RecordIteratorAlt {
 
@@ -41,8 +42,22 @@ public:
 	~MyDB_TableRecIteratorAlt ();
 	MyDB_TableRecIteratorAlt (MyDB_TableReaderWriter &myParent, MyDB_TablePtr myTableIn, int lowPage, int highPage);
 
+	// this one does not visit pages that the filter says can be skipped
+	MyDB_TableRecIteratorAlt (MyDB_TableReaderWriter &myParent, MyDB_TablePtr myTableIn, pageFilter canMatch);
+
+	// and this one only visits the pages from lowPage through highPage inclusive that the
+	// filter (which may be null) does not say can be skipped
+	MyDB_TableRecIteratorAlt (MyDB_TableReaderWriter &myParent, MyDB_TablePtr myTableIn, int lowPage, int highPage,
+		pageFilter canMatch);
+
+	// the number of pages that were skipped so far
+	int getNumPagesSkipped ();
+
 private:
 
+	pageFilter canMatch;
+	int numPagesSkipped;
+
 	MyDB_RecordIteratorAltPtr myIter;
 	int curPage;
 	int highPage;	
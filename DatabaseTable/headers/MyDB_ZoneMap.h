@@ -0,0 +1,116 @@
+
+#ifndef ZONE_MAP_H
+#define ZONE_MAP_H
+
+#include <functional>
+#include <memory>
+#include "MyDB_Record.h"
+#include "MyDB_Schema.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for zone maps
+class MyDB_ZoneMap;
+typedef shared_ptr <MyDB_ZoneMap> MyDB_ZoneMapPtr;
+
+// a function that, given a page number, returns false only if it is certain that
+// no record on the page can satisfy some predicate
+typedef function <bool (size_t)> pageFilter;
+
+// this class stores a min/max summary of every attribute on every page of a table.
+// The summary for a page is only valid if every record on the page was written
+// through MyDB_TableReaderWriter :: append; pages that were written any other way
+// are "untracked" and can never be skipped (a page that the table gives out, through
+// operator [], last () or getPinned (), stops being tracked when it is first written)
+class MyDB_ZoneMap {
+
+public:
+
+	// creates an empty zone map for a table with the given schema
+	MyDB_ZoneMap (MyDB_SchemaPtr mySchema);
+
+	// the given page has just been emptied out by the table; start tracking it
+	void track (size_t whichPage);
+
+	// the contents of the given page are no longer known; stop tracking it
+	void forget (size_t whichPage);
+
+	// the given record was just appended to the given page; widen its ranges
+	void update (size_t whichPage, MyDB_RecordPtr fromMe);
+
+	// forget about every page
+	void clear ();
+
+	// replaces the summary of the given page with the one in another zone map over the same
+	// schema (one that was kept on the side while the page was being written)
+	void copyPage (size_t whichPage, MyDB_ZoneMap &fromMe);
+
+	// returns the number of pages that are currently tracked
+	size_t getNumTracked ();
+
+	// builds a function that tells us whether a page might have a record that is
+	// accepted by the given predicate.  The predicate is encoded exactly as in
+	// MyDB_Record :: compileComputation; only comparisons of the form att op literal
+	// (or literal op att) with op one of ==, <, > are used, combined via && and ||.
+	// Anything else is conservatively assumed to accept every page
+	pageFilter compileFilter (string predicate);
+	pageFilter compileFilter (MyDB_CompNodePtr predicate);
+
+	// writes the zone map to a text file
+	void toFile (string fName);
+
+	// the zone map may have been written to the given file by toFile (it is also set by toFile)
+	void setFile (string fName);
+
+	// the table has changed, so the file written by toFile (if any) is out of date; remove it
+	void forgetFile ();
+
+	// reads the zone map from a text file written by toFile; pages at or after
+	// lastValidPage are not read, and neither is the last page in the file, since they
+	// may have changed since the file was written.  Returns false if there was no usable file
+	bool fromFile (string fName, int lastValidPage);
+
+private:
+
+	// the summary of one page
+	struct PageSummary {
+		bool tracked;
+		size_t numRecs;
+		vector <double> lowNum;
+		vector <double> highNum;
+		vector <string> lowStr;
+		vector <string> highStr;
+	};
+
+	// the result of parsing a piece of the predicate
+	struct FilterTerm {
+		int whichAtt;
+		bool isNumLit;
+		bool isStrLit;
+		double numVal;
+		string strVal;
+		pageFilter filter;
+	};
+
+	// helpers for compileFilter
+	FilterTerm compileHelper (MyDB_CompNodePtr compileMe);
+	FilterTerm compare (FilterTerm lhs, FilterTerm rhs, char op);
+	FilterTerm acceptAll ();
+
+	// make sure that we have an entry for the given page
+	PageSummary &getPage (size_t whichPage);
+
+	// what sort of summary we keep for each att
+	enum AttKind {NumericAtt, StringAtt, NoSummary};
+	vector <AttKind> kinds;
+
+	MyDB_SchemaPtr mySchema;
+	vector <PageSummary> pages;
+
+	// where the zone map may have been written, or "" if it is known not to have been
+	string fileName;
+};
+
+#endif
@@ -25,6 +25,42 @@ MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableRea
 MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe,
         function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string pred);
 
+// the same two functions, except that the records are ordered by the value of the computation
+// sortOn over them (as in buildRecordComparator).  Each page is then sorted on normalized keys
+// (see MyDB_NormalizedKey), and the runs are merged on the kept values of sortOn, so that the
+// comparator is hardly ever called.  If replacementSelection is true, the runs are instead made
+// by streaming the records through a heap held in runSize pinned pages; the runs are then about
+// twice as long on random input, and there is just one run if the input is already sorted
+MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe,
+	string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string pred, bool replacementSelection);
+
+// the two phases of the function above, for a caller that wants to look at the runs.  The first
+// sorts sortMe into runs; the second merges them (emptying runs as it goes), fanIn runs at a
+// time, in as many passes as it takes to get down to fanIn runs, and returns an iterator that
+// merges those.  Every run that is being merged has two pages pinned, so the merge needs
+// 2 * fanIn pages to itself; buildItertorOverSortedRuns uses a fan-in of runSize / 4
+vector <vector <MyDB_PageReaderWriter>> buildSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe,
+	string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string pred, bool replacementSelection);
+MyDB_RecordIteratorAltPtr mergeSortedRuns (vector <vector <MyDB_PageReaderWriter>> &runs, int fanIn,
+	MyDB_TableReaderWriter &sortMe, string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs);
+void sort (int runSize, MyDB_TableReaderWriter &sortMe, MyDB_TableReaderWriter &sortIntoMe,
+	string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, bool replacementSelection);
+
+// the same, except that the work is spread over numThreads threads.  First, the threads take
+// runSize pages of sortMe at a time, and sort each group of pages into a run.  Then the range of
+// keys is cut into one piece per thread, at splitters sampled from the runs (the first record on
+// each page of each run), and each thread merges the records in its piece out of every run; the
+// pieces are then put into sortIntoMe, in order, a page at a time.  Each thread needs its own
+// records to compare, so the order is given by a computation over the records of sortMe (as in
+// buildRecordComparator) rather than by a comparator
+void sort (int numThreads, int runSize, MyDB_TableReaderWriter &sortMe, MyDB_TableReaderWriter &sortIntoMe,
+	string sortOn);
+
+// helper function.  Merges a list of sorted runs (each of which is a list of pages) into a
+// single sorted run, two runs at a time, using anonymous pages from parent
+vector <MyDB_PageReaderWriter> mergeRuns (MyDB_BufferManagerPtr parent, vector <vector <MyDB_PageReaderWriter>> runs,
+	function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs);
+
 // helper function.  Gets two iterators, leftIter and rightIter.  It is assumed that these are iterators over
 // sorted lists of records.  This function then merges all of those records into a list of anonymous pages,
 // and returns the list of anonymous pages to the caller.  The resulting list of anonymous pages is sorted.
@@ -32,4 +68,8 @@ MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableRea
 vector <MyDB_PageReaderWriter> mergeIntoList (MyDB_BufferManagerPtr parent, MyDB_RecordIteratorAltPtr leftIter,
         MyDB_RecordIteratorAltPtr rightIter, function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs);
 
+// helper function.  Parses a list of sort keys, each a computation and whether it is descending, into
+// the form that buildRecordComparator takes
+vector <pair <MyDB_CompNodePtr, bool>> parseSortKeys (vector <pair <string, bool>> parseUs);
+
 #endif
@@ -20,6 +20,9 @@ MyDB_BPlusTreeReaderWriter :: MyDB_BPlusTreeReaderWriter (string orderOnAttName,
 
 	// and the root location
 	rootLocation = getTable ()->getRootLocation ();
+
+	// the pages of the tree are written directly, so page summaries cannot be kept
+	zoneMap = nullptr;
 }
 
 MyDB_RecordIteratorAltPtr MyDB_BPlusTreeReaderWriter :: getSortedRangeIteratorAlt (MyDB_AttValPtr low, MyDB_AttValPtr high) {
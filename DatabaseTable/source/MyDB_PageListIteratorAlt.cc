@@ -29,10 +29,27 @@ bool MyDB_PageListIteratorAlt :: advance () {
 		return false;
 
 	curPage++;
+	if (prefetch) {
+		release (curPage - 1);
+		fetch (curPage + 1);
+	}
 	myIter = forUs[curPage].getIteratorAlt ();
 	return advance ();
 }
 
+void MyDB_PageListIteratorAlt :: fetch (int whichPage) {
+	if ((size_t) whichPage < forUs.size ())
+		pinned[whichPage] = forUs[whichPage].pin ();
+}
+
+void MyDB_PageListIteratorAlt :: release (int whichPage) {
+	if (pinned[whichPage]) {
+		forUs[whichPage].unpin ();
+		pinned[whichPage] = false;
+	}
+	forUs[whichPage] = MyDB_PageReaderWriter ();
+}
+
 void *MyDB_PageListIteratorAlt :: getCurrentPointer () {
 	return myIter->getCurrentPointer ();
 }
@@ -40,9 +57,28 @@ void *MyDB_PageListIteratorAlt :: getCurrentPointer () {
 MyDB_PageListIteratorAlt :: MyDB_PageListIteratorAlt (vector <MyDB_PageReaderWriter> &forUsIn) {
 	forUs = forUsIn;
 	curPage = 0;
+	prefetch = false;
 	myIter = forUsIn[curPage].getIteratorAlt ();		
 }
 
-MyDB_PageListIteratorAlt :: ~MyDB_PageListIteratorAlt () {}
+MyDB_PageListIteratorAlt :: MyDB_PageListIteratorAlt (vector <MyDB_PageReaderWriter> &forUsIn, bool prefetchIn) {
+	forUs = forUsIn;
+	curPage = 0;
+	prefetch = prefetchIn;
+	pinned.resize (forUs.size (), false);
+	if (prefetch) {
+		fetch (0);
+		fetch (1);
+	}
+	myIter = forUs[curPage].getIteratorAlt ();		
+}
+
+MyDB_PageListIteratorAlt :: ~MyDB_PageListIteratorAlt () {
+
+	// unpin whatever is still pinned
+	for (size_t i = curPage; i < pinned.size (); i++)
+		if (pinned[i])
+			forUs[i].unpin ();
+}
 
 #endif
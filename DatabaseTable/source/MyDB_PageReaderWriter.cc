@@ -18,6 +18,7 @@
 #include "MyDB_PageRecIterator.h"
 #include "MyDB_PageRecIteratorAlt.h"
 #include "MyDB_PageListIteratorAlt.h"
+#include "MyDB_NormalizedKey.h"
 #include "RecordComparator.h"
 
 #define PAGE_TYPE *((MyDB_PageType *) ((char *) myPage->getBytes ()))
@@ -67,7 +68,7 @@ MyDB_PageReaderWriter :: MyDB_PageReaderWriter (bool pinned, MyDB_BufferManager
 void MyDB_PageReaderWriter :: clear () {
 	NUM_BYTES_USED = 2 * sizeof (size_t);
 	PAGE_TYPE = MyDB_PageType :: RegularPage;
-	myPage->wroteBytes ();	
+	wroteBytes ();	
 }
 
 MyDB_PageType MyDB_PageReaderWriter :: getType () {
@@ -78,6 +79,18 @@ MyDB_RecordIteratorAltPtr getIteratorAlt (vector <MyDB_PageReaderWriter> &forUs)
 	return make_shared <MyDB_PageListIteratorAlt> (forUs);
 }
 
+MyDB_RecordIteratorAltPtr getPrefetchingIteratorAlt (vector <MyDB_PageReaderWriter> &forUs) {
+	return make_shared <MyDB_PageListIteratorAlt> (forUs, true);
+}
+
+bool MyDB_PageReaderWriter :: pin () {
+	return myPage->getParent ().pin (myPage->page);
+}
+
+void MyDB_PageReaderWriter :: unpin () {
+	myPage->getParent ().unpin (myPage->page);
+}
+
 MyDB_RecordIteratorPtr MyDB_PageReaderWriter :: getIterator (MyDB_RecordPtr iterateIntoMe) {
 	return make_shared <MyDB_PageRecIterator> (myPage, iterateIntoMe);
 }
@@ -88,7 +101,7 @@ MyDB_RecordIteratorAltPtr MyDB_PageReaderWriter :: getIteratorAlt () {
 
 void MyDB_PageReaderWriter :: setType (MyDB_PageType toMe) {
 	PAGE_TYPE = toMe;
-	myPage->wroteBytes ();	
+	wroteBytes ();	
 }
 
 void *MyDB_PageReaderWriter :: appendAndReturnLocation (MyDB_RecordPtr appendMe) {
@@ -109,61 +122,97 @@ bool MyDB_PageReaderWriter :: append (MyDB_RecordPtr appendMe) {
 	void *address = myPage->getBytes ();
 	appendMe->toBinary (NUM_BYTES_USED + (char *) address);
 	NUM_BYTES_USED += recSize;
-	myPage->wroteBytes ();
+	wroteBytes ();
 	return true;
 }
 
-void MyDB_PageReaderWriter :: 
-	sortInPlace (function <bool ()> comparator, MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs) {
-
-	void *temp = malloc (pageSize);
-	memcpy (temp, myPage->getBytes (), pageSize);
+// finds the records on a list of pages (the bytes of each, and how many of them are used) and puts
+// them all in order together, returning their positions; with a normalized key, the records are
+// sorted on their keys, and the comparator is only used to break ties between keys that are not exact
+static vector <void *> sortRecords (vector <pair <char *, size_t>> pages, MyDB_NormalizedKeyPtr key,
+	function <bool ()> comparator, MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs) {
 
 	// first, read in the positions of all of the records
 	vector <void *> positions;
+	vector <MyDB_KeyedPointer> keyed;
 	
-	// this basically iterates through all of the records on the page
-	int bytesConsumed = sizeof (size_t) * 2;
-	while (bytesConsumed != NUM_BYTES_USED) {
-		void *pos = bytesConsumed + (char *) temp;
-		positions.push_back (pos);
-		void *nextPos = lhs->fromBinary (pos);
-		bytesConsumed += ((char *) nextPos) - ((char *) pos);
+	// this basically iterates through all of the records on the pages
+	for (auto &page : pages) {
+		char *bytes = page.first;
+		size_t bytesConsumed = sizeof (size_t) * 2;
+		while (bytesConsumed != page.second) {
+			void *pos = bytesConsumed + bytes;
+			void *nextPos = lhs->fromBinary (pos);
+			if (key != nullptr)
+				keyed.push_back ({key->getKey (), pos});
+			else
+				positions.push_back (pos);
+			bytesConsumed += ((char *) nextPos) - ((char *) pos);
+		}
 	}
 
-	// and now we sort the vector of positions, using the record contents to build a comparator
 	RecordComparator myComparator (comparator, lhs, rhs);
-	std::stable_sort (positions.begin (), positions.end (), myComparator);
+	if (key == nullptr) {
 
-	// and write the guys back
-	NUM_BYTES_USED = 2 * sizeof (size_t);
-	myPage->wroteBytes ();	
+		// and now we sort the vector of positions, using the record contents to build a comparator
+		std::stable_sort (positions.begin (), positions.end (), myComparator);
+		return positions;
+	}
+
+	MyDB_NormalizedKey :: sort (keyed);
+	for (MyDB_KeyedPointer &k : keyed)
+		positions.push_back (k.ptr);
+
+	// records with the same key that is not exact are put in order with the comparator
+	if (!key->isExact ()) {
+		size_t start = 0;
+		for (size_t i = 1; i <= keyed.size (); i++) {
+			if (i < keyed.size () && keyed[i].key == keyed[start].key)
+				continue;
+			if (i - start > 1)
+				std::stable_sort (positions.begin () + start, positions.begin () + i, myComparator);
+			start = i;
+		}
+	}
+	return positions;
+}
+
+void MyDB_PageReaderWriter :: 
+	sortInPlace (function <bool ()> comparator, MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs) {
+	sortInPlace (nullptr, comparator, lhs, rhs);
+}
+
+void MyDB_PageReaderWriter :: 
+	sortInPlace (MyDB_NormalizedKeyPtr key, function <bool ()> comparator, MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs) {
+
+	char *temp = (char *) malloc (pageSize);
+	memcpy (temp, myPage->getBytes (), pageSize);
+	vector <void *> positions = sortRecords ({make_pair (temp, NUM_BYTES_USED)}, key, comparator, lhs, rhs);
+
+	// and write the guys back; each record starts with its size, so it is copied over as is
+	char *bytes = (char *) myPage->getBytes ();
+	size_t bytesUsed = 2 * sizeof (size_t);
 	for (void *pos : positions) {
-		lhs->fromBinary (pos);
-		append (lhs);
+		size_t recSize = *((short *) pos);
+		memcpy (bytes + bytesUsed, pos, recSize);
+		bytesUsed += recSize;
 	}
+	NUM_BYTES_USED = bytesUsed;
+	wroteBytes ();	
 
 	free (temp);
 }
 
 MyDB_PageReaderWriterPtr MyDB_PageReaderWriter :: 
 	sort (function <bool ()> comparator, MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs) {
+	return sort (nullptr, comparator, lhs, rhs);
+}
 
-	// first, read in the positions of all of the records
-	vector <void *> positions;
-	
-	// this basically iterates through all of the records on the page
-	int bytesConsumed = sizeof (size_t) * 2;
-	while (bytesConsumed != NUM_BYTES_USED) {
-		void *pos = bytesConsumed + (char *) myPage->getBytes ();
-		positions.push_back (pos);
-		void *nextPos = lhs->fromBinary (pos);
-		bytesConsumed += ((char *) nextPos) - ((char *) pos);
-	}
+MyDB_PageReaderWriterPtr MyDB_PageReaderWriter :: 
+	sort (MyDB_NormalizedKeyPtr key, function <bool ()> comparator, MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs) {
 
-	// and now we sort the vector of positions, using the record contents to build a comparator
-	RecordComparator myComparator (comparator, lhs, rhs);
-	std::stable_sort (positions.begin (), positions.end (), myComparator);
+	vector <void *> positions = sortRecords ({make_pair ((char *) myPage->getBytes (), (size_t) NUM_BYTES_USED)}, key, 
+		comparator, lhs, rhs);
 
 	// and now create the page to return
 	MyDB_PageReaderWriterPtr returnVal = make_shared <MyDB_PageReaderWriter> (myPage->getParent ());
@@ -178,6 +227,66 @@ MyDB_PageReaderWriterPtr MyDB_PageReaderWriter ::
 	return returnVal;
 }
 
+vector <MyDB_PageReaderWriter> sortAcrossPages (vector <MyDB_PageReaderWriter> &sortUs, MyDB_BufferManager &parent,
+	MyDB_NormalizedKeyPtr key, function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs) {
+
+	// the pages are pinned, so their bytes stay where they are while the sort works on them
+	vector <pair <char *, size_t>> pages;
+	for (auto &page : sortUs) {
+		pages.push_back (make_pair ((char *) page.myPage->getBytes (), 
+			*((size_t *) (((char *) page.myPage->getBytes ()) + sizeof (size_t)))));
+	}
+	vector <void *> positions = sortRecords (pages, key, comparator, lhs, rhs);
+
+	// each record is copied over as is, straight from where it is to where it goes
+	vector <MyDB_PageReaderWriter> returnVal;
+	returnVal.push_back (MyDB_PageReaderWriter (parent));
+	for (void *pos : positions) {
+		if (!returnVal.back ().appendBytes (pos)) {
+			returnVal.push_back (MyDB_PageReaderWriter (parent));
+			returnVal.back ().appendBytes (pos);
+		}
+	}
+	return returnVal;
+}
+
+bool MyDB_PageReaderWriter :: appendBytes (void *rec) {
+
+	size_t recSize = *((short *) rec);
+	if (recSize > NUM_BYTES_LEFT)
+		return false;
+
+	memcpy (((char *) myPage->getBytes ()) + NUM_BYTES_USED, rec, recSize);
+	NUM_BYTES_USED += recSize;
+	wroteBytes ();
+	return true;
+}
+
+void MyDB_PageReaderWriter :: copyFrom (MyDB_PageReaderWriter &fromMe) {
+
+	// when there are several threads, only the last page that a thread looked at is sure to
+	// stay in the buffer, so the bytes go through memory of our own
+	void *temp = malloc (pageSize);
+	memcpy (temp, fromMe.getBytes (), pageSize);
+	memcpy (myPage->getBytes (), temp, pageSize);
+	wroteBytes ();
+	free (temp);
+}
+
+void MyDB_PageReaderWriter :: wroteBytes () {
+	myPage->wroteBytes ();
+	if (zoneMap != nullptr) {
+		zoneMap->forget (whichPage);
+		zoneMap->forgetFile ();
+		zoneMap = nullptr;
+	}
+}
+
+void MyDB_PageReaderWriter :: watchWrites (MyDB_ZoneMapPtr zoneMapIn, size_t whichPageIn) {
+	zoneMap = zoneMapIn;
+	whichPage = whichPageIn;
+}
+
 size_t MyDB_PageReaderWriter :: getPageSize () {
 	return pageSize;
 }
@@ -25,7 +25,11 @@ void MyDB_PageRecIteratorAlt :: getCurrent (MyDB_RecordPtr intoMe) {
 }
 
 void *MyDB_PageRecIteratorAlt :: getCurrentPointer () {
-	return bytesConsumed + (char *) myPage->getBytes ();
+
+	// every record starts with its size, so we can get ready to advance without loading it
+	char *pos = bytesConsumed + (char *) myPage->getBytes ();
+	nextRecSize = *((short *) pos);
+	return pos;
 }
 
 bool MyDB_PageRecIteratorAlt :: advance () {
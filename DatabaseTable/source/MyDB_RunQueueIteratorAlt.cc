@@ -11,46 +11,159 @@
 #ifndef RUN_QITER_ALT_C
 #define RUN_QITER_ALT_C
 
-#include "IteratorComparator.h"
 #include "MyDB_PageListIteratorAlt.h"
 #include "MyDB_PageRecIteratorAlt.h"
 #include "MyDB_RunQueueIteratorAlt.h"
 
 using namespace std;
 
-void MyDB_RunQueueIteratorAlt :: getCurrent (MyDB_RecordPtr intoMe) {
-	auto myIter = pq.top ();
-	myIter->getCurrent (intoMe);
+MyDB_RunQueueIteratorAlt :: MyDB_RunQueueIteratorAlt (function <bool ()> comparatorIn, MyDB_RecordPtr lhsIn, MyDB_RecordPtr rhsIn) {
+	comparator = comparatorIn;
+	lhs = lhsIn;
+	rhs = rhsIn;
+	inLHS = inRHS = -1;
+	keyType = 0;
+	winner = -1;
+	firstTime = true;
 }
 
-MyDB_RunQueueIteratorAlt :: MyDB_RunQueueIteratorAlt (function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs) : 
-	pq (IteratorComparator (comparator, lhs, rhs)) {
+MyDB_RunQueueIteratorAlt :: MyDB_RunQueueIteratorAlt (MyDB_SchemaPtr schemaIn, string sortOnIn) {
+	schema = schemaIn;
+	sortOn = sortOnIn;
+	inLHS = inRHS = -1;
+	winner = -1;
 	firstTime = true;
+
+	// values that are not ints, doubles, or strings are compared with a comparator
+	MyDB_Record temp (schema);
+	MyDB_AttTypePtr type = temp.compileTypedValueComputation (sortOn).second;
+	if (type->promotableToInt ()) {
+		keyType = 'i';
+	} else if (type->promotableToDouble ()) {
+		keyType = 'd';
+	} else if (type->promotableToString () && !type->isBool ()) {
+		keyType = 's';
+	} else {
+		keyType = 0;
+		lhs = make_shared <MyDB_Record> (schema);
+		rhs = make_shared <MyDB_Record> (schema);
+		comparator = buildRecordComparator (lhs, rhs, sortOn);
+	}
+}
+
+void MyDB_RunQueueIteratorAlt :: addRun (MyDB_RecordIteratorAltPtr addMe) {
+	runs.push_back (addMe);
+	done.push_back (false);
+	if (keyType != 0) {
+		runRecs.push_back (make_shared <MyDB_Record> (schema));
+		keyFuncs.push_back (runRecs.back ()->compileValueComputation (sortOn));
+		keys.push_back (MyDB_Value ());
+	}
+}
+
+int MyDB_RunQueueIteratorAlt :: getNumRuns () {
+	return (int) runs.size ();
 }
-	
+
+void MyDB_RunQueueIteratorAlt :: loadRun (int whichRun) {
+	if (keyType != 0) {
+		runs[whichRun]->getCurrent (runRecs[whichRun]);
+		keys[whichRun] = keyFuncs[whichRun] ();
+	}
+	if (inLHS == whichRun)
+		inLHS = -1;
+	if (inRHS == whichRun)
+		inRHS = -1;
+}
+
+bool MyDB_RunQueueIteratorAlt :: beats (int a, int b) {
+
+	if (done[a])
+		return false;
+	if (done[b])
+		return true;
+
+	// a wins a tie, so a beats b unless b < a
+	if (keyType == 'i')
+		return !(keys[b].toInt () < keys[a].toInt ());
+	if (keyType == 'd')
+		return !(keys[b].toDouble () < keys[a].toDouble ());
+	if (keyType == 's') {
+		MyDB_Value &left = keys[b];
+		MyDB_Value &right = keys[a];
+		if (left.dict != nullptr && left.dict == right.dict && left.dict->isOrdered ())
+			return !(left.code < right.code);
+		return !(left.stringVal.compare (right.stringVal) < 0);
+	}
+
+	if (inLHS != b) {
+		runs[b]->getCurrent (lhs);
+		inLHS = b;
+	}
+	if (inRHS != a) {
+		runs[a]->getCurrent (rhs);
+		inRHS = a;
+	}
+	return !comparator ();
+}
+
 bool MyDB_RunQueueIteratorAlt :: advance () {
 
+	int numRuns = (int) runs.size ();
+	if (numRuns == 0)
+		return false;
+
+	// lhs and rhs belong to the caller too, who may have loaded other records into them
+	inLHS = inRHS = -1;
+
 	if (firstTime) {
+
+		// play the whole tournament, from the bottom up; node i gets the winner of the
+		// games below it, and remembers the loser of the game at i
 		firstTime = false;
-		return true;
+		for (int i = 0; i < numRuns; i++)
+			loadRun (i);
+		losers.resize (numRuns);
+		vector <int> winners (2 * numRuns);
+		for (int i = 0; i < numRuns; i++)
+			winners[numRuns + i] = i;
+		for (int i = numRuns - 1; i >= 1; i--) {
+			int left = winners[2 * i], right = winners[2 * i + 1];
+			if (beats (left, right)) {
+				winners[i] = left;
+				losers[i] = right;
+			} else {
+				winners[i] = right;
+				losers[i] = left;
+			}
+		}
+		winner = (numRuns == 1) ? 0 : winners[1];
+		return !done[winner];
 	}
 
-	if (pq.size () == 0)
+	if (done[winner])
 		return false;
 
-	// remove from the q
-	auto myIter = pq.top ();
-	pq.pop ();
-	
-	// re-insert
-	if (myIter->advance ()) 
-		pq.push (myIter);
+	// move the winner along, and replay its games on the way up to the root
+	if (runs[winner]->advance ())
+		loadRun (winner);
+	else
+		done[winner] = true;
+
+	for (int node = (winner + numRuns) / 2; node >= 1; node /= 2) {
+		if (beats (losers[node], winner))
+			swap (losers[node], winner);
+	}
+
+	return !done[winner];
+}
 
-	return (pq.size () != 0);
+void MyDB_RunQueueIteratorAlt :: getCurrent (MyDB_RecordPtr intoMe) {
+	runs[winner]->getCurrent (intoMe);
 }
 
 void *MyDB_RunQueueIteratorAlt :: getCurrentPointer () {
-	return pq.top ()->getCurrentPointer ();
+	return runs[winner]->getCurrentPointer ();
 }
 
 MyDB_RunQueueIteratorAlt :: ~MyDB_RunQueueIteratorAlt () {}
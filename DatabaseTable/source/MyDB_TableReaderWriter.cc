@@ -29,13 +29,23 @@ using namespace std;
 MyDB_TableReaderWriter :: MyDB_TableReaderWriter (MyDB_TablePtr forMeIn, MyDB_BufferManagerPtr myBufferIn) {
 	forMe = forMeIn;
 	myBuffer = myBufferIn;
+	zoneMap = make_shared <MyDB_ZoneMap> (forMe->getSchema ());
+
+	// there may be a zone map file from before
+	zoneMap->setFile (getZoneMapFile ());
 
 	if (forMe->lastPage () == -1) {
+		forgetZoneMapFile ();
 		forMe->setLastPage (0);
 		lastPage = make_shared <MyDB_PageReaderWriter> (*this, forMe->lastPage ());
 		lastPage->clear ();
+		zoneMap->track (0);
 	} else {
 		lastPage = make_shared <MyDB_PageReaderWriter> (*this, forMe->lastPage ());	
+
+		// the last page may have been appended to since the zone map was written, so don't trust it
+		// (fromFile also ignores the page that was last when the file was written)
+		zoneMap->fromFile (getZoneMapFile (), forMe->lastPage ());
 	}
 }
 
@@ -47,25 +57,46 @@ MyDB_TablePtr MyDB_TableReaderWriter :: getTable () {
 	return forMe;
 }
 
+MyDB_ZoneMapPtr MyDB_TableReaderWriter :: getZoneMap () {
+	return zoneMap;
+}
+
+string MyDB_TableReaderWriter :: getZoneMapFile () {
+	return forMe->getStorageLoc () + ".zonemap";
+}
+
+void MyDB_TableReaderWriter :: forgetZoneMapFile () {
+	if (zoneMap != nullptr)
+		zoneMap->forgetFile ();
+}
+
 int MyDB_TableReaderWriter :: getNumPages () {
 	return forMe->lastPage () + 1;
 }
 
 MyDB_PageReaderWriter MyDB_TableReaderWriter :: getPinned (size_t i) {
-	return MyDB_PageReaderWriter (true, *this, i);
+	MyDB_PageReaderWriter pinnedBuffer (true, *this, i);
+	watchWrites (pinnedBuffer, i);
+	return pinnedBuffer;
 }
 
 MyDB_PageReaderWriter MyDB_TableReaderWriter :: operator [] (size_t i) {
 	
 	// see if we are going off of the end of the file... if so, then clear those pages
 	while (i > forMe->lastPage ()) {
+		forgetZoneMapFile ();
 		forMe->setLastPage (forMe->lastPage () + 1);
 		lastPage = make_shared <MyDB_PageReaderWriter> (*this, forMe->lastPage ());
 		lastPage->clear ();	
+
+		// whoever asked for this page is going to write it directly
+		if (zoneMap != nullptr)
+			zoneMap->forget (forMe->lastPage ());
 	}
 
 	// now get the page
 	MyDB_PageReaderWriter arrayAccessBuffer (*this, i);
+	watchWrites (arrayAccessBuffer, i);
 	return arrayAccessBuffer;
 }
 
@@ -77,11 +108,34 @@ MyDB_RecordPtr MyDB_TableReaderWriter :: getEmptyRecord () {
 
 MyDB_PageReaderWriter MyDB_TableReaderWriter :: last () {
 	MyDB_PageReaderWriter arrayAccessBuffer (*this, forMe->lastPage ());
+	watchWrites (arrayAccessBuffer, forMe->lastPage ());
 	return arrayAccessBuffer;
 }
 
+void MyDB_TableReaderWriter :: watchWrites (MyDB_PageReaderWriter &givenOut, size_t whichPage) {
+
+	// the internal last page is written through append, which keeps its zone up to date
+	if (zoneMap != nullptr)
+		givenOut.watchWrites (zoneMap, whichPage);
+}
+
+MyDB_PageReaderWriter MyDB_TableReaderWriter :: addPage (size_t &whichPage) {
+
+	lock_guard <mutex> guard (addPageLock);
+	forgetZoneMapFile ();
+	forMe->setLastPage (forMe->lastPage () + 1);
+	whichPage = forMe->lastPage ();
+	lastPage = make_shared <MyDB_PageReaderWriter> (*this, whichPage);
+	lastPage->clear ();
+	if (zoneMap != nullptr)
+		zoneMap->forget (whichPage);
+	return *lastPage;
+}
+
 void MyDB_TableReaderWriter :: append (MyDB_RecordPtr appendMe) {
 
+	forgetZoneMapFile ();
+
 	// try to append the record on the current page...
 	if (!lastPage->append (appendMe)) {
 
@@ -89,16 +143,79 @@ void MyDB_TableReaderWriter :: append (MyDB_RecordPtr appendMe) {
 		forMe->setLastPage (forMe->lastPage () + 1);
 		lastPage = make_shared <MyDB_PageReaderWriter> (*this, forMe->lastPage ());
 		lastPage->clear ();
+		if (zoneMap != nullptr)
+			zoneMap->track (forMe->lastPage ());
 		lastPage->append (appendMe);
 	}
+
+	// and remember the new record in the page summary
+	if (zoneMap != nullptr)
+		zoneMap->update (forMe->lastPage (), appendMe);
+}
+
+void MyDB_TableReaderWriter :: chooseDictionaries (string fName) {
+
+	vector <pair <string, MyDB_AttTypePtr>> &atts = forMe->getSchema ()->getAtts ();
+
+	// every string att is a candidate for a dictionary until it has too many distinct values
+	vector <bool> candidate;
+	vector <set <string>> distinct (atts.size ());
+	for (auto &a : atts) {
+		candidate.push_back (a.second->promotableToString () && !a.second->promotableToDouble () && !a.second->isBool ());
+	}
+
+	string line;
+	ifstream myfile (fName);
+	if (myfile.is_open()) {
+		while (getline (myfile, line)) {
+
+			// this cuts the line up exactly like MyDB_Record :: fromString
+			int i = 0;
+			for (int pos = 0; pos < (int) line.size () && i < (int) atts.size (); pos = (int) line.find ("|", pos + 1) + 1, i++) {
+				if (!candidate[i])
+					continue;
+
+				distinct[i].insert (line.substr (pos, line.find ("|", pos + 1) - pos));
+
+				#define MAX_DICT_SIZE 4096
+				if (distinct[i].size () > MAX_DICT_SIZE) {
+					candidate[i] = false;
+					distinct[i].clear ();
+				}
+			}
+		}
+		myfile.close ();
+	}
+
+	// and now switch the types of the atts
+	int numEncoded = 0;
+	for (int i = 0; i < (int) atts.size (); i++) {
+		if (candidate[i] && distinct[i].size () > 0) {
+			vector <string> values (distinct[i].begin (), distinct[i].end ());
+			atts[i].second = make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (values));
+			numEncoded++;
+		} else if (dynamic_pointer_cast <MyDB_DictAttType> (atts[i].second) != nullptr) {
+			atts[i].second = make_shared <MyDB_StringAttType> ();
+		}
+	}
+	cout << "Dictionary encoded " << numEncoded << " attributes.\n";
 }
 
 pair <vector <size_t>, size_t>  MyDB_TableReaderWriter :: loadFromTextFile (string fName) {
 
+	// pick the atts to dictionary encode; this has to happen before any record is created
+	if (forMe->hasOption ("dictionary"))
+		chooseDictionaries (fName);
+
 	// empty out the database file
+	forgetZoneMapFile ();
 	forMe->setLastPage (0);
 	lastPage = make_shared <MyDB_PageReaderWriter> (*this, forMe->lastPage ());
 	lastPage->clear ();
+	if (zoneMap != nullptr) {
+		zoneMap->clear ();
+		zoneMap->track (0);
+	}
 
 	// try to open the file
 	string line;
@@ -152,6 +269,10 @@ pair <vector <size_t>, size_t>  MyDB_TableReaderWriter :: loadFromTextFile (stri
 	}
 	cout << "Loaded " << counter << " records.\n";
 
+	// save the page summaries so that later scans can use them
+	if (zoneMap != nullptr)
+		zoneMap->toFile (getZoneMapFile ());
+
 	// finally, compute the vector of estimates
 	vector <size_t> returnVal;
 	for (auto &a : allHashes) {
@@ -173,6 +294,16 @@ MyDB_RecordIteratorAltPtr MyDB_TableReaderWriter :: getIteratorAlt (int lowPage,
 	return make_shared <MyDB_TableRecIteratorAlt> (*this, forMe, lowPage, highPage);
 }
 
+MyDB_TableRecIteratorAltPtr MyDB_TableReaderWriter :: getFilteredIteratorAlt (string selectionPredicate) {
+	return getFilteredIteratorAlt (MyDB_CompNode :: parse (selectionPredicate));
+}
+
+MyDB_TableRecIteratorAltPtr MyDB_TableReaderWriter :: getFilteredIteratorAlt (MyDB_CompNodePtr selectionPredicate) {
+	if (zoneMap == nullptr)
+		return make_shared <MyDB_TableRecIteratorAlt> (*this, forMe);
+	return make_shared <MyDB_TableRecIteratorAlt> (*this, forMe, zoneMap->compileFilter (selectionPredicate));
+}
+
 void MyDB_TableReaderWriter :: writeIntoTextFile (string fName) {
 	
 	// open up the output file
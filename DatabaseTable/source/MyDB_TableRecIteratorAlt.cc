@@ -29,10 +29,17 @@ bool MyDB_TableRecIteratorAlt :: advance () {
 	if (myParent[curPage].getType () == MyDB_PageType :: RegularPage && myIter->advance ())
 		return true;
 
-	if (curPage == myTable->lastPage () || curPage == highPage)
-		return false;
+	// find the next page that can have a record that we are interested in
+	while (true) {
+		if (curPage == myTable->lastPage () || curPage == highPage)
+			return false;
+
+		curPage++;
+		if (canMatch == nullptr || canMatch (curPage))
+			break;
+		numPagesSkipped++;
+	}
 
-	curPage++;
 	myIter = myParent[curPage].getIteratorAlt ();
 	return advance ();
 }
@@ -43,6 +50,8 @@ MyDB_TableRecIteratorAlt :: MyDB_TableRecIteratorAlt (MyDB_TableReaderWriter &my
 	myTable = myTableIn;
 	curPage = lowPage;
 	highPage = highPageIn;
+	canMatch = nullptr;
+	numPagesSkipped = 0;
 	myIter = myParent[curPage].getIteratorAlt ();		
 }
 
@@ -51,9 +60,36 @@ MyDB_TableRecIteratorAlt :: MyDB_TableRecIteratorAlt (MyDB_TableReaderWriter &my
 	myTable = myTableIn;
 	curPage = 0;
 	highPage = 1999999999;
+	canMatch = nullptr;
+	numPagesSkipped = 0;
+	myIter = myParent[curPage].getIteratorAlt ();		
+}
+
+MyDB_TableRecIteratorAlt :: MyDB_TableRecIteratorAlt (MyDB_TableReaderWriter &myParent, MyDB_TablePtr myTableIn,
+	pageFilter canMatchIn) :
+	MyDB_TableRecIteratorAlt (myParent, myTableIn, 0, 1999999999, canMatchIn) {}
+
+MyDB_TableRecIteratorAlt :: MyDB_TableRecIteratorAlt (MyDB_TableReaderWriter &myParent, MyDB_TablePtr myTableIn,
+	int lowPage, int highPageIn, pageFilter canMatchIn) :
+	myParent (myParent) {
+	myTable = myTableIn;
+	curPage = lowPage;
+	highPage = highPageIn;
+	canMatch = canMatchIn;
+	numPagesSkipped = 0;
+
+	// skip the leading pages; we always need some page to iterate over, so the last one is never skipped here
+	while (canMatch != nullptr && curPage < myTable->lastPage () && curPage < highPage && !canMatch (curPage)) {
+		curPage++;
+		numPagesSkipped++;
+	}
 	myIter = myParent[curPage].getIteratorAlt ();		
 }
 
+int MyDB_TableRecIteratorAlt :: getNumPagesSkipped () {
+	return numPagesSkipped;
+}
+
 MyDB_TableRecIteratorAlt :: ~MyDB_TableRecIteratorAlt () {}
 
 #endif
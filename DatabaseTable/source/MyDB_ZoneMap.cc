@@ -0,0 +1,360 @@
+
+#ifndef ZONE_MAP_C
+#define ZONE_MAP_C
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "MyDB_LikePattern.h"
+#include "MyDB_ZoneMap.h"
+#include <sstream>
+#include <string.h>
+#include <unistd.h>
+
+using namespace std;
+
+MyDB_ZoneMap :: MyDB_ZoneMap (MyDB_SchemaPtr mySchemaIn) {
+
+	mySchema = mySchemaIn;
+
+	// ints and doubles are summarized as doubles, strings as strings; bools are not worth it
+	for (auto &a : mySchema->getAtts ()) {
+		if (a.second->promotableToDouble ()) {
+			kinds.push_back (NumericAtt);
+		} else if (!a.second->isBool () && a.second->promotableToString ()) {
+			kinds.push_back (StringAtt);
+		} else {
+			kinds.push_back (NoSummary);
+		}
+	}
+}
+
+MyDB_ZoneMap :: PageSummary &MyDB_ZoneMap :: getPage (size_t whichPage) {
+	while (pages.size () <= whichPage) {
+		PageSummary temp;
+		temp.tracked = false;
+		temp.numRecs = 0;
+		pages.push_back (temp);
+	}
+	return pages[whichPage];
+}
+
+void MyDB_ZoneMap :: track (size_t whichPage) {
+	PageSummary &page = getPage (whichPage);
+	page.tracked = true;
+	page.numRecs = 0;
+	page.lowNum.resize (kinds.size ());
+	page.highNum.resize (kinds.size ());
+	page.lowStr.resize (kinds.size ());
+	page.highStr.resize (kinds.size ());
+}
+
+void MyDB_ZoneMap :: forget (size_t whichPage) {
+	getPage (whichPage).tracked = false;
+}
+
+void MyDB_ZoneMap :: clear () {
+	pages.clear ();
+}
+
+void MyDB_ZoneMap :: copyPage (size_t whichPage, MyDB_ZoneMap &fromMe) {
+	getPage (whichPage) = fromMe.getPage (whichPage);
+}
+
+size_t MyDB_ZoneMap :: getNumTracked () {
+	size_t count = 0;
+	for (auto &p : pages) {
+		if (p.tracked)
+			count++;
+	}
+	return count;
+}
+
+void MyDB_ZoneMap :: update (size_t whichPage, MyDB_RecordPtr fromMe) {
+
+	PageSummary &page = getPage (whichPage);
+	if (!page.tracked)
+		return;
+
+	// the first record on the page defines the ranges
+	bool first = (page.numRecs == 0);
+	page.numRecs++;
+	for (size_t i = 0; i < kinds.size (); i++) {
+		if (kinds[i] == NumericAtt) {
+			double val = fromMe->getAtt (i)->toDouble ();
+			if (first || val < page.lowNum[i])
+				page.lowNum[i] = val;
+			if (first || val > page.highNum[i])
+				page.highNum[i] = val;
+		} else if (kinds[i] == StringAtt) {
+			string val = fromMe->getAtt (i)->toString ();
+			if (first || val < page.lowStr[i])
+				page.lowStr[i] = val;
+			if (first || val > page.highStr[i])
+				page.highStr[i] = val;
+		}
+	}
+}
+
+void MyDB_ZoneMap :: setFile (string fName) {
+	fileName = fName;
+}
+
+void MyDB_ZoneMap :: forgetFile () {
+	if (fileName != "") {
+		unlink (fileName.c_str ());
+		fileName = "";
+	}
+}
+
+void MyDB_ZoneMap :: toFile (string fName) {
+
+	fileName = fName;
+
+	ofstream output (fName);
+	output << setprecision (17);
+	output << pages.size () << "|" << kinds.size () << "|\n";
+	for (auto &p : pages) {
+
+		// strings are written raw, so we cannot write a page that has a separator in a string
+		bool ok = p.tracked;
+		for (size_t i = 0; ok && i < kinds.size (); i++) {
+			if (kinds[i] == StringAtt && p.numRecs > 0 &&
+				(p.lowStr[i].find_first_of ("|\n") != string :: npos || p.highStr[i].find_first_of ("|\n") != string :: npos))
+				ok = false;
+		}
+
+		if (!ok) {
+			output << "0|0|\n";
+			continue;
+		}
+
+		output << "1|" << p.numRecs << "|";
+		for (size_t i = 0; i < kinds.size (); i++) {
+			if (kinds[i] == NumericAtt && p.numRecs > 0) {
+				output << p.lowNum[i] << "|" << p.highNum[i] << "|";
+			} else if (kinds[i] == StringAtt && p.numRecs > 0) {
+				output << p.lowStr[i] << "|" << p.highStr[i] << "|";
+			} else {
+				output << "||";
+			}
+		}
+		output << "\n";
+	}
+	output.close ();
+}
+
+bool MyDB_ZoneMap :: fromFile (string fName, int lastValidPage) {
+
+	clear ();
+	ifstream input (fName);
+	if (!input.is_open ())
+		return false;
+
+	// make sure that the file is for this schema
+	string line;
+	size_t numPages, numAtts;
+	if (!getline (input, line) || sscanf (line.c_str (), "%zu|%zu|", &numPages, &numAtts) != 2 || numAtts != kinds.size ())
+		return false;
+
+	// the page that was last when the file was written could have been appended to since
+	for (size_t whichPage = 0; whichPage + 1 < numPages && (int) whichPage < lastValidPage; whichPage++) {
+
+		if (!getline (input, line)) {
+			clear ();
+			return false;
+		}
+
+		// break up the line
+		vector <string> fields;
+		size_t start = 0, end;
+		while ((end = line.find ('|', start)) != string :: npos) {
+			fields.push_back (line.substr (start, end - start));
+			start = end + 1;
+		}
+
+		if (fields.size () < 2 || fields[0] != "1") {
+			forget (whichPage);
+			continue;
+		}
+
+		if (fields.size () != 2 + 2 * kinds.size ()) {
+			clear ();
+			return false;
+		}
+
+		track (whichPage);
+		PageSummary &page = pages[whichPage];
+		page.numRecs = stoul (fields[1]);
+		if (page.numRecs == 0)
+			continue;
+
+		for (size_t i = 0; i < kinds.size (); i++) {
+			if (kinds[i] == NumericAtt) {
+				page.lowNum[i] = stod (fields[2 + 2 * i]);
+				page.highNum[i] = stod (fields[3 + 2 * i]);
+			} else if (kinds[i] == StringAtt) {
+				page.lowStr[i] = fields[2 + 2 * i];
+				page.highStr[i] = fields[3 + 2 * i];
+			}
+		}
+	}
+
+	return true;
+}
+
+pageFilter MyDB_ZoneMap :: compileFilter (string predicate) {
+	return compileFilter (MyDB_CompNode :: parse (predicate));
+}
+
+pageFilter MyDB_ZoneMap :: compileFilter (MyDB_CompNodePtr predicate) {
+	FilterTerm res = compileHelper (predicate);
+	if (res.filter == nullptr)
+		return [] (size_t) {return true;};
+	return res.filter;
+}
+
+MyDB_ZoneMap :: FilterTerm MyDB_ZoneMap :: acceptAll () {
+	FilterTerm res;
+	res.whichAtt = -1;
+	res.isNumLit = false;
+	res.isStrLit = false;
+	res.filter = [] (size_t) {return true;};
+	return res;
+}
+
+MyDB_ZoneMap :: FilterTerm MyDB_ZoneMap :: compare (FilterTerm lhs, FilterTerm rhs, char op) {
+
+	// put the attribute on the left
+	if (lhs.whichAtt == -1) {
+		swap (lhs, rhs);
+		if (op == '<')
+			op = '>';
+		else if (op == '>')
+			op = '<';
+	}
+
+	// we can only do att op literal, where the types will be compared the same way that
+	// the record would compare them
+	if (lhs.whichAtt == -1 || rhs.whichAtt != -1)
+		return acceptAll ();
+
+	int whichAtt = lhs.whichAtt;
+	FilterTerm res = acceptAll ();
+	if (kinds[whichAtt] == NumericAtt && rhs.isNumLit) {
+		double val = rhs.numVal;
+		res.filter = [this, whichAtt, val, op] (size_t whichPage) {
+			if (whichPage >= pages.size () || !pages[whichPage].tracked)
+				return true;
+			PageSummary &page = pages[whichPage];
+			if (page.numRecs == 0)
+				return false;
+			if (op == '=')
+				return page.lowNum[whichAtt] <= val && val <= page.highNum[whichAtt];
+			else if (op == '<')
+				return page.lowNum[whichAtt] < val;
+			else
+				return page.highNum[whichAtt] > val;
+		};
+	} else if (kinds[whichAtt] == StringAtt && rhs.isStrLit) {
+		string val = rhs.strVal;
+		res.filter = [this, whichAtt, val, op] (size_t whichPage) {
+			if (whichPage >= pages.size () || !pages[whichPage].tracked)
+				return true;
+			PageSummary &page = pages[whichPage];
+			if (page.numRecs == 0)
+				return false;
+			if (op == '=')
+				return page.lowStr[whichAtt] <= val && val <= page.highStr[whichAtt];
+			else if (op == '<')
+				return page.lowStr[whichAtt] < val;
+			else
+				return page.highStr[whichAtt] > val;
+		};
+	}
+
+	return res;
+}
+
+MyDB_ZoneMap :: FilterTerm MyDB_ZoneMap :: compileHelper (MyDB_CompNodePtr compileMe) {
+
+	if (compileMe->isAtt ()) {
+		FilterTerm res = acceptAll ();
+		int i = 0;
+		for (auto &a : mySchema->getAtts ()) {
+			if (a.first == compileMe->attName) {
+				res.whichAtt = i;
+				break;
+			}
+			i++;
+		}
+		return res;
+	}
+
+	if (compileMe->isConstant ()) {
+		FilterTerm res = acceptAll ();
+		MyDB_Value &val = compileMe->constVal;
+		if (val.tag == IntValue || val.tag == DoubleValue) {
+			res.isNumLit = true;
+			res.numVal = val.toDouble ();
+		} else if (val.tag == StringValue) {
+			res.isStrLit = true;
+			res.strVal = *compileMe->constStr;
+		}
+		return res;
+	}
+
+	// a page can only have a value in the list if it can have one of the values
+	if (compileMe->op == "in")
+		return compileHelper (compileMe->expandInList ());
+
+	// a like whose pattern fixes how the string starts is a range check on the strings
+	if (compileMe->op == "like") {
+		FilterTerm lres = compileHelper (compileMe->inputs[0]);
+		FilterTerm rres = compileHelper (compileMe->inputs[1]);
+		if (lres.whichAtt == -1 || kinds[lres.whichAtt] != StringAtt || !rres.isStrLit)
+			return acceptAll ();
+		MyDB_LikePattern pattern (rres.strVal, nullptr);
+		if (pattern.getKind () == LikeExact) {
+			rres.strVal = pattern.getLiteral ();
+			return compare (lres, rres, '=');
+		}
+		if (pattern.getKind () != LikePrefix)
+			return acceptAll ();
+		int whichAtt = lres.whichAtt;
+		string val = pattern.getLiteral ();
+		FilterTerm res = acceptAll ();
+		res.filter = [this, whichAtt, val] (size_t whichPage) {
+			if (whichPage >= pages.size () || !pages[whichPage].tracked)
+				return true;
+			PageSummary &page = pages[whichPage];
+			if (page.numRecs == 0)
+				return false;
+			return page.lowStr[whichAtt].compare (0, val.size (), val) <= 0 && page.highStr[whichAtt] >= val;
+		};
+		return res;
+	}
+
+	// we cannot say anything about a not, or about anything that is not a predicate
+	string &op = compileMe->op;
+	if (op != "&&" && op != "||" && op != "==" && op != "<" && op != ">")
+		return acceptAll ();
+
+	FilterTerm lres = compileHelper (compileMe->inputs[0]);
+	FilterTerm rres = compileHelper (compileMe->inputs[1]);
+	if (op == "&&") {
+		FilterTerm res = acceptAll ();
+		pageFilter lhs = lres.filter, rhs = rres.filter;
+		res.filter = [lhs, rhs] (size_t whichPage) {return lhs (whichPage) && rhs (whichPage);};
+		return res;
+	} else if (op == "||") {
+		FilterTerm res = acceptAll ();
+		pageFilter lhs = lres.filter, rhs = rres.filter;
+		res.filter = [lhs, rhs] (size_t whichPage) {return lhs (whichPage) || rhs (whichPage);};
+		return res;
+	} else {
+		return compare (lres, rres, op[0]);
+	}
+}
+
+#endif
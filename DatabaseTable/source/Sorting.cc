@@ -2,7 +2,11 @@
 #ifndef SORT_C
 #define SORT_C
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <queue>
+#include "MyDB_NormalizedKey.h"
 #include "MyDB_PageReaderWriter.h"
 #include "MyDB_TableRecIterator.h"
 #include "MyDB_TableRecIteratorAlt.h"
@@ -99,126 +103,445 @@ vector <MyDB_PageReaderWriter> mergeIntoList (MyDB_BufferManagerPtr parent, MyDB
 	return returnVal;
 }
 	
-MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe, 
+vector <MyDB_PageReaderWriter> mergeRuns (MyDB_BufferManagerPtr parent, vector <vector <MyDB_PageReaderWriter>> pagesToSort,
 	function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs) {
 
-	return buildItertorOverSortedRuns (runSize, sortMe, comparator, lhs, rhs, "bool[true]");
+	// while we don't have a single sorted list
+	while (pagesToSort.size () > 1) {
+		
+		// the new version of the pages to sort vector
+		vector <vector<MyDB_PageReaderWriter>> newPagesToSort;
+
+		// repeatedly merge the last two pages
+		while (pagesToSort.size () > 0) {
+
+			// if there is one run, then just add it
+			if (pagesToSort.size () == 1) {
+				newPagesToSort.push_back (pagesToSort.back ());
+				pagesToSort.pop_back ();
+				continue;
+			}
+
+			// get the next two runs
+			vector<MyDB_PageReaderWriter> runOne = pagesToSort.back ();
+			pagesToSort.pop_back ();
+			vector<MyDB_PageReaderWriter> runTwo = pagesToSort.back ();
+			pagesToSort.pop_back ();
+	
+			// merge them
+			newPagesToSort.push_back (mergeIntoList (parent, getIteratorAlt (runOne), 
+				getIteratorAlt (runTwo), comparator, lhs, rhs));
+		}
+
+		pagesToSort = newPagesToSort;
+	}
+
+	return pagesToSort[0];
 }
 
-MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe, 
-	function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string lhsPred) {
+// makes sorted runs by replacement selection.  The records are kept in a heap, whose records
+// are held in numPages pinned pages; once those are full, the smallest record is written out
+// each time a new one comes in, and the new one goes into the current run if it is not smaller
+// than the one just written, and into the next run if it is.  On random input, the runs average
+// about twice the memory, and on input that is (nearly) sorted, there is only one run.  Records
+// are never moved in the pinned pages, so the space of the ones that were written out is
+// reclaimed by copying the rest down, a page at a time, once enough of it has built up
+class ReplacementSelection {
+
+public:
+
+	// the records are compared with their normalized keys (if key is not null, in which case
+	// it must be built over lhs), and otherwise with the comparator
+	ReplacementSelection (MyDB_BufferManagerPtr parentIn, int numPages, MyDB_NormalizedKeyPtr keyIn,
+		function <bool ()> comparatorIn, MyDB_RecordPtr lhsIn, MyDB_RecordPtr rhsIn) {
+
+		parent = parentIn;
+		key = keyIn;
+		comparator = comparatorIn;
+		lhs = lhsIn;
+		rhs = rhsIn;
+		pageSize = parent->getPageSize ();
+		for (int i = 0; i < max (numPages, 1); i++) {
+			work.push_back (MyDB_PageReaderWriter (true, *parent));
+			used.push_back (0);
+			live.push_back (0);
+		}
+		spare = MyDB_PageReaderWriter (true, *parent);
+		fillPage = 0;
+		garbage = 0;
+		curRun = 0;
+		curPage = MyDB_PageReaderWriter (*parent);
+	}
+
+	// adds the record that is in lhs
+	void add () {
+
+		// the record is copied out first, since lhs is used to compare records
+		Entry addMe;
+		addMe.key = key == nullptr ? 0 : key->getKey ();
+		incoming.resize (lhs->getBinarySize ());
+		lhs->toBinary (incoming.data ());
+		size_t size = incoming.size ();
+
+		// make room for it, writing records out as needed
+		while (!findRoom (size)) {
+			if (garbage >= (work.size () * pageSize) / 8 && garbage >= size)
+				compact ();
+			else
+				writeSmallest ();
+		}
+		addMe.page = fillPage;
+		addMe.offset = used[fillPage];
+		memcpy (getRec (addMe), incoming.data (), size);
+		used[fillPage] += size;
+		live[fillPage] += size;
+
+		// it can only go into the current run if it is not smaller than the last one written
+		addMe.run = curRun;
+		if (lastOut.size () > 0) {
+			Entry last;
+			last.run = curRun;
+			last.key = lastKey;
+			last.page = -1;
+			if (less (addMe, last))
+				addMe.run = curRun + 1;
+		}
+		heap.push_back (addMe);
+		push_heap (heap.begin (), heap.end (), Greater {this});
+	}
+
+	// writes out everything that is left, and returns the runs
+	vector <vector <MyDB_PageReaderWriter>> finish () {
+		while (heap.size () > 0)
+			writeSmallest ();
+		if (curRunPages.size () > 0 || lastOut.size () > 0) {
+			curRunPages.push_back (curPage);
+			runs.push_back (curRunPages);
+		}
+		return runs;
+	}
+
+private:
+
+	// a record in the heap: its run, its normalized key, and where it is
+	struct Entry {
+		int run;
+		uint64_t key;
+		int page;
+		size_t offset;
+	};
+
+	char *getRec (const Entry &forMe) {
+		if (forMe.page == -1)
+			return lastOut.data ();
+		return ((char *) work[forMe.page].getBytes ()) + forMe.offset;
+	}
+
+	// true if a comes before b
+	bool less (const Entry &a, const Entry &b) {
+		if (a.run != b.run)
+			return a.run < b.run;
+		if (key != nullptr && (a.key != b.key || key->isExact ()))
+			return a.key < b.key;
+		lhs->fromBinary (getRec (a));
+		rhs->fromBinary (getRec (b));
+		return comparator ();
+	}
+
+	// finds a pinned page with size bytes free at the end, and makes it the one to fill
+	bool findRoom (size_t size) {
+		if (used[fillPage] + size <= pageSize)
+			return true;
+		for (size_t i = 0; i < work.size (); i++) {
+			if (used[i] + size <= pageSize) {
+				fillPage = i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// writes out the smallest record in the heap, starting a new run if it is in the next one
+	void writeSmallest () {
+		pop_heap (heap.begin (), heap.end (), Greater {this});
+		Entry out = heap.back ();
+		heap.pop_back ();
+		if (out.run != curRun) {
+			curRunPages.push_back (curPage);
+			runs.push_back (curRunPages);
+			curRunPages.clear ();
+			curPage = MyDB_PageReaderWriter (*parent);
+			curRun = out.run;
+		}
+
+		char *rec = getRec (out);
+		size_t size = *((short *) rec);
+		lhs->fromBinary (rec);
+		appendRecord (curPage, curRunPages, lhs, parent);
+		lastOut.assign (rec, rec + size);
+		lastKey = out.key;
+
+		// a page that is empty is reclaimed right away
+		live[out.page] -= size;
+		garbage += size;
+		if (live[out.page] == 0) {
+			garbage -= used[out.page];
+			used[out.page] = 0;
+		}
+	}
+
+	// copies the records in each pinned page down to the start of the page, using the spare
+	void compact () {
+		vector <int> order (heap.size ());
+		for (size_t i = 0; i < heap.size (); i++)
+			order[i] = i;
+		std :: sort (order.begin (), order.end (), [&] (int a, int b) {
+			return heap[a].page < heap[b].page || (heap[a].page == heap[b].page && heap[a].offset < heap[b].offset);
+		});
+
+		size_t next = 0;
+		for (size_t p = 0; p < work.size (); p++) {
+			char *to = (char *) spare.getBytes ();
+			size_t bytes = 0;
+			for (; next < order.size () && heap[order[next]].page == (int) p; next++) {
+				Entry &moveMe = heap[order[next]];
+				char *rec = getRec (moveMe);
+				size_t size = *((short *) rec);
+				memcpy (to + bytes, rec, size);
+				moveMe.offset = bytes;
+				bytes += size;
+			}
+			swap (work[p], spare);
+			used[p] = bytes;
+		}
+		garbage = 0;
+		fillPage = 0;
+	}
+
+	MyDB_BufferManagerPtr parent;
+	MyDB_NormalizedKeyPtr key;
+	function <bool ()> comparator;
+	MyDB_RecordPtr lhs;
+	MyDB_RecordPtr rhs;
+	size_t pageSize;
+
+	// the pinned pages, with the bytes used at the start of each, and how many of those are
+	// still in the heap; garbage is the number of bytes used by records that were written out
+	vector <MyDB_PageReaderWriter> work;
+	vector <size_t> used;
+	vector <size_t> live;
+	MyDB_PageReaderWriter spare;
+	size_t fillPage;
+	size_t garbage;
+
+	// the heap (the std :: heap functions keep the largest on top, so they are given this)
+	struct Greater {
+		ReplacementSelection *me;
+		bool operator () (const Entry &a, const Entry &b) const {
+			return me->less (b, a);
+		}
+	};
+	vector <Entry> heap;
+	vector <char> incoming;
+
+	// the last record written, and the runs
+	vector <char> lastOut;
+	uint64_t lastKey;
+	int curRun;
+	MyDB_PageReaderWriter curPage;
+	vector <MyDB_PageReaderWriter> curRunPages;
+	vector <vector <MyDB_PageReaderWriter>> runs;
+};
+
+// the first phase of the sort: sorts the file into runs; if sortOn is not empty, the records are
+// sorted with normalized keys.  The runs are runSize pages, unless they are made by replacement
+// selection, in which case the heap gets runSize pages
+static vector <vector <MyDB_PageReaderWriter>> sortIntoRuns (int runSize, MyDB_TableReaderWriter &sortMe, 
+	function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string lhsPred, string sortOn,
+	bool replacementSelection) {
 
 	bool skipPred = false;
 	if (lhsPred == "bool[true]")
 		skipPred = true;
 
-	func f = lhs->compileComputation (lhsPred);
+	valFunc f = lhs->compileValueComputation (lhsPred);
+	MyDB_NormalizedKeyPtr key = sortOn == "" ? nullptr : MyDB_NormalizedKey :: build (lhs, sortOn);
 
-	// this is the list of all of the pages in the file
-	vector <vector<MyDB_PageReaderWriter>> allPages;
+	// this is the list of all of the runs
+	vector <vector <MyDB_PageReaderWriter>> runs;
+	
+	// with replacement selection, the records go through the heap one at a time
+	if (replacementSelection) {
+		ReplacementSelection heap (sortMe.getBufferMgr (), runSize, key, comparator, lhs, rhs);
+		for (int i = 0; i < sortMe.getNumPages (); i++) {
+			if (sortMe[i].getType () != MyDB_PageType :: RegularPage)
+				continue;
+			MyDB_RecordIteratorAltPtr temp = sortMe[i].getIteratorAlt ();
+			while (temp->advance ()) {
+				temp->getCurrent (lhs);
+				if (skipPred || f ().toBool ())
+					heap.add ();
+			}
+		}
+		runs = heap.finish ();
+	} else {
 
-	// this is the pages making up the current run
-	vector <vector<MyDB_PageReaderWriter>> pagesToSort;
+		// runSize pages at a time are pinned, and their records are sorted together and written
+		// out once, as a run.  With no predicate, the pages of the file are pinned as they are;
+		// otherwise, the records that are accepted are copied onto pinned anonymous pages first
+		MyDB_BufferManagerPtr parent = sortMe.getBufferMgr ();
+		vector <MyDB_PageReaderWriter> pinnedPages;
+		auto finishRun = [&] () {
+			if (pinnedPages.empty ())
+				return;
+			runs.push_back (sortAcrossPages (pinnedPages, *parent, key, comparator, lhs, rhs));
+			pinnedPages.clear ();
+		};
 
-	// this is the list of all of the iterators, with one for each run
-	vector <MyDB_RecordIteratorAltPtr> runIters;
-	
-	// process the file 
-	MyDB_PageReaderWriter tempPage (true, *sortMe.getBufferMgr ());
-	for (int i = 0; i < sortMe.getNumPages (); i++) {
-		
-		if (sortMe[i].getType () == MyDB_PageType :: RegularPage) {
+		for (int i = 0; i < sortMe.getNumPages (); i++) {
+
+			if (sortMe[i].getType () != MyDB_PageType :: RegularPage)
+				continue;
 
 			if (skipPred) {
-				vector <MyDB_PageReaderWriter> run;
-				run.push_back (*(sortMe[i].sort (comparator, lhs, rhs)));	
-				pagesToSort.push_back (run);
-			} else {
-				MyDB_RecordIteratorAltPtr temp = sortMe[i].getIteratorAlt ();
-				while (temp->advance ()) {
-					temp->getCurrent (lhs);
+				pinnedPages.push_back (sortMe.getPinned (i));
+				if ((int) pinnedPages.size () == runSize)
+					finishRun ();
+				continue;
+			}
 
-					if (!f ()->toBool ())
-						continue;
+			MyDB_RecordIteratorAltPtr temp = sortMe[i].getIteratorAlt ();
+			while (temp->advance ()) {
+				temp->getCurrent (lhs);
 
-					if (!tempPage.append (lhs)) {
-	
-						// remember the old page
-						vector <MyDB_PageReaderWriter> run;
-						run.push_back (*(tempPage.sort (comparator, lhs, rhs)));
-						pagesToSort.push_back (run);
-	
-						// get the new page
-						tempPage = MyDB_PageReaderWriter (true, *sortMe.getBufferMgr ());	
+				if (!f ().toBool ())
+					continue;
+
+				if (pinnedPages.empty () || !pinnedPages.back ().append (lhs)) {
+
+					// the run is full, so it is sorted (which loads other records into lhs)
+					if ((int) pinnedPages.size () == runSize) {
+						finishRun ();
 						temp->getCurrent (lhs);
-						tempPage.append (lhs);
 					}
+					pinnedPages.push_back (MyDB_PageReaderWriter (true, *parent));
+					pinnedPages.back ().append (lhs);
 				}
 			}
 		}
 
-		// if we are all done, remember the last page
-		if (i == sortMe.getNumPages () - 1) {
-			vector <MyDB_PageReaderWriter> run;
-			run.push_back (*(tempPage.sort (comparator, lhs, rhs)));
-			pagesToSort.push_back (run);
-		}
+		// and the last run, which may be short
+		finishRun ();
+	}
+
+	return runs;
+}
 
-		// if we are not done reading this run, go on to the next one
-		if (pagesToSort.size () != runSize && i != sortMe.getNumPages () - 1)
+// builds the queue that merges the given runs, reading each of them with a prefetching iterator;
+// the runs are emptied, so that the iterators hold the only copies of their pages, and each page
+// is let go as soon as it has been merged
+static MyDB_RunQueueIteratorAltPtr queueOverRuns (vector <vector <MyDB_PageReaderWriter>> &runs, size_t first, 
+	size_t last, MyDB_SchemaPtr schema, string sortOn, function <bool ()> comparator, MyDB_RecordPtr lhs, 
+	MyDB_RecordPtr rhs) {
+
+	MyDB_RunQueueIteratorAltPtr temp;
+	if (sortOn == "")
+		temp = make_shared <MyDB_RunQueueIteratorAlt> (comparator, lhs, rhs);
+	else
+		temp = make_shared <MyDB_RunQueueIteratorAlt> (schema, sortOn);
+
+	for (size_t i = first; i < last; i++) {
+		if (runs[i].empty ())
 			continue;
+		MyDB_RecordIteratorAltPtr m = getPrefetchingIteratorAlt (runs[i]);
+		runs[i].clear ();
+		if (m->advance ()) {
+			temp->addRun (m);
+		}
+	}
+	return temp;
+}
 
-		// while we don't have a single sorted list
-		while (pagesToSort.size () > 1) {
-			
-			// the new version of the pages to sort vector
-			vector <vector<MyDB_PageReaderWriter>> newPagesToSort;
-	
-			// repeatedly merge the last two pages
-			while (pagesToSort.size () > 0) {
-	
-				// if there is one run, then just add it
-				if (pagesToSort.size () == 1) {
-					newPagesToSort.push_back (pagesToSort.back ());
-					pagesToSort.pop_back ();
-					continue;
-				}
-	
-				// get the next two runs
-				vector<MyDB_PageReaderWriter> runOne = pagesToSort.back ();
-				pagesToSort.pop_back ();
-				vector<MyDB_PageReaderWriter> runTwo = pagesToSort.back ();
-				pagesToSort.pop_back ();
-		
-				// merge them
-				newPagesToSort.push_back (mergeIntoList (sortMe.getBufferMgr (), getIteratorAlt (runOne), 
-					getIteratorAlt (runTwo), comparator, lhs, rhs));
+// the second phase of the sort.  Each run that is being merged has two pages pinned (the one being
+// read, and the next one), so no more than fanIn runs are merged at once; while there are more runs
+// than that, they are merged fanIn at a time into longer runs, a pass at a time, and the last few
+// runs are merged by the iterator that is returned
+static MyDB_RecordIteratorAltPtr mergeInPasses (vector <vector <MyDB_PageReaderWriter>> &runs, int fanIn, 
+	MyDB_BufferManagerPtr parent, MyDB_SchemaPtr schema, string sortOn, function <bool ()> comparator, 
+	MyDB_RecordPtr lhs, MyDB_RecordPtr rhs) {
+
+	if (fanIn < 2)
+		fanIn = 2;
+
+	while (runs.size () > (size_t) fanIn) {
+		vector <vector <MyDB_PageReaderWriter>> longerRuns;
+		for (size_t i = 0; i < runs.size (); i += fanIn) {
+
+			// a run that is left over by itself is just carried on to the next pass
+			size_t last = min (runs.size (), i + fanIn);
+			if (last - i == 1) {
+				longerRuns.push_back (runs[i]);
+				continue;
 			}
-	
-			pagesToSort = newPagesToSort;
+
+			MyDB_RunQueueIteratorAltPtr merger = queueOverRuns (runs, i, last, schema, sortOn, comparator, lhs, rhs);
+			vector <MyDB_PageReaderWriter> run;
+			MyDB_PageReaderWriter curPage (*parent);
+			while (merger->advance ()) {
+				merger->getCurrent (lhs);
+				appendRecord (curPage, run, lhs, parent);
+			}
+			run.push_back (curPage);
+			longerRuns.push_back (run);
 		}
+		runs = longerRuns;
+	}
 
-		
-		// now we have a single list, so create an iterator for it
-		runIters.push_back (getIteratorAlt (pagesToSort[0]));
+	return queueOverRuns (runs, 0, runs.size (), schema, sortOn, comparator, lhs, rhs);
+}
 
-		// and start over on the next run
-		pagesToSort.clear ();
-	}
-	
-	// and now, we are ready to merge everything
-	MyDB_RunQueueIteratorAltPtr temp = make_shared <MyDB_RunQueueIteratorAlt> (comparator, lhs, rhs);
+// the merge gets half of the pages that the runs were made with, at two pages per run, so that
+// there are pages left for whoever reads from the merge (a sort merge join reads from two at once)
+static int fanInFor (int runSize) {
+	return runSize / 4;
+}
 
-	// load up the set
-	for (MyDB_RecordIteratorAltPtr m : runIters) {
-		if (m->advance ()) {
-			temp->getQ ().push (m);
-		}
-	}
+MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe, 
+	function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs) {
 
-	return temp;
+	return buildItertorOverSortedRuns (runSize, sortMe, comparator, lhs, rhs, "bool[true]");
+}
+
+MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe, 
+	function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string lhsPred) {
+
+	vector <vector <MyDB_PageReaderWriter>> runs = sortIntoRuns (runSize, sortMe, comparator, lhs, rhs, lhsPred, "", false);
+	return mergeInPasses (runs, fanInFor (runSize), sortMe.getBufferMgr (), sortMe.getTable ()->getSchema (), "", 
+		comparator, lhs, rhs);
+}
+
+MyDB_RecordIteratorAltPtr buildItertorOverSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe, 
+	string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string lhsPred, bool replacementSelection) {
+
+	vector <vector <MyDB_PageReaderWriter>> runs = buildSortedRuns (runSize, sortMe, sortOn, lhs, rhs, lhsPred, 
+		replacementSelection);
+	return mergeSortedRuns (runs, fanInFor (runSize), sortMe, sortOn, lhs, rhs);
 }
 
+vector <vector <MyDB_PageReaderWriter>> buildSortedRuns (int runSize, MyDB_TableReaderWriter &sortMe, 
+	string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, string lhsPred, bool replacementSelection) {
+
+	function <bool ()> comparator = buildRecordComparator (lhs, rhs, sortOn);
+	return sortIntoRuns (runSize, sortMe, comparator, lhs, rhs, lhsPred, sortOn, replacementSelection);
+}
+
+MyDB_RecordIteratorAltPtr mergeSortedRuns (vector <vector <MyDB_PageReaderWriter>> &runs, int fanIn, 
+	MyDB_TableReaderWriter &sortMe, string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs) {
+
+	function <bool ()> comparator = buildRecordComparator (lhs, rhs, sortOn);
+	return mergeInPasses (runs, fanIn, sortMe.getBufferMgr (), sortMe.getTable ()->getSchema (), sortOn, 
+		comparator, lhs, rhs);
+}
 
 void sort (int runSize, MyDB_TableReaderWriter &sortMe, MyDB_TableReaderWriter &sortIntoMe,
 	function <bool ()> comparator, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs) {
@@ -233,5 +556,227 @@ void sort (int runSize, MyDB_TableReaderWriter &sortMe, MyDB_TableReaderWriter &
 	}
 }
 
+void sort (int runSize, MyDB_TableReaderWriter &sortMe, MyDB_TableReaderWriter &sortIntoMe,
+	string sortOn, MyDB_RecordPtr lhs, MyDB_RecordPtr rhs, bool replacementSelection) {
+
+	MyDB_RecordIteratorAltPtr myIter = buildItertorOverSortedRuns (runSize, sortMe, sortOn, lhs, rhs, "bool[true]",
+		replacementSelection);
+	while (myIter->advance ()) {
+		myIter->getCurrent (lhs);
+		sortIntoMe.append (lhs);
+	}
+}
+
+
+// what the threads of a parallel sort share
+struct ParallelSort {
+	MyDB_TableReaderWriter *sortMe;
+	string sortOn;
+	int runSize;
+	int numThreads;
+
+	// the first phase: the next page to be sorted into a run, and the runs
+	atomic <int> nextPage;
+	mutex runLock;
+	vector <vector <MyDB_PageReaderWriter>> runs;
+
+	// the second phase: the first record on each page of each run (empty if the page is empty),
+	// the splitters between the pieces, and the sorted pieces
+	vector <vector <vector <char>>> firstRecs;
+	vector <vector <char>> splitters;
+	vector <vector <MyDB_PageReaderWriter>> pieces;
+};
+
+struct ParallelSortArg {
+	ParallelSort *shared;
+	int whichThread;
+};
+
+// the first phase: sort groups of pages into runs, until there are no pages left
+static void sortRunsThread (void *arg) {
+
+	ParallelSort &shared = *((ParallelSortArg *) arg)->shared;
+	MyDB_TableReaderWriter &sortMe = *shared.sortMe;
+	MyDB_RecordPtr lhs = sortMe.getEmptyRecord ();
+	MyDB_RecordPtr rhs = sortMe.getEmptyRecord ();
+	function <bool ()> comparator = buildRecordComparator (lhs, rhs, shared.sortOn);
+	MyDB_NormalizedKeyPtr key = MyDB_NormalizedKey :: build (lhs, shared.sortOn);
+
+	while (true) {
+		int lowPage = shared.nextPage.fetch_add (shared.runSize);
+		if (lowPage >= sortMe.getNumPages ())
+			break;
+
+		vector <vector <MyDB_PageReaderWriter>> pagesToSort;
+		for (int i = lowPage; i < lowPage + shared.runSize && i < sortMe.getNumPages (); i++) {
+			MyDB_PageReaderWriter page = sortMe[i];
+			if (page.getType () == MyDB_PageType :: RegularPage) {
+
+				// MyDB_PageReaderWriter :: sort reads the records straight off of the page
+				// while it writes the sorted page, but once this thread moves on to the page
+				// that it is writing, another thread can have the first one kicked out of the
+				// buffer... so the page is copied, and the copy is sorted in place
+				MyDB_PageReaderWriter sorted (*sortMe.getBufferMgr ());
+				sorted.copyFrom (page);
+				sorted.sortInPlace (key, comparator, lhs, rhs);
+				vector <MyDB_PageReaderWriter> run;
+				run.push_back (sorted);
+				pagesToSort.push_back (run);
+			}
+		}
+		if (pagesToSort.size () == 0)
+			continue;
+
+		vector <MyDB_PageReaderWriter> run = mergeRuns (sortMe.getBufferMgr (), pagesToSort, comparator, lhs, rhs);
+		lock_guard <mutex> guard (shared.runLock);
+		shared.runs.push_back (run);
+	}
+}
+
+// the second phase: merge the records from every run that fall into this thread's piece
+static void mergePieceThread (void *arg) {
+
+	ParallelSort &shared = *((ParallelSortArg *) arg)->shared;
+	int whichThread = ((ParallelSortArg *) arg)->whichThread;
+	MyDB_TableReaderWriter &sortMe = *shared.sortMe;
+	MyDB_BufferManagerPtr parent = sortMe.getBufferMgr ();
+
+	// cur and bound are used to see if a record is in the piece
+	MyDB_RecordPtr cur = sortMe.getEmptyRecord ();
+	MyDB_RecordPtr bound = sortMe.getEmptyRecord ();
+	function <bool ()> lessThanBound = buildRecordComparator (cur, bound, shared.sortOn);
+
+	// the piece is from low (inclusive) to high (exclusive); the first piece has no low, and the last has no high
+	vector <char> *low = whichThread == 0 ? nullptr : &shared.splitters[whichThread - 1];
+	vector <char> *high = whichThread == shared.numThreads - 1 ? nullptr : &shared.splitters[whichThread];
+
+	MyDB_RunQueueIteratorAltPtr myQ = make_shared <MyDB_RunQueueIteratorAlt> (sortMe.getTable ()->getSchema (), shared.sortOn);
+	for (size_t r = 0; r < shared.runs.size (); r++) {
+
+		// every record on the pages before the last page that starts below low is itself below low
+		size_t startPage = 0;
+		if (low != nullptr) {
+			bound->fromBinary (low->data ());
+			for (size_t p = 0; p < shared.firstRecs[r].size (); p++) {
+				if (shared.firstRecs[r][p].size () == 0)
+					continue;
+				cur->fromBinary (shared.firstRecs[r][p].data ());
+				if (!lessThanBound ())
+					break;
+				startPage = p;
+			}
+		}
+
+		// and skip the rest of the records that are below low
+		vector <MyDB_PageReaderWriter> pages (shared.runs[r].begin () + startPage, shared.runs[r].end ());
+		MyDB_RecordIteratorAltPtr myIter = getIteratorAlt (pages);
+		bool any = false;
+		while (myIter->advance ()) {
+			myIter->getCurrent (cur);
+			if (low == nullptr || !lessThanBound ()) {
+				any = true;
+				break;
+			}
+		}
+		if (any)
+			myQ->addRun (myIter);
+	}
+
+	// now merge, stopping at the first record that is not below high
+	vector <MyDB_PageReaderWriter> &returnVal = shared.pieces[whichThread];
+	MyDB_PageReaderWriter curPage (*parent);
+	if (high != nullptr)
+		bound->fromBinary (high->data ());
+	bool wroteAny = false;
+	while (myQ->advance ()) {
+		myQ->getCurrent (cur);
+		if (high != nullptr && !lessThanBound ())
+			break;
+		appendRecord (curPage, returnVal, cur, parent);
+		wroteAny = true;
+	}
+	if (wroteAny)
+		returnVal.push_back (curPage);
+}
+
+void sort (int numThreads, int runSize, MyDB_TableReaderWriter &sortMe, MyDB_TableReaderWriter &sortIntoMe,
+	string sortOn) {
+
+	ParallelSort shared;
+	shared.sortMe = &sortMe;
+	shared.sortOn = sortOn;
+	shared.runSize = max (runSize, 1);
+	shared.numThreads = max (numThreads, 1);
+	shared.nextPage = 0;
+
+	vector <ParallelSortArg> args (shared.numThreads);
+	vector <void *> argPtrs;
+	for (int i = 0; i < shared.numThreads; i++) {
+		args[i].shared = &shared;
+		args[i].whichThread = i;
+		argPtrs.push_back (&args[i]);
+	}
+
+	// sort the runs
+	sortMe.getBufferMgr ()->executeThreads (sortRunsThread, argPtrs);
+
+	// sample the runs, and choose the splitters so that the pieces have about the same number of pages
+	MyDB_RecordPtr lhs = sortMe.getEmptyRecord ();
+	MyDB_RecordPtr rhs = sortMe.getEmptyRecord ();
+	function <bool ()> comparator = buildRecordComparator (lhs, rhs, sortOn);
+	vector <vector <char>> samples;
+	shared.firstRecs.resize (shared.runs.size ());
+	for (size_t r = 0; r < shared.runs.size (); r++) {
+		for (MyDB_PageReaderWriter &page : shared.runs[r]) {
+			vector <char> firstRec;
+			MyDB_RecordIteratorAltPtr myIter = page.getIteratorAlt ();
+			if (myIter->advance ()) {
+				myIter->getCurrent (lhs);
+				firstRec.resize (lhs->getBinarySize ());
+				lhs->toBinary (firstRec.data ());
+				samples.push_back (firstRec);
+			}
+			shared.firstRecs[r].push_back (firstRec);
+		}
+	}
+	if (samples.size () == 0)
+		return;
+
+	std :: sort (samples.begin (), samples.end (), [&] (const vector <char> &left, const vector <char> &right) {
+		lhs->fromBinary ((void *) left.data ());
+		rhs->fromBinary ((void *) right.data ());
+		return comparator ();
+	});
+	for (int i = 1; i < shared.numThreads; i++)
+		shared.splitters.push_back (samples[(i * samples.size ()) / shared.numThreads]);
+
+	// merge the pieces
+	shared.pieces.resize (shared.numThreads);
+	sortMe.getBufferMgr ()->executeThreads (mergePieceThread, argPtrs);
+
+	// and write them out; pages of the same size are copied over whole
+	bool samePageSize = sortMe.getBufferMgr ()->getPageSize () == sortIntoMe.getBufferMgr ()->getPageSize ();
+	for (vector <MyDB_PageReaderWriter> &piece : shared.pieces) {
+		for (MyDB_PageReaderWriter &page : piece) {
+			if (samePageSize) {
+				size_t whichPage;
+				sortIntoMe.addPage (whichPage).copyFrom (page);
+			} else {
+				MyDB_RecordIteratorAltPtr myIter = page.getIteratorAlt ();
+				while (myIter->advance ()) {
+					myIter->getCurrent (lhs);
+					sortIntoMe.append (lhs);
+				}
+			}
+		}
+	}
+}
+
+vector <pair <MyDB_CompNodePtr, bool>> parseSortKeys (vector <pair <string, bool>> parseUs) {
+	vector <pair <MyDB_CompNodePtr, bool>> res;
+	for (auto &p : parseUs)
+		res.push_back (make_pair (MyDB_CompNode :: parse (p.first), p.second));
+	return res;
+}
 
 #endif
@@ -0,0 +1,77 @@
+
+#ifndef ADAPTIVE_CONJUNCTION_H
+#define ADAPTIVE_CONJUNCTION_H
+
+#include "MyDB_Batch.h"
+#include "MyDB_BatchComputation.h"
+#include "MyDB_CompNode.h"
+#include "MyDB_Record.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// this runs a predicate that is the && of a number of clauses (as the SQL layer builds from
+// the CNF of a WHERE clause), one clause at a time, stopping at the first one that fails.
+// As it goes, it keeps track of how often each clause passes and how long each one takes
+// to run, and every so often it puts the clauses in order of their cost per record that
+// they throw out, so that cheap clauses that throw out a lot of records are run first.
+// A clause with a division is never run before a clause that came before it, since
+// that clause may be what screens out the records that it would divide by zero on
+class MyDB_AdaptiveConjunction {
+
+public:
+
+	// splits a predicate into its clauses: the inputs of the &&s at its top, leaving out
+	// any that are simply true
+	static vector <MyDB_CompNodePtr> split (MyDB_CompNodePtr predicate);
+
+	// runs the clauses a record at a time; compiled has the clauses compiled over the
+	// record, in the same order (they are usually compiled along with everything else
+	// that the operator computes, so that the subexpressions that they share are shared)
+	MyDB_AdaptiveConjunction (vector <MyDB_CompNodePtr> clauses, vector <valFunc> compiled);
+
+	// runs the clauses a batch at a time, over the given batch
+	MyDB_AdaptiveConjunction (vector <MyDB_CompNodePtr> clauses, MyDB_Batch &overMe);
+
+	// for record-at-a-time: does the current record pass all of the clauses?
+	bool accepts ();
+
+	// for batch-at-a-time: removes every row that does not pass all of the clauses
+	void filter (vector <int> &selection);
+
+	// the order that the clauses are being run in, along with how often each one passed
+	// (of the records that it was run on) and how long it took per record; this is empty
+	// if there are no clauses
+	string toString ();
+
+private:
+
+	struct Clause {
+		MyDB_CompNodePtr node;
+		valFunc func;
+		MyDB_BatchComputationPtr batchComp;
+		double numRun;
+		double numPassed;
+		double numTimed;
+		double nanos;
+
+		// true if this has a division, so it has to stay after the clauses before it
+		bool canFault;
+	};
+
+	vector <Clause> clauses;
+
+	// the positions in clauses, in the order that they are run
+	vector <int> order;
+
+	// the number of records seen by accepts
+	long long numSeen;
+
+	void reorder ();
+
+	// true if the computation has a division anywhere in it
+	static bool hasDivision (MyDB_CompNodePtr checkMe);
+};
+
+#endif
@@ -3,6 +3,9 @@
 #define ATT_VAL_H
 
 #include <memory>
+#include "MyDB_Dictionary.h"
+#include "MyDB_StringView.h"
+#include "MyDB_Value.h"
 #include <string>
 #include <cstring>
 
@@ -21,6 +24,13 @@ private:
 	// this tells us whether we are using the buffer
 	bool usingBuffer;
 
+	// the hash of the current value, if it has been computed since the value last changed
+	bool haveHash;
+	size_t myHash;
+
+	// bumped every time that the value changes
+	unsigned myVersion;
+
 public:
 
 	virtual int toInt () = 0;
@@ -35,6 +45,18 @@ public:
 	virtual void serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) = 0;
 	virtual ~MyDB_AttVal ();
 
+	// these move the current value to and from the plain MyDB_Value representation
+	// that is used by compiled computations
+	virtual MyDB_Value toValue () = 0;
+	virtual void fromValue (const MyDB_Value &fromMe) = 0;
+
+	// gets the value as a string without making a copy if at all possible... the view
+	// may point into spare, which is used if the value has to be converted to a string
+	virtual MyDB_StringView toStringView (string &spare) {
+		spare = toString ();
+		return MyDB_StringView (spare);
+	}
+
 	// this gets a pointer to our data... useful because we can avoid deserializing the record
 	inline void *getDataPointer () {
 		return myData;
@@ -54,14 +76,39 @@ public:
 	inline void setBuffered (char *where) {
 		myData = where;
 		usingBuffer = true;
+		haveHash = false;
+		myVersion++;
 	}
 
 	inline void setNotBuffered () {
 		myData = nullptr;
 		usingBuffer = false;
+		haveHash = false;
+		myVersion++;
+	}
+
+	// this changes every time that the value does, so that a computed result can tell
+	// whether it is still good without looking at the value itself
+	inline unsigned getVersion () {
+		return myVersion;
+	}
+
+	// remember the hash of the current value; it is forgotten when the value changes
+	inline bool hasCachedHash () {
+		return haveHash;
+	}
+
+	inline size_t getCachedHash () {
+		return myHash;
+	}
+
+	inline void setCachedHash (size_t toMe) {
+		myHash = toMe;
+		haveHash = true;
 	}
 
 	MyDB_AttVal () {
+		myVersion = 0;
 		setNotBuffered ();	
 	}
 
@@ -96,6 +143,8 @@ public:
 	size_t hash () override;
 	MyDB_AttValPtr getCopy () override;
 	void serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) override;
+	MyDB_Value toValue () override;
+	void fromValue (const MyDB_Value &fromMe) override;
 	void set (int val);
 	MyDB_IntAttVal ();
 	~MyDB_IntAttVal ();
@@ -122,6 +171,8 @@ public:
 	void set (MyDB_AttValPtr toMe) override;
 	void fromString (string &fromMe) override;
 	void serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) override;
+	MyDB_Value toValue () override;
+	void fromValue (const MyDB_Value &fromMe) override;
 	void set (double val);
 	MyDB_DoubleAttVal ();
 	~MyDB_DoubleAttVal ();
@@ -147,11 +198,23 @@ public:
 	size_t hash () override;
 	void set (MyDB_AttValPtr toMe) override;
 	void serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) override;
+	MyDB_Value toValue () override;
+	void fromValue (const MyDB_Value &fromMe) override;
 	void fromInt (int fromMe) override;
+	MyDB_StringView toStringView (string &spare) override;
 	void set (string val);
 	MyDB_StringAttVal ();
 	~MyDB_StringAttVal ();
 
+	// gets the value without copying it.  When the value sits in a buffer, its length
+	// comes from the length that prefixes it (which counts itself and the null at the end)
+	inline MyDB_StringView getView () {
+		char *dataPtr = (char *) getDataPointer ();
+		if (dataPtr == nullptr)
+			return MyDB_StringView (value);
+		return MyDB_StringView (dataPtr, *((short *) (dataPtr - sizeof (short))) - sizeof (short) - 1);
+	}
+
 private:
 
 	string value;
@@ -174,6 +237,8 @@ public:
 	size_t hash () override;
 	void fromInt (int fromMe) override;
 	void serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) override;
+	MyDB_Value toValue () override;
+	void fromValue (const MyDB_Value &fromMe) override;
 	void set (bool val);
 	MyDB_BoolAttVal ();
 	~MyDB_BoolAttVal ();
@@ -184,5 +249,48 @@ private:
 };
 
 
+class MyDB_DictAttVal;
+typedef shared_ptr <MyDB_DictAttVal> MyDB_DictAttValPtr;
+
+// a string that is stored as its code in a dictionary
+class MyDB_DictAttVal : public MyDB_AttVal {
+
+public:
+
+	int toInt () override;
+	double toDouble () override;
+	string toString () override;
+	bool toBool () override;
+	void fromString (string &fromMe) override;
+	void set (MyDB_AttValPtr toMe) override;
+	MyDB_AttValPtr getCopy () override;
+	size_t hash () override;
+	void fromInt (int fromMe) override;
+	void serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) override;
+	MyDB_Value toValue () override;
+	void fromValue (const MyDB_Value &fromMe) override;
+	MyDB_StringView toStringView (string &spare) override;
+	void setCode (int code);
+	MyDB_DictAttVal (MyDB_DictionaryPtr myDictionary);
+	~MyDB_DictAttVal ();
+
+	// the code of the current value
+	inline int getCode () {
+		void *dataPtr = getDataPointer ();
+		if (dataPtr == nullptr) 
+			return code;
+		else
+			return *((unsigned int *) dataPtr);
+	}
+
+	inline MyDB_DictionaryPtr &getDictionary () {
+		return myDictionary;
+	}
+
+private:
+
+	int code;
+	MyDB_DictionaryPtr myDictionary;
+};
 
 #endif
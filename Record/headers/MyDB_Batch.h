@@ -0,0 +1,122 @@
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "MyDB_AttType.h"
+#include "MyDB_Record.h"
+#include "MyDB_Schema.h"
+#include "MyDB_Value.h"
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// the most records that are processed together as a batch
+#define BATCH_SIZE 1024
+
+// the values of one attribute (or of one computation) over a batch of records, stored
+// as a plain array of the right type so that loops over it can be vectorized.  Only the
+// array that matches the tag is used, except that a dictionary-coded string (one that
+// has a dict) keeps its codes in ints.  Position i holds the value for record i of the
+// batch
+struct MyDB_Column {
+
+	MyDB_ValueTag tag;
+	MyDB_Dictionary *dict;
+	vector <int> ints;
+	vector <double> doubles;
+	vector <char> bools;
+	vector <MyDB_StringView> strings;
+
+	// sets the type of the column, and makes room for a full batch
+	void setType (MyDB_ValueTag tagIn, MyDB_Dictionary *dictIn);
+
+	// gets the value at position i
+	inline MyDB_Value getValue (int i) {
+		if (tag == IntValue)
+			return MyDB_Value :: fromInt (ints[i]);
+		if (tag == DoubleValue)
+			return MyDB_Value :: fromDouble (doubles[i]);
+		if (tag == BoolValue)
+			return MyDB_Value :: fromBool (bools[i] != 0);
+		if (dict != nullptr)
+			return MyDB_Value :: fromCode (dict, ints[i]);
+		return MyDB_Value :: fromString (strings[i]);
+	}
+};
+
+// create a smart pointer for batches
+class MyDB_Batch;
+typedef shared_ptr <MyDB_Batch> MyDB_BatchPtr;
+
+// this holds up to BATCH_SIZE records that all have the same schema.  The records are
+// copied in, one at a time, in their binary form; the first time that a column is asked
+// for, the attributes that were asked for (via needAtt) are pulled out of all of the
+// records into columns.  The rows of a batch that are still of interest are given by
+// a selection vector, which is a sorted list of positions in the batch
+class MyDB_Batch {
+
+public:
+
+	// creates an empty batch for records with the given schema
+	MyDB_Batch (MyDB_SchemaPtr mySchema);
+
+	// copies a record that is in its binary form (for example, one that was obtained with
+	// getCurrentPointer () on an iterator) into the batch; source is remembered, and can be
+	// anything (it is usually where the record came from).  Returns true if the batch is
+	// now full
+	bool append (void *fromHere, void *source = nullptr);
+
+	// empties out the batch
+	void clear ();
+
+	// the number of records in the batch
+	inline int size () {
+		return (int) offsets.size ();
+	}
+
+	// loads the record at position i of the batch into intoMe
+	void getRecord (int i, MyDB_RecordPtr intoMe);
+
+	// gets the source that was given when the record at position i was appended
+	inline void *getSource (int i) {
+		return sources[i];
+	}
+
+	// says that the given attribute will be needed as a column
+	void needAtt (int whichAtt);
+
+	// gets the column for the given attribute, which must have been asked for via needAtt
+	MyDB_Column &getColumn (int whichAtt);
+
+	// sets up a selection vector that has every record in the batch
+	void selectAll (vector <int> &selection);
+
+	// access the schema
+	MyDB_SchemaPtr &getSchema ();
+
+	// the type of value that a column for the given attribute holds
+	static MyDB_ValueTag getTag (MyDB_AttTypePtr forMe);
+
+private:
+
+	// pulls the needed columns out of the records
+	void decode ();
+
+	MyDB_SchemaPtr mySchema;
+
+	// the records, one after another, along with where each starts and where it came from
+	vector <char> data;
+	vector <size_t> offsets;
+	vector <void *> sources;
+
+	// the columns, and whether they are needed
+	vector <MyDB_Column> columns;
+	vector <bool> needed;
+	int lastNeeded;
+
+	// true if the columns are up to date with the records
+	bool decoded;
+};
+
+#endif
@@ -0,0 +1,74 @@
+
+#ifndef BATCH_COMPUTATION_H
+#define BATCH_COMPUTATION_H
+
+#include "MyDB_AttType.h"
+#include "MyDB_Batch.h"
+#include "MyDB_CompNode.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// one step of a computation over a batch; these are only used inside of the computation
+struct MyDB_BatchNode;
+typedef shared_ptr <MyDB_BatchNode> MyDB_BatchNodePtr;
+
+// create a smart pointer for batch computations
+class MyDB_BatchComputation;
+typedef shared_ptr <MyDB_BatchComputation> MyDB_BatchComputationPtr;
+
+// this is a computation (written in the same language, and following the same typing
+// rules, as the ones that are compiled by MyDB_Record :: compileComputation) that is run
+// over a whole batch of records at once, instead of over one record at a time.  Each step
+// of the computation is a tight loop over plain arrays, which the compiler can vectorize;
+// a selection vector says which rows of the batch the computation is to be run on, and
+// an && or an || only runs its right side on the rows that its left side did not settle
+class MyDB_BatchComputation {
+
+public:
+
+	// compiles the computation; the attributes that it uses are asked for from the batch,
+	// which must be the batch that the computation is later run on
+	MyDB_BatchComputation (string computation, MyDB_Batch &overMe);
+
+	// the same, for a computation that has already been parsed
+	MyDB_BatchComputation (MyDB_CompNodePtr computation, MyDB_Batch &overMe);
+
+	// runs the computation over the selected rows of the batch; only the positions of
+	// the result that are in the selection vector are meaningful, and the result is only
+	// good until the computation is run again or the batch changes
+	MyDB_Column &evaluate (vector <int> &selection);
+
+	// for a boolean computation, removes every row that is not accepted from the selection
+	void filter (vector <int> &selection);
+
+	// mixes the hash of the result for each selected row i into hashes[i], with
+	// MyDB_Value :: combineHashes (hashes[i], h), where h is the hash that MyDB_Value :: hash
+	// gives for the same value; so hashing each key column in turn, starting from zeros,
+	// gives the same hashes as a record-at-a-time join or aggregate computes
+	void hash (vector <int> &selection, vector <size_t> &hashes);
+
+	// the type of the result
+	MyDB_AttTypePtr getType ();
+
+private:
+
+	MyDB_BatchNodePtr compileHelper (MyDB_CompNodePtr compileMe);
+	MyDB_BatchNodePtr fromData (MyDB_CompNodePtr findMe);
+	MyDB_BatchNodePtr castTo (MyDB_BatchNodePtr castMe, MyDB_ValueTag toMe);
+	MyDB_BatchNodePtr arith (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs);
+	MyDB_BatchNodePtr compare (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs);
+	MyDB_BatchNodePtr compareCodes (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs);
+	MyDB_BatchNodePtr logical (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs);
+
+	MyDB_Column &run (MyDB_BatchNodePtr node, vector <int> &selection);
+	void filterHelper (MyDB_BatchNodePtr node, vector <int> &selection);
+	void runMask (MyDB_BatchNodePtr node, vector <int> &selection);
+
+	MyDB_Batch &myBatch;
+	MyDB_BatchNodePtr root;
+};
+
+#endif
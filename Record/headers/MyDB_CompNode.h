@@ -0,0 +1,96 @@
+
+#ifndef COMP_NODE_H
+#define COMP_NODE_H
+
+#include "MyDB_AttType.h"
+#include "MyDB_Schema.h"
+#include "MyDB_Value.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for parsed computations
+class MyDB_CompNode;
+typedef shared_ptr <MyDB_CompNode> MyDB_CompNodePtr;
+
+// this is a computation over a record (written in the language that is described at
+// MyDB_Record :: compileComputation) that has been parsed, but not yet compiled.  It is
+// what everything that runs computations works from: MyDB_Record compiles it into
+// lambdas, MyDB_BatchComputation into loops over columns, and MyDB_ZoneMap into page
+// filters.  So a computation can be parsed once (or built directly, without ever being
+// written out as a string, as the SQL layer does) and then compiled many times over
+class MyDB_CompNode : public enable_shared_from_this <MyDB_CompNode> {
+
+public:
+
+	// parses a computation string
+	static MyDB_CompNodePtr parse (string parseMe);
+	static vector <MyDB_CompNodePtr> parse (vector <string> parseUs);
+
+	// build computations directly; op is one of the operations in the language ("+",
+	// "!=", "um", and so on), and there is one input for "!" and "um", any number of
+	// inputs for "in" (a value, followed by the constants that it is checked against),
+	// and two otherwise ("like" takes a string and a constant pattern)
+	static MyDB_CompNodePtr makeOp (string op, vector <MyDB_CompNodePtr> inputs);
+	static MyDB_CompNodePtr makeAtt (string attName);
+	static MyDB_CompNodePtr makeConstant (MyDB_Value val, MyDB_AttTypePtr type);
+
+	// the canonical text of the computation; it parses back into the same computation,
+	// and two computations with the same text always compute the same value
+	string toString ();
+
+	// looks up each of the attributes in the computation in the schema, and remembers
+	// where each was found, so that compiling the computation over a record with this
+	// schema does not need to search for them by name
+	void resolve (MyDB_SchemaPtr inMe);
+
+	// for an attribute: its position and type in the schema; the position that was found
+	// by resolve is used if it is right for this schema, and otherwise it is searched for
+	pair <int, MyDB_AttTypePtr> findAtt (MyDB_SchemaPtr inMe);
+
+	// returns a copy of the computation with each attribute renamed
+	MyDB_CompNodePtr renameAtts (function <string (string)> rename);
+
+	// returns the computation with each || of equality checks of the same value against
+	// different constants (such as "a = 1 OR a = 7 OR a = 12") turned into an "in", which
+	// is done with a single lookup; the computation itself is left as it was
+	MyDB_CompNodePtr findInLists ();
+
+	// the reverse, for an "in": the || of an equality check with each of the constants
+	MyDB_CompNodePtr expandInList ();
+
+	// what sort of step this is
+	bool isAtt () {return op == "[]";}
+	bool isConstant () {return op == "";}
+
+	// the operation ("+", "!=", "um", and so on), or "[]" for an attribute, or "" for a constant
+	string op;
+
+	// the inputs to the operation
+	vector <MyDB_CompNodePtr> inputs;
+
+	// for an attribute: its name, and the position and type found by resolve (if any)
+	string attName;
+	int attIndex;
+	MyDB_AttTypePtr attType;
+
+	// for a constant: its value and its type; a string value points into constStr
+	MyDB_Value constVal;
+	shared_ptr <string> constStr;
+	MyDB_AttTypePtr constType;
+
+	// the text of the computation, as returned by toString
+	string key;
+
+	MyDB_CompNode () : attIndex (-1) {}
+
+private:
+
+	static MyDB_CompNodePtr parseHelper (char * &vals);
+	static char *findsymbol (char val, char *input);
+};
+
+#endif
@@ -0,0 +1,76 @@
+
+#ifndef COMPILED_PLAN_H
+#define COMPILED_PLAN_H
+
+#include "MyDB_CompNode.h"
+#include "MyDB_InList.h"
+#include "MyDB_LikePattern.h"
+#include "MyDB_Schema.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for compiled plans
+class MyDB_CompiledPlan;
+typedef shared_ptr <MyDB_CompiledPlan> MyDB_CompiledPlanPtr;
+
+// everything about compiling a group of computations over records with a given schema that
+// does not depend on which record they are compiled over: the computations themselves, parsed,
+// with their constants folded and their in lists found, how many times each subexpression is
+// used, and the set up of each in and like (which can be costly for a long list, or for a
+// dictionary coded attribute).  Plans are cached by the schema and the text of the
+// computations, so an operator that compiles the same computations as the last query did,
+// or that compiles them over a second record, gets the plan that is already there, and
+// MyDB_Record only has to build the lambdas that read the record.  A plan does not change
+// once it is built, except that the set up of an in or a like is filled in the first time
+// that it is asked for
+class MyDB_CompiledPlan {
+
+public:
+
+	// finds the plan for the given computations over records with the given schema, building
+	// it if it is not in the cache
+	static MyDB_CompiledPlanPtr get (MyDB_SchemaPtr schema, vector <string> computations);
+	static MyDB_CompiledPlanPtr get (MyDB_SchemaPtr schema, vector <MyDB_CompNodePtr> computations);
+
+	// how many plans have been built, and how many times one was found in the cache
+	static int getNumBuilt ();
+	static int getNumHits ();
+
+	// empties the cache
+	static void clear ();
+
+	// builds a plan; get should be used instead, so that the plan is cached
+	MyDB_CompiledPlan (MyDB_SchemaPtr schema, vector <MyDB_CompNodePtr> computations);
+
+	// the computations, ready to be compiled, in the order they were given
+	vector <MyDB_CompNodePtr> &getComputations ();
+
+	// how many times the subexpression with the given key is used over all of the computations
+	int getUses (const string &key);
+
+	// the set up of the in or the like with the given key; the first time it is asked for,
+	// it is built by makeMe
+	MyDB_InListPtr getInList (const string &key, function <MyDB_InListPtr ()> makeMe);
+	MyDB_LikePatternPtr getLike (const string &key, function <MyDB_LikePatternPtr ()> makeMe);
+
+private:
+
+	// this is kept so that any dictionaries in the schema (whose addresses are part of the
+	// key in the cache) stay around for as long as the plan does
+	MyDB_SchemaPtr schema;
+
+	vector <MyDB_CompNodePtr> computations;
+	map <string, int> uses;
+
+	mutex setUpLock;
+	map <string, MyDB_InListPtr> inLists;
+	map <string, MyDB_LikePatternPtr> likes;
+};
+
+#endif
@@ -0,0 +1,77 @@
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <memory>
+#include "MyDB_StringView.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for dictionaries
+class MyDB_Dictionary;
+typedef shared_ptr <MyDB_Dictionary> MyDB_DictionaryPtr;
+
+// this maps each of the distinct values of a low-cardinality string attribute to a
+// small integer code.  When it is built from a set of values, the codes are given
+// out in sorted order, so that comparing two codes is the same as comparing the two
+// strings.  Values that are added later get new codes at the end, which may break
+// that ordering; isOrdered () tells us whether it still holds.  A dictionary that is
+// attached to an attribute type always has at least one value, since code 0 is the
+// value of an attribute that has not been set.  Codes are stored in records as
+// unsigned ints, so a dictionary can keep growing as new values are appended
+class MyDB_Dictionary {
+
+public:
+
+	// build a dictionary over the given values (which need not be sorted or unique)
+	MyDB_Dictionary (vector <string> values);
+
+	// returns the code for the given string, or -1 if it is not in the dictionary
+	int getCode (const string &forMe);
+
+	// returns the code for the given string, adding it if it is not there
+	int getOrAddCode (const string &forMe);
+
+	// get the string with the given code
+	inline const string &getString (int code) {
+		return values[code];
+	}
+
+	// get the hash of the string with the given code; this is exactly the hash
+	// that a MyDB_StringAttVal holding the same string would produce
+	inline size_t getHash (int code) {
+		return hashes[code];
+	}
+
+	// the number of codes given out
+	inline int size () {
+		return (int) values.size ();
+	}
+
+	// true if code order is the same as string order
+	inline bool isOrdered () {
+		return ordered;
+	}
+
+	// the number of strings in the dictionary that are < (respectively <=) the given
+	// one... only meaningful if the dictionary is ordered
+	int countLess (const string &thanMe);
+	int countLessOrEqual (const string &thanMe);
+
+	// converts the dictionary to and from a list of strings that can be stored in the
+	// catalog (which cannot hold empty strings or the '#' character in a string list)
+	vector <string> toCatalogList ();
+	static MyDB_DictionaryPtr fromCatalogList (vector <string> &fromMe);
+
+private:
+
+	vector <string> values;
+	vector <size_t> hashes;
+	unordered_map <string, int> codes;
+	bool ordered;
+};
+
+#endif
@@ -0,0 +1,105 @@
+
+#ifndef IN_LIST_H
+#define IN_LIST_H
+
+#include "MyDB_AttType.h"
+#include "MyDB_Dictionary.h"
+#include "MyDB_Value.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for in lists
+class MyDB_InList;
+typedef shared_ptr <MyDB_InList> MyDB_InListPtr;
+
+// the list of constants of an "in" (see MyDB_CompNode), set up so that checking whether a
+// value is in the list takes one lookup, rather than one comparison per constant.  The value
+// is compared with the constants exactly as an == would compare them: as ints if both sides
+// are ints, then as doubles, then as bools, and otherwise as strings.  A short list is kept
+// sorted and searched directly; a long one is put into a hash set
+class MyDB_InList {
+
+public:
+
+	// builds the list for a value of type valueType; each constant comes with its type
+	MyDB_InList (MyDB_AttTypePtr valueType, vector <pair <MyDB_Value, MyDB_AttTypePtr>> constants);
+
+	// how the value is compared with the constants
+	MyDB_ValueTag getTag () {
+		return tag;
+	}
+
+	// these check a value that has already been converted to the right type
+	inline bool containsInt (int checkMe) {
+		if (!useSet) {
+			for (int i : ints)
+				if (i == checkMe)
+					return true;
+			return false;
+		}
+		return intSet.count (checkMe) > 0;
+	}
+
+	inline bool containsDouble (double checkMe) {
+		if (!useSet) {
+			for (double d : doubles)
+				if (d == checkMe)
+					return true;
+			return false;
+		}
+		return doubleSet.count (checkMe) > 0;
+	}
+
+	inline bool containsBool (bool checkMe) {
+		return checkMe ? hasTrue : hasFalse;
+	}
+
+	inline bool containsString (MyDB_StringView checkMe) {
+		if (!useSet)
+			return binary_search (views.begin (), views.end (), checkMe);
+		return stringSet.count (checkMe) > 0;
+	}
+
+	// for a value that is dictionary coded: whether each of the codes that the dictionary
+	// had when the list was built is in the list is looked up ahead of time
+	inline bool containsCode (MyDB_Dictionary *dictIn, int code) {
+		if (dictIn == dict && code < (int) codes.size ())
+			return codes[code] != 0;
+		return containsString (MyDB_StringView (dictIn->getString (code)));
+	}
+
+	// checks any value, converting it as needed
+	bool contains (const MyDB_Value &checkMe);
+
+private:
+
+	struct ViewHash {
+		size_t operator () (const MyDB_StringView &hashMe) const {
+			return hashMe.hash ();
+		}
+	};
+
+	MyDB_ValueTag tag;
+	bool useSet;
+
+	vector <int> ints;
+	vector <double> doubles;
+	bool hasTrue;
+	bool hasFalse;
+	vector <string> strings;
+	vector <MyDB_StringView> views;
+
+	unordered_set <int> intSet;
+	unordered_set <double> doubleSet;
+	unordered_set <MyDB_StringView, ViewHash> stringSet;
+
+	MyDB_Dictionary *dict;
+	vector <char> codes;
+};
+
+#endif
@@ -0,0 +1,124 @@
+
+#ifndef JOIN_HASH_TABLE_H
+#define JOIN_HASH_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// the hash table that a join builds over the records of its smaller input.  Each distinct
+// hash of the join keys has one entry, which holds the hash and where the list of its
+// records starts and ends; the records themselves stay where they are, on pinned pages, and
+// the lists are kept as indexes into two arrays (the records, in the order they were added,
+// and the next record with the same hash), so adding a record whose hash is already there
+// takes the same time however many records have that hash.  The entries are kept in one
+// flat array with open addressing (linear probing), rather than in a map: a lookup is one
+// jump into the array, and then a walk along it, over entries that are next to each other
+// in RAM.  The entries are kept in "robin hood" order: along a walk, an entry is never
+// further from its own position than the one before it was from its own, plus one.  So a
+// lookup of a hash that is not there stops as soon as it reaches an entry that is closer to
+// home than it would be, instead of going on to the next empty entry.  The hashes are
+// expected to be mixed well in their low bits (see MyDB_Value :: combineHashes), which are
+// used as the position in the array
+class MyDB_JoinHashTable {
+
+public:
+
+	MyDB_JoinHashTable ();
+
+	// gets ready for about numRecs records, so that the table does not grow as they are added
+	void reserve (size_t numRecs);
+
+	// adds the record at rec, whose hash is hashVal
+	inline void insert (size_t hashVal, void *rec) {
+		uint32_t which = recs.size ();
+		recs.push_back (rec);
+		nextRec.push_back (NO_REC);
+
+		// if the hash is there already, the record goes at the end of its list
+		size_t pos = hashVal & mask;
+		for (size_t dist = 0; entries[pos].first != NO_REC && ((pos - entries[pos].hashVal) & mask) >= dist; dist++) {
+			if (entries[pos].hashVal == hashVal) {
+				nextRec[entries[pos].last] = which;
+				entries[pos].last = which;
+				return;
+			}
+			pos = (pos + 1) & mask;
+		}
+
+		// otherwise, it gets an entry of its own
+		if (2 * (numEntries + 1) > entries.size ())
+			grow ();
+		place ({hashVal, which, which});
+	}
+
+	// calls forEach on each record whose hash is hashVal, in the order they were added
+	template <class F>
+	inline void probe (size_t hashVal, F forEach) {
+		size_t pos = hashVal & mask;
+		for (size_t dist = 0; entries[pos].first != NO_REC && ((pos - entries[pos].hashVal) & mask) >= dist; dist++) {
+			if (entries[pos].hashVal == hashVal) {
+				for (uint32_t i = entries[pos].first; i != NO_REC; i = nextRec[i])
+					forEach (recs[i]);
+				return;
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	// the number of records in the table
+	size_t size ();
+
+	// removes everything, and gives back the RAM
+	void clear ();
+
+private:
+
+	// marks the end of a list, and an empty entry
+	enum : uint32_t {NO_REC = 0xFFFFFFFF};
+
+	// a hash, and the first and last of its records
+	struct Entry {
+		size_t hashVal;
+		uint32_t first;
+		uint32_t last;
+	};
+
+	// puts the entry for a hash that is not in the table yet into the array
+	inline void place (Entry placeMe) {
+		size_t pos = placeMe.hashVal & mask;
+		size_t dist = 0;
+		while (entries[pos].first != NO_REC) {
+
+			// if the entry here is closer to its own position than this one is, this one
+			// takes its place, and it is moved along instead
+			size_t theirDist = (pos - entries[pos].hashVal) & mask;
+			if (theirDist < dist) {
+				swap (placeMe, entries[pos]);
+				dist = theirDist;
+			}
+			pos = (pos + 1) & mask;
+			dist++;
+		}
+		entries[pos] = placeMe;
+		numEntries++;
+	}
+
+	// doubles the size of the array, and puts the entries back in
+	void grow ();
+
+	// the array, whose size is always a power of two; it is never more than half full, so a
+	// walk along it always stops at an empty entry
+	vector <Entry> entries;
+	size_t mask;
+	size_t numEntries;
+
+	// the records, and for each one, the next record with the same hash
+	vector <void *> recs;
+	vector <uint32_t> nextRec;
+};
+
+#endif
@@ -0,0 +1,114 @@
+
+#ifndef LIKE_PATTERN_H
+#define LIKE_PATTERN_H
+
+#include "MyDB_AttType.h"
+#include "MyDB_Dictionary.h"
+#include "MyDB_StringView.h"
+#include "MyDB_Value.h"
+#include <memory>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for like patterns
+class MyDB_LikePattern;
+typedef shared_ptr <MyDB_LikePattern> MyDB_LikePatternPtr;
+
+// the different shapes of pattern that are checked without the general matcher
+enum MyDB_LikeKind {LikeAll, LikeExact, LikePrefix, LikeSuffix, LikeContains, LikeGeneral};
+
+// the pattern of a "like" (see MyDB_CompNode): a % matches any number of characters, and
+// an _ matches any one character.  The patterns that come up all the time ('abc', 'abc%',
+// '%abc' and '%abc%') are checked directly against the characters of the string, with a
+// memcmp or a memchr-driven search, and anything else is matched one piece (between the
+// %s) at a time.  Nothing is ever copied out of the string being checked
+class MyDB_LikePattern {
+
+public:
+
+	// sets up the pattern for a value of type valueType (which may be null if the type
+	// is not known); if that is dictionary coded, every code is checked right now
+	MyDB_LikePattern (string pattern, MyDB_AttTypePtr valueType);
+
+	// the shape of the pattern, and the text that it looks for if it is not LikeGeneral
+	MyDB_LikeKind getKind () {
+		return kind;
+	}
+
+	string &getLiteral () {
+		return literal;
+	}
+
+	inline bool matches (MyDB_StringView checkMe) {
+		size_t n = literal.size ();
+		switch (kind) {
+		case LikeAll:
+			return true;
+		case LikeExact:
+			return checkMe.len == n && memcmp (checkMe.data, literal.data (), n) == 0;
+		case LikePrefix:
+			return checkMe.len >= n && memcmp (checkMe.data, literal.data (), n) == 0;
+		case LikeSuffix:
+			return checkMe.len >= n && memcmp (checkMe.data + checkMe.len - n, literal.data (), n) == 0;
+		case LikeContains:
+			return find (checkMe.data, checkMe.len, literal.data (), n) != nullptr;
+		default:
+			return matchesGeneral (checkMe);
+		}
+	}
+
+	// for a value that is dictionary coded, the answer for each code that the dictionary had
+	// when the pattern was set up is looked up ahead of time
+	inline bool matchesCode (MyDB_Dictionary *dictIn, int code) {
+		if (dictIn == dict && code < (int) codes.size ())
+			return codes[code] != 0;
+		return matches (MyDB_StringView (dictIn->getString (code)));
+	}
+
+	// checks any value, converting it to a string as needed
+	bool matches (const MyDB_Value &checkMe);
+
+	// finds the first place that needle appears in hay (or returns null); memchr looks for
+	// the first character of the needle, many bytes at a time, and only then are the rest
+	// of the characters compared
+	static inline const char *find (const char *hay, size_t hayLen, const char *needle, size_t needleLen) {
+		if (needleLen == 0)
+			return hay;
+		if (hayLen < needleLen)
+			return nullptr;
+		const char *last = hay + hayLen - needleLen;
+		char first = needle[0];
+		char final = needle[needleLen - 1];
+		for (const char *pos = hay; pos <= last; pos++) {
+			pos = (const char *) memchr (pos, first, last - pos + 1);
+			if (pos == nullptr)
+				return nullptr;
+			if (pos[needleLen - 1] == final && memcmp (pos + 1, needle + 1, needleLen - 1) == 0)
+				return pos;
+		}
+		return nullptr;
+	}
+
+private:
+
+	MyDB_LikeKind kind;
+	string literal;
+
+	// for LikeGeneral: the pieces between the %s, and whether there is a % at either end
+	vector <string> pieces;
+	vector <bool> hasWildcard;
+	bool anyStart;
+	bool anyEnd;
+
+	MyDB_Dictionary *dict;
+	vector <char> codes;
+
+	bool matchesGeneral (MyDB_StringView checkMe);
+	const char *findPiece (const char *hay, size_t hayLen, int whichPiece);
+	bool pieceAt (const char *here, int whichPiece);
+};
+
+#endif
@@ -0,0 +1,83 @@
+
+#ifndef NATIVE_COMPUTATION_H
+#define NATIVE_COMPUTATION_H
+
+#include "MyDB_CompNode.h"
+#include "MyDB_Record.h"
+#include "MyDB_Schema.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for native computations
+class MyDB_NativeComputation;
+typedef shared_ptr <MyDB_NativeComputation> MyDB_NativeComputationPtr;
+
+// this is a selection predicate along with a set of projections (written in the same language,
+// and following the same typing rules, as the computations compiled by MyDB_Record) that has
+// been turned into C++, compiled with the system compiler, and loaded with dlopen.  The code
+// that is generated reads the attributes straight out of a record in its binary form: the
+// offset of every attribute that comes before the first variable-length one is a constant,
+// and the rest are found by hopping over the length of each attribute before them.
+//
+// Compiling takes a good fraction of a second, so this only pays off for a long scan.  Each
+// module is named after the hash of its code and kept (both in memory and on disk) so a
+// query that is run again does not need to be compiled again
+class MyDB_NativeComputation {
+
+public:
+
+	// builds the native code; this returns nullptr if some part of the predicate or the
+	// projections cannot be done natively (for example, a string concatenation, or a
+	// dictionary-coded attribute inside of a computation), or if the compiler could not
+	// be run... in which case the computations should simply be interpreted
+	static MyDB_NativeComputationPtr compile (MyDB_SchemaPtr inputSchema, MyDB_CompNodePtr predicate,
+		vector <MyDB_CompNodePtr> projections);
+
+	// runs the predicate over a record in its binary form (as given by getCurrentPointer on
+	// an iterator); if the record is accepted, the projections are written into the
+	// attributes of outRec, in order, and true is returned
+	bool run (void *rec, MyDB_RecordPtr outRec);
+
+	// where the generated code and the compiled modules are kept (by default, or if dirIn is
+	// empty, a directory of the user's own under $TMPDIR or /tmp; it is made if it is not there),
+	// and the compiler that is used (by default, $CXX, or c++ if that is not set)
+	static void setCacheDirectory (string dirIn);
+	static void setCompiler (string compilerIn);
+
+	// the number of modules that have been compiled, and the number that were found already
+	// loaded or already on disk, since the program started
+	static int getNumCompiled ();
+	static int getNumCacheHits ();
+
+private:
+
+	// the entry point of a module: returns 1 and fills in one slot per projection if the
+	// record is accepted, and returns 0 otherwise
+	typedef int (*nativeFunc) (const char *rec, long long *ints, double *doubles, const char **strings, int *lens);
+
+	nativeFunc func;
+
+	// for each projection: 'i', 'd', 'b', 's', or 'c' (a dictionary code), saying which slot
+	// its result is in, and for a code, which dictionary it is from
+	vector <char> kinds;
+	vector <MyDB_Dictionary *> dicts;
+
+	// the slots that the module writes its results into
+	vector <long long> ints;
+	vector <double> doubles;
+	vector <const char *> strings;
+	vector <int> lens;
+
+	// builds the C++ expression for a computation, and says what type of value it produces
+	// ('i', 'd', 'b', or 's'); returns false if this cannot be done natively
+	static bool generate (MyDB_CompNodePtr genMe, MyDB_SchemaPtr schema, vector <bool> &needed,
+		string &code, char &type);
+
+	// finds (or compiles) the module for the given code, returning its entry point
+	static nativeFunc load (string &code);
+};
+
+#endif
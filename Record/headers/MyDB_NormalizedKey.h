@@ -0,0 +1,101 @@
+
+#ifndef NORMALIZED_KEY_H
+#define NORMALIZED_KEY_H
+
+#include "MyDB_AttType.h"
+#include "MyDB_Dictionary.h"
+#include "MyDB_Record.h"
+#include "MyDB_Value.h"
+#include <cstring>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// create a smart pointer for normalized keys
+class MyDB_NormalizedKey;
+typedef shared_ptr <MyDB_NormalizedKey> MyDB_NormalizedKeyPtr;
+
+// a record (or anything else that is being sorted), along with its normalized key
+struct MyDB_KeyedPointer {
+	uint64_t key;
+	void *ptr;
+};
+
+// this turns the value of a computation over a record into a normalized key: a 64 bit word
+// whose order as an unsigned integer (which is the memcmp order of its bytes, taken most
+// significant first) is the order of the values.  An int has its sign bit flipped; a double
+// has its sign bit flipped if it is positive, and all of its bits flipped if it is negative;
+// a dictionary coded string whose dictionary is ordered is just its code; and any other string
+// is its first eight characters.  For a descending order, every bit of the key is flipped.
+// Sorting on the keys takes no calls through the comparator, and no records are looked at
+// again; only two strings that start with the same eight characters have to be compared with
+// the comparator, to break the tie
+class MyDB_NormalizedKey {
+
+public:
+
+	// sets up the key of the computation sortOn over whatever record is loaded into rec; this
+	// returns a null pointer if the computation does not give an int, a double, or a string
+	static MyDB_NormalizedKeyPtr build (MyDB_RecordPtr rec, string sortOn, bool descending = false);
+
+	// the key of the record that is in rec right now
+	inline uint64_t getKey () {
+		MyDB_Value val = keyFunc ();
+		uint64_t res;
+		if (keyType == 'i')
+			res = fromInt (val.toInt ());
+		else if (keyType == 'd')
+			res = fromDouble (val.toDouble ());
+		else if (keyType == 'c')
+			res = (uint64_t) val.code;
+		else
+			res = fromString (val.stringVal);
+		return descending ? ~res : res;
+	}
+
+	// true if two values with the same key are always equal, so that a tie does not need to be
+	// broken with the comparator; this is the case for everything but strings that are not coded
+	bool isExact () {
+		return keyType != 's';
+	}
+
+	// sorts the list on the keys, keeping items with the same key in the order that they
+	// were in; this is an MSD radix sort, a byte at a time, that switches to an insertion
+	// sort once there are only a few items left to sort
+	static void sort (vector <MyDB_KeyedPointer> &sortMe);
+
+	// the keys of single values
+	static inline uint64_t fromInt (int fromMe) {
+		return ((uint64_t) ((uint32_t) fromMe ^ 0x80000000u)) << 32;
+	}
+
+	static inline uint64_t fromDouble (double fromMe) {
+		uint64_t bits;
+		memcpy (&bits, &fromMe, sizeof (double));
+		return (bits >> 63) ? ~bits : (bits | (1ull << 63));
+	}
+
+	static inline uint64_t fromString (MyDB_StringView fromMe) {
+		uint64_t res = 0;
+		size_t len = fromMe.len < 8 ? fromMe.len : 8;
+		for (size_t i = 0; i < len; i++)
+			res |= ((uint64_t) (unsigned char) fromMe.data[i]) << (56 - 8 * i);
+		return res;
+	}
+
+	// use build instead
+	MyDB_NormalizedKey (valFunc keyFunc, char keyType, bool descending);
+
+private:
+
+	valFunc keyFunc;
+
+	// 'i' for an int, 'd' for a double, 'c' for a code, and 's' for a string
+	char keyType;
+	bool descending;
+};
+
+#endif
@@ -4,7 +4,12 @@
 
 #include <functional>
 #include "MyDB_AttVal.h"
+#include "MyDB_CompiledPlan.h"
+#include "MyDB_CompNode.h"
+#include "MyDB_InList.h"
+#include "MyDB_LikePattern.h"
 #include "MyDB_Schema.h"
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -18,6 +23,13 @@ typedef shared_ptr <MyDB_Record> MyDB_RecordPtr;
 // a lambda function over the record... computes an attribute value
 typedef function <MyDB_AttValPtr ()> func;
 
+// a lambda function over the record that computes a plain value; this is what the
+// computations are compiled to, and it is what should be used inside of tight loops,
+// since calling it does no allocation, reference counting, or virtual calls.  Note that
+// a string result may point into storage owned by the function, so it is only good
+// until the function is called again or goes away
+typedef function <MyDB_Value ()> valFunc;
+
 class MyDB_Record {
 
 public:
@@ -100,6 +112,34 @@ public:
 	//
 	func compileComputation (string fromMe);
 
+	// just like compileComputation, except that the type of the result is returned as well
+	pair <func, MyDB_AttTypePtr> compileTypedComputation (string fromMe);
+
+	// these are just like the above, except that the function returns a MyDB_Value
+	// rather than a MyDB_AttValPtr... the two above are built on top of these, and copy
+	// each result into an attribute value
+	valFunc compileValueComputation (string fromMe);
+	pair <valFunc, MyDB_AttTypePtr> compileTypedValueComputation (string fromMe);
+
+	// compiles a group of computations over the record at once; this should be used for
+	// all of the computations run by one operator (say, a join's predicate and its output
+	// computations).  Any part of a computation that only involves constants is computed
+	// once, at compile time, and any subexpression that appears more than once in the 
+	// group is only computed once per record, no matter how many of the returned functions
+	// use it.  The results are in the same order as the input strings.  Since whether the
+	// record has changed is checked via the attributes, the group should be compiled after
+	// any call to buildFrom.  All of the work that does not depend on the record itself
+	// (parsing, folding, and so on) is kept in a MyDB_CompiledPlan, which is cached, so
+	// compiling the same group over another record with the same schema only has to build
+	// the lambdas
+	vector <valFunc> compileValueComputations (vector <string> fromUs);
+	vector <pair <valFunc, MyDB_AttTypePtr>> compileTypedValueComputations (vector <string> fromUs);
+
+	// just like the above, except that the computations have already been parsed (or were
+	// built directly; see MyDB_CompNode), so no parsing needs to be done here
+	vector <valFunc> compileValueComputations (vector <MyDB_CompNodePtr> fromUs);
+	vector <pair <valFunc, MyDB_AttTypePtr>> compileTypedValueComputations (vector <MyDB_CompNodePtr> fromUs);
+
 	// builds a function that returns true if lhs < rhs; the comparison is done by running whatever computation is 
 	// encoded by the string "computation" on both lhs and rhs, and then compariing the results obtained using this
 	// computation over both.  If the result from lhs is < the result from rhs, then the function returned from
@@ -109,6 +149,13 @@ public:
 	// used by the method compileComputation above
 	friend function <bool ()> buildRecordComparator (MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs, string computation);
 
+	// the same, except that the records are compared on a list of computations: the first one whose
+	// results differ over lhs and rhs decides, and if its bool is true, the order of its results is
+	// reversed (as for a descending value in an ORDER BY).  If the results of every computation are the
+	// same, the function returns false
+	friend function <bool ()> buildRecordComparator (MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs,
+		vector <pair <MyDB_CompNodePtr, bool>> computations);
+
 	// access the schema
 	MyDB_SchemaPtr &getSchema ();
 
@@ -117,6 +164,9 @@ public:
 
 private:
 
+	// plans are built by folding over a scratch record
+	friend class MyDB_CompiledPlan;
+
 	// for fast reading from a page; the contents of the record are simply copied into this buffer
 	char *buffer;
 
@@ -126,26 +176,41 @@ private:
 	// the amount of data in the record buffer
 	size_t recSize;
 
-	// helper function for the compilation
-	pair <func, MyDB_AttTypePtr> compileHelper (char * &vals);
+	// helper functions for the compilation: fold the constants in a computation, count 
+	// how many times each subexpression is used (these two are used to build a plan), and
+	// then build the lambdas
+	MyDB_CompNodePtr fold (MyDB_CompNodePtr foldMe);
+	void countUses (MyDB_CompNodePtr countMe, map <string, int> &uses);
+	void findAtts (MyDB_CompNodePtr searchMe, vector <int> &atts);
+	pair <valFunc, MyDB_AttTypePtr> compileHelper (MyDB_CompNodePtr compileMe, MyDB_CompiledPlan &plan,
+		map <string, pair <valFunc, MyDB_AttTypePtr>> &shared);
+	vector <pair <valFunc, MyDB_AttTypePtr>> compilePlan (MyDB_CompiledPlanPtr plan);
+	pair <valFunc, MyDB_AttTypePtr> apply (string op, vector <pair <valFunc, MyDB_AttTypePtr>> &inputs);
 
-	// helper function for the compilation
-	char *findsymbol (char val, char *input);
-	
 	// these functions are all used to build up computations over the record
-	pair <func, MyDB_AttTypePtr> fromData (string attName);
-	pair <func, MyDB_AttTypePtr> plus (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> minus (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> times (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> divide (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> gt (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> lt (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> eq (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> neq (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> andd (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> orr (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs);
-	pair <func, MyDB_AttTypePtr> unaryMinus (pair <func, MyDB_AttTypePtr> lhs);
-	pair <func, MyDB_AttTypePtr> nott (pair <func, MyDB_AttTypePtr> lhs);
+	pair <valFunc, MyDB_AttTypePtr> fromData (MyDB_CompNodePtr findMe);
+	pair <valFunc, MyDB_AttTypePtr> fromConstant (MyDB_CompNodePtr constant);
+	pair <valFunc, MyDB_AttTypePtr> plus (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> minus (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> times (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> divide (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> gt (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> lt (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> eq (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> neq (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> andd (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> orr (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+	pair <valFunc, MyDB_AttTypePtr> unaryMinus (pair <valFunc, MyDB_AttTypePtr> lhs);
+	pair <valFunc, MyDB_AttTypePtr> nott (pair <valFunc, MyDB_AttTypePtr> lhs);
+	pair <valFunc, MyDB_AttTypePtr> inList (valFunc lhs, MyDB_InListPtr list);
+	pair <valFunc, MyDB_AttTypePtr> like (valFunc lhs, MyDB_LikePatternPtr pattern);
+	static MyDB_InListPtr makeInList (vector <pair <valFunc, MyDB_AttTypePtr>> &inputs);
+	static MyDB_LikePatternPtr makeLike (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs);
+
+	// if a comparison can be done on dictionary codes instead of on strings, this builds
+	// it into result and returns true; op is one of '=', '!', '<', '>'
+	bool compareCodes (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs, char op, 
+		pair <valFunc, MyDB_AttTypePtr> &result);
 
 	// write the current attribute values into the buffer
 	void writeAttsToBuffer ();
@@ -0,0 +1,57 @@
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// the comparisons that the kernels can do
+enum MyDB_CompareOp {GreaterThan, LessThan, Equal, NotEqual};
+
+// the instruction sets that the kernels can be run with, from slowest to fastest
+enum MyDB_SimdLevel {ScalarLevel, Sse2Level, Avx2Level};
+
+// these compare a column of ints or doubles with another column, or with a constant, and
+// write the result as a bitmask: bit (i % 64) of mask[i / 64] is set if row i passes.  The
+// mask must have room for n bits, rounded up to a whole number of words.  The first time
+// that a kernel is used, cpuid is checked to pick the fastest instruction set that the
+// machine has (AVX2, then SSE2); on other machines, plain loops are used
+class MyDB_SimdKernels {
+
+public:
+
+	// compares lhs[i] with rhs[i] (or with rhs[0], if rhsIsConstant) for each of the n rows
+	static void compareInts (MyDB_CompareOp op, const int *lhs, const int *rhs, bool rhsIsConstant,
+		int n, uint64_t *mask);
+	static void compareDoubles (MyDB_CompareOp op, const double *lhs, const double *rhs, bool rhsIsConstant,
+		int n, uint64_t *mask);
+
+	// combine two masks over n rows, putting the result into the first
+	static void andMasks (uint64_t *intoMe, const uint64_t *other, int n);
+	static void orMasks (uint64_t *intoMe, const uint64_t *other, int n);
+
+	// flips each of the first n bits of the mask
+	static void notMask (uint64_t *flipMe, int n);
+
+	// the number of words in a mask over n rows
+	static inline int numWords (int n) {
+		return (n + 63) / 64;
+	}
+
+	// puts the positions of the set bits in the mask into the selection vector, in order
+	static void maskToSelection (const uint64_t *mask, int n, vector <int> &selection);
+
+	// the best instruction set that this machine supports
+	static MyDB_SimdLevel getBestLevel ();
+
+	// the instruction set that the kernels are using; this can be set to anything up to
+	// the best level (for example, to compare the speed of the different versions)
+	static MyDB_SimdLevel getLevel ();
+	static void setLevel (MyDB_SimdLevel toMe);
+	static string getLevelName (MyDB_SimdLevel forMe);
+};
+
+#endif
@@ -0,0 +1,80 @@
+
+#ifndef STRING_VIEW_H
+#define STRING_VIEW_H
+
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+// this is a string that we do not own: a pointer to its characters, along with its
+// length.  It lets us look at a string that sits in a page or in a record's buffer
+// without copying it into a std :: string.  A view is only good for as long as the
+// thing that it points into is not changed
+struct MyDB_StringView {
+
+	const char *data;
+	size_t len;
+
+	MyDB_StringView () : data (""), len (0) {}
+
+	MyDB_StringView (const char *dataIn, size_t lenIn) : data (dataIn), len (lenIn) {}
+
+	MyDB_StringView (const string &fromMe) : data (fromMe.data ()), len (fromMe.size ()) {}
+
+	inline string toString () const {
+		return string (data, len);
+	}
+
+	// returns < 0, 0, or > 0, exactly like std :: string :: compare
+	inline int compare (const MyDB_StringView &toMe) const {
+		int res = memcmp (data, toMe.data, len < toMe.len ? len : toMe.len);
+		if (res != 0)
+			return res;
+		return (len < toMe.len) ? -1 : (len > toMe.len ? 1 : 0);
+	}
+
+	inline bool operator == (const MyDB_StringView &toMe) const {
+		return len == toMe.len && memcmp (data, toMe.data, len) == 0;
+	}
+
+	inline bool operator != (const MyDB_StringView &toMe) const {
+		return !(*this == toMe);
+	}
+
+	inline bool operator < (const MyDB_StringView &toMe) const {
+		return compare (toMe) < 0;
+	}
+
+	inline bool operator > (const MyDB_StringView &toMe) const {
+		return compare (toMe) > 0;
+	}
+
+	// hashes the characters eight at a time; every string attribute value (no matter
+	// how it is stored) hashes through here, so that equal strings have equal hashes
+	inline size_t hash () const {
+		const uint64_t mult = 0xc6a4a7935bd1e995ULL;
+		uint64_t h = 0x9e3779b97f4a7c15ULL ^ (len * mult);
+		size_t i = 0;
+		for (; i + 8 <= len; i += 8) {
+			uint64_t k;
+			memcpy (&k, data + i, 8);
+			k *= mult;
+			k ^= k >> 47;
+			k *= mult;
+			h ^= k;
+			h *= mult;
+		}
+		uint64_t k = 0;
+		memcpy (&k, data + i, len - i);
+		h ^= k;
+		h *= mult;
+		h ^= h >> 47;
+		h *= mult;
+		h ^= h >> 47;
+		return h;
+	}
+};
+
+#endif
@@ -0,0 +1,175 @@
+
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include "MyDB_Dictionary.h"
+#include "MyDB_StringView.h"
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+// the kinds of values that a computation can produce
+enum MyDB_ValueTag {IntValue, DoubleValue, BoolValue, StringValue};
+
+// this is a single value, as it flows through a compiled computation over a record.
+// Unlike a MyDB_AttVal, it is a plain struct that is passed around by value: there is
+// no allocation, no reference counting, and no virtual call needed to get at it... the
+// tag says which member of the union (or the string view) is meaningful.  A string value
+// does not own its characters; it points into the record's buffer, into a dictionary,
+// or into storage owned by the computation that produced it, so it is only good until
+// the record or the computation changes.  A string that is dictionary coded also
+// carries its dictionary and its code, so that it can be compared and hashed by code
+struct MyDB_Value {
+
+	MyDB_ValueTag tag;
+	int code;
+	union {
+		int intVal;
+		double doubleVal;
+		bool boolVal;
+	};
+	MyDB_StringView stringVal;
+	MyDB_Dictionary *dict;
+
+	static inline MyDB_Value fromInt (int fromMe) {
+		MyDB_Value returnVal (IntValue);
+		returnVal.intVal = fromMe;
+		return returnVal;
+	}
+
+	static inline MyDB_Value fromDouble (double fromMe) {
+		MyDB_Value returnVal (DoubleValue);
+		returnVal.doubleVal = fromMe;
+		return returnVal;
+	}
+
+	static inline MyDB_Value fromBool (bool fromMe) {
+		MyDB_Value returnVal (BoolValue);
+		returnVal.boolVal = fromMe;
+		return returnVal;
+	}
+
+	static inline MyDB_Value fromString (MyDB_StringView fromMe) {
+		MyDB_Value returnVal (StringValue);
+		returnVal.stringVal = fromMe;
+		return returnVal;
+	}
+
+	static inline MyDB_Value fromCode (MyDB_Dictionary *dictIn, int codeIn) {
+		MyDB_Value returnVal (StringValue);
+		returnVal.stringVal = MyDB_StringView (dictIn->getString (codeIn));
+		returnVal.dict = dictIn;
+		returnVal.code = codeIn;
+		return returnVal;
+	}
+
+	MyDB_Value () : tag (IntValue), code (-1), intVal (0), dict (nullptr) {}
+
+	// the conversions follow the same rules as the ones in MyDB_AttVal
+	inline int toInt () const {
+		if (tag == IntValue)
+			return intVal;
+		if (tag == DoubleValue)
+			return (int) doubleVal;
+		cout << "Oops!  Can't convert " << tagName () << " to int";
+		exit (1);
+	}
+
+	inline double toDouble () const {
+		if (tag == DoubleValue)
+			return doubleVal;
+		if (tag == IntValue)
+			return (double) intVal;
+		cout << "Oops!  Can't convert " << tagName () << " to double";
+		exit (1);
+	}
+
+	inline bool toBool () const {
+		if (tag == BoolValue)
+			return boolVal;
+		cout << "Oops!  Can't convert " << tagName () << " to bool";
+		exit (1);
+	}
+
+	string toString () const {
+		if (tag == IntValue)
+			return to_string (intVal);
+		if (tag == DoubleValue)
+			return to_string (doubleVal);
+		if (tag == BoolValue)
+			return boolVal ? "true" : "false";
+		return stringVal.toString ();
+	}
+
+	// like toString, but only fills in spare (and points into it) if this is not a string
+	inline MyDB_StringView toStringView (string &spare) const {
+		if (tag == StringValue)
+			return stringVal;
+		spare = toString ();
+		return MyDB_StringView (spare);
+	}
+
+	// a double that holds an int hashes just as the int does, so that an int and a double that
+	// are == have the same hash; any other double is hashed on all of its bits (it used to be
+	// cut down to an int, so that 2.1 and 2.9 had the same hash)
+	static inline size_t hashDouble (double hashMe) {
+		if (hashMe >= -2147483648.0 && hashMe <= 2147483647.0 && hashMe == (double) (int) hashMe)
+			return std :: hash <int> () ((int) hashMe);
+		uint64_t bits;
+		memcpy (&bits, &hashMe, sizeof (bits));
+		return (size_t) bits;
+	}
+
+	// mixes the hash of one more value into the hash of the values so far (start from zero).
+	// This is the "mum" step of wyhash: both are xored with constants and multiplied out to
+	// 128 bits, and the two halves are xored together.  Unlike an xor of the hashes, the order
+	// matters, so (a, b) and (b, a) hash differently, and two equal values do not cancel out;
+	// also, since every bit of the result depends on every bit of both, the low bits can be
+	// used to index a table even when the values are small ints, which hash to themselves
+	static inline size_t combineHashes (size_t soFar, size_t next) {
+		uint64_t a = (uint64_t) soFar ^ 0xa0761d6478bd642fULL;
+		uint64_t b = (uint64_t) next ^ 0xe7037ed1a0b428dbULL;
+#ifdef __SIZEOF_INT128__
+		unsigned __int128 res = (unsigned __int128) a * b;
+		return (size_t) ((uint64_t) res ^ (uint64_t) (res >> 64));
+#else
+		// no 128-bit type, so multiply the 32-bit halves and add up the four products
+		uint64_t lowLow = (a & 0xffffffffULL) * (b & 0xffffffffULL);
+		uint64_t lowHigh = (a & 0xffffffffULL) * (b >> 32);
+		uint64_t highLow = (a >> 32) * (b & 0xffffffffULL);
+		uint64_t highHigh = (a >> 32) * (b >> 32);
+		uint64_t middle = (lowLow >> 32) + (lowHigh & 0xffffffffULL) + (highLow & 0xffffffffULL);
+		uint64_t low = (middle << 32) | (lowLow & 0xffffffffULL);
+		uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+		return (size_t) (low ^ high);
+#endif
+	}
+
+	// this gives the same hash as the MyDB_AttVal holding the same value would
+	inline size_t hash () const {
+		if (tag == IntValue)
+			return std :: hash <int> () (intVal);
+		if (tag == DoubleValue)
+			return hashDouble (doubleVal);
+		if (tag == BoolValue)
+			return std :: hash <int> () (boolVal);
+		if (dict != nullptr)
+			return dict->getHash (code);
+		return stringVal.hash ();
+	}
+
+private:
+
+	explicit MyDB_Value (MyDB_ValueTag tagIn) : tag (tagIn), code (-1), intVal (0), dict (nullptr) {}
+
+	const char *tagName () const {
+		return tag == IntValue ? "int" : (tag == DoubleValue ? "double" : (tag == BoolValue ? "bool" : "string"));
+	}
+};
+
+#endif
@@ -0,0 +1,162 @@
+
+#ifndef ADAPTIVE_CONJUNCTION_C
+#define ADAPTIVE_CONJUNCTION_C
+
+#include "MyDB_AdaptiveConjunction.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+
+using namespace std;
+
+// one record in this many is timed, since reading the clock costs about as much as a cheap clause
+#define TIME_EVERY 32
+
+// how many records accepts sees between reorderings
+#define REORDER_EVERY 1024
+
+vector <MyDB_CompNodePtr> MyDB_AdaptiveConjunction :: split (MyDB_CompNodePtr predicate) {
+	vector <MyDB_CompNodePtr> res;
+	if (predicate->op == "&&") {
+		for (MyDB_CompNodePtr &in : predicate->inputs) {
+			vector <MyDB_CompNodePtr> more = split (in);
+			res.insert (res.end (), more.begin (), more.end ());
+		}
+	} else if (!(predicate->isConstant () && predicate->constVal.tag == BoolValue && predicate->constVal.boolVal)) {
+		res.push_back (predicate);
+	}
+	return res;
+}
+
+MyDB_AdaptiveConjunction :: MyDB_AdaptiveConjunction (vector <MyDB_CompNodePtr> clausesIn, vector <valFunc> compiled) {
+	for (size_t i = 0; i < clausesIn.size (); i++) {
+		clauses.push_back ({clausesIn[i], compiled[i], nullptr, 0, 0, 0, 0, hasDivision (clausesIn[i])});
+		order.push_back (i);
+	}
+	numSeen = 0;
+}
+
+MyDB_AdaptiveConjunction :: MyDB_AdaptiveConjunction (vector <MyDB_CompNodePtr> clausesIn, MyDB_Batch &overMe) {
+	for (size_t i = 0; i < clausesIn.size (); i++) {
+		clauses.push_back ({clausesIn[i], nullptr, make_shared <MyDB_BatchComputation> (clausesIn[i], overMe), 0, 0, 0, 0, 
+			hasDivision (clausesIn[i])});
+		order.push_back (i);
+	}
+	numSeen = 0;
+}
+
+bool MyDB_AdaptiveConjunction :: accepts () {
+
+	numSeen++;
+	if (numSeen % REORDER_EVERY == 0)
+		reorder ();
+
+	bool timeIt = (numSeen % TIME_EVERY == 0);
+	for (int i : order) {
+		Clause &c = clauses[i];
+		bool passed;
+		if (timeIt) {
+			auto start = chrono :: steady_clock :: now ();
+			passed = c.func ().toBool ();
+			c.nanos += chrono :: duration <double, nano> (chrono :: steady_clock :: now () - start).count ();
+			c.numTimed++;
+		} else {
+			passed = c.func ().toBool ();
+		}
+		c.numRun++;
+		if (!passed)
+			return false;
+		c.numPassed++;
+	}
+	return true;
+}
+
+void MyDB_AdaptiveConjunction :: filter (vector <int> &selection) {
+
+	for (int i : order) {
+		if (selection.empty ())
+			break;
+		Clause &c = clauses[i];
+		double before = selection.size ();
+		auto start = chrono :: steady_clock :: now ();
+		c.batchComp->filter (selection);
+		c.nanos += chrono :: duration <double, nano> (chrono :: steady_clock :: now () - start).count ();
+		c.numTimed += before;
+		c.numRun += before;
+		c.numPassed += selection.size ();
+	}
+
+	// a batch is big enough to learn from all by itself
+	reorder ();
+}
+
+void MyDB_AdaptiveConjunction :: reorder () {
+
+	// a clause is worth running early if it is cheap, and if it throws out a lot of records;
+	// sorting on the cost per record thrown out puts those first.  The pass rate starts out
+	// at one half, and a clause that has not been timed yet is taken to be free
+	vector <double> rank (clauses.size ());
+	for (size_t i = 0; i < clauses.size (); i++) {
+		Clause &c = clauses[i];
+		double passRate = (c.numPassed + 1) / (c.numRun + 2);
+		double cost = c.numTimed > 0 ? c.nanos / c.numTimed : 0;
+		rank[i] = cost / (1 - passRate);
+	}
+
+	// repeatedly take the best ranked clause that may be run next; a clause with a division
+	// may only be run once every clause before it (in the order the clauses were given in)
+	// has been, and ties go to the clause that was given first
+	vector <bool> placed (clauses.size (), false);
+	for (size_t pos = 0; pos < clauses.size (); pos++) {
+		int best = -1;
+		for (size_t i = 0; i < clauses.size (); i++) {
+			if (placed[i] || (best != -1 && rank[i] >= rank[best]))
+				continue;
+			bool ready = true;
+			for (size_t j = 0; clauses[i].canFault && j < i; j++)
+				ready = ready && placed[j];
+			if (ready)
+				best = i;
+		}
+		placed[best] = true;
+		order[pos] = best;
+	}
+
+	// older observations count for less and less, so that the order follows the data if
+	// it changes part way through the scan; the counts are kept large enough that a
+	// clause that is now run late still has a reasonable estimate
+	for (Clause &c : clauses) {
+		if (c.numRun > 1e6) {
+			c.numRun /= 2;
+			c.numPassed /= 2;
+			c.numTimed /= 2;
+			c.nanos /= 2;
+		}
+	}
+}
+
+bool MyDB_AdaptiveConjunction :: hasDivision (MyDB_CompNodePtr checkMe) {
+	if (checkMe->op == "/")
+		return true;
+	for (MyDB_CompNodePtr &in : checkMe->inputs) {
+		if (hasDivision (in))
+			return true;
+	}
+	return false;
+}
+
+string MyDB_AdaptiveConjunction :: toString () {
+	string res;
+	char temp[64];
+	for (int i : order) {
+		Clause &c = clauses[i];
+		snprintf (temp, 64, " [passed %.1f%%, %.1f ns]", c.numRun > 0 ? 100 * c.numPassed / c.numRun : 100.0,
+			c.numTimed > 0 ? c.nanos / c.numTimed : 0.0);
+		if (res != "")
+			res += " then ";
+		res += c.node->toString () + temp;
+	}
+	return res;
+}
+
+#endif
@@ -52,7 +52,11 @@ void MyDB_BoolAttVal :: set (MyDB_AttValPtr fromMe) {
 }
 
 void MyDB_StringAttVal :: set (MyDB_AttValPtr fromMe) {
-	value = fromMe->toString ();
+
+	// assign, rather than copy a temporary, so that we reuse the space we already have
+	string spare;
+	MyDB_StringView fromView = fromMe->toStringView (spare);
+	value.assign (fromView.data, fromView.len);
 	setNotBuffered ();
 }
 
@@ -71,7 +75,7 @@ size_t MyDB_IntAttVal :: hash () {
 }
 
 size_t MyDB_DoubleAttVal :: hash () {
-	return std :: hash <int> () (toDouble ());
+	return MyDB_Value :: hashDouble (toDouble ());
 }
 
 size_t MyDB_BoolAttVal :: hash () {
@@ -79,7 +83,9 @@ size_t MyDB_BoolAttVal :: hash () {
 }
 
 size_t MyDB_StringAttVal :: hash () {
-	return std :: hash <string> () (toString ());
+	if (!hasCachedHash ())
+		setCachedHash (getView ().hash ());
+	return getCachedHash ();
 }
 
 bool MyDB_IntAttVal :: toBool () {
@@ -102,6 +108,15 @@ void MyDB_IntAttVal :: set (int val) {
 	setNotBuffered ();
 }
 
+MyDB_Value MyDB_IntAttVal :: toValue () {
+	return MyDB_Value :: fromInt (toInt ());
+}
+
+void MyDB_IntAttVal :: fromValue (const MyDB_Value &fromMe) {
+	value = fromMe.toInt ();
+	setNotBuffered ();
+}
+
 MyDB_IntAttVal :: MyDB_IntAttVal () {
 	value = 0;
 	setNotBuffered ();
@@ -163,6 +178,15 @@ void MyDB_DoubleAttVal :: set (double val) {
 	setNotBuffered ();
 }
 
+MyDB_Value MyDB_DoubleAttVal :: toValue () {
+	return MyDB_Value :: fromDouble (toDouble ());
+}
+
+void MyDB_DoubleAttVal :: fromValue (const MyDB_Value &fromMe) {
+	value = fromMe.toDouble ();
+	setNotBuffered ();
+}
+
 MyDB_DoubleAttVal :: MyDB_DoubleAttVal () {
 	value = 0;
 	setNotBuffered ();
@@ -198,7 +222,11 @@ string MyDB_StringAttVal :: toString () {
 	if (dataPtr == nullptr) 
 		return value;
 	else
-		return string ((char *) dataPtr);
+		return getView ().toString ();
+}
+
+MyDB_StringView MyDB_StringAttVal :: toStringView (string &) {
+	return getView ();
 }
 
 bool MyDB_StringAttVal :: toBool () {
@@ -208,14 +236,23 @@ bool MyDB_StringAttVal :: toBool () {
 
 void MyDB_StringAttVal :: serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) {
 
-	string value = toString ();
+	MyDB_StringView myView = getView ();
+	size_t len = myView.len;
 
-	extendBuffer (buffer, allocatedSize, totSize, strlen (value.c_str ()) + 1 + sizeof (short));
+	// we may be sitting in the very buffer that we are writing to, and extending the
+	// buffer frees the old one... so only in that case, take a copy first
+	string copy;
+	if (totSize + len + 1 + sizeof (short) > allocatedSize) {
+		copy.assign (myView.data, len);
+		myView = MyDB_StringView (copy);
+		extendBuffer (buffer, allocatedSize, totSize, len + 1 + sizeof (short));
+	}
 
-	*((short *) (buffer + totSize)) = (short) (sizeof (short) + strlen (value.c_str ()) + 1);
-	totSize += sizeof (short);
-	memcpy (buffer + totSize, value.c_str (), strlen (value.c_str ()) + 1);
-	totSize += strlen (value.c_str ()) + 1;
+	// move the characters first, since they may overlap where the length goes
+	memmove (buffer + totSize + sizeof (short), myView.data, len);
+	*((short *) (buffer + totSize)) = (short) (sizeof (short) + len + 1);
+	totSize += sizeof (short) + len;
+	buffer[totSize++] = 0;
 }
 
 void MyDB_StringAttVal :: set (string val) {
@@ -223,6 +260,17 @@ void MyDB_StringAttVal :: set (string val) {
 	setNotBuffered ();
 }
 
+MyDB_Value MyDB_StringAttVal :: toValue () {
+	return MyDB_Value :: fromString (getView ());
+}
+
+void MyDB_StringAttVal :: fromValue (const MyDB_Value &fromMe) {
+	string spare;
+	MyDB_StringView fromView = fromMe.toStringView (spare);
+	value.assign (fromView.data, fromView.len);
+	setNotBuffered ();
+}
+
 MyDB_StringAttVal :: MyDB_StringAttVal () {
         value = "";
 	setNotBuffered ();
@@ -322,6 +370,15 @@ MyDB_AttValPtr MyDB_BoolAttVal :: getCopy () {
 	return retVal;	
 }
 
+MyDB_Value MyDB_BoolAttVal :: toValue () {
+	return MyDB_Value :: fromBool (toBool ());
+}
+
+void MyDB_BoolAttVal :: fromValue (const MyDB_Value &fromMe) {
+	value = fromMe.toBool ();
+	setNotBuffered ();
+}
+
 MyDB_BoolAttVal :: MyDB_BoolAttVal () {
 	value = false;
 	setNotBuffered ();
@@ -329,4 +386,99 @@ MyDB_BoolAttVal :: MyDB_BoolAttVal () {
 
 MyDB_BoolAttVal :: ~MyDB_BoolAttVal () {}
 
+int MyDB_DictAttVal :: toInt () {
+        cout << "Oops!  Can't convert string to int";
+        exit (1);
+}
+
+double MyDB_DictAttVal :: toDouble () {
+        cout << "Oops!  Can't convert string to double";
+        exit (1);
+}
+
+bool MyDB_DictAttVal :: toBool () {
+        cout << "Oops!  Can't convert string to bool";
+        exit (1);
+}
+
+string MyDB_DictAttVal :: toString () {
+	return myDictionary->getString (getCode ());
+}
+
+void MyDB_DictAttVal :: fromString (string &fromMe) {
+	code = myDictionary->getOrAddCode (fromMe);
+	setNotBuffered ();
+}
+
+void MyDB_DictAttVal :: fromInt (int fromMe) {
+	string temp = to_string (fromMe);
+	fromString (temp);
+}
+
+void MyDB_DictAttVal :: set (MyDB_AttValPtr fromMe) {
+
+	// if the other guy is coded with the same dictionary, we can just copy the code
+	MyDB_DictAttVal *other = dynamic_cast <MyDB_DictAttVal *> (fromMe.get ());
+	if (other != nullptr && other->myDictionary == myDictionary) {
+		code = other->getCode ();
+		setNotBuffered ();
+	} else {
+		string temp = fromMe->toString ();
+		fromString (temp);
+	}
+}
+
+MyDB_Value MyDB_DictAttVal :: toValue () {
+	return MyDB_Value :: fromCode (myDictionary.get (), getCode ());
+}
+
+void MyDB_DictAttVal :: fromValue (const MyDB_Value &fromMe) {
+
+	// just like set: if the value is coded with our dictionary, copy the code
+	if (fromMe.dict == myDictionary.get ()) {
+		code = fromMe.code;
+		setNotBuffered ();
+	} else {
+		string temp = fromMe.toString ();
+		fromString (temp);
+	}
+}
+
+void MyDB_DictAttVal :: setCode (int codeIn) {
+	code = codeIn;
+	setNotBuffered ();
+}
+
+MyDB_StringView MyDB_DictAttVal :: toStringView (string &) {
+	return MyDB_StringView (myDictionary->getString (getCode ()));
+}
+
+size_t MyDB_DictAttVal :: hash () {
+	return myDictionary->getHash (getCode ());
+}
+
+MyDB_AttValPtr MyDB_DictAttVal :: getCopy () {
+	MyDB_DictAttValPtr retVal = make_shared <MyDB_DictAttVal> (myDictionary);
+	retVal->setCode (getCode ());
+	return retVal;	
+}
+
+void MyDB_DictAttVal :: serialize (char *&buffer, size_t &allocatedSize, size_t &totSize) {
+
+	extendBuffer (buffer, allocatedSize, totSize, sizeof (unsigned int) + sizeof (short));
+
+	*((short *) (buffer + totSize)) = (short) (sizeof (short) + sizeof (unsigned int));
+	totSize += sizeof (short);
+	*((unsigned int *) (buffer + totSize)) = (unsigned int) getCode ();
+	totSize += sizeof (unsigned int);
+}
+
+MyDB_DictAttVal :: MyDB_DictAttVal (MyDB_DictionaryPtr myDictionaryIn) {
+	myDictionary = myDictionaryIn;
+	code = 0;
+	setNotBuffered ();
+}
+
+MyDB_DictAttVal :: ~MyDB_DictAttVal () {}
+
 #endif
@@ -0,0 +1,133 @@
+
+#ifndef BATCH_C
+#define BATCH_C
+
+#include "MyDB_Batch.h"
+#include <string.h>
+
+using namespace std;
+
+void MyDB_Column :: setType (MyDB_ValueTag tagIn, MyDB_Dictionary *dictIn) {
+	tag = tagIn;
+	dict = dictIn;
+	if (tag == IntValue || dict != nullptr)
+		ints.resize (BATCH_SIZE);
+	else if (tag == DoubleValue)
+		doubles.resize (BATCH_SIZE);
+	else if (tag == BoolValue)
+		bools.resize (BATCH_SIZE);
+	else
+		strings.resize (BATCH_SIZE);
+}
+
+MyDB_ValueTag MyDB_Batch :: getTag (MyDB_AttTypePtr forMe) {
+	if (forMe->isBool ())
+		return BoolValue;
+	if (forMe->promotableToInt ())
+		return IntValue;
+	if (forMe->promotableToDouble ())
+		return DoubleValue;
+	return StringValue;
+}
+
+MyDB_Batch :: MyDB_Batch (MyDB_SchemaPtr mySchemaIn) {
+
+	mySchema = mySchemaIn;
+	for (auto &a : mySchema->getAtts ()) {
+		MyDB_DictAttTypePtr dictType = dynamic_pointer_cast <MyDB_DictAttType> (a.second);
+		columns.push_back (MyDB_Column ());
+		columns.back ().tag = getTag (a.second);
+		columns.back ().dict = (dictType == nullptr) ? nullptr : dictType->getDictionary ().get ();
+		needed.push_back (false);
+	}
+	lastNeeded = -1;
+	decoded = false;
+	data.reserve (BATCH_SIZE * 64);
+	offsets.reserve (BATCH_SIZE);
+	sources.reserve (BATCH_SIZE);
+}
+
+bool MyDB_Batch :: append (void *fromHere, void *source) {
+
+	size_t offset = data.size ();
+	short recSize = *((short *) fromHere);
+	data.resize (offset + recSize);
+	memcpy (&data[offset], fromHere, recSize);
+	offsets.push_back (offset);
+	sources.push_back (source);
+	decoded = false;
+	return size () >= BATCH_SIZE;
+}
+
+void MyDB_Batch :: clear () {
+	data.clear ();
+	offsets.clear ();
+	sources.clear ();
+	decoded = false;
+}
+
+void MyDB_Batch :: getRecord (int i, MyDB_RecordPtr intoMe) {
+	intoMe->fromBinary (&data[offsets[i]]);
+}
+
+void MyDB_Batch :: needAtt (int whichAtt) {
+	if (!needed[whichAtt]) {
+		needed[whichAtt] = true;
+		columns[whichAtt].setType (columns[whichAtt].tag, columns[whichAtt].dict);
+	}
+	if (whichAtt > lastNeeded)
+		lastNeeded = whichAtt;
+	decoded = false;
+}
+
+MyDB_Column &MyDB_Batch :: getColumn (int whichAtt) {
+	if (!decoded)
+		decode ();
+	return columns[whichAtt];
+}
+
+void MyDB_Batch :: selectAll (vector <int> &selection) {
+	int n = size ();
+	selection.resize (n);
+	for (int i = 0; i < n; i++)
+		selection[i] = i;
+}
+
+MyDB_SchemaPtr &MyDB_Batch :: getSchema () {
+	return mySchema;
+}
+
+void MyDB_Batch :: decode () {
+
+	// walk each record once, pulling out every needed attribute... the fields are not
+	// aligned within a record, so everything is read with a memcpy
+	int n = size ();
+	for (int i = 0; i < n; i++) {
+		char *pos = &data[offsets[i]] + sizeof (short);
+		for (int j = 0; j <= lastNeeded; j++) {
+			short len;
+			memcpy (&len, pos, sizeof (short));
+			if (needed[j]) {
+				MyDB_Column &col = columns[j];
+				char *val = pos + sizeof (short);
+				if (col.dict != nullptr) {
+					unsigned int code;
+					memcpy (&code, val, sizeof (unsigned int));
+					col.ints[i] = code;
+				} else if (col.tag == IntValue) {
+					memcpy (&col.ints[i], val, sizeof (int));
+				} else if (col.tag == DoubleValue) {
+					memcpy (&col.doubles[i], val, sizeof (double));
+				} else if (col.tag == BoolValue) {
+					col.bools[i] = (*val == 1);
+				} else {
+					col.strings[i] = MyDB_StringView (val, len - sizeof (short) - 1);
+				}
+			}
+			pos += len;
+		}
+	}
+	decoded = true;
+}
+
+#endif
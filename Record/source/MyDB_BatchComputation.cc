@@ -0,0 +1,720 @@
+
+#ifndef BATCH_COMPUTATION_C
+#define BATCH_COMPUTATION_C
+
+#include "MyDB_BatchComputation.h"
+#include "MyDB_CompiledPlan.h"
+#include "MyDB_InList.h"
+#include "MyDB_LikePattern.h"
+#include "MyDB_SimdKernels.h"
+#include <functional>
+#include <iostream>
+#include <string.h>
+
+using namespace std;
+
+// the different steps that a batch computation can be made of
+enum MyDB_BatchOp {AttOp, ConstOp, CastOp, PlusOp, MinusOp, TimesOp, DivideOp, NegOp, ConcatOp,
+	GtOp, LtOp, EqOp, NeqOp, CodeEqOp, CodeRangeOp, InOp, LikeOp, AndOp, OrOp, NotOp};
+
+struct MyDB_BatchNode {
+
+	MyDB_BatchOp op;
+
+	// the type of the result, and the type that the inputs are compared as
+	MyDB_AttTypePtr type;
+	MyDB_ValueTag argTag;
+
+	// the inputs
+	MyDB_BatchNodePtr lhs;
+	MyDB_BatchNodePtr rhs;
+
+	// the attribute that is read by an AttOp
+	int whichAtt;
+
+	// the result; strings that are built here are kept in storage
+	MyDB_Column result;
+	vector <string> storage;
+
+	// the rows that the right side of an && or || still needs to be run on
+	vector <int> subSelection;
+
+	// true if this is a comparison of plain int or double columns and constants (or an
+	// &&, || or ! of those), which can be run over the whole batch with the SIMD kernels;
+	// the result is then a bitmask instead of a column
+	bool maskable;
+	vector <uint64_t> mask;
+
+	// for a comparison of dictionary codes with a literal: the code (or bound) of the
+	// literal, how many codes the dictionary had at compile time, and the literal itself
+	// for any codes handed out after that
+	MyDB_Dictionary *dict;
+	int code;
+	int numCodes;
+	bool flag;
+	shared_ptr <string> literal;
+
+	// the constants that an InOp looks the value up in
+	MyDB_InListPtr inList;
+
+	// the pattern that a LikeOp checks its input against
+	MyDB_LikePatternPtr like;
+
+	MyDB_BatchNode (MyDB_BatchOp opIn, MyDB_AttTypePtr typeIn) : op (opIn), type (typeIn), argTag (IntValue),
+		whichAtt (-1), maskable (false), dict (nullptr), code (-1), numCodes (0), flag (false) {
+		if (op != AttOp)
+			result.setType (MyDB_Batch :: getTag (type), nullptr);
+	}
+};
+
+// runs f on every selected row; if every row is selected, this is a plain counted loop,
+// which is what lets the compiler vectorize the body
+template <class F>
+static inline void forSel (vector <int> &selection, int n, F f) {
+	if ((int) selection.size () == n) {
+		for (int i = 0; i < n; i++)
+			f (i);
+	} else {
+		for (int i : selection)
+			f (i);
+	}
+}
+
+static bool isDict (MyDB_BatchNodePtr checkMe) {
+	return dynamic_pointer_cast <MyDB_DictAttType> (checkMe->type) != nullptr;
+}
+
+// see if a comparison (or a combination of comparisons) can be run with the SIMD kernels...
+// only an attribute or a constant (possibly cast to a double) is allowed as an input to a
+// comparison, since the kernels run on every row, and a computation such as a division
+// might not be safe to run on a row that an && was supposed to screen out
+static void checkMaskable (MyDB_BatchNodePtr checkMe) {
+
+	auto isPlain = [] (MyDB_BatchNodePtr input) {
+		if (input->op == CastOp)
+			input = input->lhs;
+		return input->op == AttOp || input->op == ConstOp;
+	};
+
+	if (checkMe->op == AndOp || checkMe->op == OrOp)
+		checkMe->maskable = checkMe->lhs->maskable && checkMe->rhs->maskable;
+	else if (checkMe->op == NotOp)
+		checkMe->maskable = checkMe->lhs->maskable;
+	else if (checkMe->op == GtOp || checkMe->op == LtOp || checkMe->op == EqOp || checkMe->op == NeqOp)
+		checkMe->maskable = (checkMe->argTag == IntValue || checkMe->argTag == DoubleValue) &&
+			isPlain (checkMe->lhs) && isPlain (checkMe->rhs);
+
+	if (checkMe->maskable)
+		checkMe->mask.resize (MyDB_SimdKernels :: numWords (BATCH_SIZE));
+}
+
+MyDB_BatchComputation :: MyDB_BatchComputation (string computation, MyDB_Batch &overMe) : myBatch (overMe) {
+
+	// the plan has the computation already parsed and folded, if it has been compiled before
+	root = compileHelper (MyDB_CompiledPlan :: get (overMe.getSchema (), vector <string> {computation})->getComputations ()[0]);
+}
+
+MyDB_BatchComputation :: MyDB_BatchComputation (MyDB_CompNodePtr computation, MyDB_Batch &overMe) : myBatch (overMe) {
+	root = compileHelper (computation);
+}
+
+MyDB_AttTypePtr MyDB_BatchComputation :: getType () {
+	return root->type;
+}
+
+MyDB_BatchNodePtr MyDB_BatchComputation :: compileHelper (MyDB_CompNodePtr compileMe) {
+
+	if (compileMe->isAtt ())
+		return fromData (compileMe);
+
+	if (compileMe->isConstant ()) {
+		MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (ConstOp, compileMe->constType);
+		MyDB_Value &val = compileMe->constVal;
+		if (val.tag == IntValue) {
+			fill (res->result.ints.begin (), res->result.ints.end (), val.intVal);
+		} else if (val.tag == DoubleValue) {
+			fill (res->result.doubles.begin (), res->result.doubles.end (), val.doubleVal);
+		} else if (val.tag == BoolValue) {
+			fill (res->result.bools.begin (), res->result.bools.end (), val.boolVal);
+		} else {
+			res->literal = compileMe->constStr;
+			fill (res->result.strings.begin (), res->result.strings.end (), MyDB_StringView (*res->literal));
+		}
+		return res;
+	}
+
+	// the list of an in is not a column, but is set up right now
+	if (compileMe->op == "in") {
+		vector <pair <MyDB_Value, MyDB_AttTypePtr>> constants;
+		for (size_t i = 1; i < compileMe->inputs.size (); i++) {
+			if (!compileMe->inputs[i]->isConstant ()) {
+				cout << "The list of an in can only hold constants.\n";
+				exit (1);
+			}
+			constants.push_back (make_pair (compileMe->inputs[i]->constVal, compileMe->inputs[i]->constType));
+		}
+		MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (InOp, make_shared <MyDB_BoolAttType> ());
+		res->lhs = compileHelper (compileMe->inputs[0]);
+		res->inList = make_shared <MyDB_InList> (res->lhs->type, constants);
+		return res;
+	}
+
+	// so is the pattern of a like
+	if (compileMe->op == "like") {
+		MyDB_CompNodePtr pattern = compileMe->inputs[1];
+		if (!pattern->isConstant ()) {
+			cout << "The pattern of a like can only be a constant.\n";
+			exit (1);
+		}
+		MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (LikeOp, make_shared <MyDB_BoolAttType> ());
+		res->lhs = compileHelper (compileMe->inputs[0]);
+		if (!res->lhs->type->promotableToString ()) {
+			cout << "This is bad... cannot do anything with the like.\n";
+			exit (1);
+		}
+		string spare;
+		res->like = make_shared <MyDB_LikePattern> (pattern->constVal.toStringView (spare).toString (), res->lhs->type);
+		return res;
+	}
+
+	MyDB_BatchNodePtr lres = compileHelper (compileMe->inputs[0]);
+	MyDB_BatchNodePtr rres;
+	if (compileMe->inputs.size () == 2)
+		rres = compileHelper (compileMe->inputs[1]);
+
+	// the operations are named by a single character here
+	string &op = compileMe->op;
+	if (op == "!")
+		return logical ('n', lres, rres);
+	if (op == "&&" || op == "||")
+		return logical (op[0], lres, rres);
+	if (op == "!=" || op == "==" || op == ">" || op == "<")
+		return compare (op[0], lres, rres);
+	if (op == "um")
+		return arith ('u', lres, rres);
+	return arith (op[0], lres, rres);
+}
+
+MyDB_BatchNodePtr MyDB_BatchComputation :: fromData (MyDB_CompNodePtr findMe) {
+
+	auto whichAtt = findMe->findAtt (myBatch.getSchema ());
+	myBatch.needAtt (whichAtt.first);
+
+	MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (AttOp, whichAtt.second);
+	res->whichAtt = whichAtt.first;
+	return res;
+}
+
+MyDB_BatchNodePtr MyDB_BatchComputation :: castTo (MyDB_BatchNodePtr castMe, MyDB_ValueTag toMe) {
+
+	// nothing to do if this is already a plain value of the right type
+	if (MyDB_Batch :: getTag (castMe->type) == toMe && !isDict (castMe))
+		return castMe;
+
+	MyDB_AttTypePtr toType;
+	if (toMe == DoubleValue)
+		toType = make_shared <MyDB_DoubleAttType> ();
+	else
+		toType = make_shared <MyDB_StringAttType> ();
+
+	// a constant is just converted right now
+	if (castMe->op == ConstOp && toMe == DoubleValue) {
+		MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (ConstOp, toType);
+		fill (res->result.doubles.begin (), res->result.doubles.end (), (double) castMe->result.ints[0]);
+		return res;
+	}
+
+	MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (CastOp, toType);
+	res->lhs = castMe;
+	if (toMe == StringValue)
+		res->storage.resize (BATCH_SIZE);
+	return res;
+}
+
+MyDB_BatchNodePtr MyDB_BatchComputation :: arith (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs) {
+
+	MyDB_BatchOp whichOp = (op == '+') ? PlusOp : (op == '-') ? MinusOp : (op == '*') ? TimesOp :
+		(op == '/') ? DivideOp : NegOp;
+
+	// if all sides can be cast upwards to be ints, then do so
+	if (lhs->type->promotableToInt () && (rhs == nullptr || rhs->type->promotableToInt ())) {
+		MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (whichOp, make_shared <MyDB_IntAttType> ());
+		res->lhs = lhs;
+		res->rhs = rhs;
+		return res;
+
+	// otherwise, if all sides can be cast upwards to be doubles, then do so
+	} else if (lhs->type->promotableToDouble () && (rhs == nullptr || rhs->type->promotableToDouble ())) {
+		MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (whichOp, make_shared <MyDB_DoubleAttType> ());
+		res->lhs = castTo (lhs, DoubleValue);
+		if (rhs != nullptr)
+			res->rhs = castTo (rhs, DoubleValue);
+		return res;
+
+	// the only thing left is to put two strings together
+	} else if (op == '+' && lhs->type->promotableToString () && rhs->type->promotableToString ()) {
+		MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (ConcatOp, make_shared <MyDB_StringAttType> ());
+		res->lhs = castTo (lhs, StringValue);
+		res->rhs = castTo (rhs, StringValue);
+		res->storage.resize (BATCH_SIZE);
+		return res;
+	}
+
+	string name = (op == '+') ? "plus" : (op == '-') ? "minus" : (op == '*') ? "times" :
+		(op == '/') ? "divide" : "unary minus";
+	cout << "This is bad... cannot do anything with the " << name << ".\n";
+	exit (1);
+}
+
+MyDB_BatchNodePtr MyDB_BatchComputation :: compareCodes (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs) {
+
+	// put the encoded side on the left
+	if (!isDict (lhs)) {
+		swap (lhs, rhs);
+		if (op == '<')
+			op = '>';
+		else if (op == '>')
+			op = '<';
+	}
+
+	if (!isDict (lhs))
+		return nullptr;
+
+	MyDB_DictionaryPtr dict = dynamic_pointer_cast <MyDB_DictAttType> (lhs->type)->getDictionary ();
+	MyDB_BatchNodePtr res;
+
+	// both sides are from the same dictionary, so equality is equality of codes
+	if (isDict (rhs) && (op == '=' || op == '!') &&
+		dynamic_pointer_cast <MyDB_DictAttType> (rhs->type)->getDictionary () == dict) {
+
+		res = make_shared <MyDB_BatchNode> (EqOp, make_shared <MyDB_BoolAttType> ());
+		res->op = (op == '=') ? EqOp : NeqOp;
+		res->argTag = IntValue;
+		res->rhs = rhs;
+
+	// compare with a literal, which we can look up in the dictionary right now
+	} else if (rhs->op == ConstOp && rhs->literal != nullptr && (op == '=' || op == '!' || dict->isOrdered ())) {
+
+		res = make_shared <MyDB_BatchNode> (CodeEqOp, make_shared <MyDB_BoolAttType> ());
+		res->literal = rhs->literal;
+		res->numCodes = dict->size ();
+		if (op == '=' || op == '!') {
+			res->code = dict->getCode (*res->literal);
+			res->flag = (op == '=');
+
+		// for an ordered dictionary, a range check on a literal is a range check on codes
+		} else {
+			res->op = CodeRangeOp;
+			res->flag = (op == '<');
+			res->code = res->flag ? dict->countLess (*res->literal) : dict->countLessOrEqual (*res->literal);
+		}
+
+	} else {
+		return nullptr;
+	}
+
+	res->lhs = lhs;
+	res->dict = dict.get ();
+	checkMaskable (res);
+	return res;
+}
+
+MyDB_BatchNodePtr MyDB_BatchComputation :: compare (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs) {
+
+	// see if we can get away with comparing dictionary codes
+	MyDB_BatchNodePtr res = compareCodes (op, lhs, rhs);
+	if (res != nullptr)
+		return res;
+
+	res = make_shared <MyDB_BatchNode> (op == '>' ? GtOp : op == '<' ? LtOp : op == '=' ? EqOp : NeqOp,
+		make_shared <MyDB_BoolAttType> ());
+
+	if (lhs->type->promotableToInt () && rhs->type->promotableToInt ()) {
+		res->argTag = IntValue;
+	} else if (lhs->type->promotableToDouble () && rhs->type->promotableToDouble ()) {
+		res->argTag = DoubleValue;
+	} else if ((op == '=' || op == '!') && lhs->type->isBool () && rhs->type->isBool ()) {
+		res->argTag = BoolValue;
+	} else if (lhs->type->promotableToString () && rhs->type->promotableToString ()) {
+		res->argTag = StringValue;
+	} else {
+		cout << "This is bad... cannot do anything with the >.\n";
+		exit (1);
+	}
+
+	res->lhs = castTo (lhs, res->argTag);
+	res->rhs = castTo (rhs, res->argTag);
+	checkMaskable (res);
+	return res;
+}
+
+MyDB_BatchNodePtr MyDB_BatchComputation :: logical (char op, MyDB_BatchNodePtr lhs, MyDB_BatchNodePtr rhs) {
+
+	if (!lhs->type->isBool () || (rhs != nullptr && !rhs->type->isBool ())) {
+		if (op == 'n')
+			cout << "This is bad... cannot do not on non boolean.\n";
+		else
+			cout << "This is bad... cannot do or on non booleans.\n";
+		exit (1);
+	}
+
+	MyDB_BatchNodePtr res = make_shared <MyDB_BatchNode> (op == '&' ? AndOp : op == '|' ? OrOp : NotOp,
+		make_shared <MyDB_BoolAttType> ());
+	res->lhs = lhs;
+	res->rhs = rhs;
+	checkMaskable (res);
+	return res;
+}
+
+MyDB_Column &MyDB_BatchComputation :: evaluate (vector <int> &selection) {
+	return run (root, selection);
+}
+
+void MyDB_BatchComputation :: filter (vector <int> &selection) {
+	filterHelper (root, selection);
+}
+
+void MyDB_BatchComputation :: filterHelper (MyDB_BatchNodePtr node, vector <int> &selection) {
+
+	// if every row is still selected, comparisons over plain columns are run with the
+	// SIMD kernels, and the selection is read off of the resulting bitmask
+	int n = myBatch.size ();
+	if (node->maskable && (int) selection.size () == n) {
+		runMask (node, selection);
+		MyDB_SimdKernels :: maskToSelection (node->mask.data (), n, selection);
+		return;
+	}
+
+	// a conjunction just filters twice
+	if (node->op == AndOp) {
+		filterHelper (node->lhs, selection);
+		filterHelper (node->rhs, selection);
+		return;
+	}
+
+	// otherwise, compute the predicate and keep the rows where it is true (without a branch)
+	const char *accepted = run (node, selection).bools.data ();
+	int numKept = 0;
+	for (int i : selection) {
+		selection[numKept] = i;
+		numKept += (accepted[i] != 0);
+	}
+	selection.resize (numKept);
+}
+
+void MyDB_BatchComputation :: runMask (MyDB_BatchNodePtr node, vector <int> &selection) {
+
+	int n = myBatch.size ();
+	uint64_t *mask = node->mask.data ();
+	int numWords = MyDB_SimdKernels :: numWords (n);
+
+	if (node->op == AndOp || node->op == OrOp) {
+		runMask (node->lhs, selection);
+		runMask (node->rhs, selection);
+		copy (node->lhs->mask.begin (), node->lhs->mask.begin () + numWords, mask);
+		if (node->op == AndOp)
+			MyDB_SimdKernels :: andMasks (mask, node->rhs->mask.data (), n);
+		else
+			MyDB_SimdKernels :: orMasks (mask, node->rhs->mask.data (), n);
+		return;
+	}
+
+	if (node->op == NotOp) {
+		runMask (node->lhs, selection);
+		copy (node->lhs->mask.begin (), node->lhs->mask.begin () + numWords, mask);
+		MyDB_SimdKernels :: notMask (mask, n);
+		return;
+	}
+
+	// a comparison; put any constant on the right
+	MyDB_CompareOp op = (node->op == GtOp) ? GreaterThan : (node->op == LtOp) ? LessThan :
+		(node->op == EqOp) ? Equal : NotEqual;
+	MyDB_BatchNodePtr lhs = node->lhs;
+	MyDB_BatchNodePtr rhs = node->rhs;
+	if (lhs->op == ConstOp) {
+		swap (lhs, rhs);
+		if (op == GreaterThan)
+			op = LessThan;
+		else if (op == LessThan)
+			op = GreaterThan;
+	}
+
+	MyDB_Column &l = run (lhs, selection);
+	MyDB_Column &r = run (rhs, selection);
+	bool rhsIsConstant = (rhs->op == ConstOp);
+	if (node->argTag == IntValue)
+		MyDB_SimdKernels :: compareInts (op, l.ints.data (), r.ints.data (), rhsIsConstant, n, mask);
+	else
+		MyDB_SimdKernels :: compareDoubles (op, l.doubles.data (), r.doubles.data (), rhsIsConstant, n, mask);
+}
+
+void MyDB_BatchComputation :: hash (vector <int> &selection, vector <size_t> &hashes) {
+
+	MyDB_Column &col = run (root, selection);
+	int n = myBatch.size ();
+	size_t *out = hashes.data ();
+	if (col.dict != nullptr) {
+		MyDB_Dictionary *dict = col.dict;
+		const int *in = col.ints.data ();
+		forSel (selection, n, [&] (int i) {out[i] = MyDB_Value :: combineHashes (out[i], dict->getHash (in[i]));});
+	} else if (col.tag == IntValue) {
+		const int *in = col.ints.data ();
+		forSel (selection, n, [&] (int i) {out[i] = MyDB_Value :: combineHashes (out[i], std :: hash <int> () (in[i]));});
+	} else if (col.tag == DoubleValue) {
+		const double *in = col.doubles.data ();
+		forSel (selection, n, [&] (int i) {out[i] = MyDB_Value :: combineHashes (out[i], MyDB_Value :: hashDouble (in[i]));});
+	} else if (col.tag == BoolValue) {
+		const char *in = col.bools.data ();
+		forSel (selection, n, [&] (int i) {out[i] = MyDB_Value :: combineHashes (out[i], std :: hash <int> () (in[i] != 0));});
+	} else {
+		const MyDB_StringView *in = col.strings.data ();
+		forSel (selection, n, [&] (int i) {out[i] = MyDB_Value :: combineHashes (out[i], in[i].hash ());});
+	}
+}
+
+MyDB_Column &MyDB_BatchComputation :: run (MyDB_BatchNodePtr node, vector <int> &selection) {
+
+	int n = myBatch.size ();
+	MyDB_Column &res = node->result;
+
+	switch (node->op) {
+
+	case AttOp:
+		return myBatch.getColumn (node->whichAtt);
+
+	case ConstOp:
+		return res;
+
+	case CastOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		if (res.tag == DoubleValue) {
+			const int *in = l.ints.data ();
+			double *out = res.doubles.data ();
+			forSel (selection, n, [&] (int i) {out[i] = (double) in[i];});
+		} else if (l.dict != nullptr) {
+			MyDB_Dictionary *dict = l.dict;
+			forSel (selection, n, [&] (int i) {res.strings[i] = MyDB_StringView (dict->getString (l.ints[i]));});
+		} else {
+			forSel (selection, n, [&] (int i) {
+				node->storage[i] = l.getValue (i).toString ();
+				res.strings[i] = MyDB_StringView (node->storage[i]);});
+		}
+		return res;
+	}
+
+	case PlusOp:
+	case MinusOp:
+	case TimesOp:
+	case DivideOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		MyDB_Column &r = run (node->rhs, selection);
+		if (res.tag == IntValue) {
+			const int *a = l.ints.data (), *b = r.ints.data ();
+			int *out = res.ints.data ();
+			if (node->op == PlusOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] + b[i];});
+			else if (node->op == MinusOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] - b[i];});
+			else if (node->op == TimesOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] * b[i];});
+			else
+				forSel (selection, n, [&] (int i) {out[i] = a[i] / b[i];});
+		} else {
+			const double *a = l.doubles.data (), *b = r.doubles.data ();
+			double *out = res.doubles.data ();
+			if (node->op == PlusOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] + b[i];});
+			else if (node->op == MinusOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] - b[i];});
+			else if (node->op == TimesOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] * b[i];});
+			else
+				forSel (selection, n, [&] (int i) {out[i] = a[i] / b[i];});
+		}
+		return res;
+	}
+
+	case NegOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		if (res.tag == IntValue) {
+			const int *a = l.ints.data ();
+			int *out = res.ints.data ();
+			forSel (selection, n, [&] (int i) {out[i] = -a[i];});
+		} else {
+			const double *a = l.doubles.data ();
+			double *out = res.doubles.data ();
+			forSel (selection, n, [&] (int i) {out[i] = -a[i];});
+		}
+		return res;
+	}
+
+	case ConcatOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		MyDB_Column &r = run (node->rhs, selection);
+		forSel (selection, n, [&] (int i) {
+			string &temp = node->storage[i];
+			temp.assign (l.strings[i].data, l.strings[i].len);
+			temp.append (r.strings[i].data, r.strings[i].len);
+			res.strings[i] = MyDB_StringView (temp);});
+		return res;
+	}
+
+	case GtOp:
+	case LtOp:
+	case EqOp:
+	case NeqOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		MyDB_Column &r = run (node->rhs, selection);
+		char *out = res.bools.data ();
+		MyDB_BatchOp op = node->op;
+		if (node->argTag == IntValue) {
+			const int *a = l.ints.data (), *b = r.ints.data ();
+			if (op == GtOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] > b[i];});
+			else if (op == LtOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] < b[i];});
+			else if (op == EqOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] == b[i];});
+			else
+				forSel (selection, n, [&] (int i) {out[i] = a[i] != b[i];});
+		} else if (node->argTag == DoubleValue) {
+			const double *a = l.doubles.data (), *b = r.doubles.data ();
+			if (op == GtOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] > b[i];});
+			else if (op == LtOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] < b[i];});
+			else if (op == EqOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] == b[i];});
+			else
+				forSel (selection, n, [&] (int i) {out[i] = a[i] != b[i];});
+		} else if (node->argTag == BoolValue) {
+			const char *a = l.bools.data (), *b = r.bools.data ();
+			if (op == EqOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] == b[i];});
+			else
+				forSel (selection, n, [&] (int i) {out[i] = a[i] != b[i];});
+		} else {
+			const MyDB_StringView *a = l.strings.data (), *b = r.strings.data ();
+			if (op == GtOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i].compare (b[i]) > 0;});
+			else if (op == LtOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i].compare (b[i]) < 0;});
+			else if (op == EqOp)
+				forSel (selection, n, [&] (int i) {out[i] = a[i] == b[i];});
+			else
+				forSel (selection, n, [&] (int i) {out[i] = a[i] != b[i];});
+		}
+		return res;
+	}
+
+	case CodeEqOp:
+	case CodeRangeOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		const int *a = l.ints.data ();
+		char *out = res.bools.data ();
+		int code = node->code;
+		bool flag = node->flag;
+		if (node->op == CodeEqOp)
+			forSel (selection, n, [&] (int i) {out[i] = (a[i] == code) == flag;});
+		else if (flag)
+			forSel (selection, n, [&] (int i) {out[i] = a[i] < code;});
+		else
+			forSel (selection, n, [&] (int i) {out[i] = a[i] >= code;});
+
+		// codes handed out after we were compiled are checked by comparing strings
+		if (node->dict->size () > node->numCodes) {
+			MyDB_StringView literal (*node->literal);
+			for (int i : selection) {
+				if (a[i] < node->numCodes)
+					continue;
+				int cmp = MyDB_StringView (node->dict->getString (a[i])).compare (literal);
+				if (node->op == CodeEqOp)
+					out[i] = (cmp == 0) == flag;
+				else
+					out[i] = flag ? cmp < 0 : cmp > 0;
+			}
+		}
+		return res;
+	}
+
+	case InOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		MyDB_InList &list = *node->inList;
+		char *out = res.bools.data ();
+		if (l.dict != nullptr) {
+			MyDB_Dictionary *dict = l.dict;
+			const int *a = l.ints.data ();
+			forSel (selection, n, [&] (int i) {out[i] = list.containsCode (dict, a[i]);});
+		} else if (list.getTag () == IntValue) {
+			const int *a = l.ints.data ();
+			forSel (selection, n, [&] (int i) {out[i] = list.containsInt (a[i]);});
+		} else if (list.getTag () == DoubleValue && l.tag == DoubleValue) {
+			const double *a = l.doubles.data ();
+			forSel (selection, n, [&] (int i) {out[i] = list.containsDouble (a[i]);});
+		} else if (list.getTag () == DoubleValue) {
+			const int *a = l.ints.data ();
+			forSel (selection, n, [&] (int i) {out[i] = list.containsDouble (a[i]);});
+		} else if (list.getTag () == l.tag && l.tag == BoolValue) {
+			const char *a = l.bools.data ();
+			forSel (selection, n, [&] (int i) {out[i] = list.containsBool (a[i] != 0);});
+		} else if (list.getTag () == l.tag) {
+			const MyDB_StringView *a = l.strings.data ();
+			forSel (selection, n, [&] (int i) {out[i] = list.containsString (a[i]);});
+		} else {
+			forSel (selection, n, [&] (int i) {out[i] = list.contains (l.getValue (i));});
+		}
+		return res;
+	}
+
+	case LikeOp: {
+		MyDB_Column &l = run (node->lhs, selection);
+		MyDB_LikePattern &pattern = *node->like;
+		char *out = res.bools.data ();
+		if (l.dict != nullptr) {
+			MyDB_Dictionary *dict = l.dict;
+			const int *a = l.ints.data ();
+			forSel (selection, n, [&] (int i) {out[i] = pattern.matchesCode (dict, a[i]);});
+		} else if (l.tag == StringValue) {
+			const MyDB_StringView *a = l.strings.data ();
+			forSel (selection, n, [&] (int i) {out[i] = pattern.matches (a[i]);});
+		} else {
+			forSel (selection, n, [&] (int i) {out[i] = pattern.matches (l.getValue (i));});
+		}
+		return res;
+	}
+
+	case AndOp:
+	case OrOp: {
+
+		// the right side is only run on the rows where the left side does not decide it
+		const char *a = run (node->lhs, selection).bools.data ();
+		char *out = res.bools.data ();
+		char settles = (node->op == AndOp) ? 0 : 1;
+		vector <int> &rest = node->subSelection;
+		rest.resize (selection.size ());
+		int numLeft = 0;
+		for (int i : selection) {
+			out[i] = a[i];
+			rest[numLeft] = i;
+			numLeft += (a[i] != settles);
+		}
+		rest.resize (numLeft);
+
+		const char *b = run (node->rhs, rest).bools.data ();
+		for (int i : rest)
+			out[i] = b[i];
+		return res;
+	}
+
+	case NotOp: {
+		const char *a = run (node->lhs, selection).bools.data ();
+		char *out = res.bools.data ();
+		forSel (selection, n, [&] (int i) {out[i] = !a[i];});
+		return res;
+	}
+	}
+
+	return res;
+}
+
+#endif
@@ -0,0 +1,356 @@
+
+#ifndef COMP_NODE_C
+#define COMP_NODE_C
+
+#include "MyDB_CompNode.h"
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+
+using namespace std;
+
+char *MyDB_CompNode :: findsymbol (char val, char *input) {
+	while (*input != val) {
+		input++;
+	}
+	return input + 1;
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: parse (string parseMe) {
+	char *str = (char *) parseMe.c_str ();
+	return parseHelper (str);
+}
+
+vector <MyDB_CompNodePtr> MyDB_CompNode :: parse (vector <string> parseUs) {
+	vector <MyDB_CompNodePtr> res;
+	for (string &s : parseUs)
+		res.push_back (parse (s));
+	return res;
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: makeOp (string op, vector <MyDB_CompNodePtr> inputs) {
+	MyDB_CompNodePtr res = make_shared <MyDB_CompNode> ();
+	res->op = op;
+	res->inputs = inputs;
+	res->key = op + " (" + inputs[0]->key;
+	for (size_t i = 1; i < inputs.size (); i++)
+		res->key += ", " + inputs[i]->key;
+	res->key += ")";
+	return res;
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: makeAtt (string attName) {
+	MyDB_CompNodePtr res = make_shared <MyDB_CompNode> ();
+	res->op = "[]";
+	res->attName = attName;
+	res->key = "[" + attName + "]";
+	return res;
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: makeConstant (MyDB_Value val, MyDB_AttTypePtr type) {
+
+	MyDB_CompNodePtr res = make_shared <MyDB_CompNode> ();
+	res->constType = type;
+	if (val.tag == IntValue) {
+		res->constVal = MyDB_Value :: fromInt (val.intVal);
+		res->key = "int[" + to_string (val.intVal) + "]";
+	} else if (val.tag == DoubleValue) {
+		res->constVal = MyDB_Value :: fromDouble (val.doubleVal);
+
+		// written exactly, so that two different doubles never have the same text
+		char text[64];
+		snprintf (text, 64, "%a", val.doubleVal);
+		res->key = "double[" + string (text) + "]";
+	} else if (val.tag == BoolValue) {
+		res->constVal = MyDB_Value :: fromBool (val.boolVal);
+		res->key = val.boolVal ? "bool[true]" : "bool[false]";
+	} else {
+
+		// the string is copied, so that the constant does not depend on whatever the value
+		// pointed into; a string constant is always a literal, whatever type made it
+		string spare;
+		res->constStr = make_shared <string> (val.toStringView (spare).toString ());
+		res->constVal = MyDB_Value :: fromString (MyDB_StringView (*res->constStr));
+		res->constType = make_shared <MyDB_StringLiteralAttType> (*res->constStr);
+		res->key = "string[" + *res->constStr + "]";
+	}
+	return res;
+}
+
+string MyDB_CompNode :: toString () {
+	return key;
+}
+
+void MyDB_CompNode :: resolve (MyDB_SchemaPtr inMe) {
+	if (isAtt ()) {
+		attIndex = -1;
+		int i = 0;
+		for (auto &a : inMe->getAtts ()) {
+			if (a.first == attName) {
+				attIndex = i;
+				attType = a.second;
+				break;
+			}
+			i++;
+		}
+	}
+	for (MyDB_CompNodePtr &in : inputs)
+		in->resolve (inMe);
+}
+
+pair <int, MyDB_AttTypePtr> MyDB_CompNode :: findAtt (MyDB_SchemaPtr inMe) {
+	vector <pair <string, MyDB_AttTypePtr>> &atts = inMe->getAtts ();
+	if (attIndex >= 0 && attIndex < (int) atts.size () && atts[attIndex].first == attName)
+		return make_pair (attIndex, atts[attIndex].second);
+	return inMe->getAttByName (attName);
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: renameAtts (function <string (string)> rename) {
+	if (isConstant ())
+		return shared_from_this ();
+	if (isAtt ())
+		return makeAtt (rename (attName));
+	vector <MyDB_CompNodePtr> newInputs;
+	for (MyDB_CompNodePtr &in : inputs)
+		newInputs.push_back (in->renameAtts (rename));
+	return makeOp (op, newInputs);
+}
+
+// if this is an equality check of a value against a constant (or an in list), puts the value
+// and the constants into the output parameters
+static bool getEqualities (MyDB_CompNodePtr checkMe, MyDB_CompNodePtr &value, vector <MyDB_CompNodePtr> &constants) {
+
+	// the constants of an in list that is merged must all be of the same type
+	if (checkMe->op == "in") {
+		value = checkMe->inputs[0];
+		constants.assign (checkMe->inputs.begin () + 1, checkMe->inputs.end ());
+		for (MyDB_CompNodePtr &c : constants)
+			if (!c->isConstant () || c->constVal.tag != constants[0]->constVal.tag)
+				return false;
+		return true;
+	}
+
+	if (checkMe->op != "==")
+		return false;
+	MyDB_CompNodePtr lhs = checkMe->inputs[0];
+	MyDB_CompNodePtr rhs = checkMe->inputs[1];
+	if (lhs->isConstant ())
+		swap (lhs, rhs);
+
+	// a bool constant is left alone, since "== ([b], bool[true])" is already as cheap as it gets
+	if (lhs->isConstant () || !rhs->isConstant () || rhs->constVal.tag == BoolValue)
+		return false;
+	value = lhs;
+	constants.assign (1, rhs);
+	return true;
+}
+
+// collects the inputs of a run of ||s
+static void getDisjuncts (MyDB_CompNodePtr fromMe, vector <MyDB_CompNodePtr> &disjuncts) {
+	if (fromMe->op == "||") {
+		for (MyDB_CompNodePtr &in : fromMe->inputs)
+			getDisjuncts (in, disjuncts);
+	} else {
+		disjuncts.push_back (fromMe);
+	}
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: findInLists () {
+
+	if (isConstant () || isAtt ())
+		return shared_from_this ();
+
+	if (op != "||") {
+		bool changed = false;
+		vector <MyDB_CompNodePtr> newInputs;
+		for (MyDB_CompNodePtr &in : inputs) {
+			newInputs.push_back (in->findInLists ());
+			changed = changed || newInputs.back () != in;
+		}
+		return changed ? makeOp (op, newInputs) : shared_from_this ();
+	}
+
+	// group the disjuncts that check the same value against constants of the same type;
+	// mixing types is left alone, since how a value is compared depends on both types
+	vector <MyDB_CompNodePtr> disjuncts;
+	getDisjuncts (shared_from_this (), disjuncts);
+	vector <MyDB_CompNodePtr> values;
+	vector <vector <MyDB_CompNodePtr>> lists;
+	vector <MyDB_CompNodePtr> others;
+	vector <int> where;
+	for (MyDB_CompNodePtr &d : disjuncts) {
+		MyDB_CompNodePtr value;
+		vector <MyDB_CompNodePtr> constants;
+		if (!getEqualities (d, value, constants)) {
+			where.push_back (-1 - (int) others.size ());
+			others.push_back (d->findInLists ());
+			continue;
+		}
+		MyDB_ValueTag tag = constants[0]->constVal.tag;
+		size_t i = 0;
+		for (; i < values.size (); i++)
+			if (values[i]->key == value->key && lists[i][0]->constVal.tag == tag)
+				break;
+		if (i == values.size ()) {
+			values.push_back (value);
+			lists.push_back ({});
+			where.push_back (i);
+		}
+		lists[i].insert (lists[i].end (), constants.begin (), constants.end ());
+	}
+
+	// and put the ||s back together, in the same order
+	MyDB_CompNodePtr res;
+	for (int w : where) {
+		MyDB_CompNodePtr next;
+		if (w < 0) {
+			next = others[-1 - w];
+		} else if (lists[w].size () == 1) {
+			next = makeOp ("==", {values[w], lists[w][0]});
+		} else {
+			vector <MyDB_CompNodePtr> in = {values[w]};
+			in.insert (in.end (), lists[w].begin (), lists[w].end ());
+			next = makeOp ("in", in);
+		}
+		res = (res == nullptr) ? next : makeOp ("||", {res, next});
+	}
+	return res->key == key ? shared_from_this () : res;
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: expandInList () {
+	MyDB_CompNodePtr res;
+	for (size_t i = 1; i < inputs.size (); i++) {
+		MyDB_CompNodePtr next = makeOp ("==", {inputs[0], inputs[i]});
+		res = (res == nullptr) ? next : makeOp ("||", {res, next});
+	}
+	return res;
+}
+
+MyDB_CompNodePtr MyDB_CompNode :: parseHelper (char * &vals) {
+
+	// search for one of the infix symbols
+	while (true) {
+
+		if (vals[0] == 0) {
+			cout << "Reached end of string while parsing.\n";
+			exit (1);
+		}
+
+		// see if this is an operation; "!=" must be checked for before "!"
+		string op;
+		if (vals[0] == '!' && vals[1] == '=')
+			op = "!=";
+		else if (vals[0] == '!')
+			op = "!";
+		else if (vals[0] == '|' && vals[1] == '|')
+			op = "||";
+		else if (vals[0] == '+')
+			op = "+";
+		else if (vals[0] == '&' && vals[1] == '&')
+			op = "&&";
+		else if (vals[0] == '=' && vals[1] == '=')
+			op = "==";
+		else if (vals[0] == '>')
+			op = ">";
+		else if (vals[0] == '<')
+			op = "<";
+		else if (vals[0] == '*')
+			op = "*";
+		else if (vals[0] == '/')
+			op = "/";
+		else if (vals[0] == '-')
+			op = "-";
+		else if (vals[0] == 'u' && vals[1] == 'm')
+			op = "um";
+		else if (vals[0] == 'i' && vals[1] == 'n' && (vals[2] == ' ' || vals[2] == '('))
+			op = "in";
+		else if (strncmp (vals, "like", 4) == 0 && (vals[4] == ' ' || vals[4] == '('))
+			op = "like";
+
+		if (op != "") {
+
+			// find the l-paren
+			vals = findsymbol ('(', vals);
+
+			// find the left result
+			vector <MyDB_CompNodePtr> inputs;
+			inputs.push_back (parseHelper (vals));
+
+			// and the comma and the right result, if there is one
+			if (op != "!" && op != "um") {
+				vals = findsymbol (',', vals);
+				inputs.push_back (parseHelper (vals));
+			}
+
+			// an in has as many more as there are commas before the r-paren
+			while (op == "in") {
+				while (*vals == ' ')
+					vals++;
+				if (*vals != ',')
+					break;
+				vals++;
+				inputs.push_back (parseHelper (vals));
+			}
+
+			// find the r-paren
+			vals = findsymbol (')', vals);
+
+			// outta here!
+			return makeOp (op, inputs);
+
+		} else if (vals[0] == '[') {
+
+			// find the right bracket
+			vals++;
+			int cnt = 0;
+			for (; vals[cnt] != ']'; cnt++);
+			string name (vals, cnt);
+
+			// find the ]
+			vals = findsymbol (']', vals);
+			return makeAtt (name);
+
+		} else if (strncmp (vals, "int", 3) == 0) {
+
+			vals = findsymbol ('[', vals);
+			int val = stoi (vals);
+			vals = findsymbol (']', vals);
+			return makeConstant (MyDB_Value :: fromInt (val), make_shared <MyDB_IntAttType> ());
+
+		} else if (strncmp (vals, "double", 6) == 0) {
+
+			vals = findsymbol ('[', vals);
+			double val = stod (vals);
+			vals = findsymbol (']', vals);
+			return makeConstant (MyDB_Value :: fromDouble (val), make_shared <MyDB_DoubleAttType> ());
+
+		} else if (strncmp (vals, "bool", 4) == 0) {
+
+			vals = findsymbol ('[', vals);
+			bool val = false;
+			if (strncmp (vals, "true", 4) == 0) {
+				val = true;
+			}
+			vals = findsymbol (']', vals);
+			return makeConstant (MyDB_Value :: fromBool (val), make_shared <MyDB_BoolAttType> ());
+
+		} else if (strncmp (vals, "string", 6) == 0) {
+
+			vals = findsymbol ('[', vals);
+
+			// find the right bracket
+			int cnt = 0;
+			for (; vals[cnt] != ']'; cnt++);
+			string val (vals, cnt);
+
+			// find the ]
+			vals = findsymbol (']', vals);
+			return makeConstant (MyDB_Value :: fromString (MyDB_StringView (val)), nullptr);
+
+		} else {
+			vals++;
+		}
+	}
+}
+
+#endif
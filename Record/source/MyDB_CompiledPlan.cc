@@ -0,0 +1,131 @@
+
+#ifndef COMPILED_PLAN_C
+#define COMPILED_PLAN_C
+
+#include "MyDB_CompiledPlan.h"
+#include "MyDB_Record.h"
+#include <stdio.h>
+
+using namespace std;
+
+// the cache is emptied once it has this many plans in it
+#define MAX_PLANS 1024
+
+// the plans, by the key made by planKey
+static map <string, MyDB_CompiledPlanPtr> allPlans;
+static mutex planLock;
+static int numBuilt = 0;
+static int numHits = 0;
+
+// two groups of computations get the same plan if their text is the same and they are over
+// records with the same attributes; a dictionary coded attribute is identified by its
+// dictionary, since the set up of an in or a like looks at the codes in the dictionary
+static string planKey (MyDB_SchemaPtr schema, vector <string> &texts) {
+	string res;
+	if (schema != nullptr) {
+		char temp[32];
+		for (auto &a : schema->getAtts ()) {
+			res += a.first + ":" + a.second->toString ();
+			MyDB_DictAttTypePtr dictType = dynamic_pointer_cast <MyDB_DictAttType> (a.second);
+			if (dictType != nullptr) {
+				snprintf (temp, 32, "@%p", (void *) dictType->getDictionary ().get ());
+				res += temp;
+			}
+			res += "|";
+		}
+	}
+	for (string &s : texts)
+		res += "\n" + s;
+	return res;
+}
+
+// looks for a plan with the given key, building it with makeMe if there is none; the plan is
+// built without the lock held, since two threads building the same plan at once is harmless
+static MyDB_CompiledPlanPtr findPlan (string &key, function <MyDB_CompiledPlanPtr ()> makeMe) {
+	{
+		lock_guard <mutex> guard (planLock);
+		auto found = allPlans.find (key);
+		if (found != allPlans.end ()) {
+			numHits++;
+			return found->second;
+		}
+	}
+
+	MyDB_CompiledPlanPtr res = makeMe ();
+	lock_guard <mutex> guard (planLock);
+	if (allPlans.size () >= MAX_PLANS)
+		allPlans.clear ();
+	allPlans[key] = res;
+	numBuilt++;
+	return res;
+}
+
+MyDB_CompiledPlanPtr MyDB_CompiledPlan :: get (MyDB_SchemaPtr schema, vector <string> computations) {
+	string key = planKey (schema, computations);
+	return findPlan (key, [&] {return make_shared <MyDB_CompiledPlan> (schema, MyDB_CompNode :: parse (computations));});
+}
+
+MyDB_CompiledPlanPtr MyDB_CompiledPlan :: get (MyDB_SchemaPtr schema, vector <MyDB_CompNodePtr> computations) {
+	vector <string> texts;
+	for (MyDB_CompNodePtr &c : computations)
+		texts.push_back (c->key);
+	string key = planKey (schema, texts);
+	return findPlan (key, [&] {return make_shared <MyDB_CompiledPlan> (schema, computations);});
+}
+
+int MyDB_CompiledPlan :: getNumBuilt () {
+	lock_guard <mutex> guard (planLock);
+	return numBuilt;
+}
+
+int MyDB_CompiledPlan :: getNumHits () {
+	lock_guard <mutex> guard (planLock);
+	return numHits;
+}
+
+void MyDB_CompiledPlan :: clear () {
+	lock_guard <mutex> guard (planLock);
+	allPlans.clear ();
+}
+
+MyDB_CompiledPlan :: MyDB_CompiledPlan (MyDB_SchemaPtr schemaIn, vector <MyDB_CompNodePtr> computationsIn) {
+
+	schema = schemaIn;
+
+	// fold the constants, and then turn any || of equality checks into an in list (this is
+	// done second, since folding may be what turns the right side of an equality into a constant)
+	MyDB_Record scratch (schema);
+	for (MyDB_CompNodePtr &c : computationsIn)
+		computations.push_back (scratch.fold (c)->findInLists ());
+
+	// find the subexpressions that are used more than once over the whole group
+	for (MyDB_CompNodePtr &c : computations)
+		scratch.countUses (c, uses);
+}
+
+vector <MyDB_CompNodePtr> &MyDB_CompiledPlan :: getComputations () {
+	return computations;
+}
+
+int MyDB_CompiledPlan :: getUses (const string &key) {
+	auto found = uses.find (key);
+	return found == uses.end () ? 0 : found->second;
+}
+
+MyDB_InListPtr MyDB_CompiledPlan :: getInList (const string &key, function <MyDB_InListPtr ()> makeMe) {
+	lock_guard <mutex> guard (setUpLock);
+	MyDB_InListPtr &res = inLists[key];
+	if (res == nullptr)
+		res = makeMe ();
+	return res;
+}
+
+MyDB_LikePatternPtr MyDB_CompiledPlan :: getLike (const string &key, function <MyDB_LikePatternPtr ()> makeMe) {
+	lock_guard <mutex> guard (setUpLock);
+	MyDB_LikePatternPtr &res = likes[key];
+	if (res == nullptr)
+		res = makeMe ();
+	return res;
+}
+
+#endif
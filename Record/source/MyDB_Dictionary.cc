@@ -0,0 +1,97 @@
+
+#ifndef DICTIONARY_C
+#define DICTIONARY_C
+
+#include <algorithm>
+#include <functional>
+#include "MyDB_Dictionary.h"
+
+using namespace std;
+
+MyDB_Dictionary :: MyDB_Dictionary (vector <string> valuesIn) {
+
+	sort (valuesIn.begin (), valuesIn.end ());
+	valuesIn.erase (unique (valuesIn.begin (), valuesIn.end ()), valuesIn.end ());
+
+	ordered = true;
+	for (string &s : valuesIn) {
+		getOrAddCode (s);
+	}
+}
+
+int MyDB_Dictionary :: getCode (const string &forMe) {
+	auto res = codes.find (forMe);
+	if (res == codes.end ())
+		return -1;
+	return res->second;
+}
+
+int MyDB_Dictionary :: getOrAddCode (const string &forMe) {
+
+	int code = getCode (forMe);
+	if (code != -1)
+		return code;
+
+	// new values go at the end, so see if we are still sorted
+	if (!values.empty () && forMe < values.back ())
+		ordered = false;
+
+	code = (int) values.size ();
+	values.push_back (forMe);
+	hashes.push_back (MyDB_StringView (forMe).hash ());
+	codes[forMe] = code;
+	return code;
+}
+
+int MyDB_Dictionary :: countLess (const string &thanMe) {
+	return lower_bound (values.begin (), values.end (), thanMe) - values.begin ();
+}
+
+int MyDB_Dictionary :: countLessOrEqual (const string &thanMe) {
+	return upper_bound (values.begin (), values.end (), thanMe) - values.begin ();
+}
+
+vector <string> MyDB_Dictionary :: toCatalogList () {
+
+	// every entry starts with a '.', so that none are empty; '#' and '\' are escaped
+	vector <string> returnVal;
+	for (string &s : values) {
+		string entry = ".";
+		for (char c : s) {
+			if (c == '#')
+				entry += "\\h";
+			else if (c == '\\')
+				entry += "\\\\";
+			else
+				entry += c;
+		}
+		returnVal.push_back (entry);
+	}
+	return returnVal;
+}
+
+MyDB_DictionaryPtr MyDB_Dictionary :: fromCatalogList (vector <string> &fromMe) {
+
+	vector <string> allVals;
+	for (string &entry : fromMe) {
+		string s = "";
+		for (size_t i = 1; i < entry.size (); i++) {
+			if (entry[i] == '\\' && i + 1 < entry.size ()) {
+				i++;
+				s += (entry[i] == 'h') ? '#' : entry[i];
+			} else {
+				s += entry[i];
+			}
+		}
+		allVals.push_back (s);
+	}
+
+	// put the values back in code order... the constructor would sort them, so add them one at a time
+	MyDB_DictionaryPtr returnVal = make_shared <MyDB_Dictionary> (vector <string> ());
+	for (string &s : allVals) {
+		returnVal->getOrAddCode (s);
+	}
+	return returnVal;
+}
+
+#endif
@@ -0,0 +1,92 @@
+
+#ifndef IN_LIST_C
+#define IN_LIST_C
+
+#include "MyDB_InList.h"
+#include <iostream>
+
+using namespace std;
+
+// lists up to this long are searched directly
+#define SMALL_LIST 8
+
+MyDB_InList :: MyDB_InList (MyDB_AttTypePtr valueType, vector <pair <MyDB_Value, MyDB_AttTypePtr>> constants) {
+
+	// the same promotions as for an ==
+	bool allInt = true, allDouble = true, allBool = true, allString = true;
+	for (auto &c : constants) {
+		allInt = allInt && c.second->promotableToInt ();
+		allDouble = allDouble && c.second->promotableToDouble ();
+		allBool = allBool && c.second->isBool ();
+		allString = allString && c.second->promotableToString ();
+	}
+	if (valueType->promotableToInt () && allInt) {
+		tag = IntValue;
+	} else if (valueType->promotableToDouble () && allDouble) {
+		tag = DoubleValue;
+	} else if (valueType->isBool () && allBool) {
+		tag = BoolValue;
+	} else if (valueType->promotableToString () && allString) {
+		tag = StringValue;
+	} else {
+		cout << "This is bad... cannot do anything with the in.\n";
+		exit (1);
+	}
+
+	hasTrue = hasFalse = false;
+	for (auto &c : constants) {
+		if (tag == IntValue) {
+			ints.push_back (c.first.toInt ());
+		} else if (tag == DoubleValue) {
+			doubles.push_back (c.first.toDouble ());
+		} else if (tag == BoolValue) {
+			hasTrue = hasTrue || c.first.toBool ();
+			hasFalse = hasFalse || !c.first.toBool ();
+		} else {
+			string spare;
+			strings.push_back (c.first.toStringView (spare).toString ());
+		}
+	}
+
+	sort (ints.begin (), ints.end ());
+	ints.erase (unique (ints.begin (), ints.end ()), ints.end ());
+	sort (doubles.begin (), doubles.end ());
+	doubles.erase (unique (doubles.begin (), doubles.end ()), doubles.end ());
+	sort (strings.begin (), strings.end ());
+	strings.erase (unique (strings.begin (), strings.end ()), strings.end ());
+
+	// the views point into strings, which does not change from here on
+	for (string &s : strings)
+		views.push_back (MyDB_StringView (s));
+
+	useSet = (ints.size () > SMALL_LIST || doubles.size () > SMALL_LIST || strings.size () > SMALL_LIST);
+	if (useSet) {
+		intSet.insert (ints.begin (), ints.end ());
+		doubleSet.insert (doubles.begin (), doubles.end ());
+		stringSet.insert (views.begin (), views.end ());
+	}
+
+	dict = nullptr;
+	MyDB_DictAttTypePtr dictType = dynamic_pointer_cast <MyDB_DictAttType> (valueType);
+	if (tag == StringValue && dictType != nullptr) {
+		dict = dictType->getDictionary ().get ();
+		codes.resize (dict->size ());
+		for (int i = 0; i < dict->size (); i++)
+			codes[i] = containsString (MyDB_StringView (dict->getString (i)));
+	}
+}
+
+bool MyDB_InList :: contains (const MyDB_Value &checkMe) {
+	if (tag == IntValue)
+		return containsInt (checkMe.toInt ());
+	if (tag == DoubleValue)
+		return containsDouble (checkMe.toDouble ());
+	if (tag == BoolValue)
+		return containsBool (checkMe.toBool ());
+	if (checkMe.dict != nullptr)
+		return containsCode (checkMe.dict, checkMe.code);
+	string spare;
+	return containsString (checkMe.toStringView (spare));
+}
+
+#endif
@@ -0,0 +1,48 @@
+
+#ifndef JOIN_HASH_TABLE_C
+#define JOIN_HASH_TABLE_C
+
+#include "MyDB_JoinHashTable.h"
+
+using namespace std;
+
+// the size of the array of an empty table
+#define INITIAL_ENTRIES 16
+
+MyDB_JoinHashTable :: MyDB_JoinHashTable () {
+	clear ();
+}
+
+void MyDB_JoinHashTable :: reserve (size_t numRecs) {
+	while (entries.size () < 2 * numRecs)
+		grow ();
+	recs.reserve (numRecs);
+	nextRec.reserve (numRecs);
+}
+
+size_t MyDB_JoinHashTable :: size () {
+	return recs.size ();
+}
+
+void MyDB_JoinHashTable :: clear () {
+	vector <Entry> empty (INITIAL_ENTRIES, {0, NO_REC, NO_REC});
+	entries.swap (empty);
+	mask = INITIAL_ENTRIES - 1;
+	numEntries = 0;
+	vector <void *> ().swap (recs);
+	vector <uint32_t> ().swap (nextRec);
+}
+
+void MyDB_JoinHashTable :: grow () {
+
+	vector <Entry> oldEntries (entries.size () * 2, {0, NO_REC, NO_REC});
+	entries.swap (oldEntries);
+	mask = entries.size () - 1;
+	numEntries = 0;
+	for (auto &e : oldEntries) {
+		if (e.first != NO_REC)
+			place (e);
+	}
+}
+
+#endif
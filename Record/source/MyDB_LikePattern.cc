@@ -0,0 +1,115 @@
+
+#ifndef LIKE_PATTERN_C
+#define LIKE_PATTERN_C
+
+#include "MyDB_LikePattern.h"
+
+using namespace std;
+
+MyDB_LikePattern :: MyDB_LikePattern (string pattern, MyDB_AttTypePtr valueType) {
+
+	// break the pattern up at the %s, leaving out the empty pieces that come from a run of
+	// %s, or from a % at either end
+	anyStart = pattern.size () > 0 && pattern[0] == '%';
+	anyEnd = pattern.size () > 0 && pattern.back () == '%';
+	string piece;
+	for (size_t i = 0; i <= pattern.size (); i++) {
+		if (i < pattern.size () && pattern[i] != '%') {
+			piece += pattern[i];
+		} else if (piece != "") {
+			pieces.push_back (piece);
+			piece = "";
+		}
+	}
+	for (string &p : pieces)
+		hasWildcard.push_back (p.find ('_') != string :: npos);
+
+	// now see if this is one of the shapes that is checked directly
+	bool hasPercent = pattern.find ('%') != string :: npos;
+	bool simple = pieces.size () <= 1 && (pieces.empty () || !hasWildcard[0]);
+	literal = pieces.empty () ? "" : pieces[0];
+	if (!simple)
+		kind = LikeGeneral;
+	else if (!hasPercent)
+		kind = LikeExact;
+	else if (pieces.empty ())
+		kind = LikeAll;
+	else if (anyStart && anyEnd)
+		kind = LikeContains;
+	else if (anyEnd)
+		kind = LikePrefix;
+	else
+		kind = LikeSuffix;
+
+	dict = nullptr;
+	MyDB_DictAttTypePtr dictType = dynamic_pointer_cast <MyDB_DictAttType> (valueType);
+	if (dictType != nullptr) {
+		dict = dictType->getDictionary ().get ();
+		codes.resize (dict->size ());
+		for (int i = 0; i < dict->size (); i++)
+			codes[i] = matches (MyDB_StringView (dict->getString (i)));
+	}
+}
+
+bool MyDB_LikePattern :: matches (const MyDB_Value &checkMe) {
+	if (checkMe.dict != nullptr)
+		return matchesCode (checkMe.dict, checkMe.code);
+	string spare;
+	return matches (checkMe.toStringView (spare));
+}
+
+bool MyDB_LikePattern :: pieceAt (const char *here, int whichPiece) {
+	string &piece = pieces[whichPiece];
+	if (!hasWildcard[whichPiece])
+		return memcmp (here, piece.data (), piece.size ()) == 0;
+	for (size_t i = 0; i < piece.size (); i++)
+		if (piece[i] != '_' && piece[i] != here[i])
+			return false;
+	return true;
+}
+
+const char *MyDB_LikePattern :: findPiece (const char *hay, size_t hayLen, int whichPiece) {
+	string &piece = pieces[whichPiece];
+	if (!hasWildcard[whichPiece])
+		return find (hay, hayLen, piece.data (), piece.size ());
+	for (size_t i = 0; i + piece.size () <= hayLen; i++)
+		if (pieceAt (hay + i, whichPiece))
+			return hay + i;
+	return nullptr;
+}
+
+bool MyDB_LikePattern :: matchesGeneral (MyDB_StringView checkMe) {
+
+	// with no % at all, this is a piece that must cover the whole string
+	const char *pos = checkMe.data;
+	const char *end = checkMe.data + checkMe.len;
+	int first = 0, last = (int) pieces.size () - 1;
+	if (!anyStart && !anyEnd && pieces.size () == 1)
+		return checkMe.len == pieces[0].size () && pieceAt (pos, 0);
+
+	// the pieces that are tied to the start and to the end of the string
+	if (!anyStart) {
+		if ((size_t) (end - pos) < pieces[0].size () || !pieceAt (pos, 0))
+			return false;
+		pos += pieces[0].size ();
+		first++;
+	}
+	if (!anyEnd) {
+		if ((size_t) (end - pos) < pieces[last].size () || !pieceAt (end - pieces[last].size (), last))
+			return false;
+		end -= pieces[last].size ();
+		last--;
+	}
+
+	// each of the others is matched as early as it can be, which leaves the most room for
+	// the ones after it
+	for (int i = first; i <= last; i++) {
+		const char *found = findPiece (pos, end - pos, i);
+		if (found == nullptr)
+			return false;
+		pos = found + pieces[i].size ();
+	}
+	return true;
+}
+
+#endif
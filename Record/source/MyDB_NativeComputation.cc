@@ -0,0 +1,419 @@
+
+#ifndef NATIVE_COMPUTATION_C
+#define NATIVE_COMPUTATION_C
+
+#include "MyDB_LikePattern.h"
+#include "MyDB_NativeComputation.h"
+#include <dlfcn.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// the modules that are loaded, by the hash of their code; the code is kept as well, so that
+// two different pieces of code with the same hash are never mixed up.  Modules are never
+// unloaded, since a string that a module returns may point into it
+static map <size_t, pair <string, void *>> loadedModules;
+static mutex moduleLock;
+
+// by default, modules go in a directory of our own under $TMPDIR (or /tmp), so that they are not
+// left lying around wherever the program happened to be started
+static string defaultCacheDirectory () {
+	const char *tempDir = getenv ("TMPDIR");
+	string dir = (tempDir != nullptr && tempDir[0] != '\0') ? tempDir : "/tmp";
+	return dir + "/myDB_native_" + to_string (getuid ());
+}
+
+static string cacheDirectory = defaultCacheDirectory ();
+static string compiler = (getenv ("CXX") != nullptr ? getenv ("CXX") : "c++");
+static int numCompiled = 0;
+static int numCacheHits = 0;
+
+// this goes at the top of every module
+static const char *preamble =
+	"#include <string.h>\n"
+	"struct Str {const char *data; int len;};\n"
+	"static inline short ld16 (const char *p) {short v; memcpy (&v, p, sizeof (short)); return v;}\n"
+	"static inline int ldInt (const char *p) {int v; memcpy (&v, p, sizeof (int)); return v;}\n"
+	"static inline double ldDouble (const char *p) {double v; memcpy (&v, p, sizeof (double)); return v;}\n"
+	"static inline int cmp (Str l, Str r) {\n"
+	"	int res = memcmp (l.data, r.data, l.len < r.len ? l.len : r.len);\n"
+	"	if (res != 0) return res;\n"
+	"	return (l.len < r.len) ? -1 : (l.len > r.len ? 1 : 0);\n"
+	"}\n"
+	"static inline bool prefix (Str s, Str p) {return s.len >= p.len && memcmp (s.data, p.data, p.len) == 0;}\n"
+	"static inline bool suffix (Str s, Str p) {return s.len >= p.len && memcmp (s.data + s.len - p.len, p.data, p.len) == 0;}\n"
+	"static inline bool contains (Str s, Str p) {\n"
+	"	if (s.len < p.len) return false;\n"
+	"	for (const char *pos = s.data, *last = s.data + s.len - p.len; pos <= last; pos++) {\n"
+	"		pos = (const char *) memchr (pos, p.data[0], last - pos + 1);\n"
+	"		if (pos == 0) return false;\n"
+	"		if (memcmp (pos, p.data, p.len) == 0) return true;\n"
+	"	}\n"
+	"	return false;\n"
+	"}\n";
+
+void MyDB_NativeComputation :: setCacheDirectory (string dirIn) {
+	lock_guard <mutex> guard (moduleLock);
+	cacheDirectory = (dirIn == "") ? defaultCacheDirectory () : dirIn;
+}
+
+void MyDB_NativeComputation :: setCompiler (string compilerIn) {
+	lock_guard <mutex> guard (moduleLock);
+	compiler = compilerIn;
+}
+
+int MyDB_NativeComputation :: getNumCompiled () {
+	return numCompiled;
+}
+
+int MyDB_NativeComputation :: getNumCacheHits () {
+	return numCacheHits;
+}
+
+// the type of an attribute, as far as the generated code is concerned: 'i', 'd', 'b', 's',
+// 'c' for a dictionary code, or 0 for anything else
+static char attKind (MyDB_AttTypePtr type) {
+	if (dynamic_pointer_cast <MyDB_DictAttType> (type) != nullptr)
+		return 'c';
+	if (dynamic_pointer_cast <MyDB_StringAttType> (type) != nullptr)
+		return 's';
+	if (dynamic_pointer_cast <MyDB_IntAttType> (type) != nullptr)
+		return 'i';
+	if (dynamic_pointer_cast <MyDB_DoubleAttType> (type) != nullptr)
+		return 'd';
+	if (dynamic_pointer_cast <MyDB_BoolAttType> (type) != nullptr)
+		return 'b';
+	return 0;
+}
+
+// the bytes that an attribute takes up in a record, or 0 if that varies from record to record
+static int fixedSize (char kind) {
+	if (kind == 'i')
+		return sizeof (short) + sizeof (int);
+	if (kind == 'd')
+		return sizeof (short) + sizeof (double);
+	if (kind == 'b')
+		return sizeof (short) + sizeof (char);
+	if (kind == 'c')
+		return sizeof (short) + sizeof (unsigned int);
+	return 0;
+}
+
+// writes a string as a C++ literal; every character is escaped, so that nothing in it can
+// end the literal early
+static string quote (const string &quoteMe) {
+	string res = "\"";
+	char temp[8];
+	for (unsigned char c : quoteMe) {
+		snprintf (temp, 8, "\\%03o", c);
+		res += temp;
+	}
+	return res + "\"";
+}
+
+bool MyDB_NativeComputation :: generate (MyDB_CompNodePtr genMe, MyDB_SchemaPtr schema, vector <bool> &needed,
+	string &code, char &type) {
+
+	if (genMe->isAtt ()) {
+		pair <int, MyDB_AttTypePtr> att = genMe->findAtt (schema);
+		if (att.first < 0)
+			return false;
+		type = attKind (att.second);
+		string field = "f" + to_string (att.first);
+		needed[att.first] = true;
+		if (type == 'i')
+			code = "ldInt (" + field + " + 2)";
+		else if (type == 'd')
+			code = "ldDouble (" + field + " + 2)";
+		else if (type == 'b')
+			code = "(" + field + "[2] == 1)";
+		else if (type == 's')
+			code = "Str {" + field + " + 2, ld16 (" + field + ") - 3}";
+		else
+			return false;
+		return true;
+	}
+
+	if (genMe->isConstant ()) {
+		MyDB_Value &val = genMe->constVal;
+		if (val.tag == IntValue) {
+			type = 'i';
+			code = "((int) " + to_string ((long long) val.intVal) + "LL)";
+		} else if (val.tag == DoubleValue) {
+
+			// written so that it reads back as exactly the same double
+			char temp[64];
+			snprintf (temp, 64, "%.17g", val.doubleVal);
+			if (string (temp).find_first_of ("ni") != string :: npos)
+				return false;
+			type = 'd';
+			code = "((double) " + string (temp) + ")";
+		} else if (val.tag == BoolValue) {
+			type = 'b';
+			code = val.boolVal ? "true" : "false";
+		} else {
+			type = 's';
+			code = "Str {" + quote (*genMe->constStr) + ", " + to_string (genMe->constStr->size ()) + "}";
+		}
+		return true;
+	}
+
+	// the generated code is a chain of comparisons, which the compiler is good at anyway
+	if (genMe->op == "in")
+		return generate (genMe->expandInList (), schema, needed, code, type);
+
+	vector <string> inCode (genMe->inputs.size ());
+	vector <char> inType (genMe->inputs.size ());
+	for (size_t i = 0; i < genMe->inputs.size (); i++) {
+		if (!generate (genMe->inputs[i], schema, needed, inCode[i], inType[i]))
+			return false;
+	}
+
+	string op = genMe->op;
+
+	// the unary operations
+	if (op == "!") {
+		type = 'b';
+		code = "(!" + inCode[0] + ")";
+		return inType[0] == 'b';
+	}
+	if (op == "um") {
+		type = inType[0];
+		code = "(-" + inCode[0] + ")";
+		return type == 'i' || type == 'd';
+	}
+
+	string lhs = inCode[0], rhs = inCode[1];
+
+	// the shapes of like pattern that are checked directly are written out; anything more
+	// complicated is left to the interpreter
+	if (op == "like") {
+		if (inType[0] != 's' || !genMe->inputs[1]->isConstant () || genMe->inputs[1]->constVal.tag != StringValue)
+			return false;
+		MyDB_LikePattern pattern (*genMe->inputs[1]->constStr, nullptr);
+		string lit = "Str {" + quote (pattern.getLiteral ()) + ", " + to_string (pattern.getLiteral ().size ()) + "}";
+		type = 'b';
+		if (pattern.getKind () == LikeAll)
+			code = "true";
+		else if (pattern.getKind () == LikeExact)
+			code = "(cmp (" + lhs + ", " + lit + ") == 0)";
+		else if (pattern.getKind () == LikePrefix)
+			code = "prefix (" + lhs + ", " + lit + ")";
+		else if (pattern.getKind () == LikeSuffix)
+			code = "suffix (" + lhs + ", " + lit + ")";
+		else if (pattern.getKind () == LikeContains)
+			code = "contains (" + lhs + ", " + lit + ")";
+		else
+			return false;
+		return true;
+	}
+	bool bothInt = inType[0] == 'i' && inType[1] == 'i';
+	bool bothNumeric = (inType[0] == 'i' || inType[0] == 'd') && (inType[1] == 'i' || inType[1] == 'd');
+	bool bothBool = inType[0] == 'b' && inType[1] == 'b';
+	bool bothString = inType[0] == 's' && inType[1] == 's';
+
+	// these follow the order in which MyDB_Record tries to promote the two sides; a string
+	// concatenation, or a comparison that would turn a number or a bool into a string, is
+	// left to the interpreter
+	if (op == "&&" || op == "||") {
+		type = 'b';
+		code = "(" + lhs + " " + op + " " + rhs + ")";
+		return bothBool;
+	}
+
+	bool isCompare = (op == "==" || op == "!=" || op == "<" || op == ">");
+	if (!isCompare && op != "+" && op != "-" && op != "*" && op != "/")
+		return false;
+
+	type = isCompare ? 'b' : (bothInt ? 'i' : 'd');
+	if (bothInt || (bothBool && (op == "==" || op == "!="))) {
+		code = "(" + lhs + " " + op + " " + rhs + ")";
+	} else if (bothNumeric) {
+		code = "((double) " + lhs + " " + op + " (double) " + rhs + ")";
+	} else if (bothString && isCompare) {
+		code = "(cmp (" + lhs + ", " + rhs + ") " + op + " 0)";
+	} else {
+		return false;
+	}
+	return true;
+}
+
+MyDB_NativeComputationPtr MyDB_NativeComputation :: compile (MyDB_SchemaPtr inputSchema, MyDB_CompNodePtr predicate,
+	vector <MyDB_CompNodePtr> projections) {
+
+	vector <pair <string, MyDB_AttTypePtr>> &atts = inputSchema->getAtts ();
+	vector <bool> needed (atts.size (), false);
+	MyDB_NativeComputationPtr res = make_shared <MyDB_NativeComputation> ();
+
+	// the predicate...
+	string predCode;
+	char predType;
+	if (!generate (predicate, inputSchema, needed, predCode, predType) || predType != 'b')
+		return nullptr;
+
+	// ...and the projections, each of which writes its result into its slot
+	stringstream body;
+	for (size_t j = 0; j < projections.size (); j++) {
+
+		// an attribute that is dictionary coded can be copied over as a code
+		string slot = "[" + to_string (j) + "]";
+		pair <int, MyDB_AttTypePtr> att = make_pair (-1, nullptr);
+		if (projections[j]->isAtt ())
+			att = projections[j]->findAtt (inputSchema);
+		if (att.first >= 0 && attKind (att.second) == 'c') {
+			needed[att.first] = true;
+			body << "\tints" << slot << " = ldInt (f" << att.first << " + 2);\n";
+			res->kinds.push_back ('c');
+			res->dicts.push_back (dynamic_pointer_cast <MyDB_DictAttType> (att.second)->getDictionary ().get ());
+			continue;
+		}
+
+		string projCode;
+		char projType;
+		if (!generate (projections[j], inputSchema, needed, projCode, projType))
+			return nullptr;
+		if (projType == 'i' || projType == 'b')
+			body << "\tints" << slot << " = " << projCode << ";\n";
+		else if (projType == 'd')
+			body << "\tdoubles" << slot << " = " << projCode << ";\n";
+		else
+			body << "\t{Str s = " << projCode << "; strings" << slot << " = s.data; lens" << slot << " = s.len;}\n";
+		res->kinds.push_back (projType);
+		res->dicts.push_back (nullptr);
+	}
+
+	// find each attribute that is used; this is where the code is specialized to the layout
+	// of the records... off is how far the next attribute is past p, which is only moved
+	// forward when we hop over an attribute whose length is not known ahead of time
+	stringstream fields;
+	fields << "\tconst char *p = rec + " << sizeof (short) << ";\n";
+	int off = 0;
+	int last = -1;
+	for (size_t i = 0; i < needed.size (); i++)
+		if (needed[i])
+			last = i;
+	for (int i = 0; i <= last; i++) {
+		char kind = attKind (atts[i].second);
+		if (needed[i])
+			fields << "\tconst char *f" << i << " = p + " << off << ";\n";
+		if (i == last)
+			break;
+		if (fixedSize (kind) > 0) {
+			off += fixedSize (kind);
+		} else {
+			fields << "\tp += " << off << ";\n\tp += ld16 (p);\n";
+			off = 0;
+		}
+	}
+
+	string code = string (preamble) +
+		"extern \"C\" int myDB_native (const char *rec, long long *ints, double *doubles, const char **strings, int *lens) {\n" +
+		fields.str () +
+		"\tif (!" + predCode + ")\n\t\treturn 0;\n" +
+		body.str () +
+		"\treturn 1;\n}\n";
+
+	res->func = load (code);
+	if (res->func == nullptr)
+		return nullptr;
+
+	res->ints.resize (projections.size ());
+	res->doubles.resize (projections.size ());
+	res->strings.resize (projections.size ());
+	res->lens.resize (projections.size ());
+	return res;
+}
+
+MyDB_NativeComputation :: nativeFunc MyDB_NativeComputation :: load (string &code) {
+
+	lock_guard <mutex> guard (moduleLock);
+	size_t hash = std :: hash <string> () (code);
+
+	// see if it is already loaded; if some other code has the same hash, we just give up
+	if (loadedModules.count (hash) > 0) {
+		if (loadedModules[hash].first != code)
+			return nullptr;
+		numCacheHits++;
+		return (nativeFunc) dlsym (loadedModules[hash].second, "myDB_native");
+	}
+
+	// make the directory if it is not there; a module is only written or loaded if the directory
+	// is ours, since anyone who can write into it could put their own code there
+	struct stat dirInfo;
+	mkdir (cacheDirectory.c_str (), 0700);
+	if (stat (cacheDirectory.c_str (), &dirInfo) != 0 || !S_ISDIR (dirInfo.st_mode) || dirInfo.st_uid != getuid ())
+		return nullptr;
+
+	char name[64];
+	snprintf (name, 64, "myDB_native_%016zx", hash);
+	string base = cacheDirectory + "/" + name;
+
+	// see if it was compiled earlier (perhaps by an earlier run); the code is kept next to
+	// the module so that we can check that it really is the same code
+	ifstream oldCode (base + ".cc");
+	stringstream oldText;
+	oldText << oldCode.rdbuf ();
+	bool found = oldCode.good () && oldText.str () == code && access ((base + ".so").c_str (), R_OK) == 0;
+
+	if (!found) {
+
+		// compile into a temporary name first, so that a half-written module is never loaded
+		ofstream newCode (base + ".cc");
+		newCode << code;
+		newCode.close ();
+		string temp = base + "." + to_string (getpid ()) + ".so";
+		string command = compiler + " -O2 -fwrapv -shared -fPIC -o " + temp + " " + base + ".cc > /dev/null 2>&1";
+		if (!newCode.good () || system (command.c_str ()) != 0 || rename (temp.c_str (), (base + ".so").c_str ()) != 0) {
+			remove (temp.c_str ());
+			remove ((base + ".cc").c_str ());
+			return nullptr;
+		}
+		numCompiled++;
+	} else {
+		numCacheHits++;
+	}
+
+	// dlopen needs a path with a slash in it, or it searches the library path instead
+	string path = base + ".so";
+	if (path[0] != '/' && path[0] != '.')
+		path = "./" + path;
+	void *handle = dlopen (path.c_str (), RTLD_NOW | RTLD_LOCAL);
+	if (handle == nullptr)
+		return nullptr;
+	nativeFunc res = (nativeFunc) dlsym (handle, "myDB_native");
+	if (res == nullptr)
+		return nullptr;
+	loadedModules[hash] = make_pair (code, handle);
+	return res;
+}
+
+bool MyDB_NativeComputation :: run (void *rec, MyDB_RecordPtr outRec) {
+
+	if (func ((const char *) rec, ints.data (), doubles.data (), strings.data (), lens.data ()) == 0)
+		return false;
+
+	for (size_t j = 0; j < kinds.size (); j++) {
+		MyDB_AttValPtr &att = outRec->getAtt (j);
+		if (kinds[j] == 'i')
+			att->fromValue (MyDB_Value :: fromInt ((int) ints[j]));
+		else if (kinds[j] == 'd')
+			att->fromValue (MyDB_Value :: fromDouble (doubles[j]));
+		else if (kinds[j] == 'b')
+			att->fromValue (MyDB_Value :: fromBool (ints[j] != 0));
+		else if (kinds[j] == 's')
+			att->fromValue (MyDB_Value :: fromString (MyDB_StringView (strings[j], lens[j])));
+		else
+			att->fromValue (MyDB_Value :: fromCode (dicts[j], (int) ints[j]));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,96 @@
+
+#ifndef NORMALIZED_KEY_C
+#define NORMALIZED_KEY_C
+
+#include "MyDB_NormalizedKey.h"
+
+using namespace std;
+
+// a list this short is put in order with an insertion sort
+#define SHORT_LIST 32
+
+MyDB_NormalizedKeyPtr MyDB_NormalizedKey :: build (MyDB_RecordPtr rec, string sortOn, bool descending) {
+
+	pair <valFunc, MyDB_AttTypePtr> res = rec->compileTypedValueComputation (sortOn);
+	MyDB_AttTypePtr type = res.second;
+	char keyType;
+	MyDB_DictAttTypePtr dictType = dynamic_pointer_cast <MyDB_DictAttType> (type);
+	if (type->promotableToInt ())
+		keyType = 'i';
+	else if (type->promotableToDouble ())
+		keyType = 'd';
+	else if (dictType != nullptr && dictType->getDictionary ()->isOrdered ())
+		keyType = 'c';
+	else if (type->promotableToString () && !type->isBool ())
+		keyType = 's';
+	else
+		return nullptr;
+
+	return make_shared <MyDB_NormalizedKey> (res.first, keyType, descending);
+}
+
+MyDB_NormalizedKey :: MyDB_NormalizedKey (valFunc keyFuncIn, char keyTypeIn, bool descendingIn) {
+	keyFunc = keyFuncIn;
+	keyType = keyTypeIn;
+	descending = descendingIn;
+}
+
+static void insertionSort (MyDB_KeyedPointer *sortMe, size_t n) {
+	for (size_t i = 1; i < n; i++) {
+		MyDB_KeyedPointer temp = sortMe[i];
+		size_t j = i;
+		for (; j > 0 && sortMe[j - 1].key > temp.key; j--)
+			sortMe[j] = sortMe[j - 1];
+		sortMe[j] = temp;
+	}
+}
+
+// puts sortMe in order on the given byte of the key and the ones after it; the bytes before
+// it are the same for all of the items
+static void radixSort (MyDB_KeyedPointer *sortMe, MyDB_KeyedPointer *scratch, size_t n, int whichByte) {
+
+	if (whichByte < 0)
+		return;
+	if (n <= SHORT_LIST) {
+		insertionSort (sortMe, n);
+		return;
+	}
+
+	// count how many items go into each bucket; if they all go into the same one, there is
+	// nothing to move on this byte
+	int shift = 8 * whichByte;
+	size_t counts[256] = {0};
+	for (size_t i = 0; i < n; i++)
+		counts[(sortMe[i].key >> shift) & 255]++;
+	if (counts[(sortMe[0].key >> shift) & 255] == n) {
+		radixSort (sortMe, scratch, n, whichByte - 1);
+		return;
+	}
+
+	// move everyone into their buckets, keeping the order within each bucket
+	size_t starts[256], next[256];
+	size_t total = 0;
+	for (int b = 0; b < 256; b++) {
+		starts[b] = next[b] = total;
+		total += counts[b];
+	}
+	for (size_t i = 0; i < n; i++)
+		scratch[next[(sortMe[i].key >> shift) & 255]++] = sortMe[i];
+	memcpy (sortMe, scratch, n * sizeof (MyDB_KeyedPointer));
+
+	// and sort each of the buckets on the rest of the key
+	for (int b = 0; b < 256; b++)
+		if (counts[b] > 1)
+			radixSort (sortMe + starts[b], scratch + starts[b], counts[b], whichByte - 1);
+}
+
+void MyDB_NormalizedKey :: sort (vector <MyDB_KeyedPointer> &sortMe) {
+	if (sortMe.size () <= SHORT_LIST) {
+		insertionSort (sortMe.data (), sortMe.size ());
+		return;
+	}
+	vector <MyDB_KeyedPointer> scratch (sortMe.size ());
+	radixSort (sortMe.data (), scratch.data (), sortMe.size (), 7);
+}
+
+#endif
@@ -4,425 +4,258 @@
 
 #include "MyDB_Record.h"
 #include "MyDB_Schema.h"
+#include <algorithm>
 #include <iostream>
+#include <stdio.h>
 #include <string.h>
 
 using namespace std;
 
-char *MyDB_Record :: findsymbol (char val, char *input) {
-	while (*input != val) {
-		input++;
+// compares two values as strings, without copying either of them if we can help it
+static inline int compareStrings (const MyDB_Value &lhs, const MyDB_Value &rhs) {
+	string lhsSpare, rhsSpare;
+	return lhs.toStringView (lhsSpare).compare (rhs.toStringView (rhsSpare));
+}
+
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: apply (string op, vector <pair <valFunc, MyDB_AttTypePtr>> &inputs) {
+	if (op == "!=") return neq (inputs[0], inputs[1]);
+	if (op == "!") return nott (inputs[0]);
+	if (op == "||") return orr (inputs[0], inputs[1]);
+	if (op == "+") return plus (inputs[0], inputs[1]);
+	if (op == "&&") return andd (inputs[0], inputs[1]);
+	if (op == "==") return eq (inputs[0], inputs[1]);
+	if (op == ">") return gt (inputs[0], inputs[1]);
+	if (op == "<") return lt (inputs[0], inputs[1]);
+	if (op == "*") return times (inputs[0], inputs[1]);
+	if (op == "/") return divide (inputs[0], inputs[1]);
+	if (op == "-") return minus (inputs[0], inputs[1]);
+	if (op == "in") return inList (inputs[0].first, makeInList (inputs));
+	if (op == "like") return like (inputs[0].first, makeLike (inputs[0], inputs[1]));
+	return unaryMinus (inputs[0]);
+}
+
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: fromConstant (MyDB_CompNodePtr constant) {
+
+	// the string (if any) that the value points to goes along with the lambda
+	MyDB_Value val = constant->constVal;
+	shared_ptr <string> keep = constant->constStr;
+	return make_pair ([val, keep] {return val;}, constant->constType);
+}
+
+MyDB_CompNodePtr MyDB_Record :: fold (MyDB_CompNodePtr foldMe) {
+
+	if (foldMe->isConstant () || foldMe->isAtt ())
+		return foldMe;
+
+	// fold the inputs first; if any of them is not a constant, neither are we... the
+	// computation that we were given is left as it was
+	bool allConstant = true;
+	bool changed = false;
+	vector <MyDB_CompNodePtr> newInputs;
+	vector <pair <valFunc, MyDB_AttTypePtr>> inputs;
+	for (MyDB_CompNodePtr &in : foldMe->inputs) {
+		newInputs.push_back (fold (in));
+		changed = changed || newInputs.back () != in;
+		allConstant = allConstant && newInputs.back ()->isConstant ();
+		if (allConstant)
+			inputs.push_back (fromConstant (newInputs.back ()));
 	}
-	return input + 1;
+	MyDB_CompNodePtr res = changed ? MyDB_CompNode :: makeOp (foldMe->op, newInputs) : foldMe;
+	if (!allConstant)
+		return res;
+
+	// a division by zero is left for the record-by-record computation to hit, in
+	// case it never actually gets run (say, because it is on one side of an &&)
+	if (foldMe->op == "/") {
+		MyDB_Value divisor = inputs[1].first ();
+		if ((divisor.tag == IntValue && divisor.intVal == 0) || 
+			(divisor.tag == DoubleValue && divisor.doubleVal == 0))
+			return res;
+	}
+
+	// run the operation once, right now
+	pair <valFunc, MyDB_AttTypePtr> val = apply (foldMe->op, inputs);
+	return MyDB_CompNode :: makeConstant (val.first (), val.second);
 }
 
-func MyDB_Record :: compileComputation (string compileMe) {
-	char *str = (char *) compileMe.c_str ();
-	return compileHelper (str).first;
+void MyDB_Record :: countUses (MyDB_CompNodePtr countMe, map <string, int> &uses) {
+
+	// the inputs of a repeated subexpression are only counted the first time, since
+	// they are not run again when it is shared
+	if (countMe->isConstant () || countMe->isAtt ())
+		return;
+	if (uses[countMe->key]++ > 0)
+		return;
+	for (MyDB_CompNodePtr &in : countMe->inputs)
+		countUses (in, uses);
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: compileHelper(char * &vals) {
-	
-	// search for one of the infix symbols
-	while (true) {
+void MyDB_Record :: findAtts (MyDB_CompNodePtr searchMe, vector <int> &atts) {
+	if (searchMe->isAtt ()) {
+		int whichAtt = searchMe->findAtt (mySchema).first;
+		if (find (atts.begin (), atts.end (), whichAtt) == atts.end ())
+			atts.push_back (whichAtt);
+	}
+	for (MyDB_CompNodePtr &in : searchMe->inputs)
+		findAtts (in, atts);
+}
 
-		if (vals[0] == 0) {
-			cout << "Reached end of string while parsing.\n";
-			exit (1);
-		}
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: compileHelper (MyDB_CompNodePtr compileMe, MyDB_CompiledPlan &plan,
+	map <string, pair <valFunc, MyDB_AttTypePtr>> &shared) {
+
+	if (compileMe->isConstant ())
+		return fromConstant (compileMe);
 
-		// not equal
-		if (vals[0] == '!' && vals[1] == '=') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return neq (lres, rres);
-
-		// not
-		} else if (vals[0] == '!') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the result
-			auto res = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return nott (res);
-			
-		// or
-		} else if (vals[0] == '|' && vals[1] == '|') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return orr (lres, rres);
-
-		// plus
-		} else if (vals[0] == '+') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return plus (lres, rres);
-
-		// and
-		} else if (vals[0] == '&' && vals[1] == '&') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return andd (lres, rres);
-
-		// equals
-		} else if (vals[0] == '=' && vals[1] == '=') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return eq (lres, rres);
-
-		// greater than
-		} else if (vals[0] == '>') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return gt (lres, rres);
-
-		// less than
-		} else if (vals[0] == '<') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return lt (lres, rres);
-
-		// times
-		} else if (vals[0] == '*') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return times (lres, rres);
-
-		// divide
-		} else if (vals[0] == '/') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return divide (lres, rres);
-
-		// minus
-		} else if (vals[0] == '-') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return minus (lres, rres);
-
-		// unary minus
-		} else if (vals[0] == 'u' && vals[1] == 'm') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the result
-			auto res = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return unaryMinus (res);
-
-		// not equal
-		} else if (vals[0] == '!' && vals[1] == '=') {
-
-			// find the l-paren
-			vals = findsymbol ('(', vals);
-
-			// find the left result
-			auto lres = compileHelper (vals);
-			
-			// and the comma
-			vals = findsymbol (',', vals);
-
-			// find the right result
-			auto rres = compileHelper (vals);
-			
-			// find the r-paren
-			vals = findsymbol (')', vals);
-			
-			// outta here!
-			return neq (lres, rres);
-
-		} else if (vals[0] == '[') {
-
-			// find the right bracket
-			vals++;
-			int cnt = 0;
-			for (; vals[cnt] != ']'; cnt++);
-
-			// copy the string over
-			char name[cnt + 1];
-			for (cnt = 0; vals[cnt] != ']'; cnt++) {
-				name[cnt] = vals[cnt];
-			}	
-			name[cnt] = 0;
-
-			// find the ]
-			vals = findsymbol (']', vals);
-	
-			// and get that attribute
-			return fromData (name);		
-
-		} else if (strncmp (vals, "int", 3) == 0) {
-
-			vals = findsymbol ('[', vals);
-			int val = stoi (vals);
-			vals = findsymbol (']', vals);
-
-			// remember this value
-			MyDB_IntAttValPtr temp = make_shared <MyDB_IntAttVal> ();
-			scratch.push_back (temp);
-			temp->set (val);
-
-			// returns a lambda that computes the result
-			return make_pair ([temp] {return temp;}, make_shared <MyDB_IntAttType> ());
-
-		} else if (strncmp (vals, "double", 6) == 0) {
-
-			vals = findsymbol ('[', vals);
-			double val = stod (vals);
-			vals = findsymbol (']', vals);
-
-			// remember this value
-			MyDB_DoubleAttValPtr temp = make_shared <MyDB_DoubleAttVal> ();
-			scratch.push_back (temp);
-			temp->set (val);
-
-			// returns a lambda that computes the result
-			return make_pair ([temp] {return temp;}, make_shared <MyDB_DoubleAttType> ());
-
-		} else if (strncmp (vals, "bool", 4) == 0) {
-
-			vals = findsymbol ('[', vals);
-			bool val = false;
-			if (strncmp (vals, "true", 4) == 0) {
-				val = true;
+	if (compileMe->isAtt ())
+		return fromData (compileMe);
+
+	// see if this is a repeat that was already compiled
+	if (shared.count (compileMe->key) > 0)
+		return shared[compileMe->key];
+
+	// the pattern of a like is looked at once, right now
+	if (compileMe->op == "like" && !compileMe->inputs[1]->isConstant ()) {
+		cout << "The pattern of a like can only be a constant.\n";
+		exit (1);
+	}
+
+	// as is the list of an in
+	if (compileMe->op == "in") {
+		for (size_t i = 1; i < compileMe->inputs.size (); i++) {
+			if (!compileMe->inputs[i]->isConstant ()) {
+				cout << "The list of an in can only hold constants.\n";
+				exit (1);
 			}
-			vals = findsymbol (']', vals);
-
-			// remember this value
-			MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-			scratch.push_back (temp);
-			temp->set (val);
-
-			// returns a lambda that computes the result
-			return make_pair ([temp] {return temp;}, make_shared <MyDB_BoolAttType> ());
-
-		} else if (strncmp (vals, "string", 6) == 0) {
-
-			vals = findsymbol ('[', vals);
-
-			// find the right bracket
-			int cnt = 0;
-			for (; vals[cnt] != ']'; cnt++);
-
-			// copy the string over
-			char name[cnt+1];
-			for (cnt = 0; vals[cnt] != ']'; cnt++) {
-				name[cnt] = vals[cnt];
-			}	
-			name[cnt] = 0;
-
-			// find the ]
-			vals = findsymbol (']', vals);
-	
-			// remember this value
-			MyDB_StringAttValPtr temp = make_shared <MyDB_StringAttVal> ();
-			scratch.push_back (temp);
-			temp->set (name);
-
-			// returns a lambda that computes the result
-			return make_pair ([temp] {return temp;}, make_shared <MyDB_StringAttType> ());
-			
-		} else {
-			vals++;
 		}
 	}
+
+	vector <pair <valFunc, MyDB_AttTypePtr>> inputs;
+	for (MyDB_CompNodePtr &in : compileMe->inputs)
+		inputs.push_back (compileHelper (in, plan, shared));
+
+	// the set up of an in or a like is shared by every record that the plan is compiled over
+	pair <valFunc, MyDB_AttTypePtr> res;
+	if (compileMe->op == "in")
+		res = inList (inputs[0].first, plan.getInList (compileMe->key, [&] {return makeInList (inputs);}));
+	else if (compileMe->op == "like")
+		res = like (inputs[0].first, plan.getLike (compileMe->key, [&] {return makeLike (inputs[0], inputs[1]);}));
+	else
+		res = apply (compileMe->op, inputs);
+
+	if (plan.getUses (compileMe->key) < 2)
+		return res;
+
+	// this subexpression is used more than once, so its result is remembered, along with
+	// the versions of the attributes that it was computed from; it is only run again
+	// once one of those attributes has changed (that is, once there is a new record)
+	vector <int> atts;
+	findAtts (compileMe, atts);
+	shared_ptr <vector <unsigned>> versions = make_shared <vector <unsigned>> (atts.size ());
+	shared_ptr <MyDB_Value> lastVal = make_shared <MyDB_Value> ();
+	shared_ptr <bool> haveVal = make_shared <bool> (false);
+	valFunc f = res.first;
+	res.first = [this, atts, versions, lastVal, haveVal, f] {
+		bool same = *haveVal;
+		for (size_t j = 0; j < atts.size (); j++) {
+			unsigned version = values[atts[j]]->getVersion ();
+			if (version != (*versions)[j]) {
+				(*versions)[j] = version;
+				same = false;
+			}
+		}
+		if (!same) {
+			*lastVal = f ();
+			*haveVal = true;
+		}
+		return *lastVal;
+	};
+	shared[compileMe->key] = res;
+	return res;
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: fromData (string attName) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: fromData (MyDB_CompNodePtr findMe) {
+
+	// find the attribute
+	auto whichAtt = findMe->findAtt (mySchema);
+	int i = whichAtt.first;
+	MyDB_AttVal *att = values[i].get ();
+
+	// when we know what sort of attribute this is, we read it directly: straight out of
+	// the record's buffer if that is where it is, and otherwise with a non-virtual call...
+	// this relies on each slot in the record always holding the same type of attribute,
+	// which is true since the attributes are created from the schema
+	if (dynamic_cast <MyDB_IntAttVal *> (att) != nullptr) {
+		return make_pair ([this, i] {
+			MyDB_IntAttVal *att = static_cast <MyDB_IntAttVal *> (values[i].get ());
+			void *dataPtr = att->getDataPointer ();
+			if (dataPtr != nullptr)
+				return MyDB_Value :: fromInt (*((int *) dataPtr));
+			return att->MyDB_IntAttVal :: toValue ();}, whichAtt.second);
+
+	} else if (dynamic_cast <MyDB_DoubleAttVal *> (att) != nullptr) {
+		return make_pair ([this, i] {
+			MyDB_DoubleAttVal *att = static_cast <MyDB_DoubleAttVal *> (values[i].get ());
+			void *dataPtr = att->getDataPointer ();
+			if (dataPtr != nullptr)
+				return MyDB_Value :: fromDouble (*((double *) dataPtr));
+			return att->MyDB_DoubleAttVal :: toValue ();}, whichAtt.second);
+
+	} else if (dynamic_cast <MyDB_BoolAttVal *> (att) != nullptr) {
+		return make_pair ([this, i] {
+			MyDB_BoolAttVal *att = static_cast <MyDB_BoolAttVal *> (values[i].get ());
+			void *dataPtr = att->getDataPointer ();
+			if (dataPtr != nullptr)
+				return MyDB_Value :: fromBool (*((char *) dataPtr) == 1);
+			return att->MyDB_BoolAttVal :: toValue ();}, whichAtt.second);
+
+	} else if (dynamic_cast <MyDB_StringAttVal *> (att) != nullptr) {
+		return make_pair ([this, i] {
+			return MyDB_Value :: fromString (static_cast <MyDB_StringAttVal *> (values[i].get ())->getView ());},
+			whichAtt.second);
+
+	} else if (dynamic_cast <MyDB_DictAttVal *> (att) != nullptr) {
+		return make_pair ([this, i] {
+			MyDB_DictAttVal *att = static_cast <MyDB_DictAttVal *> (values[i].get ());
+			return MyDB_Value :: fromCode (att->getDictionary ().get (), att->getCode ());}, whichAtt.second);
+	}
 
-	// just return a particular attribute
-	auto whichAtt = mySchema->getAttByName (attName);
-	return make_pair ([this, whichAtt] {return values[whichAtt.first];}, whichAtt.second);		
+	// otherwise, just ask the attribute
+	return make_pair ([this, i] {return values[i]->toValue ();}, whichAtt.second);
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: plus (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: plus (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_IntAttValPtr temp = make_shared <MyDB_IntAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () + rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromInt (lf ().toInt () + rf ().toInt ());},
 			make_shared <MyDB_IntAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_DoubleAttValPtr temp = make_shared <MyDB_DoubleAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () + rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromDouble (lf ().toDouble () + rf ().toDouble ());},
 			make_shared <MyDB_DoubleAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be strings, then do so
 	} else if (lhs.second->promotableToString () && rhs.second->promotableToString ()) {
-		MyDB_StringAttValPtr temp = make_shared <MyDB_StringAttVal> ();
-		scratch.push_back (temp);
+
+		// the result lives here until the next time the lambda is called
+		shared_ptr <string> temp = make_shared <string> ();
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toString () + rhs.first ()->toString ()); return temp;},
+		return make_pair ([temp, lf, rf] {
+				string lhsSpare, rhsSpare;
+				MyDB_StringView lhsView = lf ().toStringView (lhsSpare);
+				MyDB_StringView rhsView = rf ().toStringView (rhsSpare);
+				temp->assign (lhsView.data, lhsView.len);
+				temp->append (rhsView.data, rhsView.len);
+				return MyDB_Value :: fromString (MyDB_StringView (*temp));},
 			make_shared <MyDB_StringAttType> ());
 
 	} else {
@@ -431,76 +264,72 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: plus (pair <func, MyDB_AttTypePtr> l
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: minus (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: minus (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_IntAttValPtr temp = make_shared <MyDB_IntAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () - rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromInt (lf ().toInt () - rf ().toInt ());},
 			make_shared <MyDB_IntAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_DoubleAttValPtr temp = make_shared <MyDB_DoubleAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () - rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromDouble (lf ().toDouble () - rf ().toDouble ());},
 			make_shared <MyDB_DoubleAttType> ());
-	
+
 	} else {
 		cout << "This is bad... cannot do anything with the minus.\n";
 		exit (1);
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: unaryMinus (pair <func, MyDB_AttTypePtr> lhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: unaryMinus (pair <valFunc, MyDB_AttTypePtr> lhs) {
+
+	valFunc lf = lhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt ()) {
-		MyDB_IntAttValPtr temp = make_shared <MyDB_IntAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs] {temp->set (-lhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf] {return MyDB_Value :: fromInt (-lf ().toInt ());},
 			make_shared <MyDB_IntAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble ()) {
-		MyDB_DoubleAttValPtr temp = make_shared <MyDB_DoubleAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs] {temp->set (-lhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf] {return MyDB_Value :: fromDouble (-lf ().toDouble ());},
 			make_shared <MyDB_DoubleAttType> ());
-	
+
 	} else {
 		cout << "This is bad... cannot do anything with the unary minus.\n";
 		exit (1);
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: times (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: times (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_IntAttValPtr temp = make_shared <MyDB_IntAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () * rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromInt (lf ().toInt () * rf ().toInt ());},
 			make_shared <MyDB_IntAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_DoubleAttValPtr temp = make_shared <MyDB_DoubleAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () * rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromDouble (lf ().toDouble () * rf ().toDouble ());},
 			make_shared <MyDB_DoubleAttType> ());
 
 	} else {
@@ -509,24 +338,23 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: times (pair <func, MyDB_AttTypePtr>
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: divide (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: divide (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_IntAttValPtr temp = make_shared <MyDB_IntAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () / rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromInt (lf ().toInt () / rf ().toInt ());},
 			make_shared <MyDB_IntAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_DoubleAttValPtr temp = make_shared <MyDB_DoubleAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () / rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromDouble (lf ().toDouble () / rf ().toDouble ());},
 			make_shared <MyDB_DoubleAttType> ());
 
 	} else {
@@ -535,33 +363,35 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: divide (pair <func, MyDB_AttTypePtr>
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: gt (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: gt (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	// see if we can get away with comparing dictionary codes
+	pair <valFunc, MyDB_AttTypePtr> result;
+	if (compareCodes (lhs, rhs, '>', result))
+		return result;
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () > rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toInt () > rf ().toInt ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () > rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toDouble () > rf ().toDouble ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be strings, then do so
 	} else if (lhs.second->promotableToString () && rhs.second->promotableToString ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toString () > rhs.first ()->toString ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (compareStrings (lf (), rf ()) > 0);},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else {
@@ -570,33 +400,35 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: gt (pair <func, MyDB_AttTypePtr> lhs
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: lt (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: lt (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	// see if we can get away with comparing dictionary codes
+	pair <valFunc, MyDB_AttTypePtr> result;
+	if (compareCodes (lhs, rhs, '<', result))
+		return result;
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () < rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toInt () < rf ().toInt ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () < rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toDouble () < rf ().toDouble ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be strings, then do so
 	} else if (lhs.second->promotableToString () && rhs.second->promotableToString ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toString () < rhs.first ()->toString ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (compareStrings (lf (), rf ()) < 0);},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else {
@@ -605,41 +437,41 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: lt (pair <func, MyDB_AttTypePtr> lhs
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: eq (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: eq (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	// see if we can get away with comparing dictionary codes
+	pair <valFunc, MyDB_AttTypePtr> result;
+	if (compareCodes (lhs, rhs, '=', result))
+		return result;
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () == rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toInt () == rf ().toInt ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () == rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toDouble () == rf ().toDouble ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else if (lhs.second->isBool () && rhs.second->isBool ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toBool () == rhs.first ()->toBool ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toBool () == rf ().toBool ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be strings, then do so
 	} else if (lhs.second->promotableToString () && rhs.second->promotableToString ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toString () == rhs.first ()->toString ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (compareStrings (lf (), rf ()) == 0);},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else {
@@ -648,41 +480,41 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: eq (pair <func, MyDB_AttTypePtr> lhs
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: neq (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: neq (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	// see if we can get away with comparing dictionary codes
+	pair <valFunc, MyDB_AttTypePtr> result;
+	if (compareCodes (lhs, rhs, '!', result))
+		return result;
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->promotableToInt () && rhs.second->promotableToInt ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toInt () != rhs.first ()->toInt ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toInt () != rf ().toInt ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else if (lhs.second->isBool () && rhs.second->isBool ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toBool () != rhs.first ()->toBool ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toBool () != rf ().toBool ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be doubles, then do so
 	} else if (lhs.second->promotableToDouble () && rhs.second->promotableToDouble ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toDouble () != rhs.first ()->toDouble ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toDouble () != rf ().toDouble ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	// otherwise, if both sides can be cast upwards to be strings, then do so
 	} else if (lhs.second->promotableToString () && rhs.second->promotableToString ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toString () != rhs.first ()->toString ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (compareStrings (lf (), rf ()) != 0);},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else {
@@ -691,15 +523,55 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: neq (pair <func, MyDB_AttTypePtr> lh
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: orr (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+MyDB_InListPtr MyDB_Record :: makeInList (vector <pair <valFunc, MyDB_AttTypePtr>> &inputs) {
+
+	// the list is made up of constants, so their values can be taken right now
+	vector <pair <MyDB_Value, MyDB_AttTypePtr>> constants;
+	for (size_t i = 1; i < inputs.size (); i++)
+		constants.push_back (make_pair (inputs[i].first (), inputs[i].second));
+	return make_shared <MyDB_InList> (inputs[0].second, constants);
+}
+
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: inList (valFunc lf, MyDB_InListPtr list) {
+
+	// each of these checks the value with a single lookup
+	valFunc res;
+	if (list->getTag () == IntValue)
+		res = [lf, list] {return MyDB_Value :: fromBool (list->containsInt (lf ().toInt ()));};
+	else if (list->getTag () == DoubleValue)
+		res = [lf, list] {return MyDB_Value :: fromBool (list->containsDouble (lf ().toDouble ()));};
+	else
+		res = [lf, list] {return MyDB_Value :: fromBool (list->contains (lf ()));};
+	return make_pair (res, make_shared <MyDB_BoolAttType> ());
+}
+
+MyDB_LikePatternPtr MyDB_Record :: makeLike (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	if (!lhs.second->promotableToString () || !rhs.second->promotableToString ()) {
+		cout << "This is bad... cannot do anything with the like.\n";
+		exit (1);
+	}
+
+	// the pattern is a constant, so it can be set up right now
+	string spare;
+	return make_shared <MyDB_LikePattern> (rhs.first ().toStringView (spare).toString (), lhs.second);
+}
+
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: like (valFunc lf, MyDB_LikePatternPtr pattern) {
+	return make_pair ([lf, pattern] {return MyDB_Value :: fromBool (pattern->matches (lf ()));},
+		make_shared <MyDB_BoolAttType> ());
+}
+
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: orr (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->isBool () && rhs.second->isBool ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toBool () || rhs.first ()->toBool ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toBool () || rf ().toBool ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else {
@@ -708,15 +580,16 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: orr (pair <func, MyDB_AttTypePtr> lh
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: andd (pair <func, MyDB_AttTypePtr> lhs, pair <func, MyDB_AttTypePtr> rhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: andd (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs) {
+
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->isBool () && rhs.second->isBool ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs, rhs] {temp->set (lhs.first ()->toBool () && rhs.first ()->toBool ()); return temp;},
+		return make_pair ([lf, rf] {return MyDB_Value :: fromBool (lf ().toBool () && rf ().toBool ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else {
@@ -725,15 +598,15 @@ pair <func, MyDB_AttTypePtr> MyDB_Record :: andd (pair <func, MyDB_AttTypePtr> l
 	}
 }
 
-pair <func, MyDB_AttTypePtr> MyDB_Record :: nott (pair <func, MyDB_AttTypePtr> lhs) {
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: nott (pair <valFunc, MyDB_AttTypePtr> lhs) {
+
+	valFunc lf = lhs.first;
 
 	// if both sides can be cast upwards to be ints, then do so
 	if (lhs.second->isBool ()) {
-		MyDB_BoolAttValPtr temp = make_shared <MyDB_BoolAttVal> ();
-		scratch.push_back (temp);
 
 		// returns a lambda that computes the result
-		return make_pair ([temp, lhs] {temp->set (!lhs.first ()->toBool ()); return temp;},
+		return make_pair ([lf] {return MyDB_Value :: fromBool (!lf ().toBool ());},
 			make_shared <MyDB_BoolAttType> ());
 
 	} else {
@@ -825,20 +698,208 @@ std::ostream& operator<<(std::ostream& os, const MyDB_RecordPtr printMe) {
 	return os;
 }
 
+bool MyDB_Record :: compareCodes (pair <valFunc, MyDB_AttTypePtr> lhs, pair <valFunc, MyDB_AttTypePtr> rhs, char op,
+	pair <valFunc, MyDB_AttTypePtr> &result) {
+
+	// put the encoded side on the left
+	MyDB_DictAttTypePtr lhsDict = dynamic_pointer_cast <MyDB_DictAttType> (lhs.second);
+	MyDB_DictAttTypePtr rhsDict = dynamic_pointer_cast <MyDB_DictAttType> (rhs.second);
+	if (lhsDict == nullptr) {
+		swap (lhs, rhs);
+		swap (lhsDict, rhsDict);
+		if (op == '<')
+			op = '>';
+		else if (op == '>')
+			op = '<';
+	}
+
+	if (lhsDict == nullptr)
+		return false;
+
+	MyDB_DictionaryPtr dict = lhsDict->getDictionary ();
+	MyDB_StringLiteralAttTypePtr literal = dynamic_pointer_cast <MyDB_StringLiteralAttType> (rhs.second);
+	valFunc lf = lhs.first;
+	valFunc rf = rhs.first;
+
+	// codes handed out after this point are checked with a string comparison, since they
+	// may not be in order, or may not be in the translation table built below
+	int numCodes = dict->size ();
+
+	// both sides are from the same dictionary
+	if (rhsDict != nullptr && rhsDict->getDictionary () == dict) {
+
+		if (op == '=') {
+			result.first = [lf, rf] {return MyDB_Value :: fromBool (lf ().code == rf ().code);};
+		} else if (op == '!') {
+			result.first = [lf, rf] {return MyDB_Value :: fromBool (lf ().code != rf ().code);};
+		} else if (op == '<') {
+			result.first = [lf, rf, dict] {
+				MyDB_Value l = lf (), r = rf ();
+				if (dict->isOrdered ())
+					return MyDB_Value :: fromBool (l.code < r.code);
+				else
+					return MyDB_Value :: fromBool (compareStrings (l, r) < 0);};
+		} else {
+			result.first = [lf, rf, dict] {
+				MyDB_Value l = lf (), r = rf ();
+				if (dict->isOrdered ())
+					return MyDB_Value :: fromBool (l.code > r.code);
+				else
+					return MyDB_Value :: fromBool (compareStrings (l, r) > 0);};
+		}
+
+	// the two sides have different dictionaries; we can still check equality by translating
+	// each code on the left into a code on the right
+	} else if (rhsDict != nullptr && (op == '=' || op == '!')) {
+
+		MyDB_DictionaryPtr otherDict = rhsDict->getDictionary ();
+		int numOtherCodes = otherDict->size ();
+		vector <int> translate;
+		for (int i = 0; i < numCodes; i++) {
+			translate.push_back (otherDict->getCode (dict->getString (i)));
+		}
+
+		bool wantEqual = (op == '=');
+		result.first = [lf, rf, translate, numCodes, numOtherCodes, wantEqual] {
+			MyDB_Value l = lf (), r = rf ();
+			if (l.code < numCodes && r.code < numOtherCodes)
+				return MyDB_Value :: fromBool ((translate[l.code] == r.code) == wantEqual);
+			else
+				return MyDB_Value :: fromBool ((compareStrings (l, r) == 0) == wantEqual);};
+
+	// compare with a literal, which we can look up in the dictionary right now
+	} else if (literal != nullptr) {
+
+		// the view of the literal has to point at something that does not move when the
+		// lambda is copied, so the literal is kept in its own string
+		shared_ptr <string> value = make_shared <string> (literal->getLiteral ());
+		if (op == '=' || op == '!') {
+			int code = dict->getCode (*value);
+			bool wantEqual = (op == '=');
+			result.first = [lf, code, numCodes, value, wantEqual] {
+				MyDB_Value l = lf ();
+				if (l.code < numCodes)
+					return MyDB_Value :: fromBool ((l.code == code) == wantEqual);
+				else
+					return MyDB_Value :: fromBool ((l.stringVal == MyDB_StringView (*value)) == wantEqual);};
+
+		// for an ordered dictionary, a range check on a literal is a range check on codes
+		} else if (dict->isOrdered ()) {
+			bool lessThan = (op == '<');
+			int bound = lessThan ? dict->countLess (*value) : dict->countLessOrEqual (*value);
+			result.first = [lf, bound, numCodes, value, lessThan] {
+				MyDB_Value l = lf ();
+				if (l.code < numCodes)
+					return MyDB_Value :: fromBool (lessThan ? l.code < bound : l.code >= bound);
+				int res = l.stringVal.compare (MyDB_StringView (*value));
+				return MyDB_Value :: fromBool (lessThan ? res < 0 : res > 0);};
+		} else {
+			return false;
+		}
+
+	} else {
+		return false;
+	}
+
+	result.second = make_shared <MyDB_BoolAttType> ();
+	return true;
+}
+
+valFunc MyDB_Record :: compileValueComputation (string compileMe) {
+	return compileTypedValueComputation (compileMe).first;
+}
+
+pair <valFunc, MyDB_AttTypePtr> MyDB_Record :: compileTypedValueComputation (string compileMe) {
+	return compileTypedValueComputations (vector <string> {compileMe})[0];
+}
+
+vector <valFunc> MyDB_Record :: compileValueComputations (vector <string> compileUs) {
+	vector <valFunc> res;
+	for (auto &f : compileTypedValueComputations (compileUs))
+		res.push_back (f.first);
+	return res;
+}
+
+vector <pair <valFunc, MyDB_AttTypePtr>> MyDB_Record :: compileTypedValueComputations (vector <string> compileUs) {
+	return compilePlan (MyDB_CompiledPlan :: get (mySchema, compileUs));
+}
+
+vector <valFunc> MyDB_Record :: compileValueComputations (vector <MyDB_CompNodePtr> compileUs) {
+	vector <valFunc> res;
+	for (auto &f : compileTypedValueComputations (compileUs))
+		res.push_back (f.first);
+	return res;
+}
+
+vector <pair <valFunc, MyDB_AttTypePtr>> MyDB_Record :: compileTypedValueComputations (vector <MyDB_CompNodePtr> compileUs) {
+	return compilePlan (MyDB_CompiledPlan :: get (mySchema, compileUs));
+}
+
+vector <pair <valFunc, MyDB_AttTypePtr>> MyDB_Record :: compilePlan (MyDB_CompiledPlanPtr plan) {
+
+	// everything has been worked out ahead of time, so all that is left to do is to build
+	// the lambdas that read this particular record
+	map <string, pair <valFunc, MyDB_AttTypePtr>> shared;
+	vector <pair <valFunc, MyDB_AttTypePtr>> res;
+	for (MyDB_CompNodePtr &c : plan->getComputations ())
+		res.push_back (compileHelper (c, *plan, shared));
+	return res;
+}
+
+func MyDB_Record :: compileComputation (string compileMe) {
+	return compileTypedComputation (compileMe).first;
+}
+
+pair <func, MyDB_AttTypePtr> MyDB_Record :: compileTypedComputation (string compileMe) {
+
+	// compile to a plain value, and then put that value into an att val of the right type
+	pair <valFunc, MyDB_AttTypePtr> res = compileTypedValueComputation (compileMe);
+	valFunc f = res.first;
+	MyDB_AttValPtr temp = res.second->createAtt ();
+	scratch.push_back (temp);
+	return make_pair ([temp, f] {temp->fromValue (f ()); return temp;}, res.second);
+}
+
 function <bool ()> buildRecordComparator (MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs, string computation) {
 
 	// compile a computation over the LHS and over the RHS
-	char *str = (char *) computation.c_str ();
-	pair <func, MyDB_AttTypePtr> lhsFunc = lhs->compileHelper (str);
-
-	str = (char *) computation.c_str ();
-	pair <func, MyDB_AttTypePtr> rhsFunc = rhs->compileHelper (str);
+	pair <valFunc, MyDB_AttTypePtr> lhsFunc = lhs->compileTypedValueComputation (computation);
+	pair <valFunc, MyDB_AttTypePtr> rhsFunc = rhs->compileTypedValueComputation (computation);
 
 	// and then build a lambda that performs the computatation
 	auto res = lhs->lt (lhsFunc, rhsFunc);
-	func temp = res.first;
-	return [=] {return temp ()->toBool ();};
-	
+	valFunc temp = res.first;
+	return [=] {return temp ().boolVal;};
+
+}
+
+function <bool ()> buildRecordComparator (MyDB_RecordPtr lhs,  MyDB_RecordPtr rhs, 
+	vector <pair <MyDB_CompNodePtr, bool>> computations) {
+
+	vector <MyDB_CompNodePtr> comps;
+	for (auto &c : computations)
+		comps.push_back (c.first);
+	vector <pair <valFunc, MyDB_AttTypePtr>> lhsFuncs = lhs->compileTypedValueComputations (comps);
+	vector <pair <valFunc, MyDB_AttTypePtr>> rhsFuncs = rhs->compileTypedValueComputations (comps);
+
+	// for each computation, whether lhs comes before rhs, and whether it comes after
+	vector <valFunc> before, after;
+	for (size_t i = 0; i < computations.size (); i++) {
+		valFunc lhsFirst = lhs->lt (lhsFuncs[i], rhsFuncs[i]).first;
+		valFunc rhsFirst = lhs->lt (rhsFuncs[i], lhsFuncs[i]).first;
+		before.push_back (computations[i].second ? rhsFirst : lhsFirst);
+		after.push_back (computations[i].second ? lhsFirst : rhsFirst);
+	}
+
+	return [=] {
+		for (size_t i = 0; i < before.size (); i++) {
+			if (before[i] ().boolVal)
+				return true;
+			if (after[i] ().boolVal)
+				return false;
+		}
+		return false;
+	};
 }
 
 MyDB_Record :: MyDB_Record (MyDB_SchemaPtr mySchemaIn) {
@@ -0,0 +1,302 @@
+
+#ifndef SIMD_KERNELS_C
+#define SIMD_KERNELS_C
+
+#include "MyDB_SimdKernels.h"
+#include <iostream>
+#include <string.h>
+
+#if defined (__x86_64__) || defined (__i386__)
+#define SIMD_KERNELS_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// each kernel handles as many rows as it can from the start, and says how many it did;
+// the rest are done with plain loops
+typedef int (*intKernel) (const int *lhs, const int *rhs, int n, uint64_t *mask);
+typedef int (*doubleKernel) (const double *lhs, const double *rhs, int n, uint64_t *mask);
+
+// the kernels for each level, op, and for a column (0) or a constant (1) on the right;
+// a level that this build has no kernels for uses the plain ones
+static intKernel intKernels[3][4][2];
+static doubleKernel doubleKernels[3][4][2];
+
+// the level we are running at, and the best one that the machine has
+static MyDB_SimdLevel currentLevel;
+static MyDB_SimdLevel bestLevel;
+
+template <MyDB_CompareOp op, class T>
+static inline bool compareOne (T lhs, T rhs) {
+	if (op == GreaterThan)
+		return lhs > rhs;
+	if (op == LessThan)
+		return lhs < rhs;
+	if (op == Equal)
+		return lhs == rhs;
+	return lhs != rhs;
+}
+
+template <MyDB_CompareOp op, bool rhsIsConstant, class T>
+static int compareScalar (const T *lhs, const T *rhs, int n, uint64_t *mask) {
+
+	// build each word of the mask in a register
+	int i = 0;
+	for (; i + 64 <= n; i += 64) {
+		uint64_t bits = 0;
+		for (int j = 0; j < 64; j++) {
+			bits |= ((uint64_t) compareOne <op> (lhs[i + j], rhsIsConstant ? rhs[0] : rhs[i + j])) << j;
+		}
+		mask[i >> 6] = bits;
+	}
+	for (; i < n; i++) {
+		mask[i >> 6] |= ((uint64_t) compareOne <op> (lhs[i], rhsIsConstant ? rhs[0] : rhs[i])) << (i & 63);
+	}
+	return n;
+}
+
+#ifdef SIMD_KERNELS_X86
+
+template <MyDB_CompareOp op, bool rhsIsConstant>
+static int compareIntsSse2 (const int *lhs, const int *rhs, int n, uint64_t *mask) {
+	__m128i constant = _mm_set1_epi32 (rhs[0]);
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i a = _mm_loadu_si128 ((const __m128i *) (lhs + i));
+		__m128i b = rhsIsConstant ? constant : _mm_loadu_si128 ((const __m128i *) (rhs + i));
+		__m128i res;
+		if (op == GreaterThan)
+			res = _mm_cmpgt_epi32 (a, b);
+		else if (op == LessThan)
+			res = _mm_cmplt_epi32 (a, b);
+		else
+			res = _mm_cmpeq_epi32 (a, b);
+		uint64_t bits = _mm_movemask_ps (_mm_castsi128_ps (res));
+		if (op == NotEqual)
+			bits ^= 0xf;
+		mask[i >> 6] |= bits << (i & 63);
+	}
+	return i;
+}
+
+template <MyDB_CompareOp op, bool rhsIsConstant>
+static int compareDoublesSse2 (const double *lhs, const double *rhs, int n, uint64_t *mask) {
+	__m128d constant = _mm_set1_pd (rhs[0]);
+	int i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128d a = _mm_loadu_pd (lhs + i);
+		__m128d b = rhsIsConstant ? constant : _mm_loadu_pd (rhs + i);
+		__m128d res;
+		if (op == GreaterThan)
+			res = _mm_cmpgt_pd (a, b);
+		else if (op == LessThan)
+			res = _mm_cmplt_pd (a, b);
+		else if (op == Equal)
+			res = _mm_cmpeq_pd (a, b);
+		else
+			res = _mm_cmpneq_pd (a, b);
+		uint64_t bits = _mm_movemask_pd (res);
+		mask[i >> 6] |= bits << (i & 63);
+	}
+	return i;
+}
+
+template <MyDB_CompareOp op, bool rhsIsConstant>
+__attribute__ ((target ("avx2")))
+static int compareIntsAvx2 (const int *lhs, const int *rhs, int n, uint64_t *mask) {
+	__m256i constant = _mm256_set1_epi32 (rhs[0]);
+	int i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i a = _mm256_loadu_si256 ((const __m256i *) (lhs + i));
+		__m256i b = rhsIsConstant ? constant : _mm256_loadu_si256 ((const __m256i *) (rhs + i));
+		__m256i res;
+		if (op == GreaterThan)
+			res = _mm256_cmpgt_epi32 (a, b);
+		else if (op == LessThan)
+			res = _mm256_cmpgt_epi32 (b, a);
+		else
+			res = _mm256_cmpeq_epi32 (a, b);
+		uint64_t bits = _mm256_movemask_ps (_mm256_castsi256_ps (res));
+		if (op == NotEqual)
+			bits ^= 0xff;
+		mask[i >> 6] |= bits << (i & 63);
+	}
+	return i;
+}
+
+template <MyDB_CompareOp op, bool rhsIsConstant>
+__attribute__ ((target ("avx2")))
+static int compareDoublesAvx2 (const double *lhs, const double *rhs, int n, uint64_t *mask) {
+	__m256d constant = _mm256_set1_pd (rhs[0]);
+	int i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d a = _mm256_loadu_pd (lhs + i);
+		__m256d b = rhsIsConstant ? constant : _mm256_loadu_pd (rhs + i);
+		__m256d res;
+		if (op == GreaterThan)
+			res = _mm256_cmp_pd (a, b, _CMP_GT_OQ);
+		else if (op == LessThan)
+			res = _mm256_cmp_pd (a, b, _CMP_LT_OQ);
+		else if (op == Equal)
+			res = _mm256_cmp_pd (a, b, _CMP_EQ_OQ);
+		else
+			res = _mm256_cmp_pd (a, b, _CMP_NEQ_UQ);
+		uint64_t bits = _mm256_movemask_pd (res);
+		mask[i >> 6] |= bits << (i & 63);
+	}
+	return i;
+}
+
+#endif
+
+// fills in the kernels for one op
+template <MyDB_CompareOp op>
+static void setKernels () {
+	for (int level = 0; level < 3; level++) {
+		intKernels[level][op][0] = compareScalar <op, false, int>;
+		intKernels[level][op][1] = compareScalar <op, true, int>;
+		doubleKernels[level][op][0] = compareScalar <op, false, double>;
+		doubleKernels[level][op][1] = compareScalar <op, true, double>;
+	}
+#ifdef SIMD_KERNELS_X86
+	intKernels[Sse2Level][op][0] = compareIntsSse2 <op, false>;
+	intKernels[Sse2Level][op][1] = compareIntsSse2 <op, true>;
+	doubleKernels[Sse2Level][op][0] = compareDoublesSse2 <op, false>;
+	doubleKernels[Sse2Level][op][1] = compareDoublesSse2 <op, true>;
+	intKernels[Avx2Level][op][0] = compareIntsAvx2 <op, false>;
+	intKernels[Avx2Level][op][1] = compareIntsAvx2 <op, true>;
+	doubleKernels[Avx2Level][op][0] = compareDoublesAvx2 <op, false>;
+	doubleKernels[Avx2Level][op][1] = compareDoublesAvx2 <op, true>;
+#endif
+}
+
+// asks the processor (and the operating system, which has to save the AVX registers)
+// what it supports
+static MyDB_SimdLevel checkCpu () {
+#ifdef SIMD_KERNELS_X86
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid (1, &eax, &ebx, &ecx, &edx))
+		return ScalarLevel;
+	bool hasSse2 = (edx & bit_SSE2) != 0;
+	if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX) && __get_cpuid_max (0, nullptr) >= 7) {
+		unsigned int xcrLow, xcrHigh;
+		__asm__ ("xgetbv" : "=a" (xcrLow), "=d" (xcrHigh) : "c" (0));
+		if ((xcrLow & 6) == 6) {
+			__cpuid_count (7, 0, eax, ebx, ecx, edx);
+			if (ebx & bit_AVX2)
+				return Avx2Level;
+		}
+	}
+	if (hasSse2)
+		return Sse2Level;
+#endif
+	return ScalarLevel;
+}
+
+static bool setUp () {
+	setKernels <GreaterThan> ();
+	setKernels <LessThan> ();
+	setKernels <Equal> ();
+	setKernels <NotEqual> ();
+	bestLevel = checkCpu ();
+	currentLevel = bestLevel;
+	return true;
+}
+
+static inline MyDB_SimdLevel getCurrentLevel () {
+	static bool isSetUp = setUp ();
+	(void) isSetUp;
+	return currentLevel;
+}
+
+// does the rows that a kernel left over, one at a time
+template <class T>
+static void compareRest (MyDB_CompareOp op, const T *lhs, const T *rhs, bool rhsIsConstant, int from, int n,
+	uint64_t *mask) {
+	for (int i = from; i < n; i++) {
+		T rhsVal = rhsIsConstant ? rhs[0] : rhs[i];
+		bool res = (op == GreaterThan) ? lhs[i] > rhsVal : (op == LessThan) ? lhs[i] < rhsVal :
+			(op == Equal) ? lhs[i] == rhsVal : lhs[i] != rhsVal;
+		mask[i >> 6] |= ((uint64_t) res) << (i & 63);
+	}
+}
+
+void MyDB_SimdKernels :: compareInts (MyDB_CompareOp op, const int *lhs, const int *rhs, bool rhsIsConstant,
+	int n, uint64_t *mask) {
+	memset (mask, 0, numWords (n) * sizeof (uint64_t));
+	int done = intKernels[getCurrentLevel ()][op][rhsIsConstant] (lhs, rhs, n, mask);
+	compareRest (op, lhs, rhs, rhsIsConstant, done, n, mask);
+}
+
+void MyDB_SimdKernels :: compareDoubles (MyDB_CompareOp op, const double *lhs, const double *rhs, bool rhsIsConstant,
+	int n, uint64_t *mask) {
+	memset (mask, 0, numWords (n) * sizeof (uint64_t));
+	int done = doubleKernels[getCurrentLevel ()][op][rhsIsConstant] (lhs, rhs, n, mask);
+	compareRest (op, lhs, rhs, rhsIsConstant, done, n, mask);
+}
+
+void MyDB_SimdKernels :: andMasks (uint64_t *intoMe, const uint64_t *other, int n) {
+	int words = numWords (n);
+	for (int i = 0; i < words; i++)
+		intoMe[i] &= other[i];
+}
+
+void MyDB_SimdKernels :: orMasks (uint64_t *intoMe, const uint64_t *other, int n) {
+	int words = numWords (n);
+	for (int i = 0; i < words; i++)
+		intoMe[i] |= other[i];
+}
+
+void MyDB_SimdKernels :: notMask (uint64_t *flipMe, int n) {
+	int words = numWords (n);
+	for (int i = 0; i < words; i++)
+		flipMe[i] = ~flipMe[i];
+
+	// the bits past the end stay clear
+	if (n % 64 != 0)
+		flipMe[words - 1] &= (((uint64_t) 1) << (n % 64)) - 1;
+}
+
+void MyDB_SimdKernels :: maskToSelection (const uint64_t *mask, int n, vector <int> &selection) {
+	selection.resize (n);
+	int numSelected = 0;
+	int words = numWords (n);
+	for (int i = 0; i < words; i++) {
+		uint64_t bits = mask[i];
+		while (bits != 0) {
+			selection[numSelected++] = i * 64 + __builtin_ctzll (bits);
+			bits &= bits - 1;
+		}
+	}
+	selection.resize (numSelected);
+}
+
+MyDB_SimdLevel MyDB_SimdKernels :: getBestLevel () {
+	getCurrentLevel ();
+	return bestLevel;
+}
+
+MyDB_SimdLevel MyDB_SimdKernels :: getLevel () {
+	return getCurrentLevel ();
+}
+
+void MyDB_SimdKernels :: setLevel (MyDB_SimdLevel toMe) {
+	getCurrentLevel ();
+	if (toMe > bestLevel) {
+		cout << "This machine cannot run the " << getLevelName (toMe) << " kernels.\n";
+		exit (1);
+	}
+	currentLevel = toMe;
+}
+
+string MyDB_SimdKernels :: getLevelName (MyDB_SimdLevel forMe) {
+	if (forMe == Avx2Level)
+		return "AVX2";
+	if (forMe == Sse2Level)
+		return "SSE2";
+	return "scalar";
+}
+
+#endif
@@ -2,19 +2,32 @@
 #ifndef RECORD_TEST_H
 #define RECORD_TEST_H
 
+#include "MyDB_AdaptiveConjunction.h"
 #include "MyDB_AttType.h"  
+#include "MyDB_BatchComputation.h"
 #include "MyDB_BufferManager.h"
 #include "MyDB_Catalog.h"  
+#include "MyDB_CompiledPlan.h"
+#include "MyDB_CompNode.h"
+#include "MyDB_JoinHashTable.h"
+#include "MyDB_LikePattern.h"
+#include "MyDB_NativeComputation.h"
+#include "MyDB_NormalizedKey.h"
 #include "MyDB_Page.h"
 #include "MyDB_PageReaderWriter.h"
 #include "MyDB_Record.h"
 #include "MyDB_Table.h"
 #include "MyDB_TableReaderWriter.h"
 #include "MyDB_Schema.h"
+#include "MyDB_SimdKernels.h"
 #include "QUnit.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <time.h>
+#include <unordered_map>
 #include <unistd.h>
 #include <vector>
 
@@ -53,7 +66,7 @@ void initialize() {
 int main(int argc, char *argv[]) {
 	int start = 1;
 	if (argc > 1 && argv[1][0] >= '0' && argv[1][0] <= '9') {
-		start = argv[1][0] - '0';
+		start = atoi (argv[1]);
 	}
 	cout << "start from test " << start << endl << flush;
 
@@ -463,6 +476,982 @@ int main(int argc, char *argv[]) {
 		QUNIT_IS_FALSE(result);
 	}
 	FALLTHROUGH_INTENDED;
+	case 11:
+	{
+		// strings in a record buffer are looked at in place, using their length prefix
+		cout << "TEST 11..." << flush;
+		vector <string> words = {"", "a", "ab", "abcdefg", "abcdefgh", "abcdefghi", "zzz", "the quick brown fox"};
+		MyDB_DictionaryPtr dict = make_shared <MyDB_Dictionary> (words);
+		bool ok = true;
+
+		// write each word into a buffer, then read it back through a second att
+		char *buffer = new char[4];
+		size_t allocated = 4, used = 0;
+		vector <size_t> offsets;
+		for (string &w : words) {
+			MyDB_StringAttVal att;
+			att.set (w);
+			offsets.push_back (used);
+			att.serialize (buffer, allocated, used);
+		}
+
+		for (size_t i = 0; i < words.size (); i++) {
+			MyDB_StringAttVal inBuffer, notInBuffer;
+			inBuffer.fromBinary (buffer + offsets[i]);
+			notInBuffer.set (words[i]);
+			string spare;
+			ok = ok && inBuffer.toString () == words[i] && inBuffer.toStringView (spare).len == words[i].size ();
+			ok = ok && inBuffer.hash () == notInBuffer.hash () && inBuffer.hash () == dict->getHash (dict->getCode (words[i]));
+			for (size_t j = 0; j < words.size (); j++) {
+				MyDB_StringView lhs = inBuffer.getView (), rhs (words[j]);
+				int expected = words[i].compare (words[j]);
+				int got = lhs.compare (rhs);
+				ok = ok && ((expected < 0) == (got < 0)) && ((expected == 0) == (got == 0)) && ((expected == 0) == (lhs == rhs));
+			}
+		}
+
+		// a value that is sitting in the buffer can be written back into the same buffer,
+		// both when the buffer has room and when it has to grow
+		for (int i = 0; i < 2; i++) {
+			MyDB_StringAttVal att;
+			att.fromBinary (buffer + offsets.back ());
+			if (i == 0)
+				used = 0;
+			else
+				used = allocated - 3;
+			size_t at = used;
+			att.serialize (buffer, allocated, used);
+			MyDB_StringAttVal check;
+			check.fromBinary (buffer + at);
+			ok = ok && check.toString () == words.back ();
+		}
+		delete [] buffer;
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 12:
+	{
+		// computations compiled to plain values agree with the ones that produce att vals
+		cout << "TEST 12..." << flush;
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("d", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("b", make_shared <MyDB_BoolAttType> ()));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+		MyDB_RecordPtr other = make_shared <MyDB_Record> (mySchema);
+
+		vector <string> comps = {"+ ([i], int[3])", "/ ([d], [i])", "- (um ([i]), double[0.5])", "* ([i], [i])",
+			"+ ([s], string[xyz])", "+ ([s], [i])", "< ([s], string[m])", "== ([s], string[abc])",
+			"&& ([b], > ([d], int[1]))", "|| (! ([b]), != ([i], int[7]))", "== ([b], bool[true])", "[s]"};
+		vector <string> rows = {"7|2.5|abc|true|", "-4|10.25|zz top|false|", "0|0.5|a|true|"};
+		bool ok = true;
+		for (string &row : rows) {
+
+			// once with the atts in the record's buffer, and once not
+			other->fromString (row);
+			void *space = malloc (other->getBinarySize ());
+			other->toBinary (space);
+			for (int buffered = 0; buffered < 2; buffered++) {
+				if (buffered)
+					rec->fromBinary (space);
+				else
+					rec->fromString (row);
+				for (string &c : comps) {
+					valFunc f = rec->compileValueComputation (c);
+					MyDB_Value val = f ();
+					MyDB_AttValPtr att = rec->compileComputation (c) ();
+					ok = ok && val.toString () == att->toString () && val.hash () == att->hash ();
+					ok = ok && val.hash () == att->toValue ().hash ();
+				}
+			}
+			free (space);
+		}
+
+		// and a record comparator over strings works on the views
+		rec->fromString ("1|1.0|abc|true|");
+		other->fromString ("1|1.0|abd|true|");
+		function <bool ()> comp = buildRecordComparator (rec, other, "[s]");
+		function <bool ()> compBack = buildRecordComparator (other, rec, "[s]");
+		ok = ok && comp () && !compBack ();
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 13:
+	{
+		// computations run a batch at a time agree with the ones run a record at a time
+		cout << "TEST 13..." << flush;
+		vector <string> codes = {"AIR", "MAIL", "SHIP"};
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("d", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("b", make_shared <MyDB_BoolAttType> ()));
+		mySchema->appendAtt (make_pair ("c", make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (codes))));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+
+		// enough records for two full batches and part of a third
+		int numRecs = BATCH_SIZE * 2 + 100;
+		vector <char> space (numRecs * 64);
+		vector <void *> recs;
+		char *pos = space.data ();
+		for (int i = 0; i < numRecs; i++) {
+			rec->fromString (to_string (i % 13 - 6) + "|" + to_string (i * 0.5) + "|" + codes[i % 2] + to_string (i % 5) + 
+				"|" + (i % 3 == 0 ? "true" : "false") + "|" + codes[i % 3] + "|");
+			recs.push_back (pos);
+			pos = (char *) rec->toBinary (pos);
+		}
+
+		vector <string> comps = {"+ ([i], int[3])", "/ ([d], int[4])", "- (um ([i]), double[0.5])", "* ([i], [d])",
+			"+ ([s], string[xyz])", "+ ([s], [i])", "< ([s], string[MAIL])", "== ([s], string[AIR1])",
+			"&& ([b], > ([d], int[100]))", "|| (! ([b]), != ([i], int[2]))", "== ([b], bool[true])", "[s]", "[c]",
+			"== ([c], string[MAIL])", "!= ([c], string[NONE])", "< ([c], string[B])", "> (string[M], [c])",
+			"== ([c], [c])", "+ ([c], [s])", "< ([c], [s])", "&& (< ([i], int[0]), == ([c], string[SHIP]))",
+			"|| (> ([d], [i]), ! (== ([i], int[2])))", "&& (!= ([i], int[1]), < (double[3.5], [d]))"};
+		bool ok = true;
+		MyDB_Batch batch (mySchema);
+		for (string &c : comps) {
+			MyDB_BatchComputation batchComp (c, batch);
+			valFunc f = rec->compileValueComputation (c);
+			bool isBool = batchComp.getType ()->isBool ();
+			vector <int> selection, filtered;
+			vector <size_t> hashes (BATCH_SIZE);
+			int start = 0;
+			for (int i = 0; i < numRecs; i++) {
+				if (!batch.append (recs[i]) && i < numRecs - 1)
+					continue;
+
+				// run over all of the rows, and then over every third one
+				for (int every = 1; every <= 3; every += 2) {
+					batch.selectAll (selection);
+					selection.erase (remove_if (selection.begin (), selection.end (), [every] (int j) {return j % every != 0;}),
+						selection.end ());
+					fill (hashes.begin (), hashes.end (), 0);
+					batchComp.hash (selection, hashes);
+					MyDB_Column &col = batchComp.evaluate (selection);
+					filtered = selection;
+					if (isBool)
+						batchComp.filter (filtered);
+					size_t numAccepted = 0;
+					for (int j : selection) {
+						rec->fromBinary (recs[start + j]);
+						MyDB_Value val = f ();
+						ok = ok && val.toString () == col.getValue (j).toString () &&
+							MyDB_Value :: combineHashes (0, val.hash ()) == hashes[j];
+						if (isBool && val.toBool ())
+							ok = ok && numAccepted < filtered.size () && filtered[numAccepted++] == j;
+					}
+					ok = ok && (!isBool || numAccepted == filtered.size ());
+				}
+				start = i + 1;
+				batch.clear ();
+			}
+		}
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 14:
+	{
+		// each of the SIMD comparison kernels that this machine can run gets the same answer
+		// as a plain loop; also time each of them
+		cout << "TEST 14..." << flush;
+		int n = 1000;
+		vector <int> ints (n), otherInts (n);
+		vector <double> doubles (n), otherDoubles (n);
+		srand (530);
+		for (int i = 0; i < n; i++) {
+			ints[i] = rand () % 20 - 10;
+			otherInts[i] = rand () % 20 - 10;
+			doubles[i] = (rand () % 200) / 10.0 - 10;
+			otherDoubles[i] = (i % 7 == 0) ? doubles[i] : (rand () % 200) / 10.0 - 10;
+		}
+		int intConstant = 3;
+		double doubleConstant = 2.5;
+
+		auto check = [] (MyDB_CompareOp op, double lhs, double rhs) {
+			return (op == GreaterThan) ? lhs > rhs : (op == LessThan) ? lhs < rhs : (op == Equal) ? lhs == rhs : lhs != rhs;
+		};
+		auto bit = [] (vector <uint64_t> &mask, int i) {
+			return ((mask[i / 64] >> (i % 64)) & 1) == 1;
+		};
+
+		bool ok = true;
+		MyDB_SimdLevel best = MyDB_SimdKernels :: getBestLevel ();
+		vector <uint64_t> mask (MyDB_SimdKernels :: numWords (n)), otherMask (MyDB_SimdKernels :: numWords (n));
+		for (int level = ScalarLevel; level <= best; level++) {
+			MyDB_SimdKernels :: setLevel ((MyDB_SimdLevel) level);
+			for (int op = GreaterThan; op <= NotEqual; op++) {
+				MyDB_CompareOp compOp = (MyDB_CompareOp) op;
+				MyDB_SimdKernels :: compareInts (compOp, ints.data (), otherInts.data (), false, n, mask.data ());
+				for (int i = 0; i < n; i++)
+					ok = ok && bit (mask, i) == check (compOp, ints[i], otherInts[i]);
+				MyDB_SimdKernels :: compareInts (compOp, ints.data (), &intConstant, true, n, mask.data ());
+				for (int i = 0; i < n; i++)
+					ok = ok && bit (mask, i) == check (compOp, ints[i], intConstant);
+				MyDB_SimdKernels :: compareDoubles (compOp, doubles.data (), otherDoubles.data (), false, n, mask.data ());
+				for (int i = 0; i < n; i++)
+					ok = ok && bit (mask, i) == check (compOp, doubles[i], otherDoubles[i]);
+				MyDB_SimdKernels :: compareDoubles (compOp, doubles.data (), &doubleConstant, true, n, mask.data ());
+				for (int i = 0; i < n; i++)
+					ok = ok && bit (mask, i) == check (compOp, doubles[i], doubleConstant);
+			}
+
+			// combining masks, and reading off the selection
+			MyDB_SimdKernels :: compareInts (GreaterThan, ints.data (), &intConstant, true, n, mask.data ());
+			MyDB_SimdKernels :: compareDoubles (LessThan, doubles.data (), otherDoubles.data (), false, n, otherMask.data ());
+			MyDB_SimdKernels :: orMasks (mask.data (), otherMask.data (), n);
+			MyDB_SimdKernels :: notMask (mask.data (), n);
+			MyDB_SimdKernels :: compareInts (NotEqual, ints.data (), otherInts.data (), false, n, otherMask.data ());
+			MyDB_SimdKernels :: andMasks (mask.data (), otherMask.data (), n);
+			vector <int> selection;
+			MyDB_SimdKernels :: maskToSelection (mask.data (), n, selection);
+			vector <int> expected;
+			for (int i = 0; i < n; i++) {
+				if (!(ints[i] > intConstant || doubles[i] < otherDoubles[i]) && ints[i] != otherInts[i])
+					expected.push_back (i);
+			}
+			ok = ok && selection == expected && !expected.empty ();
+			MyDB_SimdKernels :: notMask (mask.data (), n);
+			MyDB_SimdKernels :: maskToSelection (mask.data (), n, selection);
+			ok = ok && selection.size () == n - expected.size ();
+		}
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+
+		// and the timings, in ns per value
+		int reps = 20000;
+		for (int level = ScalarLevel; level <= best; level++) {
+			MyDB_SimdKernels :: setLevel ((MyDB_SimdLevel) level);
+			double times[4];
+			for (int which = 0; which < 4; which++) {
+				auto start = chrono :: steady_clock :: now ();
+				for (int rep = 0; rep < reps; rep++) {
+					if (which == 0)
+						MyDB_SimdKernels :: compareInts (GreaterThan, ints.data (), &intConstant, true, n, mask.data ());
+					else if (which == 1)
+						MyDB_SimdKernels :: compareInts (LessThan, ints.data (), otherInts.data (), false, n, mask.data ());
+					else if (which == 2)
+						MyDB_SimdKernels :: compareDoubles (GreaterThan, doubles.data (), &doubleConstant, true, n, mask.data ());
+					else
+						MyDB_SimdKernels :: compareDoubles (LessThan, doubles.data (), otherDoubles.data (), false, n, mask.data ());
+				}
+				times[which] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count () * 1e9 / reps / n;
+			}
+			cout << "\t" << MyDB_SimdKernels :: getLevelName ((MyDB_SimdLevel) level) << " (ns per value): int vs. constant "
+				<< times[0] << ", int vs. int " << times[1] << ", double vs. constant " << times[2]
+				<< ", double vs. double " << times[3] << endl;
+		}
+		MyDB_SimdKernels :: setLevel (best);
+	}
+	FALLTHROUGH_INTENDED;
+	case 15:
+	{
+		// constants are folded, and a group of computations shares its common subexpressions
+		// (while still noticing when the record changes)
+		cout << "TEST 15..." << flush;
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("d", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+
+		// a folded string constant is a literal, so it can still be compared on dictionary codes
+		bool ok = true;
+		pair <valFunc, MyDB_AttTypePtr> folded = rec->compileTypedValueComputation ("+ (string[ab], + (int[1], int[2]))");
+		ok = ok && folded.first ().toString () == "ab3" && 
+			dynamic_pointer_cast <MyDB_StringLiteralAttType> (folded.second) != nullptr;
+
+		// a division by zero is not folded, and is never run here
+		valFunc guarded = rec->compileValueComputation ("&& (bool[false], == (/ (int[1], int[0]), int[1]))");
+		ok = ok && !guarded ().toBool ();
+
+		vector <valFunc> group = rec->compileValueComputations ({"* ([d], + (double[1.0], double[0.5]))", 
+			"+ (* ([i], [d]), * ([i], [d]))", "> (* ([i], [d]), double[3.0])", "+ ([s], string[x])", 
+			"== (+ ([s], string[x]), string[abx])", "- (int[7], * (int[2], int[3]))", "+ ([s], string[x])"});
+
+		vector <char> space (64);
+		for (int r = 0; r < 100; r++) {
+			int i = r % 7 - 3;
+			double d = r * 0.25;
+			string str = (r % 2 == 0 ? "ab" : "cd");
+			rec->fromString (to_string (i) + "|" + to_string (d) + "|" + str + "|");
+			if (r % 3 == 0) {
+				rec->toBinary (space.data ());
+				rec->fromBinary (space.data ());
+			}
+
+			// the second time around, an attribute is changed, which the shared subexpressions must notice
+			for (int rep = 0; rep < 2; rep++) {
+				ok = ok && group[0] ().toDouble () == d * 1.5;
+				ok = ok && group[1] ().toDouble () == i * d + i * d;
+				ok = ok && group[2] ().toBool () == (i * d > 3.0);
+				ok = ok && group[3] ().toString () == str + "x";
+				ok = ok && group[4] ().toBool () == (str == "ab");
+				ok = ok && group[5] ().toInt () == 1;
+
+				// the concatenation is only done once, so both of its uses see the very same string
+				ok = ok && group[3] ().stringVal.data == group[6] ().stringVal.data;
+
+				i++;
+				rec->getAtt (0)->fromInt (i);
+			}
+		}
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 16:
+	{
+		// computations that are built directly (as the SQL layer does) work just like the
+		// ones that are parsed from strings
+		cout << "TEST 16..." << flush;
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("d", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+
+		// the text of a parsed computation parses back into the same computation
+		bool ok = true;
+		string text = "&& (> (+ ([i], int[2]), um ([d])), ! (== ([s], string[ab])))";
+		MyDB_CompNodePtr parsed = MyDB_CompNode :: parse (text);
+		ok = ok && parsed->toString () == text && MyDB_CompNode :: parse (parsed->toString ())->toString () == text;
+
+		// the same computation, built directly
+		MyDB_CompNodePtr built = MyDB_CompNode :: makeOp ("&&", {
+			MyDB_CompNode :: makeOp (">", {
+				MyDB_CompNode :: makeOp ("+", {MyDB_CompNode :: makeAtt ("i"), 
+					MyDB_CompNode :: makeConstant (MyDB_Value :: fromInt (2), make_shared <MyDB_IntAttType> ())}),
+				MyDB_CompNode :: makeOp ("um", {MyDB_CompNode :: makeAtt ("d")})}),
+			MyDB_CompNode :: makeOp ("!", {
+				MyDB_CompNode :: makeOp ("==", {MyDB_CompNode :: makeAtt ("s"), 
+					MyDB_CompNode :: makeConstant (MyDB_Value :: fromString (MyDB_StringView ("ab")), nullptr)})})});
+		ok = ok && built->toString () == text;
+
+		// resolving finds the positions; a wrong position is not trusted
+		built->resolve (mySchema);
+		MyDB_CompNodePtr attS = built->inputs[1]->inputs[0]->inputs[0];
+		ok = ok && attS->attIndex == 2 && attS->findAtt (mySchema).first == 2;
+		MyDB_CompNodePtr attI = built->inputs[0]->inputs[0]->inputs[0];
+		attI->attIndex = 1;
+		ok = ok && attI->findAtt (mySchema).first == 0;
+
+		// renaming copies the computation, and leaves the original alone
+		MyDB_CompNodePtr renamed = built->renameAtts ([] (string name) {return "t_" + name;});
+		ok = ok && renamed->toString () == "&& (> (+ ([t_i], int[2]), um ([t_d])), ! (== ([t_s], string[ab])))" && 
+			built->toString () == text;
+
+		// all of them compute the same thing, a record at a time and a batch at a time
+		valFunc fromText = rec->compileValueComputation (text);
+		vector <valFunc> fromTrees = rec->compileValueComputations (vector <MyDB_CompNodePtr> {parsed, built});
+		MyDB_Batch batch (mySchema);
+		MyDB_BatchComputation batchComp (built, batch);
+		vector <char> space (100 * 64);
+		vector <void *> recs;
+		char *pos = space.data ();
+		for (int r = 0; r < 100; r++) {
+			rec->fromString (to_string (r % 9 - 4) + "|" + to_string (r * -0.5) + "|" + (r % 2 == 0 ? "ab" : "cd") + "|");
+			recs.push_back (pos);
+			pos = (char *) rec->toBinary (pos);
+			batch.append (recs.back ());
+		}
+		vector <int> selection;
+		batch.selectAll (selection);
+		MyDB_Column &col = batchComp.evaluate (selection);
+		for (int r = 0; r < 100; r++) {
+			rec->fromBinary (recs[r]);
+			bool expected = fromText ().toBool ();
+			ok = ok && fromTrees[0] ().toBool () == expected && fromTrees[1] ().toBool () == expected &&
+				col.getValue (r).toBool () == expected;
+		}
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 17:
+	{
+		// predicates and projections compiled to native code agree with the interpreter, and
+		// are only compiled once; this also times both, to find the break-even table size
+		cout << "TEST 17..." << flush;
+		vector <string> codes = {"AIR", "MAIL", "SHIP"};
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("d", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("c", make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (codes))));
+		mySchema->appendAtt (make_pair ("b", make_shared <MyDB_BoolAttType> ()));
+		mySchema->appendAtt (make_pair ("t", make_shared <MyDB_StringAttType> ()));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+
+		int numRecs = 200000;
+		vector <char> space (numRecs * 64);
+		vector <void *> recs;
+		char *pos = space.data ();
+		for (int i = 0; i < numRecs; i++) {
+			rec->fromString (to_string (i % 101 - 50) + "|" + codes[i % 3] + to_string (i % 7) + "|" + to_string (i * 0.25) + 
+				"|" + codes[i % 2] + "|" + (i % 3 == 0 ? "true" : "false") + "|x" + to_string (i % 11) + "|");
+			recs.push_back (pos);
+			pos = (char *) rec->toBinary (pos);
+		}
+
+		MyDB_SchemaPtr outSchema = make_shared <MyDB_Schema> ();
+		outSchema->appendAtt (make_pair ("o1", make_shared <MyDB_DoubleAttType> ()));
+		outSchema->appendAtt (make_pair ("o2", make_shared <MyDB_IntAttType> ()));
+		outSchema->appendAtt (make_pair ("o3", make_shared <MyDB_StringAttType> ()));
+		outSchema->appendAtt (make_pair ("o4", make_shared <MyDB_StringAttType> ()));
+		outSchema->appendAtt (make_pair ("o5", make_shared <MyDB_BoolAttType> ()));
+		MyDB_RecordPtr interpOut = make_shared <MyDB_Record> (outSchema);
+		MyDB_RecordPtr nativeOut = make_shared <MyDB_Record> (outSchema);
+
+		string pred = "&& (|| (> (* ([i], double[1.5]), [d]), == ([t], string[x3])), && (! ([b]), < ([s], string[MAIL3])))";
+		vector <string> projs = {"- (* ([d], int[2]), [i])", "/ (um ([i]), int[3])", "[t]", "[c]", 
+			"|| ([b], != ([s], [t]))"};
+
+		// the cache directory is made when the first module is written
+		system ("rm -rf nativeCache");
+		MyDB_NativeComputation :: setCacheDirectory ("nativeCache");
+		bool ok = true;
+
+		// a string concatenation is left to the interpreter
+		ok = ok && MyDB_NativeComputation :: compile (mySchema, MyDB_CompNode :: parse ("== (+ ([s], [t]), string[a])"),
+			{}) == nullptr;
+
+		auto start = chrono :: steady_clock :: now ();
+		MyDB_NativeComputationPtr native = MyDB_NativeComputation :: compile (mySchema, MyDB_CompNode :: parse (pred),
+			MyDB_CompNode :: parse (projs));
+		double compileTime = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+
+		if (native == nullptr) {
+			cout << "no compiler could be run, so only the fallback was checked..." << flush;
+		} else {
+
+			// the second time around, the module is already loaded
+			int numCompiled = MyDB_NativeComputation :: getNumCompiled ();
+			ok = ok && MyDB_NativeComputation :: compile (mySchema, MyDB_CompNode :: parse (pred), 
+				MyDB_CompNode :: parse (projs)) != nullptr && MyDB_NativeComputation :: getNumCompiled () == numCompiled;
+
+			vector <valFunc> comps = rec->compileValueComputations (projs);
+			valFunc predFunc = rec->compileValueComputation (pred);
+			int numAccepted = 0;
+			for (int i = 0; i < numRecs; i++) {
+				rec->fromBinary (recs[i]);
+				bool accepted = predFunc ().toBool ();
+				if (accepted) {
+					for (size_t j = 0; j < comps.size (); j++)
+						interpOut->getAtt (j)->fromValue (comps[j] ());
+				}
+				ok = ok && native->run (recs[i], nativeOut) == accepted;
+				if (accepted) {
+					numAccepted++;
+					for (size_t j = 0; j < comps.size (); j++)
+						ok = ok && interpOut->getAtt (j)->toString () == nativeOut->getAtt (j)->toString ();
+				}
+			}
+			ok = ok && numAccepted > 0 && numAccepted < numRecs;
+			ok = ok && access ("nativeCache", R_OK) == 0;
+
+			// now time the two of them
+			start = chrono :: steady_clock :: now ();
+			for (int i = 0; i < numRecs; i++) {
+				rec->fromBinary (recs[i]);
+				if (predFunc ().toBool ()) {
+					for (size_t j = 0; j < comps.size (); j++)
+						interpOut->getAtt (j)->fromValue (comps[j] ());
+				}
+			}
+			double interpTime = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count () / numRecs;
+			start = chrono :: steady_clock :: now ();
+			for (int i = 0; i < numRecs; i++)
+				native->run (recs[i], nativeOut);
+			double nativeTime = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count () / numRecs;
+			cout << "\n\tinterpreted " << interpTime * 1e9 << " ns per record, native " << nativeTime * 1e9 
+				<< " ns per record, compiling " << compileTime * 1e3 << " ms\n\tbreak-even table size: ";
+			if (interpTime > nativeTime)
+				cout << (long long) (compileTime / (interpTime - nativeTime)) << " records\n";
+			else
+				cout << "never\n";
+		}
+		system ("rm -rf nativeCache");
+		MyDB_NativeComputation :: setCacheDirectory ("");
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 18:
+	{
+		// the clauses of a predicate are moved so that a cheap clause that throws out most
+		// records runs before an expensive one that throws out almost none
+		cout << "TEST 18..." << flush;
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+
+		int numRecs = BATCH_SIZE * 40;
+		vector <char> space (numRecs * 64);
+		vector <void *> recs;
+		char *pos = space.data ();
+		for (int i = 0; i < numRecs; i++) {
+			rec->fromString (to_string (i % 100) + "|" + (i % 97 == 0 ? "odd" : "some string value") + "|");
+			recs.push_back (pos);
+			pos = (char *) rec->toBinary (pos);
+		}
+
+		string expensive = "!= (+ (+ ([s], [s]), + ([s], [s])), string[odd])";
+		string cheap = "< ([i], int[10])";
+		MyDB_CompNodePtr pred = MyDB_CompNode :: parse ("&& (" + expensive + ", && (" + cheap + ", bool[true]))");
+		vector <MyDB_CompNodePtr> clauses = MyDB_AdaptiveConjunction :: split (pred);
+		bool ok = clauses.size () == 2 && clauses[0]->toString () == expensive;
+
+		// a record at a time
+		valFunc whole = rec->compileValueComputation (pred->toString ());
+		MyDB_AdaptiveConjunction byRecord (clauses, rec->compileValueComputations (clauses));
+		for (int i = 0; i < numRecs; i++) {
+			rec->fromBinary (recs[i]);
+			ok = ok && byRecord.accepts () == whole ().toBool ();
+		}
+		ok = ok && byRecord.toString ().find (cheap) == 0;
+
+		// and a batch at a time
+		MyDB_Batch batch (mySchema);
+		MyDB_AdaptiveConjunction byBatch (clauses, batch);
+		vector <int> selection;
+		int start = 0;
+		for (int i = 0; i < numRecs; i++) {
+			if (!batch.append (recs[i]) && i < numRecs - 1)
+				continue;
+			batch.selectAll (selection);
+			byBatch.filter (selection);
+			size_t next = 0;
+			for (int j = 0; j < batch.size (); j++) {
+				rec->fromBinary (recs[start + j]);
+				bool accepted = next < selection.size () && selection[next] == j;
+				ok = ok && accepted == whole ().toBool ();
+				if (accepted)
+					next++;
+			}
+			start = i + 1;
+			batch.clear ();
+		}
+		ok = ok && byBatch.toString ().find (cheap) == 0;
+		cout << "\n\t" << byRecord.toString () << "\n\t" << byBatch.toString () << "\n";
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 19:
+	{
+		// an || of equality checks against constants becomes an in list, which gives the same
+		// answers as the || does, for both short lists and long ones
+		cout << "TEST 19..." << flush;
+		vector <string> codes = {"AIR", "MAIL", "SHIP", "RAIL"};
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("d", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("c", make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (codes))));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+
+		int numRecs = 1000;
+		vector <char> space (numRecs * 64);
+		vector <void *> recs;
+		char *pos = space.data ();
+		for (int r = 0; r < numRecs; r++) {
+			rec->fromString (to_string (r % 30) + "|" + to_string (r * 0.5) + "|w" + to_string (r % 20) + "|" + codes[r % 4] + "|");
+			recs.push_back (pos);
+			pos = (char *) rec->toBinary (pos);
+		}
+
+		// writes out the || of att == each of the constants
+		auto anyOf = [] (string att, vector <string> constants) {
+			string res = "== ([" + att + "], " + constants.back () + ")";
+			for (int i = constants.size () - 2; i >= 0; i--)
+				res = "|| (== ([" + att + "], " + constants[i] + "), " + res + ")";
+			return res;
+		};
+		vector <string> manyInts, manyStrings;
+		for (int i = 0; i < 12; i++)
+			manyInts.push_back ("int[" + to_string (i * 2) + "]");
+		for (int i = 0; i < 10; i++)
+			manyStrings.push_back ("string[w" + to_string (i) + "]");
+		manyStrings.push_back ("string[nope]");
+
+		vector <pair <string, function <bool (int)>>> checks = {
+			{anyOf ("i", {"int[1]", "int[7]", "int[12]"}), [] (int r) {return r % 30 == 1 || r % 30 == 7 || r % 30 == 12;}},
+			{anyOf ("i", manyInts), [] (int r) {return r % 30 < 24 && r % 2 == 0;}},
+			{anyOf ("d", {"int[1]", "int[3]", "double[4.5]"}), [] (int r) {return r == 2 || r == 6 || r == 9;}},
+			{anyOf ("s", {"string[w1]", "string[w3]"}), [] (int r) {return r % 20 == 1 || r % 20 == 3;}},
+			{anyOf ("s", manyStrings), [] (int r) {return r % 20 < 10;}},
+			{anyOf ("c", {"string[MAIL]", "string[SHIP]"}), [] (int r) {return r % 4 == 1 || r % 4 == 2;}},
+			{anyOf ("c", {"string[TRUCK]", "string[AIR]"}), [] (int r) {return r % 4 == 0;}}};
+
+		// the text of an in list parses back into the same list
+		bool ok = true;
+		MyDB_CompNodePtr small = MyDB_CompNode :: parse (checks[0].first)->findInLists ();
+		ok = ok && small->toString () == "in ([i], int[1], int[7], int[12])";
+		ok = ok && MyDB_CompNode :: parse (small->toString ())->toString () == small->toString ();
+		ok = ok && small->expandInList ()->findInLists ()->toString () == small->toString ();
+
+		// an || that also checks something else keeps that check
+		MyDB_CompNodePtr mixed = MyDB_CompNode :: parse ("|| (== ([i], int[1]), || (> ([d], int[2]), == ([i], int[7])))");
+		ok = ok && mixed->findInLists ()->toString () == "|| (in ([i], int[1], int[7]), > ([d], int[2]))";
+
+		for (auto &check : checks) {
+			valFunc byRecord = rec->compileValueComputation (check.first);
+			MyDB_Batch batch (mySchema);
+			MyDB_BatchComputation byBatch (MyDB_CompNode :: parse (check.first)->findInLists (), batch);
+			int start = 0;
+			for (int r = 0; r < numRecs; r++) {
+				rec->fromBinary (recs[r]);
+				ok = ok && byRecord ().toBool () == check.second (r);
+				if (!batch.append (recs[r]) && r < numRecs - 1)
+					continue;
+				vector <int> selection;
+				batch.selectAll (selection);
+				MyDB_Column &col = byBatch.evaluate (selection);
+				for (int j = 0; j < batch.size (); j++)
+					ok = ok && (col.bools[j] != 0) == check.second (start + j);
+				start = r + 1;
+				batch.clear ();
+			}
+		}
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 20:
+	{
+		// like agrees with a simple matcher that copies each string out and tries every way
+		// of matching the %s, and the common shapes of pattern are quite a bit faster than it
+		cout << "TEST 20..." << flush;
+		vector <string> codes = {"AIR", "MAIL", "SHIP", "RAIL", "TRUCK"};
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("c", make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (codes))));
+		MyDB_RecordPtr rec = make_shared <MyDB_Record> (mySchema);
+
+		function <bool (string, string)> naive = [&naive] (string s, string p) {
+			if (p == "")
+				return s == "";
+			if (p[0] == '%')
+				return naive (s, p.substr (1)) || (s != "" && naive (s.substr (1), p));
+			return s != "" && (p[0] == '_' || p[0] == s[0]) && naive (s.substr (1), p.substr (1));
+		};
+
+		int numRecs = 20000;
+		vector <char> space (numRecs * 128);
+		vector <void *> recs;
+		vector <string> values;
+		char *pos = space.data ();
+		srand48 (38);
+		for (int i = 0; i < numRecs; i++) {
+			string val;
+			int len = 1 + lrand48 () % 40;
+			for (int j = 0; j < len; j++)
+				val += "abcde fgh"[lrand48 () % 9];
+			if (i % 7 == 0)
+				val = "furiously " + val + " deposits";
+			values.push_back (val);
+			rec->fromString (val + "|" + codes[i % 5] + "|");
+			recs.push_back (pos);
+			pos = (char *) rec->toBinary (pos);
+		}
+
+		vector <string> patterns = {"furiously%", "%deposits", "%bead%", "%", "", "abc", "a_c%", "%a%b%c%", 
+			"fur%dep%its", "%e_a%", "_", "%%", "f%s", "%ly%de%"};
+		bool ok = true;
+		for (string &pattern : patterns) {
+			string text = "like ([s], string[" + pattern + "])";
+			valFunc byRecord = rec->compileValueComputation (text);
+			valFunc onCodes = rec->compileValueComputation ("like ([c], string[" + pattern + "])");
+			MyDB_Batch batch (mySchema);
+			MyDB_BatchComputation byBatch (text, batch);
+			int start = 0;
+			for (int i = 0; i < numRecs; i++) {
+				rec->fromBinary (recs[i]);
+				ok = ok && byRecord ().toBool () == naive (values[i], pattern);
+				ok = ok && onCodes ().toBool () == naive (codes[i % 5], pattern);
+				if (!batch.append (recs[i]) && i < numRecs - 1)
+					continue;
+				vector <int> selection;
+				batch.selectAll (selection);
+				MyDB_Column &col = byBatch.evaluate (selection);
+				for (int j = 0; j < batch.size (); j++)
+					ok = ok && (col.bools[j] != 0) == naive (values[start + j], pattern);
+				start = i + 1;
+				batch.clear ();
+			}
+		}
+		ok = ok && MyDB_CompNode :: parse ("like ([s], string[a%])")->toString () == "like ([s], string[a%])";
+		ok = ok && MyDB_LikePattern ("%abc%", nullptr).getKind () == LikeContains && 
+			MyDB_LikePattern ("abc%", nullptr).getKind () == LikePrefix &&
+			MyDB_LikePattern ("%abc", nullptr).getKind () == LikeSuffix &&
+			MyDB_LikePattern ("%a_c", nullptr).getKind () == LikeGeneral;
+
+		// time each of the fast paths against the simple matcher
+		cout << "\n";
+		for (string pattern : {"furiously%", "%deposits", "%bead%"}) {
+			MyDB_LikePattern fast (pattern, nullptr);
+			int fastCount = 0, naiveCount = 0;
+			auto startTime = chrono :: steady_clock :: now ();
+			for (int rep = 0; rep < 10; rep++)
+				for (string &val : values)
+					fastCount += fast.matches (MyDB_StringView (val));
+			double fastNanos = chrono :: duration <double, nano> (chrono :: steady_clock :: now () - startTime).count ();
+			startTime = chrono :: steady_clock :: now ();
+			for (int rep = 0; rep < 10; rep++)
+				for (string &val : values)
+					naiveCount += naive (val, pattern);
+			double naiveNanos = chrono :: duration <double, nano> (chrono :: steady_clock :: now () - startTime).count ();
+			ok = ok && fastCount == naiveCount;
+			cout << "\t'" << pattern << "': " << fastNanos / (10 * numRecs) << " ns per string, against " <<
+				naiveNanos / (10 * numRecs) << " ns for the simple matcher\n";
+		}
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 21:
+	{
+		// compiling the same computations over a second record (or a second time) gets the
+		// plan from the cache, and each record still gets its own lambdas
+		cout << "TEST 21..." << flush;
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		MyDB_RecordPtr first = make_shared <MyDB_Record> (mySchema);
+		MyDB_RecordPtr second = make_shared <MyDB_Record> (mySchema);
+		first->fromString ("3|furiously|");
+		second->fromString ("12|quickly|");
+
+		vector <string> comps = {"&& (|| (== ([i], int[3]), == ([i], int[12])), like ([s], string[%ly]))", 
+			"+ ([i], * (int[2], int[5]))"};
+		MyDB_CompiledPlan :: clear ();
+		int built = MyDB_CompiledPlan :: getNumBuilt ();
+		int hits = MyDB_CompiledPlan :: getNumHits ();
+		vector <valFunc> firstFuncs = first->compileValueComputations (comps);
+		vector <valFunc> secondFuncs = second->compileValueComputations (comps);
+		bool ok = MyDB_CompiledPlan :: getNumBuilt () == built + 1 && MyDB_CompiledPlan :: getNumHits () == hits + 1;
+		ok = ok && firstFuncs[0] ().toBool () && secondFuncs[0] ().toBool ();
+		ok = ok && firstFuncs[1] ().toInt () == 13 && secondFuncs[1] ().toInt () == 22;
+		second->fromString ("7|quickly|");
+		ok = ok && firstFuncs[1] ().toInt () == 13 && secondFuncs[1] ().toInt () == 17 && !secondFuncs[0] ().toBool ();
+
+		// the plan has the constants folded, and the || turned into an in
+		MyDB_CompiledPlanPtr plan = MyDB_CompiledPlan :: get (mySchema, comps);
+		ok = ok && plan->getComputations ()[1]->toString () == "+ ([i], int[10])" &&
+			plan->getComputations ()[0]->inputs[0]->op == "in";
+
+		// a schema that looks the same but has a different dictionary gets a different plan
+		MyDB_SchemaPtr dictOne = make_shared <MyDB_Schema> ();
+		MyDB_SchemaPtr dictTwo = make_shared <MyDB_Schema> ();
+		dictOne->appendAtt (make_pair ("c", make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (vector <string> {"AIR", "MAIL"}))));
+		dictTwo->appendAtt (make_pair ("c", make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (vector <string> {"MAIL", "AIR"}))));
+		ok = ok && MyDB_CompiledPlan :: get (dictOne, vector <string> {"[c]"}) != MyDB_CompiledPlan :: get (dictTwo, vector <string> {"[c]"});
+		ok = ok && MyDB_CompiledPlan :: get (dictOne, vector <string> {"[c]"}) == MyDB_CompiledPlan :: get (dictOne, vector <string> {"[c]"});
+
+		// time compiling with and without the cache
+		int reps = 2000;
+		auto startTime = chrono :: steady_clock :: now ();
+		for (int i = 0; i < reps; i++)
+			second->compileValueComputations (comps);
+		double cached = chrono :: duration <double, micro> (chrono :: steady_clock :: now () - startTime).count ();
+		startTime = chrono :: steady_clock :: now ();
+		for (int i = 0; i < reps; i++) {
+			MyDB_CompiledPlan :: clear ();
+			second->compileValueComputations (comps);
+		}
+		double uncached = chrono :: duration <double, micro> (chrono :: steady_clock :: now () - startTime).count ();
+		cout << "\n\tcompiling took " << cached / reps << " us from the cache, and " << uncached / reps << " us without it\n";
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	case 22:
+	{
+		// the order of the normalized keys is the order of the values, and the radix sort
+		// puts the keys in order without moving items with the same key past one another
+		cout << "TEST 22..." << flush;
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("i", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("d", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("s", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("c", make_shared <MyDB_DictAttType> (make_shared <MyDB_Dictionary> (vector <string> {"AIR", "MAIL", "RAIL", "SHIP"}))));
+		MyDB_RecordPtr lhs = make_shared <MyDB_Record> (mySchema);
+		MyDB_RecordPtr rhs = make_shared <MyDB_Record> (mySchema);
+		vector <string> recs = {"0|0.0|a|AIR|", "-1|-0.5|ab|MAIL|", "1|0.5|abcdefgh|RAIL|", "-2147483647|-1e300|abcdefghi|SHIP|",
+			"2147483647|1e300|abcdefghj|AIR|", "17|3.25|A|MAIL|", "-17|-3.25|zz|RAIL|", "5|2.5e-300|\xff|SHIP|"};
+
+		bool ok = true;
+		for (string att : {"[i]", "[d]", "[s]", "[c]"}) {
+			for (bool descending : {false, true}) {
+				MyDB_NormalizedKeyPtr lhsKey = MyDB_NormalizedKey :: build (lhs, att, descending);
+				MyDB_NormalizedKeyPtr rhsKey = MyDB_NormalizedKey :: build (rhs, att, descending);
+				function <bool ()> less = descending ? buildRecordComparator (rhs, lhs, att) : buildRecordComparator (lhs, rhs, att);
+				ok = ok && lhsKey != nullptr && lhsKey->isExact () == (att != "[s]");
+				for (string &left : recs) {
+					for (string &right : recs) {
+						lhs->fromString (left);
+						rhs->fromString (right);
+						uint64_t l = lhsKey->getKey (), r = rhsKey->getKey ();
+
+						// a key that is not exact may have ties that the comparator has to break
+						if (l < r)
+							ok = ok && less ();
+						if (lhsKey->isExact () && l == r)
+							ok = ok && !less ();
+						if (less ())
+							ok = ok && l <= r && (l < r || !lhsKey->isExact ());
+					}
+				}
+			}
+		}
+		ok = ok && MyDB_NormalizedKey :: build (lhs, "== ([i], int[1])") == nullptr;
+
+		// sort lots of keys, with lots of ties
+		srand48 (530);
+		for (int n : {10, 1000, 100000}) {
+			vector <MyDB_KeyedPointer> keys;
+			for (int i = 0; i < n; i++)
+				keys.push_back ({MyDB_NormalizedKey :: fromInt ((int) (lrand48 () % 2000) - 1000), (void *) (size_t) i});
+			vector <MyDB_KeyedPointer> expected = keys;
+			stable_sort (expected.begin (), expected.end (), 
+				[] (const MyDB_KeyedPointer &a, const MyDB_KeyedPointer &b) {return a.key < b.key;});
+			MyDB_NormalizedKey :: sort (keys);
+			for (int i = 0; i < n; i++)
+				ok = ok && keys[i].key == expected[i].key && keys[i].ptr == expected[i].ptr;
+		}
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
+	case 23:
+	{
+		// the join hash table finds exactly the records with a given hash, the hashes of a
+		// list of values depend on their order and do not cancel out, and doubles are hashed
+		// on more than their int part; also time probes into tables that fit in L2, that fit
+		// in L3, and that do not, against the map of lists that the joins used to build
+		cout << "TEST 23..." << flush;
+		bool ok = true;
+		size_t ab = MyDB_Value :: combineHashes (MyDB_Value :: combineHashes (0, MyDB_Value :: fromInt (1).hash ()), 
+			MyDB_Value :: fromInt (2).hash ());
+		size_t ba = MyDB_Value :: combineHashes (MyDB_Value :: combineHashes (0, MyDB_Value :: fromInt (2).hash ()), 
+			MyDB_Value :: fromInt (1).hash ());
+		size_t aa = MyDB_Value :: combineHashes (MyDB_Value :: combineHashes (0, MyDB_Value :: fromInt (7).hash ()), 
+			MyDB_Value :: fromInt (7).hash ());
+		size_t bb = MyDB_Value :: combineHashes (MyDB_Value :: combineHashes (0, MyDB_Value :: fromInt (8).hash ()), 
+			MyDB_Value :: fromInt (8).hash ());
+		ok = ok && ab != ba && aa != bb;
+		ok = ok && MyDB_Value :: fromDouble (2.1).hash () != MyDB_Value :: fromDouble (2.9).hash ();
+		ok = ok && MyDB_Value :: fromDouble (3.0).hash () == MyDB_Value :: fromInt (3).hash ();
+		ok = ok && MyDB_Value :: fromDouble (-0.0).hash () == MyDB_Value :: fromDouble (0.0).hash ();
+
+		// records 0, 1, ... have keys that are spread over a third as many values, so each key
+		// has a few records; half of the probes are for keys that are not there
+		auto hashOf = [] (long key) {
+			return MyDB_Value :: combineHashes (0, MyDB_Value :: fromInt ((int) key).hash ());
+		};
+		srand48 (530);
+		for (long numRecs : {8000L, 128000L, 2000000L}) {
+
+			MyDB_JoinHashTable flat;
+			unordered_map <size_t, vector <void *>> lists;
+			for (long i = 0; i < numRecs; i++) {
+				size_t hashVal = hashOf (i % (numRecs / 3));
+				flat.insert (hashVal, (void *) (i + 1));
+				lists[hashVal].push_back ((void *) (i + 1));
+			}
+			ok = ok && flat.size () == (size_t) numRecs;
+
+			long numProbes = 4000000;
+			vector <size_t> probes (numProbes);
+			for (auto &p : probes)
+				p = hashOf (lrand48 () % (2 * (numRecs / 3)));
+
+			size_t sums[2] = {0, 0};
+			double times[2];
+			for (int which = 0; which < 2; which++) {
+				auto start = chrono :: steady_clock :: now ();
+				size_t sum = 0;
+				for (size_t p : probes) {
+					if (which == 0) {
+						flat.probe (p, [&] (void *rec) {sum += (size_t) rec;});
+					} else {
+						auto found = lists.find (p);
+						if (found != lists.end ())
+							for (void *rec : found->second)
+								sum += (size_t) rec;
+					}
+				}
+				times[which] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count () * 1e9 / numProbes;
+				sums[which] = sum;
+			}
+			ok = ok && sums[0] == sums[1] && sums[0] > 0;
+			cout << "\n\t" << numRecs << " records (ns per probe): flat table " << times[0] << ", map of lists " << times[1];
+		}
+
+		// a build side with only four distinct keys: adding a record should take the same
+		// time however many records already have its key, and each probe finds them all
+		for (long numRecs : {10000L, 40000L, 160000L}) {
+			MyDB_JoinHashTable flat;
+			unordered_map <size_t, vector <void *>> lists;
+			flat.reserve (numRecs);
+			double times[2];
+			for (int which = 0; which < 2; which++) {
+				auto start = chrono :: steady_clock :: now ();
+				for (long i = 0; i < numRecs; i++) {
+					if (which == 0)
+						flat.insert (hashOf (i % 4), (void *) (i + 1));
+					else
+						lists[hashOf (i % 4)].push_back ((void *) (i + 1));
+				}
+				times[which] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count () * 1e9 / numRecs;
+			}
+			ok = ok && flat.size () == (size_t) numRecs;
+			for (long key = 0; key < 5; key++) {
+				vector <void *> found;
+				flat.probe (hashOf (key), [&] (void *rec) {found.push_back (rec);});
+				vector <void *> expected;
+				if (lists.count (hashOf (key)) != 0)
+					expected = lists[hashOf (key)];
+				ok = ok && found == expected;
+			}
+			cout << "\n\t" << numRecs << " records, 4 keys (ns per insert): flat table " << times[0] << 
+				", map of lists " << times[1];
+		}
+		cout << endl;
+
+		if (ok) cout << "CORRECT" << endl << flush;
+		else cout << "***FAIL***" << endl << flush;
+		QUNIT_IS_TRUE(ok);
+	}
+	FALLTHROUGH_INTENDED;
 	default:
 		break;
 	}
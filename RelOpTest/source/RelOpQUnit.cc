@@ -20,7 +20,17 @@
 #include "RegularSelection.h"
 #include "ScanJoin.h"
 #include "SortMergeJoin.h"
+#include "HashDistinct.h"
+#include "HybridHashJoin.h"
+#include "OrderBy.h"
+#include "SortDistinct.h"
+#include "TopN.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <set>
+#include <thread>
 #include <vector>
 #include <utility>
 
@@ -587,6 +597,822 @@ int main () {
                 }
 	}
 
+	{
+		// compare a plain table with a dictionary-encoded one, on lineitem-like data
+		// where most of the bytes are in low-cardinality string columns
+		const char *flags[] = {"A", "N", "R"};
+		const char *modes[] = {"AIR", "FOB", "MAIL", "RAIL", "REG AIR", "SHIP", "TRUCK"};
+		const char *instructs[] = {"COLLECT COD", "DELIVER IN PERSON", "NONE", "TAKE BACK RETURN"};
+		const char *nations[] = {"ALGERIA", "ARGENTINA", "BRAZIL", "CANADA", "EGYPT", "ETHIOPIA", "FRANCE", 
+			"GERMANY", "INDIA", "INDONESIA", "IRAN", "IRAQ", "JAPAN", "JORDAN", "KENYA", "MOROCCO", 
+			"MOZAMBIQUE", "PERU", "CHINA", "ROMANIA", "SAUDI ARABIA", "VIETNAM", "RUSSIA", 
+			"UNITED KINGDOM", "UNITED STATES"};
+		ofstream dictFile ("dictTest.tbl");
+		for (int i = 0; i < 100000; i++) {
+			dictFile << i << "|" << flags[i % 3] << "|" << modes[(i / 3) % 7] << "|" << instructs[(i / 7) % 4] 
+				<< "|" << nations[(i * 7) % 25] << "|" << (i % 50) << "|\n";
+		}
+		dictFile.close ();
+
+		vector <string> dictOption;
+		dictOption.push_back ("dictionary");
+		auto countRecs = [] (MyDB_TableReaderWriterPtr countMe) {
+			MyDB_RecordPtr temp = countMe->getEmptyRecord ();
+			MyDB_RecordIteratorAltPtr myIter = countMe->getIteratorAlt ();
+			int count = 0;
+			while (myIter->advance ()) {
+				myIter->getCurrent (temp);
+				count++;
+			}
+			return count;
+		};
+
+		MyDB_TableReaderWriterPtr tables[2];
+		double times[2][3];
+		int counts[2][3];
+		for (int which = 0; which < 2; which++) {
+
+			// each table gets its own schema (loading may change the att types) and its
+			// own buffer manager, so that the second run does not pay for the first
+			MyDB_SchemaPtr mySchemaD = make_shared <MyDB_Schema> ();
+			mySchemaD->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+			mySchemaD->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+			mySchemaD->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+			mySchemaD->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+			mySchemaD->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+			mySchemaD->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+			MyDB_BufferManagerPtr dictMgr = make_shared <MyDB_BufferManager> (131072, 128, "dictTempFile" + to_string (which));
+			string name = (which == 0) ? "plainItems" : "dictItems";
+			MyDB_TablePtr myTable = make_shared <MyDB_Table> (name, name + ".bin", mySchemaD);
+			if (which == 1)
+				myTable->setOptions (dictOption);
+			tables[which] = make_shared <MyDB_TableReaderWriter> (myTable, dictMgr);
+			tables[which]->loadFromTextFile ("dictTest.tbl");
+
+			// an equality selection on a string
+			MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+			mySchemaOut->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableOut = make_shared <MyDB_Table> ("dictOut", "dictOut.bin", mySchemaOut);
+			MyDB_TableReaderWriterPtr selOut = make_shared <MyDB_TableReaderWriter> (myTableOut, dictMgr);
+			vector <string> projections;
+			projections.push_back ("[d_orderkey]");
+			RegularSelection mySel (tables[which], selOut, 
+				"&& (== ([d_shipmode], string[MAIL]), == ([d_nation], string[JAPAN]))", projections);
+			auto start = chrono :: steady_clock :: now ();
+			mySel.run ();
+			times[which][0] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			counts[which][0] = countRecs (selOut);
+
+			// a group by on a string
+			vector <pair <MyDB_AggType, string>> aggsToCompute;
+			aggsToCompute.push_back (make_pair (MyDB_AggType :: sumType, "[d_quantity]"));
+			vector <string> groupings;
+			groupings.push_back ("[d_nation]");
+			MyDB_SchemaPtr mySchemaAgg = make_shared <MyDB_Schema> ();
+			mySchemaAgg->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+			mySchemaAgg->appendAtt (make_pair ("d_sum", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableAgg = make_shared <MyDB_Table> ("dictAgg", "dictAgg.bin", mySchemaAgg);
+			MyDB_TableReaderWriterPtr aggOut = make_shared <MyDB_TableReaderWriter> (myTableAgg, dictMgr);
+			Aggregate myAgg (tables[which], aggOut, aggsToCompute, groupings, "bool[true]");
+			start = chrono :: steady_clock :: now ();
+			myAgg.run ();
+			times[which][1] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			counts[which][1] = countRecs (aggOut);
+
+			// a join on a string
+			MyDB_SchemaPtr mySchemaJ = make_shared <MyDB_Schema> ();
+			mySchemaJ->appendAtt (make_pair ("j_orderkey", make_shared <MyDB_IntAttType> ()));
+			mySchemaJ->appendAtt (make_pair ("j_nation", make_shared <MyDB_StringAttType> ()));
+			MyDB_TablePtr myTableJ = make_shared <MyDB_Table> ("dictJoinIn", "dictJoinIn.bin", mySchemaJ);
+			MyDB_TableReaderWriterPtr joinIn = make_shared <MyDB_TableReaderWriter> (myTableJ, dictMgr);
+			vector <string> joinInProj;
+			joinInProj.push_back ("[d_orderkey]");
+			joinInProj.push_back ("[d_nation]");
+			RegularSelection makeJoinIn (tables[which], joinIn, "< ([d_orderkey], int[10])", joinInProj);
+			makeJoinIn.run ();
+
+			MyDB_SchemaPtr mySchemaJOut = make_shared <MyDB_Schema> ();
+			mySchemaJOut->appendAtt (make_pair ("j_orderkey", make_shared <MyDB_IntAttType> ()));
+			mySchemaJOut->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableJOut = make_shared <MyDB_Table> ("dictJoinOut", "dictJoinOut.bin", mySchemaJOut);
+			MyDB_TableReaderWriterPtr joinOut = make_shared <MyDB_TableReaderWriter> (myTableJOut, dictMgr);
+			vector <pair <string, string>> hashAtts;
+			hashAtts.push_back (make_pair (string ("[j_nation]"), string ("[d_nation]")));
+			vector <string> joinProj;
+			joinProj.push_back ("[j_orderkey]");
+			joinProj.push_back ("[d_orderkey]");
+			ScanJoin myJoin (joinIn, tables[which], joinOut, "== ([j_nation], [d_nation])", joinProj, hashAtts,
+				"bool[true]", "bool[true]");
+			start = chrono :: steady_clock :: now ();
+			myJoin.run ();
+			times[which][2] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			counts[which][2] = countRecs (joinOut);
+		}
+
+		cout << "\nDictionary encoding (plain vs. encoded):\n";
+		cout << "\tpages:     " << tables[0]->getNumPages () << " vs. " << tables[1]->getNumPages () << "\n";
+		cout << "\tselection: " << times[0][0] << "s vs. " << times[1][0] << "s\n";
+		cout << "\tgroup by:  " << times[0][1] << "s vs. " << times[1][1] << "s\n";
+		cout << "\tjoin:      " << times[0][2] << "s vs. " << times[1][2] << "s\n";
+
+		QUNIT_IS_TRUE (tables[1]->getNumPages () < tables[0]->getNumPages ());
+		QUNIT_IS_EQUAL (counts[0][0], 572);
+		QUNIT_IS_EQUAL (counts[1][0], counts[0][0]);
+		QUNIT_IS_EQUAL (counts[0][1], 25);
+		QUNIT_IS_EQUAL (counts[1][1], counts[0][1]);
+		QUNIT_IS_EQUAL (counts[0][2], 40000);
+		QUNIT_IS_EQUAL (counts[1][2], counts[0][2]);
+
+		// appending more distinct values than fit in two bytes keeps growing the dictionary
+		MyDB_RecordPtr temp = tables[1]->getEmptyRecord ();
+		for (int i = 0; i < 70000; i++) {
+			temp->fromString (to_string (100000 + i) + "|A|MODE" + to_string (i) + "|NONE|PERU|1|");
+			tables[1]->append (temp);
+		}
+		MyDB_DictAttTypePtr modeType = dynamic_pointer_cast <MyDB_DictAttType> 
+			(tables[1]->getTable ()->getSchema ()->getAttByName ("d_shipmode").second);
+		QUNIT_IS_TRUE (modeType != nullptr && modeType->getDictionary ()->size () > 70000);
+		MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+		mySchemaOut->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+		MyDB_TablePtr myTableOut = make_shared <MyDB_Table> ("dictOut", "dictOut.bin", mySchemaOut);
+		MyDB_TableReaderWriterPtr selOut = make_shared <MyDB_TableReaderWriter> (myTableOut, tables[1]->getBufferMgr ());
+		vector <string> projections;
+		projections.push_back ("[d_shipmode]");
+		RegularSelection mySel (tables[1], selOut, "== ([d_orderkey], int[169999])", projections);
+		mySel.run ();
+		MyDB_RecordPtr outRec = selOut->getEmptyRecord ();
+		MyDB_RecordIteratorAltPtr myIter = selOut->getIteratorAlt ();
+		string found = "";
+		while (myIter->advance ()) {
+			myIter->getCurrent (outRec);
+			found += outRec->getAtt (0)->toString ();
+		}
+		QUNIT_IS_EQUAL (found, "MODE69999");
+		QUNIT_IS_EQUAL (countRecs (tables[1]), 170000);
+	}
+
+	{
+		// compare running the computations a record at a time with running them a batch
+		// at a time, on the same data as above
+		auto sumRecs = [] (MyDB_TableReaderWriterPtr sumMe, int whichAtt) {
+			MyDB_RecordPtr temp = sumMe->getEmptyRecord ();
+			MyDB_RecordIteratorAltPtr myIter = sumMe->getIteratorAlt ();
+			double sum = 0;
+			while (myIter->advance ()) {
+				myIter->getCurrent (temp);
+				sum += temp->getAtt (whichAtt)->toDouble ();
+			}
+			return sum;
+		};
+
+		int numTuples = 100000;
+		double times[2][3];
+		double sums[2][3];
+		for (int which = 0; which < 2; which++) {
+
+			bool batchMode = (which == 1);
+			MyDB_SchemaPtr mySchemaB = make_shared <MyDB_Schema> ();
+			mySchemaB->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+			mySchemaB->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+			mySchemaB->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+			mySchemaB->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+			mySchemaB->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+			mySchemaB->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+			MyDB_BufferManagerPtr batchMgr = make_shared <MyDB_BufferManager> (131072, 128, "batchTempFile" + to_string (which));
+			MyDB_TablePtr myTable = make_shared <MyDB_Table> ("batchItems", "batchItems.bin", mySchemaB);
+			MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, batchMgr);
+			items->loadFromTextFile ("dictTest.tbl");
+
+			// a selection with arithmetic, mixed types, and a string comparison
+			MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+			mySchemaOut->appendAtt (make_pair ("b_orderkey", make_shared <MyDB_IntAttType> ()));
+			mySchemaOut->appendAtt (make_pair ("b_value", make_shared <MyDB_DoubleAttType> ()));
+			MyDB_TablePtr myTableOut = make_shared <MyDB_Table> ("batchOut", "batchOut.bin", mySchemaOut);
+			MyDB_TableReaderWriterPtr selOut = make_shared <MyDB_TableReaderWriter> (myTableOut, batchMgr);
+			vector <string> projections;
+			projections.push_back ("[d_orderkey]");
+			projections.push_back ("- (* ([d_quantity], double[1.5]), int[2])");
+			RegularSelection mySel (items, selOut, "&& (> (* ([d_quantity], double[1.5]), double[70.0]), "
+				"|| (== ([d_returnflag], string[N]), < ([d_nation], string[CHINA])))", projections);
+			mySel.setBatchMode (batchMode);
+			auto start = chrono :: steady_clock :: now ();
+			mySel.run ();
+			times[which][0] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			sums[which][0] = sumRecs (selOut, 1);
+
+			// a group by on two atts
+			vector <pair <MyDB_AggType, string>> aggsToCompute;
+			aggsToCompute.push_back (make_pair (MyDB_AggType :: sumType, "[d_quantity]"));
+			vector <string> groupings;
+			groupings.push_back ("[d_shipmode]");
+			groupings.push_back ("[d_returnflag]");
+			MyDB_SchemaPtr mySchemaAgg = make_shared <MyDB_Schema> ();
+			mySchemaAgg->appendAtt (make_pair ("b_shipmode", make_shared <MyDB_StringAttType> ()));
+			mySchemaAgg->appendAtt (make_pair ("b_returnflag", make_shared <MyDB_StringAttType> ()));
+			mySchemaAgg->appendAtt (make_pair ("b_sum", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableAgg = make_shared <MyDB_Table> ("batchAgg", "batchAgg.bin", mySchemaAgg);
+			MyDB_TableReaderWriterPtr aggOut = make_shared <MyDB_TableReaderWriter> (myTableAgg, batchMgr);
+			Aggregate myAgg (items, aggOut, aggsToCompute, groupings, "< ([d_quantity], int[40])");
+			myAgg.setBatchMode (batchMode);
+			start = chrono :: steady_clock :: now ();
+			myAgg.run ();
+			times[which][1] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			sums[which][1] = sumRecs (aggOut, 2);
+
+			// a join on an int, with a selective predicate on the big side
+			MyDB_SchemaPtr mySchemaJ = make_shared <MyDB_Schema> ();
+			mySchemaJ->appendAtt (make_pair ("j_quantity", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableJ = make_shared <MyDB_Table> ("batchJoinIn", "batchJoinIn.bin", mySchemaJ);
+			MyDB_TableReaderWriterPtr joinIn = make_shared <MyDB_TableReaderWriter> (myTableJ, batchMgr);
+			vector <string> joinInProj;
+			joinInProj.push_back ("[d_orderkey]");
+			RegularSelection makeJoinIn (items, joinIn, "< ([d_orderkey], int[50])", joinInProj);
+			makeJoinIn.run ();
+
+			MyDB_SchemaPtr mySchemaJOut = make_shared <MyDB_Schema> ();
+			mySchemaJOut->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableJOut = make_shared <MyDB_Table> ("batchJoinOut", "batchJoinOut.bin", mySchemaJOut);
+			MyDB_TableReaderWriterPtr joinOut = make_shared <MyDB_TableReaderWriter> (myTableJOut, batchMgr);
+			vector <pair <string, string>> hashAtts;
+			hashAtts.push_back (make_pair (string ("[j_quantity]"), string ("[d_quantity]")));
+			vector <string> joinProj;
+			joinProj.push_back ("[d_orderkey]");
+			ScanJoin myJoin (joinIn, items, joinOut, "== ([j_quantity], [d_quantity])", joinProj, hashAtts,
+				"bool[true]", "== ([d_shipmode], string[RAIL])");
+			myJoin.setBatchMode (batchMode);
+			start = chrono :: steady_clock :: now ();
+			myJoin.run ();
+			times[which][2] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			sums[which][2] = sumRecs (joinOut, 0);
+		}
+
+		cout << "\nBatch evaluation (ns per input tuple, record at a time vs. batch at a time):\n";
+		cout << "\tselection: " << times[0][0] * 1e9 / numTuples << " vs. " << times[1][0] * 1e9 / numTuples << "\n";
+		cout << "\tgroup by:  " << times[0][1] * 1e9 / numTuples << " vs. " << times[1][1] * 1e9 / numTuples << "\n";
+		cout << "\tjoin:      " << times[0][2] * 1e9 / numTuples << " vs. " << times[1][2] * 1e9 / numTuples << "\n";
+
+		QUNIT_IS_TRUE (sums[0][0] > 0);
+		QUNIT_IS_EQUAL (sums[1][0], sums[0][0]);
+		QUNIT_IS_TRUE (sums[0][1] > 0);
+		QUNIT_IS_EQUAL (sums[1][1], sums[0][1]);
+		QUNIT_IS_TRUE (sums[0][2] > 0);
+		QUNIT_IS_EQUAL (sums[1][2], sums[0][2]);
+	}
+
+	{
+		// run a selection on one, two, and four threads, a record at a time and a batch at a time,
+		// on the same data as above; small pages, so that there are many of them to hand out, and
+		// so that the threads have to share a buffer that cannot hold the whole table
+		MyDB_SchemaPtr mySchemaP = make_shared <MyDB_Schema> ();
+		mySchemaP->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+		MyDB_BufferManagerPtr parMgr = make_shared <MyDB_BufferManager> (4096, 64, "parTempFile");
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("parItems", "parItems.bin", mySchemaP);
+		MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, parMgr);
+		items->loadFromTextFile ("dictTest.tbl");
+
+		int numThreads[] = {1, 2, 4};
+		double times[2][3];
+		size_t counts[2][3];
+		double sums[2][3];
+		for (int mode = 0; mode < 2; mode++) {
+			for (int which = 0; which < 3; which++) {
+
+				MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+				mySchemaOut->appendAtt (make_pair ("p_orderkey", make_shared <MyDB_IntAttType> ()));
+				mySchemaOut->appendAtt (make_pair ("p_nation", make_shared <MyDB_StringAttType> ()));
+				mySchemaOut->appendAtt (make_pair ("p_value", make_shared <MyDB_DoubleAttType> ()));
+				string outName = "parOut" + to_string (mode) + to_string (which);
+				MyDB_TablePtr myTableOut = make_shared <MyDB_Table> (outName, outName + ".bin", mySchemaOut);
+				MyDB_TableReaderWriterPtr selOut = make_shared <MyDB_TableReaderWriter> (myTableOut, parMgr);
+				vector <string> projections;
+				projections.push_back ("[d_orderkey]");
+				projections.push_back ("[d_nation]");
+				projections.push_back ("- (* ([d_quantity], double[1.5]), int[2])");
+				RegularSelection mySel (items, selOut, "&& (> ([d_quantity], int[10]), "
+					"|| (== ([d_returnflag], string[N]), < ([d_nation], string[CHINA])))", projections);
+				mySel.setBatchMode (mode == 1);
+				mySel.setNumThreads (numThreads[which]);
+				auto start = chrono :: steady_clock :: now ();
+				mySel.run ();
+				times[mode][which] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+
+				// every record should be there once, whatever order the threads wrote them in
+				MyDB_RecordPtr temp = selOut->getEmptyRecord ();
+				MyDB_RecordIteratorAltPtr myIter = selOut->getIteratorAlt ();
+				counts[mode][which] = 0;
+				sums[mode][which] = 0;
+				while (myIter->advance ()) {
+					myIter->getCurrent (temp);
+					counts[mode][which]++;
+					sums[mode][which] += temp->getAtt (0)->toInt () * temp->getAtt (2)->toDouble () +
+						temp->getAtt (1)->toString ().size ();
+				}
+
+				// and the zone map of the output should know what is on the pages that the threads wrote
+				QUNIT_IS_EQUAL (selOut->getZoneMap ()->getNumTracked (), (size_t) selOut->getNumPages ());
+			}
+		}
+
+		cout << "\nParallel selection (ns per input tuple on 1, 2, and 4 threads):\n";
+		for (int mode = 0; mode < 2; mode++) {
+			cout << (mode == 0 ? "\trecord at a time: " : "\tbatch at a time:  ");
+			for (int which = 0; which < 3; which++)
+				cout << times[mode][which] * 1e9 / 100000 << (which < 2 ? " vs. " : "\n");
+		}
+
+		QUNIT_IS_TRUE (counts[0][0] > 0);
+		for (int mode = 0; mode < 2; mode++) {
+			for (int which = 0; which < 3; which++) {
+				QUNIT_IS_EQUAL (counts[mode][which], counts[0][0]);
+				QUNIT_IS_EQUAL (sums[mode][which], sums[0][0]);
+			}
+		}
+	}
+	{
+		// how the parallel selection scales with a filter that is expensive to compute; the
+		// buffer can hold the whole table, and it is scanned once before timing, so that the
+		// threads are not waiting on the disk.  That scan uses two threads, since the C and C++
+		// libraries skip their atomic operations until a program first starts a thread, which
+		// would otherwise make the one thread time look better than it is in a real server.
+		// Each time is the best of three runs
+		MyDB_SchemaPtr mySchemaS = make_shared <MyDB_Schema> ();
+		mySchemaS->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+		mySchemaS->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+		mySchemaS->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+		mySchemaS->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+		mySchemaS->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+		mySchemaS->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+		MyDB_BufferManagerPtr scaleMgr = make_shared <MyDB_BufferManager> (65536, 256, "scaleTempFile");
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("scaleItems", "scaleItems.bin", mySchemaS);
+		MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, scaleMgr);
+		items->loadFromTextFile ("dictTest.tbl");
+
+		// a string comparison and a long chain of arithmetic for every record
+		string value = "[d_quantity]";
+		for (int i = 0; i < 16; i++)
+			value = "+ (* (" + value + ", double[0.75]), * ([d_orderkey], double[0.001]))";
+		string pred = "&& (> (" + value + ", double[40.0]), > ([d_nation], string[BRAZIL]))";
+
+		int numThreads[] = {1, 2, 4, 8};
+		double times[4];
+		size_t counts[4];
+		for (int which = -1; which < 4; which++) {
+			double best = 0;
+			for (int rep = 0; rep < 3; rep++) {
+				MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+				mySchemaOut->appendAtt (make_pair ("s_orderkey", make_shared <MyDB_IntAttType> ()));
+				MyDB_TablePtr myTableOut = make_shared <MyDB_Table> ("scaleOut", "scaleOut.bin", mySchemaOut);
+				MyDB_TableReaderWriterPtr selOut = make_shared <MyDB_TableReaderWriter> (myTableOut, scaleMgr);
+				vector <string> projections;
+				projections.push_back ("[d_orderkey]");
+				RegularSelection mySel (items, selOut, pred, projections);
+				mySel.setNumThreads (which < 0 ? 2 : numThreads[which]);
+				auto start = chrono :: steady_clock :: now ();
+				mySel.run ();
+				double time = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+				if (rep == 0 || time < best)
+					best = time;
+
+				// the first pass only brings the table into the buffer
+				if (which < 0)
+					break;
+
+				MyDB_RecordPtr temp = selOut->getEmptyRecord ();
+				MyDB_RecordIteratorAltPtr myIter = selOut->getIteratorAlt ();
+				counts[which] = 0;
+				while (myIter->advance ()) {
+					myIter->getCurrent (temp);
+					counts[which]++;
+				}
+			}
+			if (which >= 0)
+				times[which] = best;
+		}
+
+		cout << "\nParallel selection with an expensive filter (ns per input tuple, and speedup over one thread; " << 
+			thread :: hardware_concurrency () << " hardware threads):\n";
+		for (int which = 0; which < 4; which++)
+			cout << "\t" << numThreads[which] << " threads: " << times[which] * 1e9 / 100000 << 
+				" (" << times[0] / times[which] << "x)\n";
+
+		QUNIT_IS_TRUE (counts[0] > 0);
+		QUNIT_IS_TRUE (counts[0] < 100000);
+		for (int which = 1; which < 4; which++)
+			QUNIT_IS_EQUAL (counts[which], counts[0]);
+	}
+	{
+		// ORDER BY ... LIMIT, both with a heap that keeps the first records and with a full
+		// sort that stops early; both should agree with sorting everything in RAM
+		MyDB_SchemaPtr mySchemaP = make_shared <MyDB_Schema> ();
+		mySchemaP->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+		MyDB_BufferManagerPtr topMgr = make_shared <MyDB_BufferManager> (4096, 64, "topTempFile");
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("topItems", "topItems.bin", mySchemaP);
+		MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, topMgr);
+		items->loadFromTextFile ("dictTest.tbl");
+
+		// the answer, by brute force: nation ascending, then quantity descending, then orderkey
+		vector <pair <string, pair <int, int>>> all;
+		MyDB_RecordPtr temp = items->getEmptyRecord ();
+		MyDB_RecordIteratorAltPtr myIter = items->getIteratorAlt ();
+		while (myIter->advance ()) {
+			myIter->getCurrent (temp);
+			all.push_back (make_pair (temp->getAtt (4)->toString (),
+				make_pair (-temp->getAtt (5)->toInt (), temp->getAtt (0)->toInt ())));
+		}
+		sort (all.begin (), all.end ());
+
+		vector <pair <string, bool>> sortKeys;
+		sortKeys.push_back (make_pair ("[d_nation]", false));
+		sortKeys.push_back (make_pair ("[d_quantity]", true));
+		sortKeys.push_back (make_pair ("[d_orderkey]", false));
+		vector <string> projections;
+		projections.push_back ("[d_orderkey]");
+		projections.push_back ("[d_nation]");
+		projections.push_back ("[d_quantity]");
+
+		long limits[] = {1, 100, 1000};
+		double times[2][3];
+		bool allMatch = true;
+		for (int mode = 0; mode < 2; mode++) {
+			for (int which = 0; which < 3; which++) {
+
+				MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+				mySchemaOut->appendAtt (make_pair ("t_orderkey", make_shared <MyDB_IntAttType> ()));
+				mySchemaOut->appendAtt (make_pair ("t_nation", make_shared <MyDB_StringAttType> ()));
+				mySchemaOut->appendAtt (make_pair ("t_quantity", make_shared <MyDB_IntAttType> ()));
+				string outName = "topOut" + to_string (mode) + to_string (which);
+				MyDB_TablePtr myTableOut = make_shared <MyDB_Table> (outName, outName + ".bin", mySchemaOut);
+				MyDB_TableReaderWriterPtr topOut = make_shared <MyDB_TableReaderWriter> (myTableOut, topMgr);
+
+				auto start = chrono :: steady_clock :: now ();
+				if (mode == 0) {
+					TopN myOp (items, topOut, sortKeys, projections, limits[which]);
+					myOp.run ();
+				} else {
+					OrderBy myOp (items, topOut, sortKeys, projections);
+					myOp.setLimit (limits[which]);
+					myOp.run ();
+				}
+				times[mode][which] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+
+				MyDB_RecordPtr outRec = topOut->getEmptyRecord ();
+				MyDB_RecordIteratorAltPtr outIter = topOut->getIteratorAlt ();
+				long count = 0;
+				while (outIter->advance ()) {
+					outIter->getCurrent (outRec);
+					if (count >= limits[which] || outRec->getAtt (0)->toInt () != all[count].second.second ||
+						outRec->getAtt (1)->toString () != all[count].first ||
+						outRec->getAtt (2)->toInt () != -all[count].second.first)
+						allMatch = false;
+					count++;
+				}
+				QUNIT_IS_EQUAL (count, limits[which]);
+			}
+		}
+
+		cout << "\nORDER BY ... LIMIT 1, 100, and 1000 (ns per input tuple):\n";
+		for (int mode = 0; mode < 2; mode++) {
+			cout << (mode == 0 ? "\theap:        " : "\tsort + stop: ");
+			for (int which = 0; which < 3; which++)
+				cout << times[mode][which] * 1e9 / all.size () << (which < 2 ? " vs. " : "\n");
+		}
+		QUNIT_IS_TRUE (allMatch);
+	}
+	{
+		// SELECT DISTINCT with a hash table that has all the room it needs, with one that has to
+		// write most of the records to its partitions, and with a sort; all three should find the
+		// same records as a set in RAM does
+		MyDB_SchemaPtr mySchemaP = make_shared <MyDB_Schema> ();
+		mySchemaP->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+		mySchemaP->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+		MyDB_BufferManagerPtr distMgr = make_shared <MyDB_BufferManager> (4096, 64, "distTempFile");
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("distItems", "distItems.bin", mySchemaP);
+		MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, distMgr);
+		items->loadFromTextFile ("dictTest.tbl");
+
+		// the answer, by brute force
+		set <string> all;
+		MyDB_RecordPtr temp = items->getEmptyRecord ();
+		MyDB_RecordIteratorAltPtr myIter = items->getIteratorAlt ();
+		while (myIter->advance ()) {
+			myIter->getCurrent (temp);
+			string rec = "";
+			for (int i = 1; i < 6; i++)
+				rec += temp->getAtt (i)->toString () + "|";
+			all.insert (rec);
+		}
+
+		vector <string> projections;
+		projections.push_back ("[d_returnflag]");
+		projections.push_back ("[d_shipmode]");
+		projections.push_back ("[d_shipinstruct]");
+		projections.push_back ("[d_nation]");
+		projections.push_back ("[d_quantity]");
+
+		double times[3];
+		size_t counts[3];
+		bool allMatch = true;
+		size_t numSpilled = 0;
+		for (int which = 0; which < 3; which++) {
+
+			MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+			mySchemaOut->appendAtt (make_pair ("t_returnflag", make_shared <MyDB_StringAttType> ()));
+			mySchemaOut->appendAtt (make_pair ("t_shipmode", make_shared <MyDB_StringAttType> ()));
+			mySchemaOut->appendAtt (make_pair ("t_shipinstruct", make_shared <MyDB_StringAttType> ()));
+			mySchemaOut->appendAtt (make_pair ("t_nation", make_shared <MyDB_StringAttType> ()));
+			mySchemaOut->appendAtt (make_pair ("t_quantity", make_shared <MyDB_IntAttType> ()));
+			string outName = "distOut" + to_string (which);
+			MyDB_TablePtr myTableOut = make_shared <MyDB_Table> (outName, outName + ".bin", mySchemaOut);
+			MyDB_TableReaderWriterPtr distOut = make_shared <MyDB_TableReaderWriter> (myTableOut, distMgr);
+
+			auto start = chrono :: steady_clock :: now ();
+			if (which < 2) {
+				HashDistinct myOp (items, distOut, projections);
+				if (which == 1)
+					myOp.setNumPages (1);
+				myOp.run ();
+				if (which == 1)
+					numSpilled = myOp.getNumSpilled ();
+			} else {
+				SortDistinct myOp (items, distOut, projections);
+				myOp.run ();
+			}
+			times[which] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+
+			set <string> found;
+			MyDB_RecordPtr outRec = distOut->getEmptyRecord ();
+			MyDB_RecordIteratorAltPtr outIter = distOut->getIteratorAlt ();
+			counts[which] = 0;
+			while (outIter->advance ()) {
+				outIter->getCurrent (outRec);
+				string rec = "";
+				for (int i = 0; i < 5; i++)
+					rec += outRec->getAtt (i)->toString () + "|";
+				found.insert (rec);
+				counts[which]++;
+			}
+			allMatch = allMatch && (found == all);
+		}
+
+		cout << "\nSELECT DISTINCT (ns per input tuple; " << numSpilled << " records spilled):\n";
+		cout << "\thash: " << times[0] * 1e9 / 100000 << " vs. hash, spilling: " << times[1] * 1e9 / 100000 << 
+			" vs. sort: " << times[2] * 1e9 / 100000 << "\n";
+		QUNIT_IS_TRUE (numSpilled > 0);
+		for (int which = 0; which < 3; which++) {
+			QUNIT_IS_EQUAL (counts[which], all.size ());
+		}
+		QUNIT_IS_TRUE (allMatch);
+	}
+	{
+		// a hybrid hash join that has room for all of the smaller table, one that has to write
+		// most of it to disk, and one on a key that every record of the smaller table shares,
+		// so that splitting up the partitions never helps; the answers are checked against
+		// counts taken by brute force
+		MyDB_SchemaPtr mySchemaH = make_shared <MyDB_Schema> ();
+		mySchemaH->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+		mySchemaH->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+		mySchemaH->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+		mySchemaH->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+		mySchemaH->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+		mySchemaH->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+		MyDB_BufferManagerPtr hashMgr = make_shared <MyDB_BufferManager> (4096, 256, "hashJoinTempFile");
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("hashItems", "hashItems.bin", mySchemaH);
+		MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, hashMgr);
+		items->loadFromTextFile ("dictTest.tbl");
+
+		MyDB_SchemaPtr mySchemaJ = make_shared <MyDB_Schema> ();
+		mySchemaJ->appendAtt (make_pair ("j_orderkey", make_shared <MyDB_IntAttType> ()));
+		mySchemaJ->appendAtt (make_pair ("j_returnflag", make_shared <MyDB_StringAttType> ()));
+		mySchemaJ->appendAtt (make_pair ("j_nation", make_shared <MyDB_StringAttType> ()));
+		MyDB_TablePtr myTableJ = make_shared <MyDB_Table> ("hashJoinIn", "hashJoinIn.bin", mySchemaJ);
+		MyDB_TableReaderWriterPtr joinIn = make_shared <MyDB_TableReaderWriter> (myTableJ, hashMgr);
+		vector <string> joinInProj;
+		joinInProj.push_back ("[d_orderkey]");
+		joinInProj.push_back ("[d_returnflag]");
+		joinInProj.push_back ("[d_nation]");
+		RegularSelection makeJoinIn (items, joinIn, "< ([d_orderkey], int[10000])", joinInProj);
+		makeJoinIn.run ();
+
+		// the answers, by brute force
+		long expectedCounts[3] = {0, 0, 0};
+		long expectedSums[3] = {0, 0, 0};
+		long numFlagA = 0, numProbesA = 0, probeSumA = 0;
+		MyDB_RecordPtr temp = items->getEmptyRecord ();
+		MyDB_RecordIteratorAltPtr myIter = items->getIteratorAlt ();
+		while (myIter->advance ()) {
+			myIter->getCurrent (temp);
+			long key = temp->getAtt (0)->toInt ();
+			bool isA = temp->getAtt (1)->toString () == "A";
+			if (key < 10000) {
+				expectedCounts[0]++;
+				expectedSums[0] += temp->getAtt (5)->toInt ();
+				numFlagA += isA;
+			}
+			if (key < 10 && isA) {
+				numProbesA++;
+				probeSumA += temp->getAtt (5)->toInt ();
+			}
+		}
+		expectedCounts[1] = expectedCounts[0];
+		expectedSums[1] = expectedSums[0];
+		expectedCounts[2] = numFlagA * numProbesA;
+		expectedSums[2] = numFlagA * probeSumA;
+
+		vector <string> projections;
+		projections.push_back ("[j_orderkey]");
+		projections.push_back ("[d_quantity]");
+
+		double times[3];
+		long counts[3], sums[3];
+		size_t numSpilled[3];
+		for (int which = 0; which < 3; which++) {
+
+			MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+			mySchemaOut->appendAtt (make_pair ("o_orderkey", make_shared <MyDB_IntAttType> ()));
+			mySchemaOut->appendAtt (make_pair ("o_quantity", make_shared <MyDB_IntAttType> ()));
+			string outName = "hashJoinOut" + to_string (which);
+			MyDB_TablePtr myTableOut = make_shared <MyDB_Table> (outName, outName + ".bin", mySchemaOut);
+			MyDB_TableReaderWriterPtr joinOut = make_shared <MyDB_TableReaderWriter> (myTableOut, hashMgr);
+
+			vector <pair <string, string>> hashAtts;
+			string finalPred, leftPred = "bool[true]", rightPred = "bool[true]";
+			if (which < 2) {
+				hashAtts.push_back (make_pair (string ("[j_orderkey]"), string ("[d_orderkey]")));
+				finalPred = "== ([j_orderkey], [d_orderkey])";
+			} else {
+				hashAtts.push_back (make_pair (string ("[j_returnflag]"), string ("[d_returnflag]")));
+				finalPred = "== ([j_returnflag], [d_returnflag])";
+				leftPred = "== ([j_returnflag], string[A])";
+				rightPred = "< ([d_orderkey], int[10])";
+			}
+			HybridHashJoin myOp (joinIn, items, joinOut, finalPred, projections, hashAtts, leftPred, rightPred);
+			if (which == 1)
+				myOp.setNumPages (8);
+			if (which == 2)
+				myOp.setNumPages (2);
+
+			auto start = chrono :: steady_clock :: now ();
+			myOp.run ();
+			times[which] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			numSpilled[which] = myOp.getNumSpilled ();
+
+			MyDB_RecordPtr outRec = joinOut->getEmptyRecord ();
+			MyDB_RecordIteratorAltPtr outIter = joinOut->getIteratorAlt ();
+			counts[which] = sums[which] = 0;
+			while (outIter->advance ()) {
+				outIter->getCurrent (outRec);
+				counts[which]++;
+				sums[which] += outRec->getAtt (1)->toInt ();
+			}
+		}
+
+		cout << "\nHybrid hash join (ns per input tuple; partitions written to disk in parentheses):\n";
+		cout << "\tin RAM: " << times[0] * 1e9 / 100000 << " (" << numSpilled[0] << ") vs. spilling: " << 
+			times[1] * 1e9 / 100000 << " (" << numSpilled[1] << ") vs. one key: " << times[2] * 1e9 / 100000 << 
+			" (" << numSpilled[2] << ")\n";
+		QUNIT_IS_EQUAL (numSpilled[0], (size_t) 0);
+		QUNIT_IS_TRUE (numSpilled[1] > 0);
+		QUNIT_IS_TRUE (numSpilled[2] > 0);
+		for (int which = 0; which < 3; which++) {
+			QUNIT_IS_EQUAL (counts[which], expectedCounts[which]);
+			QUNIT_IS_EQUAL (sums[which], expectedSums[which]);
+		}
+	}
+
+	{
+		// the zone map file is written by loadFromTextFile; reopening the table should use it for
+		// every page but the last, and appending afterward must not let a scan skip the new records
+		MyDB_SchemaPtr mySchemaZ = make_shared <MyDB_Schema> ();
+		mySchemaZ->appendAtt (make_pair ("d_orderkey", make_shared <MyDB_IntAttType> ()));
+		mySchemaZ->appendAtt (make_pair ("d_returnflag", make_shared <MyDB_StringAttType> ()));
+		mySchemaZ->appendAtt (make_pair ("d_shipmode", make_shared <MyDB_StringAttType> ()));
+		mySchemaZ->appendAtt (make_pair ("d_shipinstruct", make_shared <MyDB_StringAttType> ()));
+		mySchemaZ->appendAtt (make_pair ("d_nation", make_shared <MyDB_StringAttType> ()));
+		mySchemaZ->appendAtt (make_pair ("d_quantity", make_shared <MyDB_IntAttType> ()));
+		MyDB_BufferManagerPtr zoneMgr = make_shared <MyDB_BufferManager> (4096, 64, "zoneTempFile");
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("zoneItems", "zoneItems.bin", mySchemaZ);
+		MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, zoneMgr);
+		items->loadFromTextFile ("dictTest.tbl");
+
+		auto countMatches = [&] (MyDB_TableReaderWriterPtr input, string pred, int &numSkipped) {
+			MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+			mySchemaOut->appendAtt (make_pair ("z_orderkey", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableOut = make_shared <MyDB_Table> ("zoneOut", "zoneOut.bin", mySchemaOut);
+			MyDB_TableReaderWriterPtr selOut = make_shared <MyDB_TableReaderWriter> (myTableOut, zoneMgr);
+			vector <string> projections;
+			projections.push_back ("[d_orderkey]");
+			RegularSelection mySel (input, selOut, pred, projections);
+			mySel.run ();
+			numSkipped = mySel.getNumPagesSkipped ();
+			MyDB_RecordPtr temp = selOut->getEmptyRecord ();
+			MyDB_RecordIteratorAltPtr myIter = selOut->getIteratorAlt ();
+			int count = 0;
+			while (myIter->advance ()) {
+				myIter->getCurrent (temp);
+				count++;
+			}
+			return count;
+		};
+
+		int numSkipped;
+		QUNIT_IS_EQUAL (countMatches (items, "== ([d_orderkey], int[500])", numSkipped), 1);
+		QUNIT_IS_TRUE (numSkipped > 0);
+
+		// reopen; the page that was last when the file was written is not trusted
+		int numPages = items->getNumPages ();
+		items = make_shared <MyDB_TableReaderWriter> (myTable, zoneMgr);
+		QUNIT_IS_EQUAL (items->getZoneMap ()->getNumTracked (), (size_t) numPages - 1);
+		QUNIT_IS_EQUAL (countMatches (items, "== ([d_orderkey], int[500])", numSkipped), 1);
+		QUNIT_IS_TRUE (numSkipped > 0);
+
+		// append records with a key that nothing else has; they fill up the old last page
+		// and go on past it, so that the old last page is no longer the last one
+		MyDB_RecordPtr temp = items->getEmptyRecord ();
+		for (int i = 0; i < 500; i++) {
+			temp->fromString ("999999|A|AIR|NONE|PERU|" + to_string (i % 50) + "|");
+			items->append (temp);
+		}
+		QUNIT_IS_TRUE (items->getNumPages () > numPages + 1);
+		QUNIT_IS_EQUAL (countMatches (items, "== ([d_orderkey], int[999999])", numSkipped), 500);
+
+		// and reopen again; the ranges saved for the old last page must not come back
+		items = make_shared <MyDB_TableReaderWriter> (myTable, zoneMgr);
+		QUNIT_IS_EQUAL (countMatches (items, "== ([d_orderkey], int[999999])", numSkipped), 500);
+		QUNIT_IS_EQUAL (countMatches (items, "== ([d_orderkey], int[500])", numSkipped), 1);
+
+		// load again, so that the zone map file is there, and then rewrite the first page
+		// directly; the page's old ranges must not be used by this scan or after reopening
+		items->loadFromTextFile ("dictTest.tbl");
+		QUNIT_IS_TRUE (ifstream (items->getZoneMapFile ()).good ());
+		MyDB_PageReaderWriter firstPage = (*items)[0];
+		firstPage.clear ();
+		temp->fromString ("888888|A|AIR|NONE|PERU|1|");
+		firstPage.append (temp);
+		QUNIT_IS_FALSE (ifstream (items->getZoneMapFile ()).good ());
+		QUNIT_IS_EQUAL (countMatches (items, "== ([d_orderkey], int[888888])", numSkipped), 1);
+		QUNIT_IS_TRUE (numSkipped > 0);
+		items = make_shared <MyDB_TableReaderWriter> (myTable, zoneMgr);
+		QUNIT_IS_EQUAL (countMatches (items, "== ([d_orderkey], int[888888])", numSkipped), 1);
+	}
+
+	{
+		// a division that is guarded by the clause before it; the guard throws out almost
+		// nothing and the division almost everything, so the clauses would be swapped if
+		// the division were allowed to move, and it would then divide by zero
+		ofstream divFile ("divTest.tbl");
+		int expected = 0;
+		for (int i = 0; i < 20000; i++) {
+			int a = (i % 1000 == 0) ? 0 : 1 + i % 3;
+			divFile << a << "|" << i << "|\n";
+			if (a != 0 && i / a > 15000)
+				expected++;
+		}
+		divFile.close ();
+
+		MyDB_SchemaPtr mySchemaV = make_shared <MyDB_Schema> ();
+		mySchemaV->appendAtt (make_pair ("v_a", make_shared <MyDB_IntAttType> ()));
+		mySchemaV->appendAtt (make_pair ("v_b", make_shared <MyDB_IntAttType> ()));
+		MyDB_BufferManagerPtr divMgr = make_shared <MyDB_BufferManager> (4096, 64, "divTempFile");
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("divItems", "divItems.bin", mySchemaV);
+		MyDB_TableReaderWriterPtr items = make_shared <MyDB_TableReaderWriter> (myTable, divMgr);
+		items->loadFromTextFile ("divTest.tbl");
+
+		for (int mode = 0; mode < 2; mode++) {
+			MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+			mySchemaOut->appendAtt (make_pair ("v_out", make_shared <MyDB_IntAttType> ()));
+			MyDB_TablePtr myTableOut = make_shared <MyDB_Table> ("divOut", "divOut.bin", mySchemaOut);
+			MyDB_TableReaderWriterPtr selOut = make_shared <MyDB_TableReaderWriter> (myTableOut, divMgr);
+			vector <string> projections;
+			projections.push_back ("[v_b]");
+			RegularSelection mySel (items, selOut, "&& (!= ([v_a], int[0]), > (/ ([v_b], [v_a]), int[15000]))", 
+				projections);
+			mySel.setBatchMode (mode == 1);
+			mySel.run ();
+
+			MyDB_RecordPtr temp = selOut->getEmptyRecord ();
+			MyDB_RecordIteratorAltPtr myIter = selOut->getIteratorAlt ();
+			int count = 0;
+			while (myIter->advance ()) {
+				myIter->getCurrent (temp);
+				count++;
+			}
+			QUNIT_IS_EQUAL (count, expected);
+		}
+	}
 }
 
 #endif
@@ -50,17 +50,31 @@ public:
 	Aggregate (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
 		vector <pair <MyDB_AggType, string>> aggsToCompute,
 		vector <string> groupings, string selectionPredicate);
+
+	// the same, except that all of the computations have already been parsed (or were built 
+	// directly, as the SQL layer does); this way they are not parsed again here
+	Aggregate (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <pair <MyDB_AggType, MyDB_CompNodePtr>> aggsToCompute,
+		vector <MyDB_CompNodePtr> groupings, MyDB_CompNodePtr selectionPredicate);
 	
 	// execute the aggregation
 	void run ();
 
+	// if this is set, records are read and run through the selection predicate and the grouping computations a batch at a time
+	// (see MyDB_BatchComputation), rather than one at a time
+	void setBatchMode (bool batchModeIn);
+
 private:
 
 	MyDB_TableReaderWriterPtr input;
 	MyDB_TableReaderWriterPtr output;
-	vector <pair <MyDB_AggType, string>> aggsToCompute;
-	vector <string> groupings;
-	string selectionPredicate;
+	vector <pair <MyDB_AggType, MyDB_CompNodePtr>> aggsToCompute;
+	vector <MyDB_CompNodePtr> groupings;
+	MyDB_CompNodePtr selectionPredicate;
+	bool batchMode;
+
+	// parses each of the aggregates
+	static vector <pair <MyDB_AggType, MyDB_CompNodePtr>> parse (vector <pair <MyDB_AggType, string>> parseUs);
 
 };
 
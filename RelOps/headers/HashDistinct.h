@@ -0,0 +1,59 @@
+
+#ifndef HASH_DISTINCT_H
+#define HASH_DISTINCT_H
+
+#include "MyDB_TableReaderWriter.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// this class encapsulates a SELECT DISTINCT that is run with a hash table.  Each input record
+// is run through the projections, and the result is looked up in a hash table of the ones
+// that have already been written; if it is not there, it is written to the output and added.
+// The records in the table are kept on pinned pages, as in Aggregate.  Once those pages run
+// out, a record that is not in the table is written instead to one of a number of partitions
+// on disk, chosen by its hash; since the copies of a record all go to the same partition,
+// each partition can then be run the same way on its own (with a different hash function),
+// once the table has been emptied.  A record that is already in the table is thrown away
+// right away, so when there are few distinct records, nothing is ever written to disk
+
+class HashDistinct {
+
+public:
+	//
+	// Records are read from input and run through the computations in projections (see the
+	// ScanJoin for an example); each distinct result is written to output once, in no
+	// particular order
+	//
+	HashDistinct (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <string> projections);
+
+	// the same, except that the computations have already been parsed (or were built
+	// directly, as the SQL layer does); this way they are not parsed again here
+	HashDistinct (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <MyDB_CompNodePtr> projections);
+
+	// execute the operation
+	void run ();
+
+	// the most pages that the records in the hash table can take up; by default, this is
+	// half of the pages in the buffer
+	void setNumPages (int numPagesIn);
+
+	// after run (), the number of records that had to be written to a partition on disk
+	size_t getNumSpilled ();
+
+private:
+
+	// runs every record that next () loads into rec (which has the schema of the output)
+	// through the hash table, at the given level of partitioning
+	void dedup (function <bool ()> next, MyDB_RecordPtr rec, int level);
+
+	MyDB_TableReaderWriterPtr input;
+	MyDB_TableReaderWriterPtr output;
+	vector <MyDB_CompNodePtr> projections;
+	int numPages;
+	size_t numSpilled;
+};
+
+#endif
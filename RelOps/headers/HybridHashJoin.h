@@ -0,0 +1,87 @@
+
+#ifndef HYBRID_HASH_JOIN_H
+#define HYBRID_HASH_JOIN_H
+
+#include "MyDB_PageReaderWriter.h"
+#include "MyDB_TableReaderWriter.h"
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// this class encapsulates a hybrid hash join, which is what is used when the smaller table
+// does not fit into the buffer (where a ScanJoin would fail).  The records of the smaller
+// table are split up by hash into a number of partitions, each of which is kept on pinned
+// pages; if that is more pages than the join is allowed to pin, the largest partition is
+// unpinned (so it is written to disk as the buffer needs room) and any more records that
+// belong to it are simply appended to it.  The partitions that are left in RAM are put into
+// a hash table, and the larger table is scanned: a record whose partition is in RAM is
+// joined right away, and one whose partition is not is written to the matching partition
+// of the larger table.  Each pair of partitions that was written out is then joined the
+// same way, with a different split, so a partition that is still too large is split up
+// again.  If a partition is still too large after a few splits (because a lot of records
+// have the same key), it is joined a chunk at a time, scanning its other half once for
+// each chunk
+
+class HybridHashJoin {
+
+public:
+	// the arguments are exactly as for a ScanJoin
+	HybridHashJoin (MyDB_TableReaderWriterPtr leftInput, MyDB_TableReaderWriterPtr rightInput,
+		MyDB_TableReaderWriterPtr output, string finalSelectionPredicate,
+		vector <string> projections,
+		vector <pair <string, string>> equalityChecks, string leftSelectionPredicate,
+		string rightSelectionPredicate);
+
+	// the same, except that all of the computations have already been parsed (or were built
+	// directly, as the SQL layer does); this way they are not parsed again here
+	HybridHashJoin (MyDB_TableReaderWriterPtr leftInput, MyDB_TableReaderWriterPtr rightInput,
+		MyDB_TableReaderWriterPtr output, MyDB_CompNodePtr finalSelectionPredicate,
+		vector <MyDB_CompNodePtr> projections,
+		vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> equalityChecks,
+		MyDB_CompNodePtr leftSelectionPredicate, MyDB_CompNodePtr rightSelectionPredicate);
+
+	// execute the join
+	void run ();
+
+	// the most pages that the records of the smaller table can pin at once; by default, this
+	// is half of the pages in the buffer
+	void setNumPages (int numPagesIn);
+
+	// after run (), the number of partitions (at every level of splitting) that had to be
+	// written to disk
+	size_t getNumSpilled ();
+
+private:
+
+	// joins every record that nextLeft () loads into leftRec with every record that nextRight ()
+	// loads into rightRec, at the given level of splitting; there should be about estimatedPages
+	// pages of left records
+	void join (function <bool ()> nextLeft, function <bool ()> nextRight, int level, int estimatedPages);
+
+	// joins two partitions that could not be split up any further, pinning as many pages of
+	// the left one as the join is allowed at a time
+	void joinInChunks (vector <MyDB_PageReaderWriter> &leftPages, vector <MyDB_PageReaderWriter> &rightPages);
+
+	MyDB_CompNodePtr finalSelectionPredicate;
+	vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> equalityChecks;
+	vector <MyDB_CompNodePtr> projections;
+	MyDB_TableReaderWriterPtr output;
+	MyDB_TableReaderWriterPtr leftTable;
+	MyDB_TableReaderWriterPtr rightTable;
+	MyDB_CompNodePtr leftSelectionPredicate;
+	MyDB_CompNodePtr rightSelectionPredicate;
+	int numPages;
+	size_t numSpilled;
+
+	// these are set up by run (): the records that the join works on, the hash of each of
+	// them, and the function that checks the pair that is in them and writes it out if it
+	// is accepted
+	MyDB_RecordPtr leftRec;
+	MyDB_RecordPtr rightRec;
+	function <size_t ()> leftHash;
+	function <size_t ()> rightHash;
+	function <void ()> emit;
+};
+
+#endif
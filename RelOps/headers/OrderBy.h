@@ -0,0 +1,55 @@
+
+#ifndef ORDER_BY_H
+#define ORDER_BY_H
+
+#include "MyDB_TableReaderWriter.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// this class encapsulates an ORDER BY, run as a full external sort (see Sorting.h)
+
+class OrderBy {
+
+public:
+	//
+	// The records of input are put in order by the computations in sortKeys: the first
+	// computation whose results differ over two records decides which comes first, and if
+	// its bool is true, it is in descending order.  For example, the list:
+	//
+	// <("[att1]", false), ("+ ([att2], [att3])", true)>
+	//
+	// corresponds to:
+	//
+	// ORDER BY att1 ASC, att2 + att3 DESC
+	//
+	// The vector projections contains all of the computations that are performed to
+	// create the output records (see the ScanJoin for an example); they are written to
+	// output in sorted order.
+	//
+	OrderBy (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <pair <string, bool>> sortKeys, vector <string> projections);
+
+	// the same, except that the computations have already been parsed (or were built
+	// directly, as the SQL layer does); this way they are not parsed again here
+	OrderBy (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <pair <MyDB_CompNodePtr, bool>> sortKeys, vector <MyDB_CompNodePtr> projections);
+
+	// execute the sort
+	void run ();
+
+	// if this is set (to something other than -1), only the first limit records are written,
+	// and the merge of the sorted runs stops as soon as they have been.  When the limit is
+	// small enough that that many records fit in RAM, TopN is the better choice
+	void setLimit (long limitIn);
+
+private:
+
+	MyDB_TableReaderWriterPtr input;
+	MyDB_TableReaderWriterPtr output;
+	vector <pair <MyDB_CompNodePtr, bool>> sortKeys;
+	vector <MyDB_CompNodePtr> projections;
+	long limit;
+};
+
+#endif
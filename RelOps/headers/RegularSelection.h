@@ -22,16 +22,55 @@ public:
 	//
 	RegularSelection (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
 		string selectionPredicate, vector <string> projections);
+
+	// the same, except that the predicate and the projections have already been parsed (or were
+	// built directly, as the SQL layer does); this way they are not parsed again here
+	RegularSelection (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		MyDB_CompNodePtr selectionPredicate, vector <MyDB_CompNodePtr> projections);
 	
 	// execute the selection operation
 	void run ();
 
+	// if this is set, records are read and run through the predicate and the projections a batch at a time
+	// (see MyDB_BatchComputation), rather than one at a time
+	void setBatchMode (bool batchModeIn);
+
+	// if this is set, the predicate and the projections are compiled to native code (see
+	// MyDB_NativeComputation) and run straight over the records on the pages; if that cannot
+	// be done, the selection falls back to batch mode or to record-at-a-time mode
+	void setNativeMode (bool nativeModeIn);
+
+	// the number of threads that run the selection (by default, one).  With more than one,
+	// the pages of the input are handed out to the threads a few at a time, and each thread
+	// writes the records that it accepts onto pages of the output that it has to itself, so
+	// the records end up in the output in no particular order
+	void setNumThreads (int numThreadsIn);
+
+	// if this is set (to something other than -1), the selection stops as soon as limit records
+	// have been written; this is a LIMIT with no ORDER BY, so the records are the first ones
+	// accepted in the order of the input, and the selection is run on one thread
+	void setLimit (long limitIn);
+
+	// after run (), the number of pages of the input that the zone map showed could not have
+	// any record that the predicate accepts, so that they were not read
+	int getNumPagesSkipped ();
+
 private:
 
+	// true if the threads can write the output without getting in each other's way: a
+	// dictionary coded attribute of the output can only be written by a projection that
+	// copies an attribute with the same dictionary, since anything else may add to it
+	bool canRunInParallel ();
+
         MyDB_TableReaderWriterPtr input;
         MyDB_TableReaderWriterPtr output;
-        string selectionPredicate;
-        vector <string> projections;
+        MyDB_CompNodePtr selectionPredicate;
+        vector <MyDB_CompNodePtr> projections;
+	bool batchMode;
+	bool nativeMode;
+	int numThreads;
+	long limit;
+	int numPagesSkipped;
 };
 
 #endif
@@ -10,7 +10,7 @@
 // This class encapulates a scan join, where one table is hashed, and then the 
 // other is scanned and joined with the hashed table.  If the smaller table is
 // too large to be stored in the buffer manager in its entirity, then the join
-// will fail.
+// will fail (a HybridHashJoin should be used instead).
 //
 class ScanJoin {
 
@@ -82,21 +82,37 @@ public:
 		vector <string> projections,
 		vector <pair <string, string>> equalityChecks, string leftSelectionPredicate,
 		string rightSelectionPredicate);
+
+	// the same, except that all of the computations have already been parsed (or were built 
+	// directly, as the SQL layer does); this way they are not parsed again here
+	ScanJoin (MyDB_TableReaderWriterPtr leftInput, MyDB_TableReaderWriterPtr rightInput,
+		MyDB_TableReaderWriterPtr output, MyDB_CompNodePtr finalSelectionPredicate, 
+		vector <MyDB_CompNodePtr> projections,
+		vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> equalityChecks, 
+		MyDB_CompNodePtr leftSelectionPredicate, MyDB_CompNodePtr rightSelectionPredicate);
 	
 	// execute the join
 	void run ();
 
+	// if this is set, records are read and run through the selection predicates and the hash computations a batch at a time
+	// (see MyDB_BatchComputation), rather than one at a time
+	void setBatchMode (bool batchModeIn);
+
 private:
 
-	string finalSelectionPredicate;
-	vector <pair <string, string>> equalityChecks;
-	vector <string> projections;
+	MyDB_CompNodePtr finalSelectionPredicate;
+	vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> equalityChecks;
+	vector <MyDB_CompNodePtr> projections;
 	MyDB_TableReaderWriterPtr output;	
 	MyDB_TableReaderWriterPtr leftTable;
 	MyDB_TableReaderWriterPtr rightTable;
-	string leftSelectionPredicate;
-	string rightSelectionPredicate;
+	MyDB_CompNodePtr leftSelectionPredicate;
+	MyDB_CompNodePtr rightSelectionPredicate;
+	// parses each of the equality checks
+	static vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> parse (vector <pair <string, string>> parseUs);
+
 	bool hadToSwapThem;
+	bool batchMode;
 };
 
 #endif
@@ -0,0 +1,42 @@
+
+#ifndef SORT_DISTINCT_H
+#define SORT_DISTINCT_H
+
+#include "MyDB_TableReaderWriter.h"
+#include <string>
+#include <vector>
+
+// this class encapsulates a SELECT DISTINCT that is run as an external sort (see Sorting.h).
+// The input is sorted into runs on the results of the projections; the copies of a record
+// then come out of the merge of the runs one after another, so each record that comes out is
+// written only if it differs from the one before it.  The merge is not written to disk, so the
+// duplicates that it throws away are only ever written once, in the runs.  This takes two
+// passes over the data however many distinct records there are, so it is the better choice
+// when there are too many of them for HashDistinct to keep in RAM
+
+class SortDistinct {
+
+public:
+	//
+	// Records are read from input and run through the computations in projections (see the
+	// ScanJoin for an example); each distinct result is written to output once, in order
+	//
+	SortDistinct (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <string> projections);
+
+	// the same, except that the computations have already been parsed (or were built
+	// directly, as the SQL layer does); this way they are not parsed again here
+	SortDistinct (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <MyDB_CompNodePtr> projections);
+
+	// execute the operation
+	void run ();
+
+private:
+
+	MyDB_TableReaderWriterPtr input;
+	MyDB_TableReaderWriterPtr output;
+	vector <MyDB_CompNodePtr> projections;
+};
+
+#endif
@@ -42,9 +42,14 @@ public:
 	// execute the join
 	void run ();
 
+	// if this is set, the sorted runs of the two inputs are made by replacement selection (see
+	// Sorting.h), which makes fewer, longer runs when the inputs are random or nearly sorted
+	void setReplacementSelection (bool replacementSelectionIn);
+
 private:
 
 	int runSize;
+	bool replacementSelection;
 	string finalSelectionPredicate;
 	pair <string, string> equalityCheck;
 	vector <string> projections;
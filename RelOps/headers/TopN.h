@@ -0,0 +1,45 @@
+
+#ifndef TOP_N_H
+#define TOP_N_H
+
+#include "MyDB_TableReaderWriter.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// this class encapsulates an ORDER BY ... LIMIT n, for an n that is small enough that n
+// records fit in RAM.  The input is read once; the n records that come first so far are
+// kept in a heap with the one that comes last on top, so a record that does not belong in
+// the answer is thrown away after a single comparison with the top of the heap, and one
+// that does replaces the top.  Nothing is written to disk until the end, when the heap is
+// sorted and written out.  The order is given just as it is for OrderBy
+
+class TopN {
+
+public:
+	//
+	// Records are read from input, and the first n of them in the order given by sortKeys
+	// (see OrderBy) are written to output, in that order, after running them through the
+	// computations in projections
+	//
+	TopN (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <pair <string, bool>> sortKeys, vector <string> projections, long n);
+
+	// the same, except that the computations have already been parsed (or were built
+	// directly, as the SQL layer does); this way they are not parsed again here
+	TopN (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output,
+		vector <pair <MyDB_CompNodePtr, bool>> sortKeys, vector <MyDB_CompNodePtr> projections, long n);
+
+	// execute the operation
+	void run ();
+
+private:
+
+	MyDB_TableReaderWriterPtr input;
+	MyDB_TableReaderWriterPtr output;
+	vector <pair <MyDB_CompNodePtr, bool>> sortKeys;
+	vector <MyDB_CompNodePtr> projections;
+	long n;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #ifndef AGG_CC
 #define AGG_CC
 
+#include "MyDB_BatchComputation.h"
 #include "MyDB_Record.h"
 #include "MyDB_PageReaderWriter.h"
 #include "MyDB_TableReaderWriter.h"
@@ -12,14 +13,32 @@ using namespace std;
 
 Aggregate :: Aggregate (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
                 vector <pair <MyDB_AggType, string>> aggsToComputeIn,
-                vector <string> groupingsIn, string selectionPredicateIn) {
+                vector <string> groupingsIn, string selectionPredicateIn) : 
+		Aggregate (inputIn, outputIn, parse (aggsToComputeIn), MyDB_CompNode :: parse (groupingsIn), 
+		MyDB_CompNode :: parse (selectionPredicateIn)) {}
+
+vector <pair <MyDB_AggType, MyDB_CompNodePtr>> Aggregate :: parse (vector <pair <MyDB_AggType, string>> parseUs) {
+	vector <pair <MyDB_AggType, MyDB_CompNodePtr>> res;
+	for (auto &p : parseUs) {
+		res.push_back (make_pair (p.first, MyDB_CompNode :: parse (p.second)));
+	}
+	return res;
+}
+
+Aggregate :: Aggregate (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+                vector <pair <MyDB_AggType, MyDB_CompNodePtr>> aggsToComputeIn,
+                vector <MyDB_CompNodePtr> groupingsIn, MyDB_CompNodePtr selectionPredicateIn) {
 
 	input = inputIn;
 	output = outputIn;
 	aggsToCompute = aggsToComputeIn;
 	groupings = groupingsIn;
 	selectionPredicate = selectionPredicateIn;
+	batchMode = false;
+}
 
+void Aggregate :: setBatchMode (bool batchModeIn) {
+	batchMode = batchModeIn;
 }
 
 void Aggregate :: run () {
@@ -30,16 +49,36 @@ void Aggregate :: run () {
 		return;
 	}
 
+	// this will compute each of the groupings, and then run the selection on the input 
+	// records; these are compiled together, so that what they share is only run once
+	MyDB_RecordPtr inputRec = input->getEmptyRecord ();
+	vector <MyDB_CompNodePtr> inputComps = groupings;
+	inputComps.push_back (selectionPredicate);
+	vector <valFunc> groupingComps;
+	vector <MyDB_AttTypePtr> groupingTypes;
+	for (auto &res : inputRec->compileTypedValueComputations (inputComps)) {
+		groupingComps.push_back (res.first);
+		groupingTypes.push_back (res.second);
+	}
+	valFunc inputPred = groupingComps.back ();
+	groupingComps.pop_back ();
+	groupingTypes.pop_back ();
+
 	// first, we create a schema for the aggregate records... this is all grouping atts,
-	// followed by all aggregate atts, followed by the count att
+	// followed by all aggregate atts, followed by the count att.  A grouping that is a 
+	// dictionary-encoded string is stored encoded, so that groups are checked on codes
 	MyDB_SchemaPtr aggSchema = make_shared <MyDB_Schema> ();
 	int i = 0;
 	int numGroups = groupings.size ();
 	for (auto &a : output->getTable ()->getSchema ()->getAtts ()) {
-		if (i < numGroups) 
+		if (i < numGroups && dynamic_pointer_cast <MyDB_DictAttType> (groupingTypes[i]) != nullptr) {
+			aggSchema->appendAtt (make_pair ("MyDB_GroupAtt" + to_string (i), groupingTypes[i]));
+			i++;
+		} else if (i < numGroups) {
 			aggSchema->appendAtt (make_pair ("MyDB_GroupAtt" + to_string (i++), a.second));
-		else
+		} else {
 			aggSchema->appendAtt (make_pair ("MyDB_AggAtt" + to_string (i++ - numGroups), a.second));
+		}
 	}
 	aggSchema->appendAtt (make_pair ("MyDB_CntAtt", make_shared <MyDB_IntAttType> ()));
 
@@ -50,8 +89,7 @@ void Aggregate :: run () {
 	for (auto &a : aggSchema->getAtts ())
 		combinedSchema->appendAtt (a);
 
-	// now, get an intput rec, an agg rec, and a combined rec
-	MyDB_RecordPtr inputRec = input->getEmptyRecord ();
+	// now, get an agg rec and a combined rec
 	MyDB_RecordPtr aggRec = make_shared <MyDB_Record> (aggSchema);
 	MyDB_RecordPtr combinedRec = make_shared <MyDB_Record> (combinedSchema);
 	combinedRec->buildFrom (inputRec, aggRec);
@@ -66,75 +104,62 @@ void Aggregate :: run () {
 	// this is the hash index for all of the aggregate records
 	unordered_map <size_t, vector <void *>> myHash;
 
-	// this will compute each of the groupings
-	vector <func> groupingComps;
-	for (auto &s : groupings) {
-		groupingComps.push_back (inputRec->compileComputation (s));
-	}
-
-	// and this will verify that each of the groupings match up
-	func checkGroups;
-	string groupCheck;
+	// and this will verify that each of the groupings match up; these computations are all
+	// built directly, rather than written out and then parsed
+	MyDB_CompNodePtr groupCheck;
+	MyDB_CompNodePtr one = MyDB_CompNode :: makeConstant (MyDB_Value :: fromInt (1), make_shared <MyDB_IntAttType> ());
 	i = 0;
 
 	// in case there is not a grouping...
-	groupCheck = "bool[true]";
+	groupCheck = MyDB_CompNode :: makeConstant (MyDB_Value :: fromBool (true), make_shared <MyDB_BoolAttType> ());
 
 	for (auto &s : groupings) {
-		string curClause = "== (" + s + ", [MyDB_GroupAtt" + to_string (i) + "])";
+		MyDB_CompNodePtr curClause = MyDB_CompNode :: makeOp ("==", {s, MyDB_CompNode :: makeAtt ("MyDB_GroupAtt" + to_string (i))});
 		if (i == 0) {
 			groupCheck = curClause;
 		} else {
-			groupCheck = "&& (" + curClause + ", " + groupCheck + ")";
+			groupCheck = MyDB_CompNode :: makeOp ("&&", {curClause, groupCheck});
 		}
 		i++;
 	}
-	checkGroups = combinedRec->compileComputation (groupCheck);	
 
 	// this will compute each of the aggregates for updating the aggregate record
-	vector <func> aggComps;
+	vector <MyDB_CompNodePtr> aggExprs;
 
 	// this will compute the final aggregate value for each output record
-	vector <func> finalAggComps;
+	vector <MyDB_CompNodePtr> finalAggExprs;
 
 	i = 0;
 	for (auto &s : aggsToCompute) {
+		MyDB_CompNodePtr aggAtt = MyDB_CompNode :: makeAtt ("MyDB_AggAtt" + to_string (i++));
 		if (s.first == MyDB_AggType :: sumType || s.first == MyDB_AggType :: avgType) {
-			aggComps.push_back (combinedRec->compileComputation ("+ (" + s.second + 
-				", [MyDB_AggAtt" + to_string (i) + "])"));
+			aggExprs.push_back (MyDB_CompNode :: makeOp ("+", {s.second, aggAtt}));
 		} else if (s.first == MyDB_AggType :: cntType) {
-			aggComps.push_back (combinedRec->compileComputation ("+ ( int[1], [MyDB_AggAtt"
-				+ to_string (i) + "])"));
+			aggExprs.push_back (MyDB_CompNode :: makeOp ("+", {one, aggAtt}));
 		}
 
 		if (s.first == MyDB_AggType :: avgType) {
-			finalAggComps.push_back (combinedRec->compileComputation ("/ ([MyDB_AggAtt" + to_string (i++) + "], [MyDB_CntAtt])"));
+			finalAggExprs.push_back (MyDB_CompNode :: makeOp ("/", {aggAtt, MyDB_CompNode :: makeAtt ("MyDB_CntAtt")}));
 		} else {
-			finalAggComps.push_back (combinedRec->compileComputation ("[MyDB_AggAtt" + to_string (i++) + "]"));
+			finalAggExprs.push_back (aggAtt);
 		}
 	}
-	aggComps.push_back (combinedRec->compileComputation ("+ ( int[1], [MyDB_CntAtt])"));
-
-	// and this runs the selection on the input records
-	func inputPred = inputRec->compileComputation (selectionPredicate);
-
-	// at this point, we are ready to go!!
-	MyDB_RecordIteratorPtr myIter = input->getIterator (inputRec);
+	aggExprs.push_back (MyDB_CompNode :: makeOp ("+", {one, MyDB_CompNode :: makeAtt ("MyDB_CntAtt")}));
+
+	// compile them all together, so that (for example) two aggregates over the same 
+	// expression only compute it once per record
+	vector <MyDB_CompNodePtr> combinedComps = aggExprs;
+	combinedComps.insert (combinedComps.end (), finalAggExprs.begin (), finalAggExprs.end ());
+	combinedComps.push_back (groupCheck);
+	vector <valFunc> aggComps = combinedRec->compileValueComputations (combinedComps);
+	valFunc checkGroups = aggComps.back ();
+	aggComps.pop_back ();
+	vector <valFunc> finalAggComps (aggComps.begin () + aggExprs.size (), aggComps.end ());
+	aggComps.resize (aggExprs.size ());
+
+	// this adds the current input record (whose grouping atts hash to hashVal) to its group
 	MyDB_AttValPtr zero = make_shared <MyDB_IntAttVal> ();
-	while (myIter->hasNext ()) {
-
-		myIter->getNext ();
-
-		// see if it is accepted by the preicate
-		if (!inputPred ()->toBool ()) {
-			continue;
-		}
-
-		// hash the current record
-		size_t hashVal = 0;
-		for (auto &f : groupingComps) {
-			hashVal ^= f ()->hash ();
-		}
+	auto addToGroup = [&] (size_t hashVal) {
 
 		// if there is a match, then get the list of matches
 		vector <void *> &potentialMatches = myHash [hashVal];
@@ -146,7 +171,7 @@ void Aggregate :: run () {
 			aggRec->fromBinary (v);
 
 			// check to see if it matches
-			if (!checkGroups ()->toBool ()) {
+			if (!checkGroups ().toBool ()) {
 				continue;
 			}
 
@@ -160,7 +185,7 @@ void Aggregate :: run () {
 			// set up the record...
 			i = 0;
 			for (auto &f : groupingComps) {
-				aggRec->getAtt (i++)->set (f ());
+				aggRec->getAtt (i++)->fromValue (f ());
 			}
 			for (int j = 0; j < aggComps.size (); j++) {
 				aggRec->getAtt (i++)->set (zero);
@@ -170,7 +195,7 @@ void Aggregate :: run () {
 		// update each of the aggregates
 		i = 0;
 		for (auto &f : aggComps) {
-			aggRec->getAtt (numGroups + i++)->set (f ());
+			aggRec->getAtt (numGroups + i++)->fromValue (f ());
 		}
 
 		// if we did not find a match, write to a new location...
@@ -193,6 +218,64 @@ void Aggregate :: run () {
 		} else {
 			aggRec->toBinary (loc);
 		}
+	};
+
+	// at this point, we are ready to go!!  In batch mode, the predicate and the grouping
+	// hashes are computed a batch at a time, and only the accepted records are loaded
+	if (batchMode) {
+
+		MyDB_Batch batch (inputRec->getSchema ());
+		MyDB_BatchComputation batchPred (selectionPredicate, batch);
+		vector <MyDB_BatchComputationPtr> batchGroupingComps;
+		for (auto &s : groupings) {
+			batchGroupingComps.push_back (make_shared <MyDB_BatchComputation> (s, batch));
+		}
+
+		vector <int> selection;
+		vector <size_t> hashes (BATCH_SIZE);
+		auto processBatch = [&] {
+			batch.selectAll (selection);
+			batchPred.filter (selection);
+			for (int j : selection) {
+				hashes[j] = 0;
+			}
+			for (auto &f : batchGroupingComps) {
+				f->hash (selection, hashes);
+			}
+			for (int j : selection) {
+				batch.getRecord (j, inputRec);
+				addToGroup (hashes[j]);
+			}
+			batch.clear ();
+		};
+
+		MyDB_RecordIteratorAltPtr myIter = input->getIteratorAlt ();
+		while (myIter->advance ()) {
+			if (batch.append (myIter->getCurrentPointer ()))
+				processBatch ();
+		}
+		processBatch ();
+
+	} else {
+
+		MyDB_RecordIteratorPtr myIter = input->getIterator (inputRec);
+		while (myIter->hasNext ()) {
+
+			myIter->getNext ();
+
+			// see if it is accepted by the preicate
+			if (!inputPred ().toBool ()) {
+				continue;
+			}
+
+			// hash the current record
+			size_t hashVal = 0;
+			for (auto &f : groupingComps) {
+				hashVal = MyDB_Value :: combineHashes (hashVal, f ().hash ());
+			}
+
+			addToGroup (hashVal);
+		}
 	}
 
 	// now, we have processed all of the database records... so we can output the aggregates
@@ -211,7 +294,7 @@ void Aggregate :: run () {
 
 		// set the aggregate atts
 		for (auto &a : finalAggComps) {
-			outRec->getAtt (i++)->set (a ());
+			outRec->getAtt (i++)->fromValue (a ());
 		}
 		outRec->recordContentHasChanged ();
 		output->append (outRec);
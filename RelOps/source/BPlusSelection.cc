@@ -21,12 +21,13 @@ void BPlusSelection :: run () {
 	MyDB_RecordPtr inputRec = input->getEmptyRecord ();
 	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
 	
-	// compile all of the coputations that we need here
-	vector <func> finalComputations;
-	for (string s : projections) {
-		finalComputations.push_back (inputRec->compileComputation (s));
-	}
-	func pred = inputRec->compileComputation (selectionPredicate);
+	// compile all of the coputations that we need here; they are compiled together so that
+	// any subexpression that they share is only run once per record
+	vector <string> allComps = projections;
+	allComps.push_back (selectionPredicate);
+	vector <valFunc> finalComputations = inputRec->compileValueComputations (allComps);
+	valFunc pred = finalComputations.back ();
+	finalComputations.pop_back ();
 
 	// now, iterate through the B+-tree query results
 	MyDB_RecordIteratorAltPtr myIter = input->getRangeIteratorAlt (low, high);
@@ -35,14 +36,14 @@ void BPlusSelection :: run () {
 		myIter->getCurrent (inputRec);
 
 		// see if it is accepted by the predicate
-		if (!pred()->toBool ()) {
+		if (!pred ().toBool ()) {
 			continue;
 		}
 
 		// run all of the computations
 		int i = 0;
 		for (auto &f : finalComputations) {
-			outputRec->getAtt (i++)->set (f());
+			outputRec->getAtt (i++)->fromValue (f ());
 		}
 
 		outputRec->recordContentHasChanged ();
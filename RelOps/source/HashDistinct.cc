@@ -0,0 +1,144 @@
+
+#ifndef HASH_DISTINCT_C
+#define HASH_DISTINCT_C
+
+#include "MyDB_PageReaderWriter.h"
+#include "MyDB_Record.h"
+#include "HashDistinct.h"
+#include <cstring>
+#include <stdint.h>
+#include <unordered_map>
+
+using namespace std;
+
+// the number of partitions that the records which do not fit are written to
+#define NUM_DISTINCT_PARTITIONS 16
+
+// hashes the bytes of a record (FNV-1a); each level of partitioning starts from a different
+// value, so the records that were sent to one partition are spread out again over the next
+static inline uint64_t hashBytes (char *data, size_t len, int level) {
+	uint64_t res = 14695981039346656037ull ^ ((uint64_t) level * 0x9E3779B97F4A7C15ull);
+	for (size_t i = 0; i < len; i++) {
+		res ^= (unsigned char) data[i];
+		res *= 1099511628211ull;
+	}
+	return res;
+}
+
+HashDistinct :: HashDistinct (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <string> projectionsIn) :
+	HashDistinct (inputIn, outputIn, MyDB_CompNode :: parse (projectionsIn)) {}
+
+HashDistinct :: HashDistinct (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <MyDB_CompNodePtr> projectionsIn) {
+
+	input = inputIn;
+	output = outputIn;
+	projections = projectionsIn;
+	numPages = input->getBufferMgr ()->getNumPages () / 2;
+	numSpilled = 0;
+}
+
+void HashDistinct :: setNumPages (int numPagesIn) {
+	numPages = numPagesIn;
+}
+
+size_t HashDistinct :: getNumSpilled () {
+	return numSpilled;
+}
+
+void HashDistinct :: run () {
+
+	// the projections are run over the input records; everything after that is done on the
+	// records that they make, which are the records that are written out
+	MyDB_RecordPtr inputRec = input->getEmptyRecord ();
+	vector <valFunc> finalComputations = inputRec->compileValueComputations (projections);
+	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
+
+	numSpilled = 0;
+	MyDB_RecordIteratorAltPtr myIter = input->getIteratorAlt ();
+	dedup ([&] () {
+		if (!myIter->advance ())
+			return false;
+		myIter->getCurrent (inputRec);
+		int i = 0;
+		for (auto &f : finalComputations) {
+			outputRec->getAtt (i++)->fromValue (f ());
+		}
+		outputRec->recordContentHasChanged ();
+		return true;
+	}, outputRec, 0);
+}
+
+void HashDistinct :: dedup (function <bool ()> next, MyDB_RecordPtr rec, int level) {
+
+	MyDB_BufferManager &mgr = *(input->getBufferMgr ());
+
+	// the records in the hash table are kept on these pinned pages; two records are the same
+	// if they are the same byte for byte, so they are compared just as they are on the page
+	vector <MyDB_PageReaderWriter> allPages;
+	allPages.push_back (MyDB_PageReaderWriter (true, mgr));
+	unordered_map <uint64_t, vector <void *>> myHash;
+
+	// the partitions that records are written to once the pinned pages run out
+	vector <vector <MyDB_PageReaderWriter>> partitions (NUM_DISTINCT_PARTITIONS);
+	vector <char> bytes;
+	while (next ()) {
+
+		bytes.resize (rec->getBinarySize ());
+		rec->toBinary (bytes.data ());
+		uint64_t hashVal = hashBytes (bytes.data (), bytes.size (), level);
+
+		// if the record has been seen already, it is thrown away
+		bool found = false;
+		auto entry = myHash.find (hashVal);
+		if (entry != myHash.end ()) {
+			for (void *v : entry->second) {
+				if (memcmp (v, bytes.data (), bytes.size ()) == 0) {
+					found = true;
+					break;
+				}
+			}
+		}
+		if (found)
+			continue;
+
+		// otherwise, it goes into the table and is written out, if there is room
+		void *loc = allPages.back ().appendAndReturnLocation (rec);
+		if (loc == nullptr && (int) allPages.size () < numPages) {
+			allPages.push_back (MyDB_PageReaderWriter (true, mgr));
+			loc = allPages.back ().appendAndReturnLocation (rec);
+		}
+		if (loc != nullptr) {
+			myHash[hashVal].push_back (loc);
+			output->append (rec);
+			continue;
+		}
+
+		// and if there is not, it is written to its partition, to be looked at later
+		vector <MyDB_PageReaderWriter> &partition = partitions[(hashVal >> 40) % NUM_DISTINCT_PARTITIONS];
+		if (partition.empty () || !partition.back ().append (rec)) {
+			partition.push_back (MyDB_PageReaderWriter (mgr));
+			partition.back ().append (rec);
+		}
+		numSpilled++;
+	}
+
+	// let go of the table before the partitions are run, each with the whole table to itself
+	myHash.clear ();
+	allPages.clear ();
+	for (auto &partition : partitions) {
+		if (partition.empty ())
+			continue;
+		MyDB_RecordIteratorAltPtr myIter = getIteratorAlt (partition);
+		dedup ([&] () {
+			if (!myIter->advance ())
+				return false;
+			myIter->getCurrent (rec);
+			return true;
+		}, rec, level + 1);
+		partition.clear ();
+	}
+}
+
+#endif
@@ -0,0 +1,343 @@
+
+#ifndef HYBRID_HASH_JOIN_C
+#define HYBRID_HASH_JOIN_C
+
+#include "MyDB_AdaptiveConjunction.h"
+#include "MyDB_JoinHashTable.h"
+#include "MyDB_Record.h"
+#include "HybridHashJoin.h"
+#include <stdint.h>
+
+using namespace std;
+
+// the most partitions that each side is split into at each level
+#define NUM_JOIN_PARTITIONS 16
+
+// after this many levels of splitting, a partition that is still too large is joined in chunks
+#define MAX_JOIN_LEVELS 3
+
+// picks one of numParts partitions for a record with the given hash; the hash is mixed with a
+// different value at each level (this is the finalizer of splitmix64), so the records that were
+// sent to one partition are spread out again over the next, and it does not matter how the hash
+// itself uses its bits
+static inline int partitionFor (size_t hashVal, int level, int numParts) {
+	uint64_t res = (uint64_t) hashVal + (uint64_t) (level + 1) * 0x9E3779B97F4A7C15ull;
+	res = (res ^ (res >> 30)) * 0xBF58476D1CE4E5B9ull;
+	res = (res ^ (res >> 27)) * 0x94D049BB133111EBull;
+	res = res ^ (res >> 31);
+	return (int) (res % numParts);
+}
+
+static vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> parseChecks (vector <pair <string, string>> parseUs) {
+	vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> res;
+	for (auto &p : parseUs) {
+		res.push_back (make_pair (MyDB_CompNode :: parse (p.first), MyDB_CompNode :: parse (p.second)));
+	}
+	return res;
+}
+
+HybridHashJoin :: HybridHashJoin (MyDB_TableReaderWriterPtr leftInputIn, MyDB_TableReaderWriterPtr rightInputIn,
+		MyDB_TableReaderWriterPtr outputIn, string finalSelectionPredicateIn,
+		vector <string> projectionsIn,
+		vector <pair <string, string>> equalityChecksIn, string leftSelectionPredicateIn,
+		string rightSelectionPredicateIn) :
+	HybridHashJoin (leftInputIn, rightInputIn, outputIn, MyDB_CompNode :: parse (finalSelectionPredicateIn),
+		MyDB_CompNode :: parse (projectionsIn), parseChecks (equalityChecksIn),
+		MyDB_CompNode :: parse (leftSelectionPredicateIn), MyDB_CompNode :: parse (rightSelectionPredicateIn)) {}
+
+HybridHashJoin :: HybridHashJoin (MyDB_TableReaderWriterPtr leftInputIn, MyDB_TableReaderWriterPtr rightInputIn,
+		MyDB_TableReaderWriterPtr outputIn, MyDB_CompNodePtr finalSelectionPredicateIn,
+		vector <MyDB_CompNodePtr> projectionsIn,
+		vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> equalityChecksIn,
+		MyDB_CompNodePtr leftSelectionPredicateIn, MyDB_CompNodePtr rightSelectionPredicateIn) {
+
+	output = outputIn;
+	finalSelectionPredicate = finalSelectionPredicateIn;
+	projections = projectionsIn;
+
+	// as in the ScanJoin, the smaller table goes on the left, since it is the one that is hashed
+	if (leftInputIn->getNumPages () < rightInputIn->getNumPages ()) {
+		equalityChecks = equalityChecksIn;
+		leftTable = leftInputIn;
+		rightTable = rightInputIn;
+		leftSelectionPredicate = leftSelectionPredicateIn;
+		rightSelectionPredicate = rightSelectionPredicateIn;
+	} else {
+		for (auto &a : equalityChecksIn) {
+			equalityChecks.push_back (make_pair (a.second, a.first));
+		}
+		leftTable = rightInputIn;
+		rightTable = leftInputIn;
+		leftSelectionPredicate = rightSelectionPredicateIn;
+		rightSelectionPredicate = leftSelectionPredicateIn;
+	}
+
+	numPages = leftTable->getBufferMgr ()->getNumPages () / 2;
+	numSpilled = 0;
+}
+
+void HybridHashJoin :: setNumPages (int numPagesIn) {
+	numPages = numPagesIn;
+}
+
+size_t HybridHashJoin :: getNumSpilled () {
+	return numSpilled;
+}
+
+void HybridHashJoin :: run () {
+
+	// get the hash computations and the selection predicate over each side
+	leftRec = leftTable->getEmptyRecord ();
+	rightRec = rightTable->getEmptyRecord ();
+	vector <MyDB_CompNodePtr> leftComps, rightComps;
+	for (auto &p : equalityChecks) {
+		leftComps.push_back (p.first);
+		rightComps.push_back (p.second);
+	}
+	leftComps.push_back (leftSelectionPredicate);
+	rightComps.push_back (rightSelectionPredicate);
+	vector <valFunc> leftEqualities = leftRec->compileValueComputations (leftComps);
+	vector <valFunc> rightEqualities = rightRec->compileValueComputations (rightComps);
+	valFunc leftPred = leftEqualities.back ();
+	valFunc rightPred = rightEqualities.back ();
+	leftEqualities.pop_back ();
+	rightEqualities.pop_back ();
+
+	// the hashes are combined just as they are in the ScanJoin
+	leftHash = [leftEqualities] () {
+		size_t hashVal = 0;
+		for (auto &f : leftEqualities) {
+			hashVal = MyDB_Value :: combineHashes (hashVal, f ().hash ());
+		}
+		return hashVal;
+	};
+	rightHash = [rightEqualities] () {
+		size_t hashVal = 0;
+		for (auto &f : rightEqualities) {
+			hashVal = MyDB_Value :: combineHashes (hashVal, f ().hash ());
+		}
+		return hashVal;
+	};
+
+	// get the record that is made by putting the two sides together, and compile the output
+	// computations and the clauses of the final predicate over it, all at once
+	MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
+	for (auto &p : leftTable->getTable ()->getSchema ()->getAtts ())
+		mySchemaOut->appendAtt (p);
+	for (auto &p : rightTable->getTable ()->getSchema ()->getAtts ())
+		mySchemaOut->appendAtt (p);
+	MyDB_RecordPtr combinedRec = make_shared <MyDB_Record> (mySchemaOut);
+	combinedRec->buildFrom (leftRec, rightRec);
+
+	vector <MyDB_CompNodePtr> clauses = MyDB_AdaptiveConjunction :: split (finalSelectionPredicate);
+	vector <MyDB_CompNodePtr> finalComps = projections;
+	finalComps.insert (finalComps.end (), clauses.begin (), clauses.end ());
+	vector <valFunc> finalComputations = combinedRec->compileValueComputations (finalComps);
+	MyDB_AdaptiveConjunction finalPredicate (clauses, vector <valFunc> (finalComputations.begin () +
+		projections.size (), finalComputations.end ()));
+	finalComputations.resize (projections.size ());
+
+	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
+	emit = [&] () {
+		if (!finalPredicate.accepts ())
+			return;
+		int i = 0;
+		for (auto &f : finalComputations) {
+			outputRec->getAtt (i++)->fromValue (f ());
+		}
+		outputRec->recordContentHasChanged ();
+		output->append (outputRec);
+	};
+
+	// at the top level, the records come from the two tables, and are run through the predicates
+	numSpilled = 0;
+	MyDB_RecordIteratorAltPtr leftIter = leftTable->getIteratorAlt ();
+	MyDB_RecordIteratorAltPtr rightIter = rightTable->getIteratorAlt ();
+	join ([&] () {
+		while (leftIter->advance ()) {
+			leftIter->getCurrent (leftRec);
+			if (leftPred ().toBool ())
+				return true;
+		}
+		return false;
+	}, [&] () {
+		while (rightIter->advance ()) {
+			rightIter->getCurrent (rightRec);
+			if (rightPred ().toBool ())
+				return true;
+		}
+		return false;
+	}, 0, leftTable->getNumPages ());
+
+	if (finalPredicate.toString () != "")
+		cout << "HybridHashJoin : clauses ran in the order " << finalPredicate.toString () << endl;
+	if (numSpilled > 0)
+		cout << "HybridHashJoin : " << numSpilled << " partitions were written to disk" << endl;
+	emit = nullptr;
+}
+
+void HybridHashJoin :: join (function <bool ()> nextLeft, function <bool ()> nextRight, int level, 
+	int estimatedPages) {
+
+	MyDB_BufferManager &mgr = *(leftTable->getBufferMgr ());
+
+	// if the left records should all fit, they are not split up at all (if they do not, they are
+	// split up at the next level); otherwise, every partition needs at least a page of its own
+	// while it is in RAM, so there are no more of them than pages
+	int numParts = 1;
+	if (estimatedPages > numPages)
+		numParts = min (NUM_JOIN_PARTITIONS, max (numPages, 2));
+
+	// split up the left records; while a partition is in RAM, the location and the hash of
+	// each of its records are remembered, so that they can go right into the hash table
+	vector <vector <MyDB_PageReaderWriter>> leftParts (numParts);
+	vector <vector <pair <size_t, void *>>> entries (numParts);
+	vector <bool> inRAM (numParts, true);
+	int numPinned = 0;
+	while (nextLeft ()) {
+
+		size_t hashVal = leftHash ();
+		int which = partitionFor (hashVal, level, numParts);
+		if (inRAM[which]) {
+			void *loc = leftParts[which].empty () ? nullptr : leftParts[which].back ().appendAndReturnLocation (leftRec);
+			if (loc == nullptr) {
+
+				// the partition needs another page; if all of the pages are used up, the
+				// largest partition that is in RAM is written out to make room
+				if (numPinned >= numPages) {
+					int victim = which;
+					for (int i = 0; i < numParts; i++) {
+						if (inRAM[i] && leftParts[i].size () > leftParts[victim].size ())
+							victim = i;
+					}
+					for (auto &page : leftParts[victim])
+						page.unpin ();
+					numPinned -= leftParts[victim].size ();
+					entries[victim].clear ();
+					inRAM[victim] = false;
+					numSpilled++;
+				}
+				if (inRAM[which]) {
+					leftParts[which].push_back (MyDB_PageReaderWriter (true, mgr));
+					numPinned++;
+					loc = leftParts[which].back ().appendAndReturnLocation (leftRec);
+				}
+			}
+			if (loc != nullptr) {
+				entries[which].push_back (make_pair (hashVal, loc));
+				continue;
+			}
+		}
+
+		// the partition is on disk, so the record is just appended to it
+		if (leftParts[which].empty () || !leftParts[which].back ().append (leftRec)) {
+			leftParts[which].push_back (MyDB_PageReaderWriter (mgr));
+			leftParts[which].back ().append (leftRec);
+		}
+	}
+
+	// put the partitions that are in RAM into the hash table
+	MyDB_JoinHashTable myHash;
+	size_t numInRAM = 0;
+	for (auto &entryList : entries)
+		numInRAM += entryList.size ();
+	myHash.reserve (numInRAM);
+	for (auto &entryList : entries) {
+		for (auto &e : entryList) {
+			myHash.insert (e.first, e.second);
+		}
+		entryList.clear ();
+	}
+
+	// and scan the right records; the ones that cannot match anything in RAM are written to
+	// their partitions (unless the left partition is empty, in which case they match nothing)
+	vector <vector <MyDB_PageReaderWriter>> rightParts (numParts);
+	while (nextRight ()) {
+
+		size_t hashVal = rightHash ();
+		int which = partitionFor (hashVal, level, numParts);
+		if (inRAM[which]) {
+			myHash.probe (hashVal, [&] (void *v) {
+				leftRec->fromBinary (v);
+				emit ();
+			});
+		} else if (rightParts[which].empty () || !rightParts[which].back ().append (rightRec)) {
+			rightParts[which].push_back (MyDB_PageReaderWriter (mgr));
+			rightParts[which].back ().append (rightRec);
+		}
+	}
+
+	// let go of the partitions that were in RAM before the others are joined, each of them
+	// with all of the pages to itself
+	myHash.clear ();
+	for (int i = 0; i < numParts; i++) {
+		if (inRAM[i])
+			leftParts[i].clear ();
+	}
+
+	for (int i = 0; i < numParts; i++) {
+
+		if (inRAM[i] || rightParts[i].empty ()) {
+			leftParts[i].clear ();
+			continue;
+		}
+
+		if (level + 1 >= MAX_JOIN_LEVELS) {
+			joinInChunks (leftParts[i], rightParts[i]);
+		} else {
+			MyDB_RecordIteratorAltPtr leftIter = getIteratorAlt (leftParts[i]);
+			MyDB_RecordIteratorAltPtr rightIter = getIteratorAlt (rightParts[i]);
+			join ([&] () {
+				if (!leftIter->advance ())
+					return false;
+				leftIter->getCurrent (leftRec);
+				return true;
+			}, [&] () {
+				if (!rightIter->advance ())
+					return false;
+				rightIter->getCurrent (rightRec);
+				return true;
+			}, level + 1, leftParts[i].size ());
+		}
+		leftParts[i].clear ();
+		rightParts[i].clear ();
+	}
+}
+
+void HybridHashJoin :: joinInChunks (vector <MyDB_PageReaderWriter> &leftPages,
+	vector <MyDB_PageReaderWriter> &rightPages) {
+
+	MyDB_BufferManager &mgr = *(leftTable->getBufferMgr ());
+	MyDB_RecordIteratorAltPtr leftIter = getIteratorAlt (leftPages);
+	bool moreLeft = leftIter->advance ();
+	while (moreLeft) {
+
+		// copy as many left records as there is room for onto pinned pages, and hash them
+		vector <MyDB_PageReaderWriter> chunk;
+		MyDB_JoinHashTable myHash;
+		while (moreLeft) {
+			leftIter->getCurrent (leftRec);
+			void *loc = chunk.empty () ? nullptr : chunk.back ().appendAndReturnLocation (leftRec);
+			if (loc == nullptr) {
+				if ((int) chunk.size () >= max (numPages, 1))
+					break;
+				chunk.push_back (MyDB_PageReaderWriter (true, mgr));
+				loc = chunk.back ().appendAndReturnLocation (leftRec);
+			}
+			myHash.insert (leftHash (), loc);
+			moreLeft = leftIter->advance ();
+		}
+
+		// and join all of the right records with them
+		MyDB_RecordIteratorAltPtr rightIter = getIteratorAlt (rightPages);
+		while (rightIter->advance ()) {
+			rightIter->getCurrent (rightRec);
+			myHash.probe (rightHash (), [&] (void *v) {
+				leftRec->fromBinary (v);
+				emit ();
+			});
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,53 @@
+
+#ifndef ORDER_BY_C
+#define ORDER_BY_C
+
+#include "MyDB_Record.h"
+#include "OrderBy.h"
+#include "Sorting.h"
+
+OrderBy :: OrderBy (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <pair <string, bool>> sortKeysIn, vector <string> projectionsIn) :
+	OrderBy (inputIn, outputIn, parseSortKeys (sortKeysIn), MyDB_CompNode :: parse (projectionsIn)) {}
+
+OrderBy :: OrderBy (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <pair <MyDB_CompNodePtr, bool>> sortKeysIn, vector <MyDB_CompNodePtr> projectionsIn) {
+
+	input = inputIn;
+	output = outputIn;
+	sortKeys = sortKeysIn;
+	projections = projectionsIn;
+	limit = -1;
+}
+
+void OrderBy :: setLimit (long limitIn) {
+	limit = limitIn;
+}
+
+void OrderBy :: run () {
+
+	// the comparator, and the projections, are over the records that come out of the merge
+	MyDB_RecordPtr lhs = input->getEmptyRecord ();
+	MyDB_RecordPtr rhs = input->getEmptyRecord ();
+	function <bool ()> comparator = buildRecordComparator (lhs, rhs, sortKeys);
+	vector <valFunc> finalComputations = lhs->compileValueComputations (projections);
+	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
+
+	// the runs get half of the buffer, as they do in a sort merge join
+	int runSize = input->getBufferMgr ()->getNumPages () / 2;
+	MyDB_RecordIteratorAltPtr myIter = buildItertorOverSortedRuns (runSize, *input, comparator, lhs, rhs);
+
+	long numWritten = 0;
+	while ((limit < 0 || numWritten < limit) && myIter->advance ()) {
+		myIter->getCurrent (lhs);
+		int i = 0;
+		for (auto &f : finalComputations) {
+			outputRec->getAtt (i++)->fromValue (f ());
+		}
+		outputRec->recordContentHasChanged ();
+		output->append (outputRec);
+		numWritten++;
+	}
+}
+
+#endif
@@ -1,55 +1,398 @@
 
-#ifndef REG_SELECTION_C                                        
+#ifndef REG_SELECTION_C
 #define REG_SELECTION_C
 
+#include <algorithm>
+#include <atomic>
+#include "MyDB_AdaptiveConjunction.h"
+#include "MyDB_BatchComputation.h"
+#include "MyDB_NativeComputation.h"
+#include "MyDB_PageReaderWriter.h"
+#include "MyDB_TableRecIteratorAlt.h"
 #include "RegularSelection.h"
 
+// the number of pages that a thread takes at a time
+#define MORSEL_PAGES 16
+
+// the pages of the input that have not been handed out to a thread yet
+struct SelectionMorsels {
+	MyDB_TableReaderWriterPtr input;
+	pageFilter canMatch;
+	int numPages;
+	atomic <int> nextPage;
+};
+
+// everything that one thread needs to run the selection: its own records, and its own copy of
+// the compiled predicate and projections (which have state of their own, such as the batch that
+// is being filled, or the order that the clauses are being run in)
+class SelectionWorker {
+
+public:
+
+	SelectionWorker (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr output, MyDB_CompNodePtr selectionPredicate,
+		vector <MyDB_CompNodePtr> &projections, bool batchMode, MyDB_NativeComputationPtr native, bool ownPages);
+
+	// runs the selection over every record that the iterator returns
+	void scan (MyDB_TableRecIteratorAltPtr myIter);
+
+	// the selection stops once this many records have been written (-1 means no limit)
+	void setLimit (long limitIn);
+
+	// takes pages from the input until there are none left, and runs the selection over them
+	void scan (SelectionMorsels &morsels);
+
+	// writes out the records in the last (partly filled) batch
+	void finish ();
+
+	// after the thread is done, puts the summaries of the pages that it wrote into the zone map of the output
+	void copyZones ();
+
+	string getClauseOrder ();
+	int getNumPagesSkipped ();
+
+private:
+
+	// writes out outputRec, either by appending it to the output table, or (if ownPages is set)
+	// onto the page of the output that this thread is filling
+	void emit ();
+
+	// true if the limit has been reached
+	bool isFull () {
+		return limit >= 0 && numWritten >= limit;
+	}
+
+	MyDB_TableReaderWriterPtr output;
+	MyDB_RecordPtr inputRec;
+	MyDB_RecordPtr outputRec;
+	int numPagesSkipped;
+	int numSeen;
+	long limit;
+	long numWritten;
+
+	// native mode
+	MyDB_NativeComputationPtr native;
+
+	// batch mode
+	bool batchMode;
+	shared_ptr <MyDB_Batch> batch;
+	vector <MyDB_BatchComputationPtr> batchComputations;
+	vector <int> selection;
+	vector <MyDB_Column *> results;
+
+	// record at a time mode
+	vector <valFunc> finalComputations;
+
+	// the clauses of the predicate, in batch mode and in record at a time mode
+	shared_ptr <MyDB_AdaptiveConjunction> pred;
+
+	// for writing onto pages of the output; the summaries of the pages are kept on the side,
+	// since the zone map of the output is not to be changed by more than one thread at once
+	bool ownPages;
+	bool havePage;
+	MyDB_PageReaderWriter curPage;
+	size_t curPageNum;
+	vector <size_t> pagesWritten;
+	MyDB_ZoneMapPtr zones;
+};
+
+SelectionWorker :: SelectionWorker (MyDB_TableReaderWriterPtr input, MyDB_TableReaderWriterPtr outputIn,
+	MyDB_CompNodePtr selectionPredicate, vector <MyDB_CompNodePtr> &projections, bool batchModeIn,
+	MyDB_NativeComputationPtr nativeIn, bool ownPagesIn) {
+
+	output = outputIn;
+	inputRec = input->getEmptyRecord ();
+	outputRec = output->getEmptyRecord ();
+	numPagesSkipped = 0;
+	numSeen = 0;
+	limit = -1;
+	numWritten = 0;
+	native = nativeIn;
+	batchMode = batchModeIn;
+	ownPages = ownPagesIn;
+	havePage = false;
+	if (ownPages && output->getZoneMap () != nullptr)
+		zones = make_shared <MyDB_ZoneMap> (outputRec->getSchema ());
+
+	if (native != nullptr)
+		return;
+
+	if (batchMode) {
+
+		// compile the predicate and the projections over a batch
+		batch = make_shared <MyDB_Batch> (inputRec->getSchema ());
+		pred = make_shared <MyDB_AdaptiveConjunction> (MyDB_AdaptiveConjunction :: split (selectionPredicate), *batch);
+		for (MyDB_CompNodePtr s : projections) {
+			batchComputations.push_back (make_shared <MyDB_BatchComputation> (s, *batch));
+		}
+		results.resize (batchComputations.size ());
+		return;
+	}
+
+	// compile all of the coputations that we need here; they are compiled together so that
+	// any subexpression that they share is only run once per record... the clauses of the
+	// predicate are compiled one by one, so that they can be run in whatever order is best
+	vector <MyDB_CompNodePtr> clauses = MyDB_AdaptiveConjunction :: split (selectionPredicate);
+	vector <MyDB_CompNodePtr> allComps = projections;
+	allComps.insert (allComps.end (), clauses.begin (), clauses.end ());
+	finalComputations = inputRec->compileValueComputations (allComps);
+	pred = make_shared <MyDB_AdaptiveConjunction> (clauses, vector <valFunc> (finalComputations.begin () +
+		projections.size (), finalComputations.end ()));
+	finalComputations.resize (projections.size ());
+}
+
+void SelectionWorker :: setLimit (long limitIn) {
+	limit = limitIn;
+}
+
+void SelectionWorker :: emit () {
+
+	// once the limit is reached, nothing more is written
+	if (limit >= 0 && numWritten >= limit)
+		return;
+	numWritten++;
+
+	outputRec->recordContentHasChanged ();
+	if (!ownPages) {
+		output->append (outputRec);
+		return;
+	}
+
+	// start a new page if this one is full
+	if (!havePage || !curPage.append (outputRec)) {
+		curPage = output->addPage (curPageNum);
+		havePage = true;
+		pagesWritten.push_back (curPageNum);
+		if (zones != nullptr)
+			zones->track (curPageNum);
+		curPage.append (outputRec);
+	}
+
+	if (zones != nullptr)
+		zones->update (curPageNum, outputRec);
+}
+
+void SelectionWorker :: scan (MyDB_TableRecIteratorAltPtr myIter) {
+
+	if (native != nullptr) {
+
+		// the native code reads each record right where it sits on its page
+		while (!isFull () && myIter->advance ()) {
+			if (native->run (myIter->getCurrentPointer (), outputRec))
+				emit ();
+		}
+
+	} else if (batchMode) {
+
+		while (!isFull () && myIter->advance ()) {
+			if (batch->append (myIter->getCurrentPointer ()))
+				finish ();
+		}
+
+	} else {
+
+		while (!isFull () && myIter->advance ()) {
+			myIter->getCurrent (inputRec);
+
+			numSeen++;
+			if (numSeen % 10000 == 0) {
+				cout << numSeen / 10000 << endl;
+			}
+			// see if it is accepted by the predicate
+			if (!pred->accepts ()) {
+				continue;
+			}
+
+			// run all of the computations
+			int i = 0;
+			for (auto &f : finalComputations) {
+				outputRec->getAtt (i++)->fromValue (f ());
+			}
+			emit ();
+		}
+	}
+
+	numPagesSkipped += myIter->getNumPagesSkipped ();
+}
+
+void SelectionWorker :: scan (SelectionMorsels &morsels) {
+	while (true) {
+		int lowPage = morsels.nextPage.fetch_add (MORSEL_PAGES);
+		if (lowPage >= morsels.numPages)
+			break;
+		int highPage = min (lowPage + MORSEL_PAGES, morsels.numPages) - 1;
+		scan (make_shared <MyDB_TableRecIteratorAlt> (*morsels.input, morsels.input->getTable (), lowPage, highPage,
+			morsels.canMatch));
+	}
+	finish ();
+}
+
+void SelectionWorker :: finish () {
+
+	if (!batchMode || native != nullptr)
+		return;
+
+	// run everything over the batch, and write out the accepted records
+	batch->selectAll (selection);
+	pred->filter (selection);
+	for (size_t j = 0; j < batchComputations.size (); j++) {
+		results[j] = &batchComputations[j]->evaluate (selection);
+	}
+	for (int i : selection) {
+		for (size_t j = 0; j < results.size (); j++) {
+			outputRec->getAtt (j)->fromValue (results[j]->getValue (i));
+		}
+		emit ();
+	}
+	batch->clear ();
+}
+
+void SelectionWorker :: copyZones () {
+	if (zones == nullptr)
+		return;
+	for (size_t whichPage : pagesWritten)
+		output->getZoneMap ()->copyPage (whichPage, *zones);
+}
+
+string SelectionWorker :: getClauseOrder () {
+	return pred == nullptr ? "" : pred->toString ();
+}
+
+int SelectionWorker :: getNumPagesSkipped () {
+	return numPagesSkipped;
+}
+
+// where each of the threads started by executeThreads begins
+struct SelectionThreadArg {
+	SelectionWorker *worker;
+	SelectionMorsels *morsels;
+};
+
+static void runSelectionThread (void *arg) {
+	SelectionThreadArg *myArg = (SelectionThreadArg *) arg;
+	myArg->worker->scan (*myArg->morsels);
+}
+
 RegularSelection :: RegularSelection (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
-                string selectionPredicateIn, vector <string> projectionsIn) {
+                string selectionPredicateIn, vector <string> projectionsIn) :
+		RegularSelection (inputIn, outputIn, MyDB_CompNode :: parse (selectionPredicateIn),
+		MyDB_CompNode :: parse (projectionsIn)) {}
+
+RegularSelection :: RegularSelection (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+                MyDB_CompNodePtr selectionPredicateIn, vector <MyDB_CompNodePtr> projectionsIn) {
 
 	input = inputIn;
 	output = outputIn;
 	selectionPredicate = selectionPredicateIn;
 	projections = projectionsIn;
+	batchMode = false;
+	nativeMode = false;
+	numThreads = 1;
+	limit = -1;
+	numPagesSkipped = 0;
+}
+
+void RegularSelection :: setBatchMode (bool batchModeIn) {
+	batchMode = batchModeIn;
+}
+
+void RegularSelection :: setNativeMode (bool nativeModeIn) {
+	nativeMode = nativeModeIn;
+}
+
+void RegularSelection :: setNumThreads (int numThreadsIn) {
+	numThreads = numThreadsIn;
+}
+
+void RegularSelection :: setLimit (long limitIn) {
+	limit = limitIn;
+}
+
+int RegularSelection :: getNumPagesSkipped () {
+	return numPagesSkipped;
+}
+
+bool RegularSelection :: canRunInParallel () {
+
+	MyDB_SchemaPtr inSchema = input->getTable ()->getSchema ();
+	vector <pair <string, MyDB_AttTypePtr>> &outAtts = output->getTable ()->getSchema ()->getAtts ();
+	for (size_t j = 0; j < projections.size () && j < outAtts.size (); j++) {
+		MyDB_DictAttTypePtr outType = dynamic_pointer_cast <MyDB_DictAttType> (outAtts[j].second);
+		if (outType == nullptr)
+			continue;
+		if (!projections[j]->isAtt ())
+			return false;
+		MyDB_DictAttTypePtr inType = dynamic_pointer_cast <MyDB_DictAttType> (projections[j]->findAtt (inSchema).second);
+		if (inType == nullptr || inType->getDictionary () != outType->getDictionary ())
+			return false;
+	}
+	return true;
 }
 
 void RegularSelection :: run () {
 
-	MyDB_RecordPtr inputRec = input->getEmptyRecord ();
-	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
-	
-	// compile all of the coputations that we need here
-	vector <func> finalComputations;
-	for (string s : projections) {
-		finalComputations.push_back (inputRec->compileComputation (s));
+	int threads = max (numThreads, 1);
+	if (threads > 1 && limit >= 0) {
+		cout << "RegularSelection : a limit is set; using one thread" << endl;
+		threads = 1;
+	}
+	if (threads > 1 && !canRunInParallel ()) {
+		cout << "RegularSelection : the output has a dictionary that may be added to; using one thread" << endl;
+		threads = 1;
 	}
-	func pred = inputRec->compileComputation (selectionPredicate);
 
-	// now, iterate through the B+-tree query results
-	MyDB_RecordIteratorAltPtr myIter = input->getIteratorAlt ();
+	// the native code keeps its results in the object that runs it, so each thread needs its own
+	vector <MyDB_NativeComputationPtr> natives (threads, nullptr);
+	if (nativeMode) {
+		for (int i = 0; i < threads; i++)
+			natives[i] = MyDB_NativeComputation :: compile (input->getTable ()->getSchema (), selectionPredicate, projections);
+		if (natives[0] == nullptr)
+			cout << "RegularSelection : could not compile to native code; interpreting instead" << endl;
+	}
 
-	int i = 0;
-	while (myIter->advance ()) {
-		myIter->getCurrent (inputRec);
+	// everything is compiled here, before any thread starts
+	vector <shared_ptr <SelectionWorker>> workers;
+	for (int i = 0; i < threads; i++) {
+		workers.push_back (make_shared <SelectionWorker> (input, output, selectionPredicate, projections, batchMode,
+			natives[i], threads > 1));
+	}
 
-		i++;
-		if (i % 10000 == 0) {
-			cout << i / 10000 << endl; 
-		}
-		// see if it is accepted by the predicate
-		if (!pred()->toBool ()) {
-			continue;
-		}
+	numPagesSkipped = 0;
+	if (threads == 1) {
+		workers[0]->setLimit (limit);
 
-		// run all of the computations
-		int i = 0;
-		for (auto &f : finalComputations) {
-			outputRec->getAtt (i++)->set (f());
+		// iterate through the table, skipping the pages that the zone maps rule out
+		workers[0]->scan (input->getFilteredIteratorAlt (selectionPredicate));
+		workers[0]->finish ();
+		numPagesSkipped = workers[0]->getNumPagesSkipped ();
+
+	} else {
+
+		// the threads take the pages a few at a time, so that one that gets pages with
+		// many accepted records does not hold the others up
+		SelectionMorsels morsels;
+		morsels.input = input;
+		morsels.canMatch = input->getZoneMap () == nullptr ? nullptr : input->getZoneMap ()->compileFilter (selectionPredicate);
+		morsels.numPages = input->getNumPages ();
+		morsels.nextPage = 0;
+
+		vector <SelectionThreadArg> args (threads);
+		vector <void *> argPtrs;
+		for (int i = 0; i < threads; i++) {
+			args[i].worker = workers[i].get ();
+			args[i].morsels = &morsels;
+			argPtrs.push_back (&args[i]);
 		}
+		input->getBufferMgr ()->executeThreads (runSelectionThread, argPtrs);
 
-		outputRec->recordContentHasChanged ();
-		output->append (outputRec);
+		for (auto &w : workers) {
+			w->copyZones ();
+			numPagesSkipped += w->getNumPagesSkipped ();
+		}
+		cout << "RegularSelection : ran on " << threads << " threads" << endl;
 	}
+
+	if (workers[0]->getClauseOrder () != "")
+		cout << "RegularSelection : clauses ran in the order " << workers[0]->getClauseOrder () << endl;
 }
 
 #endif
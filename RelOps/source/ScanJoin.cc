@@ -2,11 +2,13 @@
 #ifndef SCAN_JOIN_C
 #define SCAN_JOIN_C
 
+#include "MyDB_AdaptiveConjunction.h"
+#include "MyDB_BatchComputation.h"
+#include "MyDB_JoinHashTable.h"
 #include "MyDB_Record.h"
 #include "MyDB_PageReaderWriter.h"
 #include "MyDB_TableReaderWriter.h"
 #include "ScanJoin.h"
-#include <unordered_map>
 
 using namespace std;
 
@@ -14,7 +16,24 @@ ScanJoin :: ScanJoin (MyDB_TableReaderWriterPtr leftInputIn, MyDB_TableReaderWri
                 MyDB_TableReaderWriterPtr outputIn, string finalSelectionPredicateIn,
 		vector <string> projectionsIn,
                 vector <pair <string, string>> equalityChecksIn, string leftSelectionPredicateIn,
-                string rightSelectionPredicateIn) {
+                string rightSelectionPredicateIn) : 
+		ScanJoin (leftInputIn, rightInputIn, outputIn, MyDB_CompNode :: parse (finalSelectionPredicateIn),
+		MyDB_CompNode :: parse (projectionsIn), parse (equalityChecksIn), MyDB_CompNode :: parse (leftSelectionPredicateIn),
+		MyDB_CompNode :: parse (rightSelectionPredicateIn)) {}
+
+vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> ScanJoin :: parse (vector <pair <string, string>> parseUs) {
+	vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> res;
+	for (auto &p : parseUs) {
+		res.push_back (make_pair (MyDB_CompNode :: parse (p.first), MyDB_CompNode :: parse (p.second)));
+	}
+	return res;
+}
+
+ScanJoin :: ScanJoin (MyDB_TableReaderWriterPtr leftInputIn, MyDB_TableReaderWriterPtr rightInputIn,
+                MyDB_TableReaderWriterPtr outputIn, MyDB_CompNodePtr finalSelectionPredicateIn,
+		vector <MyDB_CompNodePtr> projectionsIn,
+                vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> equalityChecksIn, 
+		MyDB_CompNodePtr leftSelectionPredicateIn, MyDB_CompNodePtr rightSelectionPredicateIn) {
 
 	output = outputIn;
 	finalSelectionPredicate = finalSelectionPredicateIn;
@@ -47,16 +66,21 @@ ScanJoin :: ScanJoin (MyDB_TableReaderWriterPtr leftInputIn, MyDB_TableReaderWri
 
 		hadToSwapThem = true;
 	}
+
+	batchMode = false;
+}
+
+void ScanJoin :: setBatchMode (bool batchModeIn) {
+	batchMode = batchModeIn;
 }
 
 void ScanJoin :: run () {
 
 
 	cout << "ScanJoin.run() begin" << endl;
-	// this is the hash map we'll use to look up data... the key is the hashed value
-	// of all of the records' join keys, and the value is a list of pointers were all
-	// of the records with that hsah value are located
-	unordered_map <size_t, vector <void *>> myHash;
+	// this is the hash table we'll use to look up data... it holds the hashed value
+	// of each record's join keys, along with a pointer to where the record is located
+	MyDB_JoinHashTable myHash;
 
 	// get all of the pages
 	vector <MyDB_PageReaderWriter> allData;
@@ -69,19 +93,57 @@ void ScanJoin :: run () {
 	// get the left input record 
 	MyDB_RecordPtr leftInputRec = leftTable->getEmptyRecord ();
 
-	// and get the various functions whose output we'll hash
-	vector <func> leftEqualities;
+	// and get the various functions whose output we'll hash, along with the predicate
+	vector <MyDB_CompNodePtr> leftComps;
 	for (auto &p : equalityChecks) {
-		leftEqualities.push_back (leftInputRec->compileComputation (p.first));
+		leftComps.push_back (p.first);
 	}
-
-	// now get the predicate
-	func leftPred = leftInputRec->compileComputation (leftSelectionPredicate);
+	leftComps.push_back (leftSelectionPredicate);
+	vector <valFunc> leftEqualities = leftInputRec->compileValueComputations (leftComps);
+	valFunc leftPred = leftEqualities.back ();
+	leftEqualities.pop_back ();
 
 	// add all of the records to the hash table
 	MyDB_RecordIteratorAltPtr myIter = getIteratorAlt (allData);
 	int i = 0;
-	while (myIter->advance ()) {
+
+	// in batch mode, the predicate and the hashes are computed a batch at a time, and
+	// the pointer to each record is kept with it in the batch
+	vector <int> selection;
+	vector <size_t> hashes (BATCH_SIZE);
+	if (batchMode) {
+
+		MyDB_Batch leftBatch (leftInputRec->getSchema ());
+		MyDB_BatchComputation leftBatchPred (leftSelectionPredicate, leftBatch);
+		vector <MyDB_BatchComputationPtr> leftBatchEqualities;
+		for (auto &p : equalityChecks) {
+			leftBatchEqualities.push_back (make_shared <MyDB_BatchComputation> (p.first, leftBatch));
+		}
+
+		auto processBatch = [&] {
+			leftBatch.selectAll (selection);
+			leftBatchPred.filter (selection);
+			for (int i : selection) {
+				hashes[i] = 0;
+			}
+			for (auto &f : leftBatchEqualities) {
+				f->hash (selection, hashes);
+			}
+			for (int i : selection) {
+				myHash.insert (hashes[i], leftBatch.getSource (i));
+			}
+			leftBatch.clear ();
+		};
+
+		while (myIter->advance ()) {
+			void *rec = myIter->getCurrentPointer ();
+			if (leftBatch.append (rec, rec))
+				processBatch ();
+		}
+		processBatch ();
+	}
+
+	while (!batchMode && myIter->advance ()) {
 
 		i++;
 		if (i%10000 == 0) {
@@ -91,18 +153,18 @@ void ScanJoin :: run () {
 		myIter->getCurrent (leftInputRec);
 
 		// see if it is accepted by the preicate
-		if (!leftPred ()->toBool ()) {
+		if (!leftPred ().toBool ()) {
 			continue;
 		}
 
 		// compute its hash
 		size_t hashVal = 0;
 		for (auto &f : leftEqualities) {
-			hashVal ^= f ()->hash ();
+			hashVal = MyDB_Value :: combineHashes (hashVal, f ().hash ());
 		}
 
-		// see if it is in the hash table
-		myHash [hashVal].push_back (myIter->getCurrentPointer ());
+		// and put it into the hash table
+		myHash.insert (hashVal, myIter->getCurrentPointer ());
 	}
 	i = 0;
 
@@ -111,13 +173,14 @@ void ScanJoin :: run () {
 	
 	// get the right input record, and get the various functions over it
 	MyDB_RecordPtr rightInputRec = rightTable->getEmptyRecord ();
-	vector <func> rightEqualities;
+	vector <MyDB_CompNodePtr> rightComps;
 	for (auto &p : equalityChecks) {
-		rightEqualities.push_back (rightInputRec->compileComputation (p.second));
+		rightComps.push_back (p.second);
 	}
-
-	// now get the predicate
-	func rightPred = rightInputRec->compileComputation (rightSelectionPredicate);
+	rightComps.push_back (rightSelectionPredicate);
+	vector <valFunc> rightEqualities = rightInputRec->compileValueComputations (rightComps);
+	valFunc rightPred = rightEqualities.back ();
+	rightEqualities.pop_back ();
 
 	// and get the schema that results from combining the left and right records
 	MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
@@ -130,17 +193,91 @@ void ScanJoin :: run () {
 	MyDB_RecordPtr combinedRec = make_shared <MyDB_Record> (mySchemaOut);
 	combinedRec->buildFrom (leftInputRec, rightInputRec);
 
-	// now, get the final predicate over it
-	func finalPredicate = combinedRec->compileComputation (finalSelectionPredicate);
-
-	// and get the final set of computatoins that will be used to buld the output record
-	vector <func> finalComputations;
-	for (string s : projections) {
-		finalComputations.push_back (combinedRec->compileComputation (s));
-	}
+	// now, get the final set of computatoins that will be used to buld the output record,
+	// and the clauses of the final predicate over it; these are compiled together, so that
+	// anything that the predicate and the output computations have in common is only run once
+	vector <MyDB_CompNodePtr> clauses = MyDB_AdaptiveConjunction :: split (finalSelectionPredicate);
+	vector <MyDB_CompNodePtr> finalComps = projections;
+	finalComps.insert (finalComps.end (), clauses.begin (), clauses.end ());
+	vector <valFunc> finalComputations = combinedRec->compileValueComputations (finalComps);
+	MyDB_AdaptiveConjunction finalPredicate (clauses, vector <valFunc> (finalComputations.begin () + 
+		projections.size (), finalComputations.end ()));
+	finalComputations.resize (projections.size ());
 
 	// this is the output record
 	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
+
+	// this joins the current right record with a left record that it might match (one
+	// whose join keys have the same hash)
+	auto joinWith = [&] (void *v) {
+
+		// build the combined record
+		leftInputRec->fromBinary (v);
+
+		// check to see if it is accepted by the join predicate
+		if (finalPredicate.accepts ()) {
+
+			// run all of the computations
+			int i = 0;
+			for (auto &f : finalComputations) {
+				outputRec->getAtt (i++)->fromValue (f ());
+			}
+
+			// the record's content has changed because it 
+			// is now a composite of two records whose content
+			// has changed via a read... we have to tell it this,
+			// or else the record's internal buffer may cause it
+			// to write old values
+			outputRec->recordContentHasChanged ();
+			output->append (outputRec);	
+		}
+	};
+
+	// in batch mode, the right records are first filtered and hashed a batch at a time
+	if (batchMode) {
+
+		MyDB_Batch rightBatch (rightInputRec->getSchema ());
+		MyDB_BatchComputation rightBatchPred (rightSelectionPredicate, rightBatch);
+		vector <MyDB_BatchComputationPtr> rightBatchEqualities;
+		for (auto &p : equalityChecks) {
+			rightBatchEqualities.push_back (make_shared <MyDB_BatchComputation> (p.second, rightBatch));
+		}
+
+		auto processBatch = [&] {
+			rightBatch.selectAll (selection);
+			rightBatchPred.filter (selection);
+			for (int i : selection) {
+				hashes[i] = 0;
+			}
+			for (auto &f : rightBatchEqualities) {
+				f->hash (selection, hashes);
+			}
+			// a right record is only loaded once a left record with the same hash is found
+			for (int i : selection) {
+				bool loaded = false;
+				myHash.probe (hashes[i], [&] (void *v) {
+					if (!loaded) {
+						rightBatch.getRecord (i, rightInputRec);
+						loaded = true;
+					}
+					joinWith (v);
+				});
+			}
+			rightBatch.clear ();
+		};
+
+		MyDB_RecordIteratorAltPtr myIterAgain = rightTable->getIteratorAlt ();
+		while (myIterAgain->advance ()) {
+			if (rightBatch.append (myIterAgain->getCurrentPointer ()))
+				processBatch ();
+		}
+		processBatch ();
+
+		if (finalPredicate.toString () != "")
+			cout << "ScanJoin : clauses ran in the order " << finalPredicate.toString () << endl;
+		cout << "ScanJoin.run() end" << endl;
+		return;
+	}
 	
 	// now, iterate through the right table
 	MyDB_RecordIteratorPtr myIterAgain = rightTable->getIterator (rightInputRec);
@@ -153,50 +290,20 @@ void ScanJoin :: run () {
 		myIterAgain->getNext ();
 
 		// see if it is accepted by the preicate
-		if (!rightPred ()->toBool ()) {
+		if (!rightPred ().toBool ()) {
 			continue;
 		}
 
 		// hash the current record
 		size_t hashVal = 0;
 		for (auto &f : rightEqualities) {
-			hashVal ^= f ()->hash ();
+			hashVal = MyDB_Value :: combineHashes (hashVal, f ().hash ());
 		}
 
-		// get the list of potential matches... first verify that there IS
-		// a match in there
-		if (myHash.count (hashVal) == 0) {
-			continue;
-		}
-
-		// if there is a match, then get the list of matches
-		vector <void *> &potentialMatches = myHash [hashVal];
-		
-		// and iterate though the potential matches, checking each of them
-		for (auto &v : potentialMatches) {
-
-			// build the combined record
-			leftInputRec->fromBinary (v);
-
-			// check to see if it is accepted by the join predicate
-			if (finalPredicate ()->toBool ()) {
-
-				// run all of the computations
-				int i = 0;
-				for (auto &f : finalComputations) {
-					outputRec->getAtt (i++)->set (f());
-				}
-
-				// the record's content has changed because it 
-				// is now a composite of two records whose content
-				// has changed via a read... we have to tell it this,
-				// or else the record's internal buffer may cause it
-				// to write old values
-				outputRec->recordContentHasChanged ();
-				output->append (outputRec);	
-			}
-		}
+		myHash.probe (hashVal, joinWith);
 	}
+	if (finalPredicate.toString () != "")
+		cout << "ScanJoin : clauses ran in the order " << finalPredicate.toString () << endl;
 	cout << "ScanJoin.run() end" << endl;
 }
 
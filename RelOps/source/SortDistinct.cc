@@ -0,0 +1,63 @@
+
+#ifndef SORT_DISTINCT_C
+#define SORT_DISTINCT_C
+
+#include "MyDB_Record.h"
+#include "SortDistinct.h"
+#include "Sorting.h"
+
+SortDistinct :: SortDistinct (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <string> projectionsIn) :
+	SortDistinct (inputIn, outputIn, MyDB_CompNode :: parse (projectionsIn)) {}
+
+SortDistinct :: SortDistinct (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <MyDB_CompNodePtr> projectionsIn) {
+
+	input = inputIn;
+	output = outputIn;
+	projections = projectionsIn;
+}
+
+void SortDistinct :: run () {
+
+	// the records are sorted on every one of the projections, in ascending order
+	vector <pair <MyDB_CompNodePtr, bool>> sortKeys;
+	for (auto &p : projections)
+		sortKeys.push_back (make_pair (p, false));
+	MyDB_RecordPtr lhs = input->getEmptyRecord ();
+	MyDB_RecordPtr rhs = input->getEmptyRecord ();
+	function <bool ()> comparator = buildRecordComparator (lhs, rhs, sortKeys);
+
+	// the runs get half of the buffer, as they do for an ORDER BY
+	int runSize = input->getBufferMgr ()->getNumPages () / 2;
+	MyDB_RecordIteratorAltPtr myIter = buildItertorOverSortedRuns (runSize, *input, comparator, lhs, rhs);
+
+	// the records that come out of the merge are loaded into these two, one after the other,
+	// so that the last one is still there to be compared with; since the records come out in
+	// order, a record is a copy of the last one if the last one does not come before it
+	MyDB_RecordPtr recs[2] = {input->getEmptyRecord (), input->getEmptyRecord ()};
+	function <bool ()> lastComesFirst[2] = {buildRecordComparator (recs[1], recs[0], sortKeys),
+		buildRecordComparator (recs[0], recs[1], sortKeys)};
+	vector <valFunc> finalComputations[2] = {recs[0]->compileValueComputations (projections),
+		recs[1]->compileValueComputations (projections)};
+	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
+
+	int cur = 0;
+	bool first = true;
+	while (myIter->advance ()) {
+		myIter->getCurrent (recs[cur]);
+		if (!first && !lastComesFirst[cur] ())
+			continue;
+
+		int i = 0;
+		for (auto &f : finalComputations[cur]) {
+			outputRec->getAtt (i++)->fromValue (f ());
+		}
+		outputRec->recordContentHasChanged ();
+		output->append (outputRec);
+		first = false;
+		cur = 1 - cur;
+	}
+}
+
+#endif
@@ -25,6 +25,11 @@ SortMergeJoin :: SortMergeJoin (MyDB_TableReaderWriterPtr leftInputIn, MyDB_Tabl
 	leftSelectionPredicate = leftSelectionPredicateIn;
 	rightSelectionPredicate = rightSelectionPredicateIn;
 	runSize = leftTable->getBufferMgr ()->numPages / 2;
+	replacementSelection = false;
+}
+
+void SortMergeJoin :: setReplacementSelection (bool replacementSelectionIn) {
+	replacementSelection = replacementSelectionIn;
 }
 
 void SortMergeJoin :: run () {
@@ -37,16 +42,15 @@ void SortMergeJoin :: run () {
 	MyDB_RecordPtr rightInputRec = rightTable->getEmptyRecord ();
 	MyDB_RecordPtr rightInputRecOther = rightTable->getEmptyRecord ();
 
-	// build comparators over them
+	// build comparators over the left records
 	function <bool ()> leftComp = buildRecordComparator (leftInputRec, leftInputRecOther, equalityCheck.first);
 	function <bool ()> leftCompRev = buildRecordComparator (leftInputRecOther, leftInputRec, equalityCheck.first);
-	function <bool ()> rightComp = buildRecordComparator (rightInputRec, rightInputRecOther, equalityCheck.second);
 
 	// now, sort the left and the right
-	MyDB_RecordIteratorAltPtr right = buildItertorOverSortedRuns (runSize, *rightTable, rightComp, rightInputRec, 
-		rightInputRecOther, rightSelectionPredicate);
-	MyDB_RecordIteratorAltPtr left = buildItertorOverSortedRuns (runSize, *leftTable, leftComp, leftInputRec, 
-		leftInputRecOther, leftSelectionPredicate);
+	MyDB_RecordIteratorAltPtr right = buildItertorOverSortedRuns (runSize, *rightTable, equalityCheck.second, rightInputRec, 
+		rightInputRecOther, rightSelectionPredicate, replacementSelection);
+	MyDB_RecordIteratorAltPtr left = buildItertorOverSortedRuns (runSize, *leftTable, equalityCheck.first, leftInputRec, 
+		leftInputRecOther, leftSelectionPredicate, replacementSelection);
 
 	// and get the schema that results from combining the left and right records
 	MyDB_SchemaPtr mySchemaOut = make_shared <MyDB_Schema> ();
@@ -59,19 +63,23 @@ void SortMergeJoin :: run () {
 	MyDB_RecordPtr combinedRec = make_shared <MyDB_Record> (mySchemaOut);
 	combinedRec->buildFrom (leftInputRec, rightInputRec);
 
-	// now, get the final predicate over it
-	func finalPredicate = combinedRec->compileComputation (finalSelectionPredicate);
-
-	// and get the final set of computatoins that will be used to buld the output record
-	vector <func> finalComputations;
-	for (string s : projections) {
-		finalComputations.push_back (combinedRec->compileComputation (s));
-	}
-	
-	// compares the two input recs
-	func leftSmaller = combinedRec->compileComputation (" < (" + equalityCheck.first + ", " + equalityCheck.second + ")");
-	func rightSmaller = combinedRec->compileComputation (" > (" + equalityCheck.first + ", " + equalityCheck.second + ")");
-	func areEqual = combinedRec->compileComputation (" == (" + equalityCheck.first + ", " + equalityCheck.second + ")");
+	// get the final set of computatoins that will be used to buld the output record, then
+	// the final predicate over it, and then the comparisons of the two input recs; these
+	// are all compiled together, so that anything they have in common is only run once
+	vector <string> finalComps = projections;
+	finalComps.push_back (finalSelectionPredicate);
+	finalComps.push_back (" < (" + equalityCheck.first + ", " + equalityCheck.second + ")");
+	finalComps.push_back (" > (" + equalityCheck.first + ", " + equalityCheck.second + ")");
+	finalComps.push_back (" == (" + equalityCheck.first + ", " + equalityCheck.second + ")");
+	vector <valFunc> finalComputations = combinedRec->compileValueComputations (finalComps);
+	valFunc areEqual = finalComputations.back ();
+	finalComputations.pop_back ();
+	valFunc rightSmaller = finalComputations.back ();
+	finalComputations.pop_back ();
+	valFunc leftSmaller = finalComputations.back ();
+	finalComputations.pop_back ();
+	valFunc finalPredicate = finalComputations.back ();
+	finalComputations.pop_back ();
 	
 	// this is the output record
 	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
@@ -91,21 +99,21 @@ void SortMergeJoin :: run () {
 		left->getCurrent (leftInputRec);
 		right->getCurrent (rightInputRec);
 
-		if (leftSmaller ()->toBool ()) {
+		if (leftSmaller ().toBool ()) {
 
 			// try to move the left forward
 			if (!left->advance ()) {
 				allDone = true;
 			}
 
-		} else if (rightSmaller ()->toBool ()) {
+		} else if (rightSmaller ().toBool ()) {
 
 			// try to move the right forward
 			if (!right->advance ()) {
 				allDone = true;
 			}
 
-		} else if (areEqual ()->toBool ()) {
+		} else if (areEqual ().toBool ()) {
 
 			lastPage.clear ();
 			allPages.clear ();
@@ -146,7 +154,7 @@ void SortMergeJoin :: run () {
 			while (true) {
 			
 				// the records are the same!!
-				if (areEqual ()->toBool ()) {
+				if (areEqual ().toBool ()) {
 
 					//cout << rightInputRec << "\n";
 					counter++;
@@ -162,11 +170,11 @@ void SortMergeJoin :: run () {
 					// check for a match
 					while (myIterAgain->advance ()) {
 						myIterAgain->getCurrent (leftInputRec);		
-						if (finalPredicate ()->toBool ()) {
+						if (finalPredicate ().toBool ()) {
 							// got one!!
 							int i = 0;
 							for (auto &f : finalComputations) {
-								outputRec->getAtt (i++)->set (f());
+								outputRec->getAtt (i++)->fromValue (f ());
 							}
 							outputRec->recordContentHasChanged ();
 							output->append (outputRec);	
@@ -0,0 +1,92 @@
+
+#ifndef TOP_N_C
+#define TOP_N_C
+
+#include <algorithm>
+#include "MyDB_Record.h"
+#include "Sorting.h"
+#include "TopN.h"
+
+TopN :: TopN (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <pair <string, bool>> sortKeysIn, vector <string> projectionsIn, long nIn) :
+	TopN (inputIn, outputIn, parseSortKeys (sortKeysIn), MyDB_CompNode :: parse (projectionsIn), nIn) {}
+
+TopN :: TopN (MyDB_TableReaderWriterPtr inputIn, MyDB_TableReaderWriterPtr outputIn,
+		vector <pair <MyDB_CompNodePtr, bool>> sortKeysIn, vector <MyDB_CompNodePtr> projectionsIn, long nIn) {
+
+	input = inputIn;
+	output = outputIn;
+	sortKeys = sortKeysIn;
+	projections = projectionsIn;
+	n = nIn;
+}
+
+void TopN :: run () {
+
+	if (n <= 0)
+		return;
+
+	MyDB_RecordPtr lhs = input->getEmptyRecord ();
+	MyDB_RecordPtr rhs = input->getEmptyRecord ();
+	function <bool ()> comparator = buildRecordComparator (lhs, rhs, sortKeys);
+
+	// the records that are kept, as they were on their pages; the heap holds their positions
+	// in kept, with the record that comes last on top (the std :: heap functions keep the
+	// largest on top, so they are given the order itself)
+	vector <vector <char>> kept;
+	vector <size_t> heap;
+	auto comesFirst = [&] (size_t a, size_t b) {
+		lhs->fromBinary (kept[a].data ());
+		rhs->fromBinary (kept[b].data ());
+		return comparator ();
+	};
+
+	MyDB_RecordIteratorAltPtr myIter = input->getIteratorAlt ();
+	bool topInRHS = false;
+	while (myIter->advance ()) {
+
+		// until there are n records, every one is kept
+		myIter->getCurrent (lhs);
+		if ((long) kept.size () < n) {
+			kept.emplace_back (lhs->getBinarySize ());
+			lhs->toBinary (kept.back ().data ());
+			heap.push_back (kept.size () - 1);
+			push_heap (heap.begin (), heap.end (), comesFirst);
+			topInRHS = false;
+			continue;
+		}
+
+		// after that, a record is only kept if it comes before the last one that is kept; the
+		// last one stays loaded into rhs until the top of the heap changes
+		if (!topInRHS) {
+			rhs->fromBinary (kept[heap[0]].data ());
+			topInRHS = true;
+		}
+		if (!comparator ())
+			continue;
+
+		size_t replaced = heap[0];
+		pop_heap (heap.begin (), heap.end (), comesFirst);
+		myIter->getCurrent (lhs);
+		kept[replaced].resize (lhs->getBinarySize ());
+		lhs->toBinary (kept[replaced].data ());
+		push_heap (heap.begin (), heap.end (), comesFirst);
+		topInRHS = false;
+	}
+
+	// put the records in order, and write them out
+	sort_heap (heap.begin (), heap.end (), comesFirst);
+	vector <valFunc> finalComputations = lhs->compileValueComputations (projections);
+	MyDB_RecordPtr outputRec = output->getEmptyRecord ();
+	for (size_t which : heap) {
+		lhs->fromBinary (kept[which].data ());
+		int i = 0;
+		for (auto &f : finalComputations) {
+			outputRec->getAtt (i++)->fromValue (f ());
+		}
+		outputRec->recordContentHasChanged ();
+		output->append (outputRec);
+	}
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "MyDB_AttType.h"
 #include "MyDB_Catalog.h"
+#include "MyDB_CompNode.h"
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -40,6 +41,17 @@ public:
 
 	virtual ExprType getType() = 0;
 
+	// lowers the expression into a computation that can be compiled straight away (see
+	// MyDB_CompNode), instead of writing it out with toString and parsing it again; this
+	// is only done once, so that every plan that uses the expression shares the result
+	MyDB_CompNodePtr getComp () {
+		if (comp == nullptr)
+			comp = toComp ();
+		return comp;
+	}
+
+	virtual MyDB_CompNodePtr toComp () = 0;
+
 	virtual void getAtt (vector <ExprTreePtr> &vec) {};
 	virtual bool isIdentifierAtt() {return false;}
 	virtual bool isAggregateAtt() {return false;}
@@ -97,6 +109,7 @@ public:
 
 protected :
 	MyDB_AttTypePtr attType;
+	MyDB_CompNodePtr comp;
 };
 
 class BoolLiteral : public ExprTree {
@@ -117,6 +130,10 @@ public:
 		}
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeConstant (MyDB_Value :: fromBool (myVal), make_shared <MyDB_BoolAttType> ());
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -147,6 +164,10 @@ public:
 		return "double[" + to_string (myVal) + "]";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeConstant (MyDB_Value :: fromDouble (myVal), make_shared <MyDB_DoubleAttType> ());
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -180,6 +201,10 @@ public:
 		return "int[" + to_string (myVal) + "]";
 	}
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeConstant (MyDB_Value :: fromInt (myVal), make_shared <MyDB_IntAttType> ());
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -213,6 +238,10 @@ public:
 		return "string[" + myVal + "]";
 	}
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeConstant (MyDB_Value :: fromString (MyDB_StringView (myVal)), nullptr);
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -258,6 +287,14 @@ public:
 		}
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		if (tableName == "") {
+			return MyDB_CompNode :: makeAtt (attName);
+		} else {
+			return MyDB_CompNode :: makeAtt (tableName + "_" + attName);
+		}
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -359,6 +396,10 @@ public:
 		return "- (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("-", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -426,6 +467,10 @@ public:
 		return "+ (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("+", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -494,6 +539,10 @@ public:
 		return "* (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("*", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -561,6 +610,10 @@ public:
 		return "/ (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("/", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -627,6 +680,10 @@ public:
 		return "> (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp (">", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -695,6 +752,10 @@ public:
 		return "< (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("<", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -763,6 +824,10 @@ public:
 		return "!= (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("!=", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -822,6 +887,11 @@ public:
 		return "|| (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		// an || of equality checks against constants (as an IN list is written) becomes a single lookup
+		return MyDB_CompNode :: makeOp ("||", {lhs->getComp (), rhs->getComp ()})->findInLists ();
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -887,6 +957,10 @@ public:
 		return "== (" + lhs->toString () + ", " + rhs->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("==", {lhs->getComp (), rhs->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -940,6 +1014,64 @@ public:
 	~EqOp () {}
 };
 
+class LikeOp : public ExprTree {
+
+private:
+
+	ExprTreePtr lhs;
+	ExprTreePtr pattern;
+
+public:
+
+	LikeOp (ExprTreePtr lhsIn, ExprTreePtr patternIn) {
+		lhs = lhsIn;
+		pattern = patternIn;
+	}
+
+	string toString () {
+		return "like (" + lhs->toString () + ", " + pattern->toString () + ")";
+	}
+
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("like", {lhs->getComp (), pattern->getComp ()});
+	}
+
+	bool checkFunc(
+		MyDB_CatalogPtr catalog,
+		vector <pair <string, string>> tablesToProcess,
+		vector <ExprTreePtr> groupingClauses ) {
+
+		// check for identifiers
+		if (!lhs->checkFunc(catalog, tablesToProcess, groupingClauses) || !pattern->checkFunc(catalog, tablesToProcess, groupingClauses)) {
+			// one of the identifiers is wrong
+			return false;
+		}
+
+		if (lhs->getType() != STRING_TYPE) {
+			cout << "[SemanticError: the expression " << lhs->toString() << " is not string type]" << endl;
+			return false;
+		}
+		setAttType();
+		return true;
+	}
+
+	ExprType getType() {
+		if (lhs->getType() == STRING_TYPE) {
+			return BOOL_TYPE;
+		} else return ERROR_TYPE;
+	}
+
+	void getAtt(vector <ExprTreePtr> &vec) {
+		lhs->getAtt(vec);
+ 	}
+
+ 	bool isReferToTable(string tableAlais) {
+ 		return lhs->isReferToTable(tableAlais);
+ 	}
+
+	~LikeOp () {}
+};
+
 class NotOp : public ExprTree {
 
 private:
@@ -956,6 +1088,10 @@ public:
 		return "!(" + child->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		return MyDB_CompNode :: makeOp ("!", {child->getComp ()});
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -1010,6 +1146,11 @@ public:
 		return "sum(" + child->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		// the sum itself is done by the aggregate operator; this is what is summed
+		return child->getComp ();
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
@@ -1073,6 +1214,11 @@ public:
 		return "avg(" + child->toString () + ")";
 	}	
 
+	MyDB_CompNodePtr toComp () {
+		// the average itself is done by the aggregate operator; this is what is averaged
+		return child->getComp ();
+	}
+
 	bool checkFunc(
 		MyDB_CatalogPtr catalog,
 		vector <pair <string, string>> tablesToProcess,
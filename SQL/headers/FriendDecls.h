@@ -2,20 +2,30 @@ friend struct SFWQuery *makeQueryWithGroupBy (struct ValueList *selectClause, st
 	struct CNF *cnf, struct ValueList *grouping);
 friend struct SFWQuery *makeQuery (struct ValueList *selectClause, struct FromList *fromClause, struct CNF *cnf);
 friend struct SFWQuery *makeQueryNoWhere (struct ValueList *selectClause, struct FromList *fromClause);
+friend struct SFWQuery *addOrderBy (struct SFWQuery *addToMe, struct OrderList *ordering);
+friend struct SFWQuery *addLimit (struct SFWQuery *addToMe, int limit);
+friend struct SFWQuery *addDistinct (struct SFWQuery *addToMe, int distinct);
+friend struct OrderList *makeOrderList (struct Value *sortOn, int descending);
+friend struct OrderList *appendOrderList (struct OrderList *appendToMe, struct OrderList *appendMe);
 friend struct SQLStatement *makeSelectQuery (struct SFWQuery *fromMe);
 friend struct SQLStatement *makeCreateTable (struct CreateTable *fromMe);
 friend struct CreateTable *makeTableRegular (char *tableName, struct AttList *fromMe);
+friend struct CreateTable *makeTableRegularWithOptions (char *tableName, struct AttList *fromMe, struct TableOptions *options);
 friend struct CreateTable *makeTableBPlusTree (char *tableName, struct AttList *fromMe, char *attName);
 friend struct AttList *makeAttList (char *attName, int whichType);
 friend struct FromList *makeFromList (char *tableName, char *aliasName);
 friend struct FromList *appendFromList (struct FromList *appendToMe, char *tableName, char *aliasName);
 friend struct AttList *appendAttList (struct AttList *appendToMe, struct AttList *appendMe);
+friend struct TableOptions *makeTableOptions (char *optionName);
+friend struct TableOptions *appendTableOptions (struct TableOptions *appendToMe, char *optionName);
 friend struct Value *nott (struct Value *ofMe);
 friend struct Value *orr (struct Value *lhs, struct Value *rhs);
 friend struct Value *gt (struct Value *lhs, struct Value *rhs);
 friend struct Value *lt (struct Value *lhs, struct Value *rhs);
 friend struct Value *neq (struct Value *lhs, struct Value *rhs);
 friend struct Value *eq (struct Value *lhs, struct Value *rhs);
+friend struct Value *isIn (struct Value *lhs, struct ValueList *rhs);
+friend struct Value *like (struct Value *lhs, char *pattern);
 friend struct Value *sum (struct Value *ofMe);
 friend struct Value *avg (struct Value *ofMe);
 friend struct Value *times (struct Value *lhs, struct Value *rhs);
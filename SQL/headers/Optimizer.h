@@ -14,7 +14,10 @@ public:
 		vector <ExprTreePtr> valuesToSelect,
 		vector <pair <string, string>> tablesToProcess,
 		vector <ExprTreePtr> allDisjunctions,
-		vector <ExprTreePtr> groupingClauses);
+		vector <ExprTreePtr> groupingClauses,
+		vector <pair <ExprTreePtr, bool>> orderingClauses,
+		int limit,
+		bool distinct);
 
 
 	void execute();
@@ -25,6 +28,10 @@ public:
 
 	MyDB_TableReaderWriterPtr getTableByName(string tableName);
 
+	// estimates how many distinct results the given values have over the tables in the query,
+	// from the distinct value counts of the attributes that they use, kept in the catalog
+	double estimateDistinct(vector <ExprTreePtr> values);
+
 	vector< pair<vector <pair <string, string>>, vector <pair <string, string>>>> getAllSubsets(vector <pair <string, string>> tablesToProcess);
 
 private:
@@ -44,6 +51,9 @@ private:
 	vector <pair <string, string>> tablesToProcess;
 	vector <ExprTreePtr> allDisjunctions;
 	vector <ExprTreePtr> groupingClauses;
+	vector <pair <ExprTreePtr, bool>> orderingClauses;
+	int limit;
+	bool distinct;
 };
 
 #endif
\ No newline at end of file
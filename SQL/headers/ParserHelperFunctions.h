@@ -40,6 +40,12 @@ struct AttList;
 // this is a set of table name, alias name pairs
 struct FromList;
 
+// this is a list of options given in the WITH clause of a create table
+struct TableOptions;
+
+// this is a list of the values in an ORDER BY, each ascending or descending
+struct OrderList;
+
 /******************************************************/
 // C FUNCTIONS TO MANIPULATE THE VARIOUS STRUCTURES
 /******************************************************/
@@ -50,6 +56,19 @@ struct SFWQuery *makeQueryWithGroupBy (struct ValueList *selectClause, struct Fr
 struct SFWQuery *makeQuery (struct ValueList *selectClause, struct FromList *fromClause, struct CNF *cnf);
 struct SFWQuery *makeQueryNoWhere (struct ValueList *selectClause, struct FromList *fromClause);
 
+// adds an ORDER BY or a LIMIT to a select query
+struct SFWQuery *addOrderBy (struct SFWQuery *addToMe, struct OrderList *ordering);
+struct SFWQuery *addLimit (struct SFWQuery *addToMe, int limit);
+
+// makes a select query a SELECT DISTINCT, if distinct is not zero
+struct SFWQuery *addDistinct (struct SFWQuery *addToMe, int distinct);
+
+// makes an ORDER BY list out of a single value (in descending order if descending is not zero)
+struct OrderList *makeOrderList (struct Value *sortOn, int descending);
+
+// appends the values in one ORDER BY list to the end of another
+struct OrderList *appendOrderList (struct OrderList *appendToMe, struct OrderList *appendMe);
+
 // builds an SQL statement out of a select query
 struct SQLStatement *makeSelectQuery (struct SFWQuery *fromMe);
 
@@ -59,6 +78,9 @@ struct SQLStatement *makeCreateTable (struct CreateTable *fromMe);
 // makes a regular database table
 struct CreateTable *makeTableRegular (char *tableName, struct AttList *fromMe);
 
+// makes a regular database table with the given options
+struct CreateTable *makeTableRegularWithOptions (char *tableName, struct AttList *fromMe, struct TableOptions *options);
+
 // makes a B+-Tree table
 struct CreateTable *makeTableBPlusTree (char *tableName, struct AttList *fromMe, char *attName);
 
@@ -74,6 +96,12 @@ struct FromList *appendFromList (struct FromList *appendToMe, char *tableName, c
 // appends an attribute to the end of a list
 struct AttList *appendAttList (struct AttList *appendToMe, struct AttList *appendMe);
 
+// makes a list of table options out of a single option
+struct TableOptions *makeTableOptions (char *optionName);
+
+// appends an option to the end of a list
+struct TableOptions *appendTableOptions (struct TableOptions *appendToMe, char *optionName);
+
 // construct a new value using a boolean operation
 struct Value *nott (struct Value *ofMe);
 struct Value *orr (struct Value *lhs, struct Value *rhs);
@@ -84,6 +112,12 @@ struct Value *lt (struct Value *lhs, struct Value *rhs);
 struct Value *neq (struct Value *lhs, struct Value *rhs);
 struct Value *eq (struct Value *lhs, struct Value *rhs);
 
+// construct a new value that checks whether lhs is equal to any of the values in the list
+struct Value *isIn (struct Value *lhs, struct ValueList *rhs);
+
+// construct a new value that checks whether lhs matches a pattern (with % and _ wildcards)
+struct Value *like (struct Value *lhs, char *pattern);
+
 // construct a new value using an aggregate function
 struct Value *sum (struct Value *ofMe);
 struct Value *avg (struct Value *ofMe);
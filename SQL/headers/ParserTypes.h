@@ -45,6 +45,7 @@ public:
 	
 	friend struct CNF;
 	friend struct ValueList;
+	friend struct OrderList;
 	friend struct SFWQuery;
 	#include "FriendDecls.h"
 };
@@ -91,6 +92,25 @@ public:
 	#include "FriendDecls.h"
 };
 
+// structure that encapsulates a parsed ORDER BY list
+struct OrderList {
+
+private:
+
+	// the values to sort on, in order; the bool is true if the value is in descending order
+	vector <pair <ExprTreePtr, bool>> sortKeys;
+
+public:
+	~OrderList () {}
+
+	OrderList (struct Value *useMe, bool descending) {
+		sortKeys.push_back (make_pair (useMe->myVal, descending));
+	}
+
+	friend struct SFWQuery;
+	#include "FriendDecls.h"
+};
+
 
 // structure to encapsulate a create table
 struct CreateTable {
@@ -109,6 +129,9 @@ private:
 	// the attribute to organize the B+-Tree on
 	string sortAtt;
 
+	// the options from the WITH clause, if there was one
+	vector <string> options;
+
 public:
 	string addToCatalog (string storageDir, MyDB_CatalogPtr addToMe) {
 
@@ -118,6 +141,21 @@ public:
 			mySchema->appendAtt (a);
 		}
 
+		// make sure that we know about all of the options, and that there is at most one compression scheme
+		int numCompression = 0;
+		for (auto &o : options) {
+			if (!MyDB_Table :: isKnownOption (o)) {
+				cout << "Unknown table option " << o << "; table not created.\n";
+				return "nothing";
+			}
+			if (MyDB_Table :: isCompressionOption (o))
+				numCompression++;
+		}
+		if (numCompression > 1) {
+			cout << "Only one of compressed, delta, rle, for may be given; table not created.\n";
+			return "nothing";
+		}
+
 		// now, make the table
 		MyDB_TablePtr myTable;
 
@@ -139,6 +177,7 @@ public:
 		}
 
 		// and add to the catalog
+		myTable->setOptions (options);
 		myTable->putInCatalog (addToMe);
 
 		return tableName;
@@ -183,6 +222,24 @@ public:
 	#include "FriendDecls.h"
 };
 
+// structure that stores the options from the WITH clause of a create table
+struct TableOptions {
+
+private:
+
+	// the list of options
+	vector <string> options;
+
+public:
+	TableOptions (string optionName) {
+		options.push_back (optionName);
+	}
+
+	~TableOptions () {}
+
+	#include "FriendDecls.h"
+};
+
 struct FromList {
 
 private:
@@ -215,6 +272,13 @@ private:
 	vector <ExprTreePtr> allDisjunctions;
 	vector <ExprTreePtr> groupingClauses;
 
+	// the ORDER BY (with true for a descending value), and the LIMIT, which is -1 if there is none
+	vector <pair <ExprTreePtr, bool>> orderingClauses;
+	int limit = -1;
+
+	// true for a SELECT DISTINCT
+	bool distinct = false;
+
 public:
 	SFWQuery () {}
 
@@ -243,7 +307,7 @@ public:
 	~SFWQuery () {}
 
 	void print () {
-		cout << "Selecting the following:\n";
+		cout << (distinct ? "Selecting the following, without duplicates:\n" : "Selecting the following:\n");
 		for (auto a : valuesToSelect) {
 			cout << "\t" << a->toString () << "\n";
 		}
@@ -259,6 +323,15 @@ public:
 		for (auto a : groupingClauses) {
 			cout << "\t" << a->toString () << "\n";
 		}
+		if (!orderingClauses.empty ()) {
+			cout << "Order by:\n";
+			for (auto a : orderingClauses) {
+				cout << "\t" << a.first->toString () << (a.second ? " DESC" : " ASC") << "\n";
+			}
+		}
+		if (limit >= 0) {
+			cout << "Limit to " << limit << " records\n";
+		}
 	}
 
 	// Roy7wt
@@ -280,6 +353,18 @@ public:
 		return groupingClauses;
 	}
 
+	vector <pair <ExprTreePtr, bool>> getOrderingClauses () {
+		return orderingClauses;
+	}
+
+	int getLimit () {
+		return limit;
+	}
+
+	bool isDistinct () {
+		return distinct;
+	}
+
 	void check(MyDB_CatalogPtr catalog) {
 		vector <string> tables;
 		catalog->getStringList("tables", tables);
@@ -328,6 +413,13 @@ public:
 				return;
 			}
 		}
+
+		// the ORDER BY is over the same things that the SELECT is
+		for (auto a : orderingClauses) {
+			if (!a.first->checkFunc(catalog, tablesToProcess, groupingClauses)) {
+				return;
+			}
+		}
 		cout << "[------------wq3: Semantic Check Complete------------]" << endl;
 	}
 
@@ -6,8 +6,13 @@
 #include "MyDB_Schema.h"
 #include "ExprTree.h"
 #include "Aggregate.h"
+#include "HashDistinct.h"
+#include "HybridHashJoin.h"
+#include "OrderBy.h"
 #include "RegularSelection.h"
 #include "ScanJoin.h"
+#include "SortDistinct.h"
+#include "TopN.h"
 
 using namespace std;
 
@@ -27,6 +32,12 @@ public :
 	static int tableId;
 	static int getId ();
 	static int maxTableId;
+
+	// if this is set, selections are compiled to native code when they can be
+	static bool nativeMode;
+
+	// the number of threads that each selection is run on
+	static int numThreads;
 };
 
 class Table : public RelAlgExpr {
@@ -37,6 +48,13 @@ public :
 
 	string toString();
 
+	// the stored table, before the alias is put on its attributes
+	MyDB_TableReaderWriterPtr getBaseTable ();
+
+	// rewrites a computation over the aliased attributes so it runs over the stored table
+	string toBaseAtts (string computation);
+	MyDB_CompNodePtr toBaseAtts (MyDB_CompNodePtr computation);
+
 	~Table () {}
 
 private :
@@ -58,6 +76,9 @@ public:
 
 	string toString();
 
+	// stops the selection once limit records have been written (see RegularSelection)
+	void setLimit (int limitIn);
+
 	~ SingleSelection() {}
 
 private:
@@ -65,9 +86,12 @@ private:
 	RelAlgExprPtr table;
 	vector <ExprTreePtr> valuesToSelect;
 	vector <ExprTreePtr> allDisjunctions;
+	int limit;
 };
 
 
+// a join.  If the smaller of the two inputs fits in half of the buffer, it is run with a ScanJoin;
+// otherwise, with a HybridHashJoin, which writes what does not fit to disk
 class JoinSelection : public RelAlgExpr {
 
 public:
@@ -98,7 +122,7 @@ class AggregateSelection : public RelAlgExpr {
 public :
  	// constructor
  	AggregateSelection (RelAlgExprPtr tableIn,
- 		vector <pair< pair<MyDB_AggType, string>, MyDB_AttTypePtr>> aggsToComputeIn,
+ 		vector <pair< pair<MyDB_AggType, ExprTreePtr>, MyDB_AttTypePtr>> aggsToComputeIn,
  		vector <ExprTreePtr> groupingClausesIn);
 
  	// return the sql run out table
@@ -110,7 +134,51 @@ public :
 
 private :
 	RelAlgExprPtr table;
- 	vector <pair< pair<MyDB_AggType, string>, MyDB_AttTypePtr>> aggsToCompute;
+ 	vector <pair< pair<MyDB_AggType, ExprTreePtr>, MyDB_AttTypePtr>> aggsToCompute;
  	vector <ExprTreePtr> groupingClauses;
 };
+// an ORDER BY, with an optional LIMIT (which is -1 if there is none).  If the records that the
+// LIMIT keeps fit in half of the buffer, they are found with a TopN; otherwise the whole input is
+// sorted with an OrderBy, which stops once it has written the records that the LIMIT keeps
+class OrderBySelection : public RelAlgExpr {
+
+public :
+	OrderBySelection (RelAlgExprPtr tableIn,
+		vector <ExprTreePtr> valuesToSelectIn,
+		vector <pair <ExprTreePtr, bool>> sortKeysIn,
+		int limitIn);
+
+	MyDB_TableReaderWriterPtr run();
+
+	string toString();
+
+	~ OrderBySelection() {}
+
+private :
+	RelAlgExprPtr table;
+	vector <ExprTreePtr> valuesToSelect;
+	vector <pair <ExprTreePtr, bool>> sortKeys;
+	int limit;
+};
+
+// a SELECT DISTINCT.  If the distinct records (whose number is estimated by the optimizer) fit
+// in half of the buffer, they are found with a HashDistinct; otherwise, with a SortDistinct
+class DistinctSelection : public RelAlgExpr {
+
+public :
+	DistinctSelection (RelAlgExprPtr tableIn,
+		vector <ExprTreePtr> valuesToSelectIn,
+		double numDistinctIn);
+
+	MyDB_TableReaderWriterPtr run();
+
+	string toString();
+
+	~ DistinctSelection() {}
+
+private :
+	RelAlgExprPtr table;
+	vector <ExprTreePtr> valuesToSelect;
+	double numDistinct;
+};
 #endif
\ No newline at end of file
@@ -520,9 +520,32 @@ static yyconst flex_int16_t yy_chk[207] =
 #include <stdio.h>  // For fileno()
 #include <stdlib.h> // For malloc()
 #include <string.h> // For strdup()
+#include <strings.h> // For strcasecmp()
 
 #define YY_USER_INIT (yylineno = 1)
 
+// keywords that are not given their own rule are matched as identifiers, and then
+// looked up here; returns 0 if the identifier is not one of these keywords
+static int keywordToken (const char *text) {
+	if (strcasecmp (text, "with") == 0)
+		return WITH;
+	if (strcasecmp (text, "in") == 0)
+		return IN;
+	if (strcasecmp (text, "like") == 0)
+		return LIKE;
+	if (strcasecmp (text, "order") == 0)
+		return ORDER;
+	if (strcasecmp (text, "limit") == 0)
+		return LIMIT;
+	if (strcasecmp (text, "asc") == 0)
+		return ASC;
+	if (strcasecmp (text, "desc") == 0)
+		return DESC;
+	if (strcasecmp (text, "distinct") == 0)
+		return DISTINCT;
+	return 0;
+}
+
 /******************************************************************************
  * SECTION 2
  ******************************************************************************/
@@ -1020,7 +1043,10 @@ YY_RULE_SETUP
 case 33:
 YY_RULE_SETUP
 #line 114 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Lexer.l"
-{yylval->myChar = strdup (yytext);
+{int keyword = keywordToken (yytext);
+			if (keyword != 0)
+				return keyword;
+			yylval->myChar = strdup (yytext);
   			return IDENTIFIER;
 			}     
 	YY_BREAK
@@ -4,6 +4,7 @@
 #include "Optimizer.h"
 #include "ExprTree.h"
 #include "RelAlgExpr.h"
+#include <algorithm>
 #include <iostream>
 #include <math.h>       /* pow */
 
@@ -17,7 +18,10 @@ Optimizer :: Optimizer(map <string, MyDB_TablePtr> allTablesIn,
 		vector <ExprTreePtr> valuesToSelectIn,
 		vector <pair <string, string>> tablesToProcessIn,
 		vector <ExprTreePtr> allDisjunctionsIn,
-		vector <ExprTreePtr> groupingClausesIn) {
+		vector <ExprTreePtr> groupingClausesIn,
+		vector <pair <ExprTreePtr, bool>> orderingClausesIn,
+		int limitIn,
+		bool distinctIn) {
 
 		allTables= allTablesIn;
 		allTableReaderWriters = allTableReaderWritersIn;
@@ -26,6 +30,9 @@ Optimizer :: Optimizer(map <string, MyDB_TablePtr> allTablesIn,
 		tablesToProcess = tablesToProcessIn;
 		allDisjunctions = allDisjunctionsIn;
 		groupingClauses = groupingClausesIn;
+		orderingClauses = orderingClausesIn;
+		limit = limitIn;
+		distinct = distinctIn;
 
 }
 
@@ -37,14 +44,14 @@ void Optimizer :: execute() {
 	// verify the attributes among the selection clause 
 	// and verify the aggregation computations
 	vector <ExprTreePtr> newValuesToSelect;
-	vector < pair <pair <MyDB_AggType, string>, MyDB_AttTypePtr>> aggsToCompute; // e.g. MyDB_AggType :: avg, "*([r_suppkey], double[1.0])"
+	vector < pair <pair <MyDB_AggType, ExprTreePtr>, MyDB_AttTypePtr>> aggsToCompute; // e.g. MyDB_AggType :: avg, avg(r_suppkey * 1.0)
 	for (auto a : valuesToSelect) {
 		a->getAtt(newValuesToSelect);
 
 		if (a->isAggregateAtt()) {
 			pair <string, string> agg = a->getAggregateAtt();
 			string aggType = agg.first;
-			string aggToCompute = agg.second;
+			ExprTreePtr aggToCompute = a;
 
 			if (aggType == "sum") {
 				aggsToCompute.push_back(make_pair(make_pair(MyDB_AggType :: sumType, aggToCompute), a->getAttType()));
@@ -57,6 +64,25 @@ void Optimizer :: execute() {
 		}
 	}
 
+	// without an aggregate, the ORDER BY is run over the attributes that come out of the joins, so
+	// the ones that it uses have to be kept too (with an aggregate, it can only use what is grouped
+	// on, or the aggregates that are selected)
+	if (aggsToCompute.size() == 0) {
+		for (auto o : orderingClauses) {
+			vector <ExprTreePtr> orderAtts;
+			o.first->getAtt(orderAtts);
+			for (auto a : orderAtts) {
+				bool found = false;
+				for (auto b : newValuesToSelect) {
+					found = found || a->toString() == b->toString();
+				}
+				if (!found) {
+					newValuesToSelect.push_back(a);
+				}
+			}
+		}
+	}
+
 	cout << "[Optimizer.execute(): the size of aggsToCompute is: " + to_string(aggsToCompute.size()) + "]"<< endl; 
 	cout << "[Optimizer.execute(): the list of attributes in the selection are: ]" << endl;
 	for (auto a : newValuesToSelect) {
@@ -69,6 +95,15 @@ void Optimizer :: execute() {
 	pair <RelAlgExprPtr, int> reducedRA = optimize(allDisjunctions, tablesToProcess, newValuesToSelect);
 	RelAlgExprPtr expr = reducedRA.first;
 
+	// a LIMIT with no ORDER BY and no aggregate keeps the first records that come out, so a
+	// selection over a single table can stop as soon as it has them
+	if (limit >= 0 && orderingClauses.empty() && aggsToCompute.size() == 0 && !distinct) {
+		shared_ptr <SingleSelection> selection = dynamic_pointer_cast <SingleSelection> (expr);
+		if (selection != nullptr) {
+			selection->setLimit(limit);
+		}
+	}
+
 	if (aggsToCompute.size() != 0) { // compute aggregation
 		expr = make_shared <AggregateSelection> (expr, aggsToCompute, groupingClauses);
 	}
@@ -84,6 +119,7 @@ void Optimizer :: execute() {
 
 	cout << "-------" << endl;
 	string tableName = "";
+	vector <pair <ExprTreePtr, bool>> newOrderingClauses = orderingClauses;
 	for (auto a : valuesToSelect) { 
 		if (a->isAggregateAtt()) {
 			pair <string, MyDB_AttTypePtr> outputAtt = tempOutputAtts[i++];
@@ -91,12 +127,26 @@ void Optimizer :: execute() {
 			ExprTreePtr newAttToBeSelect = make_shared <Identifier> (tableName, attName);
 			newAttToBeSelect->setAttType(outputAtt.second);
 			newValuesToSelect.push_back(newAttToBeSelect);
+
+			// an ORDER BY on this aggregate is on the attribute that it was put into
+			for (auto &o : newOrderingClauses) {
+				if (o.first->toString() == a->toString()) {
+					o.first = newAttToBeSelect;
+				}
+			}
 		} else {
 			newValuesToSelect.push_back(a);
 		}
 	}
 	cout << "-------" << endl;
 
+	for (auto o : newOrderingClauses) {
+		if (o.first->isAggregateAtt()) {
+			cout << "[Error. Optimizer.execute()]: cannot order by " << o.first->toString() << ", since it is not selected" << endl;
+			return;
+		}
+	}
+
 	cout <<  "[Optimizer.execute(): the list of attributes in the reselection are: ]" << endl;
 	for (auto a : newValuesToSelect) {
 		cout << a->toString() << endl;
@@ -105,7 +155,56 @@ void Optimizer :: execute() {
 
 
 	RelAlgExprPtr reTableIn = make_shared <Table> (output, "");
-	expr = make_shared <SingleSelection> (reTableIn, newValuesToSelect, vector <ExprTreePtr>());
+
+	// a DISTINCT is run first; an ORDER BY or a LIMIT is then run over what comes out of it, so
+	// it can only order by what is selected, which is now in the attributes of that output
+	if (distinct) {
+		double numDistinct = estimateDistinct(aggsToCompute.size() == 0 ? valuesToSelect : groupingClauses);
+		if (aggsToCompute.size() != 0 && groupingClauses.empty()) {
+			numDistinct = 1;
+		}
+		expr = make_shared <DistinctSelection> (reTableIn, newValuesToSelect, numDistinct);
+		if (!newOrderingClauses.empty() || limit >= 0) {
+			vector <int> whichValue;
+			for (auto &o : newOrderingClauses) {
+				int found = -1;
+				for (size_t j = 0; j < newValuesToSelect.size() && found < 0; j++) {
+					if (o.first->toString() == newValuesToSelect[j]->toString()) {
+						found = j;
+					}
+				}
+				if (found < 0) {
+					cout << "[Error. Optimizer.execute()]: cannot order by " << o.first->toString() << 
+						" in a SELECT DISTINCT, since it is not selected" << endl;
+					return;
+				}
+				whichValue.push_back(found);
+			}
+
+			output = expr->run();
+			tempOutputAtts = output->getTable()->getSchema()->getAtts();
+			vector <ExprTreePtr> distinctValues;
+			for (size_t j = 0; j < newValuesToSelect.size(); j++) {
+				ExprTreePtr newAttToBeSelect = make_shared <Identifier> (tableName, tempOutputAtts[j].first);
+				newAttToBeSelect->setAttType(tempOutputAtts[j].second);
+				distinctValues.push_back(newAttToBeSelect);
+			}
+			for (size_t j = 0; j < newOrderingClauses.size(); j++) {
+				newOrderingClauses[j].first = distinctValues[whichValue[j]];
+			}
+			newValuesToSelect = distinctValues;
+			reTableIn = make_shared <Table> (output, "");
+		}
+	}
+
+	if (!newOrderingClauses.empty()) {
+		expr = make_shared <OrderBySelection> (reTableIn, newValuesToSelect, newOrderingClauses, limit);
+	} else if (!distinct || limit >= 0) {
+		shared_ptr <SingleSelection> selection = make_shared <SingleSelection> (reTableIn, newValuesToSelect, 
+			vector <ExprTreePtr>());
+		selection->setLimit(limit);
+		expr = selection;
+	}
 
 	cout << "[Optimizer.execute(): re-run]" << endl;
 	cout << expr->toString() << endl;
@@ -323,6 +422,46 @@ vector< pair<vector <pair <string, string>>, vector <pair <string, string>>>> Op
 }
 
 
+double Optimizer :: estimateDistinct(vector <ExprTreePtr> values) {
+
+	// there cannot be more results than there are records coming out of the joins; a table that
+	// has not been loaded has no counts, so nothing can be said
+	double maxResults = 1;
+	for (auto t : tablesToProcess) {
+		size_t numTuples = allTables[t.first]->getTupleCount();
+		maxResults = (numTuples == 0) ? HUGE_VAL : maxResults * numTuples;
+	}
+
+	// each attribute used has as many values as the catalog says (each is counted once, however
+	// many values use it); anything else about the values is ignored
+	vector <ExprTreePtr> atts;
+	for (auto a : values) {
+		a->getAtt(atts);
+	}
+	vector <string> seen;
+	double res = 1;
+	for (auto a : atts) {
+		string name = a->toString();
+		if (find(seen.begin(), seen.end(), name) != seen.end()) {
+			continue;
+		}
+		seen.push_back(name);
+
+		double count = maxResults;
+		for (auto t : tablesToProcess) {
+			if (a->isReferToTable(t.second)) {
+				size_t distinctValues = allTables[t.first]->getDistinctValues(
+					name.substr(t.second.length() + 2, name.length() - t.second.length() - 3));
+				if (distinctValues != (size_t) -1 && distinctValues > 0) {
+					count = distinctValues;
+				}
+			}
+		}
+		res *= count;
+	}
+	return min(res, maxResults);
+}
+
 MyDB_TableReaderWriterPtr Optimizer :: getTableByName(string tableName) {
 	if (allTables[tableName]->getFileType() == "heap") {
 		return allTableReaderWriters[tableName];
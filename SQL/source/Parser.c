@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -55,72 +57,17 @@
 /* Pure parsers.  */
 #define YYPURE 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INTEGER = 258,
-     IDENTIFIER = 259,
-     DBL = 260,
-     STR = 261,
-     SELECT = 262,
-     FROM = 263,
-     WHERE = 264,
-     AS = 265,
-     BY = 266,
-     AND = 267,
-     OR = 268,
-     NOT = 269,
-     SUM = 270,
-     AVG = 271,
-     GROUP = 272,
-     INT = 273,
-     BOOL = 274,
-     BPLUSTREE = 275,
-     CREATE = 276,
-     DOUBLE = 277,
-     STRING = 278,
-     ON = 279,
-     TABLE = 280
-   };
-#endif
-/* Tokens.  */
-#define INTEGER 258
-#define IDENTIFIER 259
-#define DBL 260
-#define STR 261
-#define SELECT 262
-#define FROM 263
-#define WHERE 264
-#define AS 265
-#define BY 266
-#define AND 267
-#define OR 268
-#define NOT 269
-#define SUM 270
-#define AVG 271
-#define GROUP 272
-#define INT 273
-#define BOOL 274
-#define BPLUSTREE 275
-#define CREATE 276
-#define DOUBLE 277
-#define STRING 278
-#define ON 279
-#define TABLE 280
-
-
-
-
-/* Copy the first part of user declarations.  */
-#line 2 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 2 "Parser.y"
 
 	#include "Lexer.h"
 	#include "ParserHelperFunctions.h" 
@@ -130,86 +77,189 @@
 	#include <string.h>
 
 
+#line 81 "Parser.c"
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
+#include "Parser.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INTEGER = 3,                    /* INTEGER  */
+  YYSYMBOL_IDENTIFIER = 4,                 /* IDENTIFIER  */
+  YYSYMBOL_DBL = 5,                        /* DBL  */
+  YYSYMBOL_STR = 6,                        /* STR  */
+  YYSYMBOL_SELECT = 7,                     /* SELECT  */
+  YYSYMBOL_FROM = 8,                       /* FROM  */
+  YYSYMBOL_WHERE = 9,                      /* WHERE  */
+  YYSYMBOL_AS = 10,                        /* AS  */
+  YYSYMBOL_BY = 11,                        /* BY  */
+  YYSYMBOL_AND = 12,                       /* AND  */
+  YYSYMBOL_OR = 13,                        /* OR  */
+  YYSYMBOL_NOT = 14,                       /* NOT  */
+  YYSYMBOL_SUM = 15,                       /* SUM  */
+  YYSYMBOL_AVG = 16,                       /* AVG  */
+  YYSYMBOL_GROUP = 17,                     /* GROUP  */
+  YYSYMBOL_INT = 18,                       /* INT  */
+  YYSYMBOL_BOOL = 19,                      /* BOOL  */
+  YYSYMBOL_BPLUSTREE = 20,                 /* BPLUSTREE  */
+  YYSYMBOL_CREATE = 21,                    /* CREATE  */
+  YYSYMBOL_DOUBLE = 22,                    /* DOUBLE  */
+  YYSYMBOL_STRING = 23,                    /* STRING  */
+  YYSYMBOL_ON = 24,                        /* ON  */
+  YYSYMBOL_TABLE = 25,                     /* TABLE  */
+  YYSYMBOL_WITH = 26,                      /* WITH  */
+  YYSYMBOL_IN = 27,                        /* IN  */
+  YYSYMBOL_LIKE = 28,                      /* LIKE  */
+  YYSYMBOL_ORDER = 29,                     /* ORDER  */
+  YYSYMBOL_LIMIT = 30,                     /* LIMIT  */
+  YYSYMBOL_ASC = 31,                       /* ASC  */
+  YYSYMBOL_DESC = 32,                      /* DESC  */
+  YYSYMBOL_DISTINCT = 33,                  /* DISTINCT  */
+  YYSYMBOL_34_ = 34,                       /* '('  */
+  YYSYMBOL_35_ = 35,                       /* ')'  */
+  YYSYMBOL_36_ = 36,                       /* ','  */
+  YYSYMBOL_37_ = 37,                       /* '>'  */
+  YYSYMBOL_38_ = 38,                       /* '<'  */
+  YYSYMBOL_39_ = 39,                       /* '='  */
+  YYSYMBOL_40_ = 40,                       /* '+'  */
+  YYSYMBOL_41_ = 41,                       /* '-'  */
+  YYSYMBOL_42_ = 42,                       /* '*'  */
+  YYSYMBOL_43_ = 43,                       /* '/'  */
+  YYSYMBOL_44_ = 44,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 45,                  /* $accept  */
+  YYSYMBOL_SQLStatement = 46,              /* SQLStatement  */
+  YYSYMBOL_CreateTable = 47,               /* CreateTable  */
+  YYSYMBOL_OptionList = 48,                /* OptionList  */
+  YYSYMBOL_AttList = 49,                   /* AttList  */
+  YYSYMBOL_Att = 50,                       /* Att  */
+  YYSYMBOL_SelectQuery = 51,               /* SelectQuery  */
+  YYSYMBOL_SelectFromWhere = 52,           /* SelectFromWhere  */
+  YYSYMBOL_OptDistinct = 53,               /* OptDistinct  */
+  YYSYMBOL_OrderList = 54,                 /* OrderList  */
+  YYSYMBOL_SortKey = 55,                   /* SortKey  */
+  YYSYMBOL_FromList = 56,                  /* FromList  */
+  YYSYMBOL_CNF = 57,                       /* CNF  */
+  YYSYMBOL_Disjunction = 58,               /* Disjunction  */
+  YYSYMBOL_Comparison = 59,                /* Comparison  */
+  YYSYMBOL_ValueList = 60,                 /* ValueList  */
+  YYSYMBOL_Value = 61,                     /* Value  */
+  YYSYMBOL_MultExp = 62,                   /* MultExp  */
+  YYSYMBOL_Literal = 63                    /* Literal  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 13 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-{
-	struct SQLStatement *myStatement;
-	struct SFWQuery *mySelectQuery;
-	struct CreateTable *myCreateTable;
-	struct FromList *myFromList;
-	struct AttList *myAttList;
-	struct Value *myValue;
-	struct ValueList *allValues;
-	struct CNF *myCNF;	
-	int myInt;
-	char *myChar;
-	double myDouble;
-}
-/* Line 193 of yacc.c.  */
-#line 170 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.c"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
-#endif
 
 
+#ifdef short
+# undef short
+#endif
 
-/* Copy the second part of user declarations.  */
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Line 216 of yacc.c.  */
-#line 183 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.c"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -217,55 +267,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -282,11 +383,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -294,8 +395,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -309,119 +410,125 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-  };
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  18
+#define YYFINAL  10
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   118
+#define YYLAST   150
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  37
+#define YYNTOKENS  45
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  14
+#define YYNNTS  19
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  42
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  91
+#define YYNRULES  59
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  121
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   288
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   280
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      26,    27,    34,    32,    28,    33,    36,    35,     2,     2,
+      34,    35,    42,    40,    36,    41,    44,    43,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      30,    31,    29,     2,     2,     2,     2,     2,     2,     2,
+      38,    39,    37,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -443,291 +550,235 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
-      25
+      25,    26,    27,    28,    29,    30,    31,    32,    33
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
-{
-       0,     0,     3,     5,     7,    14,    25,    29,    31,    34,
-      37,    40,    43,    53,    60,    65,    71,    75,    79,    85,
-      87,    91,    95,    97,   101,   105,   110,   114,   117,   121,
-     123,   127,   131,   133,   138,   143,   147,   151,   153,   157,
-     159,   161,   163
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      38,     0,    -1,    42,    -1,    39,    -1,    21,    25,     4,
-      26,    40,    27,    -1,    21,    25,     4,    26,    40,    27,
-      10,    20,    24,     4,    -1,    40,    28,    41,    -1,    41,
-      -1,     4,    18,    -1,     4,    22,    -1,     4,    23,    -1,
-       4,    19,    -1,     7,    47,     8,    43,     9,    44,    17,
-      11,    47,    -1,     7,    47,     8,    43,     9,    44,    -1,
-       7,    47,     8,    43,    -1,     4,    10,     4,    28,    43,
-      -1,     4,    10,     4,    -1,    44,    12,    45,    -1,    44,
-      12,    26,    45,    27,    -1,    45,    -1,    26,    45,    27,
-      -1,    45,    13,    46,    -1,    46,    -1,    48,    29,    48,
-      -1,    48,    30,    48,    -1,    48,    30,    29,    48,    -1,
-      48,    31,    48,    -1,    14,    46,    -1,    47,    28,    48,
-      -1,    48,    -1,    49,    32,    48,    -1,    49,    33,    48,
-      -1,    49,    -1,    15,    26,    48,    27,    -1,    16,    26,
-      48,    27,    -1,    50,    34,    49,    -1,    50,    35,    49,
-      -1,    50,    -1,     4,    36,     4,    -1,     5,    -1,     6,
-      -1,     3,    -1,    26,    48,    27,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,    81,    81,    87,    95,   101,   107,   112,   118,   123,
-     128,   133,   140,   148,   155,   162,   167,   173,   178,   183,
-     188,   194,   199,   205,   210,   215,   220,   225,   231,   236,
-     242,   247,   252,   257,   262,   268,   273,   278,   283,   288,
-     293,   298,   303
+       0,    96,    96,   102,   110,   116,   122,   128,   133,   139,
+     144,   150,   155,   160,   165,   172,   177,   182,   187,   193,
+     201,   208,   215,   221,   226,   231,   237,   242,   247,   253,
+     258,   264,   269,   274,   279,   285,   290,   296,   301,   306,
+     311,   316,   321,   326,   331,   337,   342,   348,   353,   358,
+     363,   368,   374,   379,   384,   389,   394,   399,   404,   409
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "INTEGER", "IDENTIFIER", "DBL", "STR",
-  "SELECT", "FROM", "WHERE", "AS", "BY", "AND", "OR", "NOT", "SUM", "AVG",
-  "GROUP", "INT", "BOOL", "BPLUSTREE", "CREATE", "DOUBLE", "STRING", "ON",
-  "TABLE", "'('", "')'", "','", "'>'", "'<'", "'='", "'+'", "'-'", "'*'",
-  "'/'", "'.'", "$accept", "SQLStatement", "CreateTable", "AttList", "Att",
-  "SelectQuery", "FromList", "CNF", "Disjunction", "Comparison",
-  "ValueList", "Value", "MultExp", "Literal", 0
+  "\"end of file\"", "error", "\"invalid token\"", "INTEGER",
+  "IDENTIFIER", "DBL", "STR", "SELECT", "FROM", "WHERE", "AS", "BY", "AND",
+  "OR", "NOT", "SUM", "AVG", "GROUP", "INT", "BOOL", "BPLUSTREE", "CREATE",
+  "DOUBLE", "STRING", "ON", "TABLE", "WITH", "IN", "LIKE", "ORDER",
+  "LIMIT", "ASC", "DESC", "DISTINCT", "'('", "')'", "','", "'>'", "'<'",
+  "'='", "'+'", "'-'", "'*'", "'/'", "'.'", "$accept", "SQLStatement",
+  "CreateTable", "OptionList", "AttList", "Att", "SelectQuery",
+  "SelectFromWhere", "OptDistinct", "OrderList", "SortKey", "FromList",
+  "CNF", "Disjunction", "Comparison", "ValueList", "Value", "MultExp",
+  "Literal", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,    40,    41,    44,    62,
-      60,    61,    43,    45,    42,    47,    46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-64)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-       0,    37,    38,    38,    39,    39,    40,    40,    41,    41,
-      41,    41,    42,    42,    42,    43,    43,    44,    44,    44,
-      44,    45,    45,    46,    46,    46,    46,    46,    47,    47,
-      48,    48,    48,    48,    48,    49,    49,    49,    50,    50,
-      50,    50,    50
+      79,    14,    -9,    76,   -64,   -64,    59,   -64,     3,    52,
+     -64,    69,    95,   -64,    48,   -64,   -64,    87,    88,     3,
+      -3,   -64,    61,    71,    90,     3,   -64,    99,     3,     3,
+      91,   119,     3,     3,     3,    56,    56,   121,    21,   -64,
+      78,   -64,    92,    93,   -64,   120,   122,   -64,   -64,   -64,
+     -64,   -64,    89,    80,   -64,   126,     3,   -64,   -64,   -64,
+     -64,   128,    24,   -64,   -64,   -64,   -64,     5,   121,   -64,
+     -64,    97,    38,    38,    70,   123,   -64,    67,   114,   131,
+     -64,   119,   -64,    -1,    36,    63,   127,    38,   109,   105,
+     134,     3,    -2,     3,   117,   -64,   106,   -64,   -64,    38,
+     123,     3,   -64,   137,     3,   -64,   -64,     3,   -64,   -64,
+     140,   141,    10,   110,   -64,    82,   -64,   -64,   -64,   -64,
+     -64
 };
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       0,     2,     1,     1,     6,    10,     3,     1,     2,     2,
-       2,     2,     9,     6,     4,     5,     3,     3,     5,     1,
-       3,     3,     1,     3,     3,     4,     3,     2,     3,     1,
-       3,     3,     1,     4,     4,     3,     3,     1,     3,     1,
-       1,     1,     3
+       0,    23,     0,     0,     3,     2,    15,    22,     0,     0,
+       1,     0,     0,    58,     0,    56,    57,     0,     0,     0,
+       0,    46,    49,    54,     0,     0,    17,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    16,    25,
+      26,    55,     0,     0,    59,     0,    21,    45,    47,    48,
+      52,    53,     0,     0,    10,     0,     0,    27,    28,    50,
+      51,     0,     0,    11,    14,    12,    13,     4,     0,    18,
+      24,    30,     0,     0,    20,    33,    36,     0,     0,     0,
+       9,     0,    44,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     8,     5,    29,    34,     0,
+      31,     0,    35,     0,     0,    42,    37,     0,    38,    40,
+       0,     0,     0,    19,    43,     0,    39,     6,     7,    32,
+      41
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     0,     0,     0,     3,     2,    41,     0,    39,    40,
-       0,     0,     0,     0,    29,    32,    37,     0,     1,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-      38,     0,     0,    42,     0,    14,    28,    30,    31,    35,
-      36,     0,    33,    34,     0,     0,     0,     0,     7,    16,
-       0,     0,    13,    19,    22,     0,     8,    11,     9,    10,
-       4,     0,     0,    27,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     6,    15,    20,     0,    17,     0,    21,
-      23,     0,    24,    26,     0,     0,    12,    25,     0,    18,
-       5
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -64,   -64,   -64,   -64,   -64,    81,   -64,   -64,   -64,   -64,
+      94,    66,   -64,   -63,   -17,   -55,    -8,    84,   -64
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     3,     4,    47,    48,     5,    35,    52,    53,    54,
-      13,    55,    15,    16
+       0,     3,     4,    96,    53,    54,     5,     6,     8,    38,
+      39,    46,    74,    75,    76,    20,    77,    22,    23
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -50
-static const yytype_int8 yypact[] =
-{
-       1,    81,   -16,    18,   -50,   -50,   -50,     8,   -50,   -50,
-      30,    48,    81,    -7,   -50,   -19,     5,    60,   -50,    72,
-      81,    81,    51,    75,    81,    81,    81,    85,    85,    55,
-     -50,    68,    76,   -50,    89,    73,   -50,   -50,   -50,   -50,
-     -50,   100,   -50,   -50,   101,    27,    36,    21,   -50,    78,
-      31,    31,    -5,    95,   -50,    63,   -50,   -50,   -50,   -50,
-      99,   100,    75,   -50,    25,    71,    57,   102,    31,    81,
-       0,    81,    90,   -50,   -50,   -50,    31,    95,    81,   -50,
-     -50,    81,   -50,   -50,    88,    38,    86,   -50,   111,   -50,
-     -50
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      21,    13,    14,    15,    16,    31,    13,    14,    15,    16,
+      83,    30,    87,    17,    18,    78,     9,    40,    17,    18,
+      42,    43,   100,    87,    47,    48,    49,    13,    14,    15,
+      16,    79,    19,    32,    98,   107,   112,    19,    72,    17,
+      18,    13,    14,    15,    16,   119,   113,     7,    40,   115,
+      88,    55,    72,    17,    18,    82,    24,    56,    73,    13,
+      14,    15,    16,    89,    90,    84,    13,    14,    15,    16,
+     102,    44,    19,    91,    92,    93,    10,    72,    17,    18,
+      25,    88,    85,   106,   108,   109,     1,    86,    11,    12,
+      19,    84,    27,    21,    89,    90,    21,    99,    26,   116,
+       2,    33,    34,    41,    91,    92,    93,    63,    64,    57,
+      58,    65,    66,    35,    36,    67,    68,   120,    32,    50,
+      51,    28,    29,    45,    37,    52,    44,    59,    60,    69,
+      61,    62,    71,    81,    94,    95,    87,   103,   101,   104,
+     105,   110,   111,   114,   117,   118,    32,    97,     0,    80,
+      70
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int8 yycheck[] =
 {
-     -50,   -50,   -50,   -50,    56,   -50,    54,   -50,   -49,   -40,
-      40,    -1,    39,   -50
+       8,     3,     4,     5,     6,     8,     3,     4,     5,     6,
+      73,    19,    13,    15,    16,    10,    25,    25,    15,    16,
+      28,    29,    85,    13,    32,    33,    34,     3,     4,     5,
+       6,    26,    34,    36,    35,    37,    99,    34,    14,    15,
+      16,     3,     4,     5,     6,    35,   101,    33,    56,   104,
+      14,    30,    14,    15,    16,    72,     4,    36,    34,     3,
+       4,     5,     6,    27,    28,    73,     3,     4,     5,     6,
+      87,    35,    34,    37,    38,    39,     0,    14,    15,    16,
+      11,    14,    12,    91,    92,    93,     7,    17,    29,    30,
+      34,    99,    44,   101,    27,    28,   104,    34,     3,   107,
+      21,    40,    41,     4,    37,    38,    39,    18,    19,    31,
+      32,    22,    23,    42,    43,    35,    36,    35,    36,    35,
+      36,    34,    34,     4,    34,     4,    35,    35,    35,     3,
+      10,     9,     4,    36,    20,     4,    13,    28,    11,    34,
+       6,    24,    36,     6,     4,     4,    36,    81,    -1,    68,
+      56
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint8 yytable[] =
-{
-      14,    23,    64,     6,     7,     8,     9,    66,     1,    17,
-      63,    22,    67,    25,    26,    10,    11,    77,    18,    31,
-      32,    24,     2,    36,    37,    38,    12,    85,    79,    81,
-       6,     7,     8,     9,     6,     7,     8,     9,    68,    27,
-      28,    50,    10,    11,    19,    50,    10,    11,    60,    61,
-      65,    68,    75,    51,    56,    57,    20,    12,    58,    59,
-       6,     7,     8,     9,    29,    89,    39,    40,    80,    82,
-      83,    50,    10,    11,    21,    65,    30,    14,    33,    34,
-      87,    41,    45,    76,     6,     7,     8,     9,     6,     7,
-       8,     9,    69,    70,    71,    42,    10,    11,    33,    44,
-      69,    70,    71,    43,    46,    49,    62,    12,    68,    72,
-      84,    12,    88,    78,    24,    90,    74,    73,    86
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     7,    21,    46,    47,    51,    52,    33,    53,    25,
+       0,    29,    30,     3,     4,     5,     6,    15,    16,    34,
+      60,    61,    62,    63,     4,    11,     3,    44,    34,    34,
+      61,     8,    36,    40,    41,    42,    43,    34,    54,    55,
+      61,     4,    61,    61,    35,     4,    56,    61,    61,    61,
+      62,    62,     4,    49,    50,    30,    36,    31,    32,    35,
+      35,    10,     9,    18,    19,    22,    23,    35,    36,     3,
+      55,     4,    14,    34,    57,    58,    59,    61,    10,    26,
+      50,    36,    59,    58,    61,    12,    17,    13,    14,    27,
+      28,    37,    38,    39,    20,     4,    48,    56,    35,    34,
+      58,    11,    59,    28,    34,     6,    61,    37,    61,    61,
+      24,    36,    58,    60,     6,    60,    61,     4,     4,    35,
+      35
 };
 
-static const yytype_uint8 yycheck[] =
-{
-       1,     8,    51,     3,     4,     5,     6,    12,     7,    25,
-      50,    12,    17,    32,    33,    15,    16,    66,     0,    20,
-      21,    28,    21,    24,    25,    26,    26,    76,    68,    29,
-       3,     4,     5,     6,     3,     4,     5,     6,    13,    34,
-      35,    14,    15,    16,    36,    14,    15,    16,    27,    28,
-      51,    13,    27,    26,    18,    19,    26,    26,    22,    23,
-       3,     4,     5,     6,     4,    27,    27,    28,    69,    70,
-      71,    14,    15,    16,    26,    76,     4,    78,    27,     4,
-      81,    26,     9,    26,     3,     4,     5,     6,     3,     4,
-       5,     6,    29,    30,    31,    27,    15,    16,    27,    10,
-      29,    30,    31,    27,     4,     4,    28,    26,    13,    10,
-      20,    26,    24,    11,    28,     4,    62,    61,    78
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    45,    46,    46,    47,    47,    47,    48,    48,    49,
+      49,    50,    50,    50,    50,    51,    51,    51,    51,    52,
+      52,    52,    53,    53,    54,    54,    55,    55,    55,    56,
+      56,    57,    57,    57,    57,    58,    58,    59,    59,    59,
+      59,    59,    59,    59,    59,    60,    60,    61,    61,    61,
+      61,    61,    62,    62,    62,    63,    63,    63,    63,    63
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
-{
-       0,     7,    21,    38,    39,    42,     3,     4,     5,     6,
-      15,    16,    26,    47,    48,    49,    50,    25,     0,    36,
-      26,    26,    48,     8,    28,    32,    33,    34,    35,     4,
-       4,    48,    48,    27,     4,    43,    48,    48,    48,    49,
-      49,    26,    27,    27,    10,     9,     4,    40,    41,     4,
-      14,    26,    44,    45,    46,    48,    18,    19,    22,    23,
-      27,    28,    28,    46,    45,    48,    12,    17,    13,    29,
-      30,    31,    10,    41,    43,    27,    26,    45,    11,    46,
-      48,    29,    48,    48,    20,    45,    47,    48,    24,    27,
-       4
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     6,     8,    10,     3,     1,     3,
+       1,     2,     2,     2,     2,     1,     4,     3,     6,    10,
+       7,     5,     1,     0,     3,     1,     1,     2,     2,     5,
+       3,     3,     5,     1,     3,     3,     1,     3,     3,     4,
+       3,     5,     3,     4,     2,     3,     1,     3,     3,     1,
+       4,     4,     3,     3,     1,     3,     1,     1,     1,     3
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
 
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYFAIL		goto yyerrlab
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (scanner, myStatement, YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, myStatement, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
-
-
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (&yylval, YYLEX_PARAM)
-#else
-# define YYLEX yylex (&yylval, scanner)
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -737,86 +788,60 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, scanner, myStatement); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *scanner, struct SQLStatement **myStatement)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, scanner, myStatement); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, scanner, myStatement)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    void *scanner;
-    struct SQLStatement **myStatement;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *scanner, struct SQLStatement **myStatement)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (myStatement);
   if (!yyvaluep)
     return;
-  YYUSE (scanner);
-  YYUSE (myStatement);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, void *scanner, struct SQLStatement **myStatement)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, scanner, myStatement)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    void *scanner;
-    struct SQLStatement **myStatement;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *scanner, struct SQLStatement **myStatement)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, scanner, myStatement);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, myStatement);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -824,82 +849,68 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, scanner, myStatement)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
-static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule, void *scanner, struct SQLStatement **myStatement)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule, scanner, myStatement)
-    YYSTYPE *yyvsp;
-    int yyrule;
-    void *scanner;
-    struct SQLStatement **myStatement;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, void *scanner, struct SQLStatement **myStatement)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       , scanner, myStatement);
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, myStatement);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule, scanner, myStatement); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, myStatement); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -914,270 +925,30 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, void *scanner, struct SQLStatement **myStatement)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep, scanner, myStatement)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    void *scanner;
-    struct SQLStatement **myStatement;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, void *scanner, struct SQLStatement **myStatement)
 {
-  YYUSE (yyvaluep);
-  YYUSE (scanner);
-  YYUSE (myStatement);
-
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (myStatement);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
-    {
-
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
-
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *scanner, struct SQLStatement **myStatement);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
 
 
@@ -1188,209 +959,193 @@ int yyparse ();
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void *scanner, struct SQLStatement **myStatement)
-#else
-int
-yyparse (scanner, myStatement)
-    void *scanner;
-    struct SQLStatement **myStatement;
-#endif
-#endif
 {
-  /* The look-ahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
-
-  YYSIZE_T yystacksize = YYINITDEPTH;
-
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
 
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1405,30 +1160,26 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1443,14 +1194,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1463,391 +1214,543 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 82 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myStatement) = makeSelectQuery ((yyvsp[(1) - (1)].mySelectQuery));
+  case 2: /* SQLStatement: SelectQuery  */
+#line 97 "Parser.y"
+{
+	(yyval.myStatement) = makeSelectQuery ((yyvsp[0].mySelectQuery));
 	*myStatement = (yyval.myStatement);
-;}
+}
+#line 1224 "Parser.c"
     break;
 
-  case 3:
-#line 88 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myStatement) = makeCreateTable ((yyvsp[(1) - (1)].myCreateTable));
+  case 3: /* SQLStatement: CreateTable  */
+#line 103 "Parser.y"
+{
+	(yyval.myStatement) = makeCreateTable ((yyvsp[0].myCreateTable));
 	*myStatement = (yyval.myStatement);
-;}
+}
+#line 1233 "Parser.c"
     break;
 
-  case 4:
-#line 97 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myCreateTable) = makeTableRegular ((yyvsp[(3) - (6)].myChar), (yyvsp[(5) - (6)].myAttList));	
-;}
+  case 4: /* CreateTable: CREATE TABLE IDENTIFIER '(' AttList ')'  */
+#line 112 "Parser.y"
+{
+	(yyval.myCreateTable) = makeTableRegular ((yyvsp[-3].myChar), (yyvsp[-1].myAttList));	
+}
+#line 1241 "Parser.c"
     break;
 
-  case 5:
-#line 103 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myCreateTable) = makeTableBPlusTree ((yyvsp[(3) - (10)].myChar), (yyvsp[(5) - (10)].myAttList), (yyvsp[(10) - (10)].myChar));
-;}
+  case 5: /* CreateTable: CREATE TABLE IDENTIFIER '(' AttList ')' WITH OptionList  */
+#line 118 "Parser.y"
+{
+	(yyval.myCreateTable) = makeTableRegularWithOptions ((yyvsp[-5].myChar), (yyvsp[-3].myAttList), (yyvsp[0].myTableOptions));	
+}
+#line 1249 "Parser.c"
     break;
 
-  case 6:
-#line 108 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myAttList) = appendAttList ((yyvsp[(1) - (3)].myAttList), (yyvsp[(3) - (3)].myAttList));
-;}
+  case 6: /* CreateTable: CREATE TABLE IDENTIFIER '(' AttList ')' AS BPLUSTREE ON IDENTIFIER  */
+#line 124 "Parser.y"
+{
+	(yyval.myCreateTable) = makeTableBPlusTree ((yyvsp[-7].myChar), (yyvsp[-5].myAttList), (yyvsp[0].myChar));
+}
+#line 1257 "Parser.c"
     break;
 
-  case 7:
-#line 113 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myAttList) = (yyvsp[(1) - (1)].myAttList);
-;}
+  case 7: /* OptionList: OptionList ',' IDENTIFIER  */
+#line 129 "Parser.y"
+{
+	(yyval.myTableOptions) = appendTableOptions ((yyvsp[-2].myTableOptions), (yyvsp[0].myChar));
+}
+#line 1265 "Parser.c"
     break;
 
-  case 8:
-#line 119 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myAttList) = makeAttList ((yyvsp[(1) - (2)].myChar), INT);
-;}
+  case 8: /* OptionList: IDENTIFIER  */
+#line 134 "Parser.y"
+{
+	(yyval.myTableOptions) = makeTableOptions ((yyvsp[0].myChar));
+}
+#line 1273 "Parser.c"
     break;
 
-  case 9:
-#line 124 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myAttList) = makeAttList ((yyvsp[(1) - (2)].myChar), DOUBLE);
-;}
+  case 9: /* AttList: AttList ',' Att  */
+#line 140 "Parser.y"
+{
+	(yyval.myAttList) = appendAttList ((yyvsp[-2].myAttList), (yyvsp[0].myAttList));
+}
+#line 1281 "Parser.c"
     break;
 
-  case 10:
-#line 129 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myAttList) = makeAttList ((yyvsp[(1) - (2)].myChar), STRING);
-;}
+  case 10: /* AttList: Att  */
+#line 145 "Parser.y"
+{
+	(yyval.myAttList) = (yyvsp[0].myAttList);
+}
+#line 1289 "Parser.c"
     break;
 
-  case 11:
-#line 134 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myAttList) = makeAttList ((yyvsp[(1) - (2)].myChar), BOOL);
-;}
+  case 11: /* Att: IDENTIFIER INT  */
+#line 151 "Parser.y"
+{
+	(yyval.myAttList) = makeAttList ((yyvsp[-1].myChar), INT);
+}
+#line 1297 "Parser.c"
     break;
 
-  case 12:
-#line 144 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.mySelectQuery) = makeQueryWithGroupBy ((yyvsp[(2) - (9)].allValues), (yyvsp[(4) - (9)].myFromList), (yyvsp[(6) - (9)].myCNF), (yyvsp[(9) - (9)].allValues));
-;}
+  case 12: /* Att: IDENTIFIER DOUBLE  */
+#line 156 "Parser.y"
+{
+	(yyval.myAttList) = makeAttList ((yyvsp[-1].myChar), DOUBLE);
+}
+#line 1305 "Parser.c"
     break;
 
-  case 13:
-#line 151 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.mySelectQuery) = makeQuery ((yyvsp[(2) - (6)].allValues), (yyvsp[(4) - (6)].myFromList), (yyvsp[(6) - (6)].myCNF));
-;}
+  case 13: /* Att: IDENTIFIER STRING  */
+#line 161 "Parser.y"
+{
+	(yyval.myAttList) = makeAttList ((yyvsp[-1].myChar), STRING);
+}
+#line 1313 "Parser.c"
     break;
 
-  case 14:
-#line 157 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.mySelectQuery) = makeQueryNoWhere ((yyvsp[(2) - (4)].allValues), (yyvsp[(4) - (4)].myFromList));
-;}
+  case 14: /* Att: IDENTIFIER BOOL  */
+#line 166 "Parser.y"
+{
+	(yyval.myAttList) = makeAttList ((yyvsp[-1].myChar), BOOL);
+}
+#line 1321 "Parser.c"
     break;
 
-  case 15:
-#line 163 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myFromList) = appendFromList ((yyvsp[(5) - (5)].myFromList), (yyvsp[(1) - (5)].myChar), (yyvsp[(3) - (5)].myChar));
-;}
+  case 15: /* SelectQuery: SelectFromWhere  */
+#line 173 "Parser.y"
+{
+	(yyval.mySelectQuery) = (yyvsp[0].mySelectQuery);
+}
+#line 1329 "Parser.c"
     break;
 
-  case 16:
-#line 168 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myFromList) = makeFromList ((yyvsp[(1) - (3)].myChar), (yyvsp[(3) - (3)].myChar));
-;}
+  case 16: /* SelectQuery: SelectFromWhere ORDER BY OrderList  */
+#line 178 "Parser.y"
+{
+	(yyval.mySelectQuery) = addOrderBy ((yyvsp[-3].mySelectQuery), (yyvsp[0].myOrderList));
+}
+#line 1337 "Parser.c"
     break;
 
-  case 17:
-#line 174 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myCNF) = pushBackDisjunction ((yyvsp[(1) - (3)].myCNF), (yyvsp[(3) - (3)].myValue));	
-;}
+  case 17: /* SelectQuery: SelectFromWhere LIMIT INTEGER  */
+#line 183 "Parser.y"
+{
+	(yyval.mySelectQuery) = addLimit ((yyvsp[-2].mySelectQuery), (yyvsp[0].myInt));
+}
+#line 1345 "Parser.c"
     break;
 
-  case 18:
-#line 179 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myCNF) = pushBackDisjunction ((yyvsp[(1) - (5)].myCNF), (yyvsp[(4) - (5)].myValue));	
-;}
+  case 18: /* SelectQuery: SelectFromWhere ORDER BY OrderList LIMIT INTEGER  */
+#line 188 "Parser.y"
+{
+	(yyval.mySelectQuery) = addLimit (addOrderBy ((yyvsp[-5].mySelectQuery), (yyvsp[-2].myOrderList)), (yyvsp[0].myInt));
+}
+#line 1353 "Parser.c"
     break;
 
-  case 19:
-#line 184 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myCNF) = makeCNF ((yyvsp[(1) - (1)].myValue));
-;}
+  case 19: /* SelectFromWhere: SELECT OptDistinct ValueList FROM FromList WHERE CNF GROUP BY ValueList  */
+#line 197 "Parser.y"
+{
+	(yyval.mySelectQuery) = addDistinct (makeQueryWithGroupBy ((yyvsp[-7].allValues), (yyvsp[-5].myFromList), (yyvsp[-3].myCNF), (yyvsp[0].allValues)), (yyvsp[-8].myInt));
+}
+#line 1361 "Parser.c"
     break;
 
-  case 20:
-#line 189 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myCNF) = makeCNF ((yyvsp[(2) - (3)].myValue));
-;}
+  case 20: /* SelectFromWhere: SELECT OptDistinct ValueList FROM FromList WHERE CNF  */
+#line 204 "Parser.y"
+{
+	(yyval.mySelectQuery) = addDistinct (makeQuery ((yyvsp[-4].allValues), (yyvsp[-2].myFromList), (yyvsp[0].myCNF)), (yyvsp[-5].myInt));
+}
+#line 1369 "Parser.c"
     break;
 
-  case 21:
-#line 195 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = orr ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 21: /* SelectFromWhere: SELECT OptDistinct ValueList FROM FromList  */
+#line 210 "Parser.y"
+{
+	(yyval.mySelectQuery) = addDistinct (makeQueryNoWhere ((yyvsp[-2].allValues), (yyvsp[0].myFromList)), (yyvsp[-3].myInt));
+}
+#line 1377 "Parser.c"
     break;
 
-  case 22:
-#line 200 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = (yyvsp[(1) - (1)].myValue);
-;}
+  case 22: /* OptDistinct: DISTINCT  */
+#line 216 "Parser.y"
+{
+	(yyval.myInt) = 1;
+}
+#line 1385 "Parser.c"
     break;
 
-  case 23:
-#line 206 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = gt ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 23: /* OptDistinct: %empty  */
+#line 221 "Parser.y"
+{
+	(yyval.myInt) = 0;
+}
+#line 1393 "Parser.c"
     break;
 
-  case 24:
-#line 211 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = lt ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 24: /* OrderList: OrderList ',' SortKey  */
+#line 227 "Parser.y"
+{
+	(yyval.myOrderList) = appendOrderList ((yyvsp[-2].myOrderList), (yyvsp[0].myOrderList));
+}
+#line 1401 "Parser.c"
     break;
 
-  case 25:
-#line 216 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-        (yyval.myValue) = neq ((yyvsp[(1) - (4)].myValue), (yyvsp[(4) - (4)].myValue));
-;}
+  case 25: /* OrderList: SortKey  */
+#line 232 "Parser.y"
+{
+	(yyval.myOrderList) = (yyvsp[0].myOrderList);
+}
+#line 1409 "Parser.c"
     break;
 
-  case 26:
-#line 221 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = eq ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 26: /* SortKey: Value  */
+#line 238 "Parser.y"
+{
+	(yyval.myOrderList) = makeOrderList ((yyvsp[0].myValue), 0);
+}
+#line 1417 "Parser.c"
     break;
 
-  case 27:
-#line 226 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = nott ((yyvsp[(2) - (2)].myValue));
-;}
+  case 27: /* SortKey: Value ASC  */
+#line 243 "Parser.y"
+{
+	(yyval.myOrderList) = makeOrderList ((yyvsp[-1].myValue), 0);
+}
+#line 1425 "Parser.c"
     break;
 
-  case 28:
-#line 232 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.allValues) = pushBackValue ((yyvsp[(1) - (3)].allValues), (yyvsp[(3) - (3)].myValue));
-;}
+  case 28: /* SortKey: Value DESC  */
+#line 248 "Parser.y"
+{
+	(yyval.myOrderList) = makeOrderList ((yyvsp[-1].myValue), 1);
+}
+#line 1433 "Parser.c"
     break;
 
-  case 29:
-#line 237 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.allValues) = makeValueList ((yyvsp[(1) - (1)].myValue));
-;}
+  case 29: /* FromList: IDENTIFIER AS IDENTIFIER ',' FromList  */
+#line 254 "Parser.y"
+{
+	(yyval.myFromList) = appendFromList ((yyvsp[0].myFromList), (yyvsp[-4].myChar), (yyvsp[-2].myChar));
+}
+#line 1441 "Parser.c"
     break;
 
-  case 30:
-#line 243 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = plus ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 30: /* FromList: IDENTIFIER AS IDENTIFIER  */
+#line 259 "Parser.y"
+{
+	(yyval.myFromList) = makeFromList ((yyvsp[-2].myChar), (yyvsp[0].myChar));
+}
+#line 1449 "Parser.c"
     break;
 
-  case 31:
-#line 248 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = minus ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 31: /* CNF: CNF AND Disjunction  */
+#line 265 "Parser.y"
+{
+	(yyval.myCNF) = pushBackDisjunction ((yyvsp[-2].myCNF), (yyvsp[0].myValue));	
+}
+#line 1457 "Parser.c"
     break;
 
-  case 32:
-#line 253 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = (yyvsp[(1) - (1)].myValue);
-;}
+  case 32: /* CNF: CNF AND '(' Disjunction ')'  */
+#line 270 "Parser.y"
+{
+	(yyval.myCNF) = pushBackDisjunction ((yyvsp[-4].myCNF), (yyvsp[-1].myValue));	
+}
+#line 1465 "Parser.c"
     break;
 
-  case 33:
-#line 258 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = sum ((yyvsp[(3) - (4)].myValue));
-;}
+  case 33: /* CNF: Disjunction  */
+#line 275 "Parser.y"
+{
+	(yyval.myCNF) = makeCNF ((yyvsp[0].myValue));
+}
+#line 1473 "Parser.c"
     break;
 
-  case 34:
-#line 263 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = avg ((yyvsp[(3) - (4)].myValue));
-;}
+  case 34: /* CNF: '(' Disjunction ')'  */
+#line 280 "Parser.y"
+{
+	(yyval.myCNF) = makeCNF ((yyvsp[-1].myValue));
+}
+#line 1481 "Parser.c"
     break;
 
-  case 35:
-#line 269 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = times ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 35: /* Disjunction: Disjunction OR Comparison  */
+#line 286 "Parser.y"
+{
+	(yyval.myValue) = orr ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1489 "Parser.c"
     break;
 
-  case 36:
-#line 274 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = divide ((yyvsp[(1) - (3)].myValue), (yyvsp[(3) - (3)].myValue));
-;}
+  case 36: /* Disjunction: Comparison  */
+#line 291 "Parser.y"
+{
+	(yyval.myValue) = (yyvsp[0].myValue);
+}
+#line 1497 "Parser.c"
     break;
 
-  case 37:
-#line 279 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = (yyvsp[(1) - (1)].myValue);
-;}
+  case 37: /* Comparison: Value '>' Value  */
+#line 297 "Parser.y"
+{
+	(yyval.myValue) = gt ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1505 "Parser.c"
     break;
 
-  case 38:
-#line 284 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = makeIdentifier ((yyvsp[(1) - (3)].myChar), (yyvsp[(3) - (3)].myChar));
-;}
+  case 38: /* Comparison: Value '<' Value  */
+#line 302 "Parser.y"
+{
+	(yyval.myValue) = lt ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1513 "Parser.c"
     break;
 
-  case 39:
-#line 289 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = makeDouble ((yyvsp[(1) - (1)].myDouble));
-;}
+  case 39: /* Comparison: Value '<' '>' Value  */
+#line 307 "Parser.y"
+{
+        (yyval.myValue) = neq ((yyvsp[-3].myValue), (yyvsp[0].myValue));
+}
+#line 1521 "Parser.c"
     break;
 
-  case 40:
-#line 294 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = makeString ((yyvsp[(1) - (1)].myChar));	
-;}
+  case 40: /* Comparison: Value '=' Value  */
+#line 312 "Parser.y"
+{
+	(yyval.myValue) = eq ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1529 "Parser.c"
     break;
 
-  case 41:
-#line 299 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = makeInt ((yyvsp[(1) - (1)].myInt));
-;}
+  case 41: /* Comparison: Value IN '(' ValueList ')'  */
+#line 317 "Parser.y"
+{
+	(yyval.myValue) = isIn ((yyvsp[-4].myValue), (yyvsp[-1].allValues));
+}
+#line 1537 "Parser.c"
     break;
 
-  case 42:
-#line 304 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
-    {
-	(yyval.myValue) = (yyvsp[(2) - (3)].myValue);
-;}
+  case 42: /* Comparison: Value LIKE STR  */
+#line 322 "Parser.y"
+{
+	(yyval.myValue) = like ((yyvsp[-2].myValue), (yyvsp[0].myChar));
+}
+#line 1545 "Parser.c"
+    break;
+
+  case 43: /* Comparison: Value NOT LIKE STR  */
+#line 327 "Parser.y"
+{
+	(yyval.myValue) = nott (like ((yyvsp[-3].myValue), (yyvsp[0].myChar)));
+}
+#line 1553 "Parser.c"
+    break;
+
+  case 44: /* Comparison: NOT Comparison  */
+#line 332 "Parser.y"
+{
+	(yyval.myValue) = nott ((yyvsp[0].myValue));
+}
+#line 1561 "Parser.c"
+    break;
+
+  case 45: /* ValueList: ValueList ',' Value  */
+#line 338 "Parser.y"
+{
+	(yyval.allValues) = pushBackValue ((yyvsp[-2].allValues), (yyvsp[0].myValue));
+}
+#line 1569 "Parser.c"
+    break;
+
+  case 46: /* ValueList: Value  */
+#line 343 "Parser.y"
+{
+	(yyval.allValues) = makeValueList ((yyvsp[0].myValue));
+}
+#line 1577 "Parser.c"
+    break;
+
+  case 47: /* Value: MultExp '+' Value  */
+#line 349 "Parser.y"
+{
+	(yyval.myValue) = plus ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1585 "Parser.c"
+    break;
+
+  case 48: /* Value: MultExp '-' Value  */
+#line 354 "Parser.y"
+{
+	(yyval.myValue) = minus ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1593 "Parser.c"
+    break;
+
+  case 49: /* Value: MultExp  */
+#line 359 "Parser.y"
+{
+	(yyval.myValue) = (yyvsp[0].myValue);
+}
+#line 1601 "Parser.c"
+    break;
+
+  case 50: /* Value: SUM '(' Value ')'  */
+#line 364 "Parser.y"
+{
+	(yyval.myValue) = sum ((yyvsp[-1].myValue));
+}
+#line 1609 "Parser.c"
+    break;
+
+  case 51: /* Value: AVG '(' Value ')'  */
+#line 369 "Parser.y"
+{
+	(yyval.myValue) = avg ((yyvsp[-1].myValue));
+}
+#line 1617 "Parser.c"
+    break;
+
+  case 52: /* MultExp: Literal '*' MultExp  */
+#line 375 "Parser.y"
+{
+	(yyval.myValue) = times ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1625 "Parser.c"
     break;
 
+  case 53: /* MultExp: Literal '/' MultExp  */
+#line 380 "Parser.y"
+{
+	(yyval.myValue) = divide ((yyvsp[-2].myValue), (yyvsp[0].myValue));
+}
+#line 1633 "Parser.c"
+    break;
+
+  case 54: /* MultExp: Literal  */
+#line 385 "Parser.y"
+{
+	(yyval.myValue) = (yyvsp[0].myValue);
+}
+#line 1641 "Parser.c"
+    break;
+
+  case 55: /* Literal: IDENTIFIER '.' IDENTIFIER  */
+#line 390 "Parser.y"
+{
+	(yyval.myValue) = makeIdentifier ((yyvsp[-2].myChar), (yyvsp[0].myChar));
+}
+#line 1649 "Parser.c"
+    break;
+
+  case 56: /* Literal: DBL  */
+#line 395 "Parser.y"
+{
+	(yyval.myValue) = makeDouble ((yyvsp[0].myDouble));
+}
+#line 1657 "Parser.c"
+    break;
+
+  case 57: /* Literal: STR  */
+#line 400 "Parser.y"
+{
+	(yyval.myValue) = makeString ((yyvsp[0].myChar));	
+}
+#line 1665 "Parser.c"
+    break;
+
+  case 58: /* Literal: INTEGER  */
+#line 405 "Parser.y"
+{
+	(yyval.myValue) = makeInt ((yyvsp[0].myInt));
+}
+#line 1673 "Parser.c"
+    break;
+
+  case 59: /* Literal: '(' Value ')'  */
+#line 410 "Parser.y"
+{
+	(yyval.myValue) = (yyvsp[-1].myValue);
+}
+#line 1681 "Parser.c"
+    break;
+
+
+#line 1685 "Parser.c"
 
-/* Line 1267 of yacc.c.  */
-#line 1758 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.c"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (scanner, myStatement, YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (scanner, myStatement, yymsg);
-	  }
-	else
-	  {
-	    yyerror (scanner, myStatement, YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, scanner, myStatement);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, scanner, myStatement);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -1856,14 +1759,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1876,42 +1778,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, scanner, myStatement);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, myStatement);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1922,53 +1824,56 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (scanner, myStatement, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval, scanner, myStatement);
-  /* Do not reclaim the symbols of the rule which action triggered
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, scanner, myStatement);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, scanner, myStatement);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, myStatement);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
 
-#line 309 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
+  return yyresult;
+}
 
+#line 415 "Parser.y"
 
 
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
+/* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,88 +31,96 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Tokens.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_PARSER_H_INCLUDED
+# define YY_YY_PARSER_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     INTEGER = 258,
-     IDENTIFIER = 259,
-     DBL = 260,
-     STR = 261,
-     SELECT = 262,
-     FROM = 263,
-     WHERE = 264,
-     AS = 265,
-     BY = 266,
-     AND = 267,
-     OR = 268,
-     NOT = 269,
-     SUM = 270,
-     AVG = 271,
-     GROUP = 272,
-     INT = 273,
-     BOOL = 274,
-     BPLUSTREE = 275,
-     CREATE = 276,
-     DOUBLE = 277,
-     STRING = 278,
-     ON = 279,
-     TABLE = 280
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INTEGER = 258,                 /* INTEGER  */
+    IDENTIFIER = 259,              /* IDENTIFIER  */
+    DBL = 260,                     /* DBL  */
+    STR = 261,                     /* STR  */
+    SELECT = 262,                  /* SELECT  */
+    FROM = 263,                    /* FROM  */
+    WHERE = 264,                   /* WHERE  */
+    AS = 265,                      /* AS  */
+    BY = 266,                      /* BY  */
+    AND = 267,                     /* AND  */
+    OR = 268,                      /* OR  */
+    NOT = 269,                     /* NOT  */
+    SUM = 270,                     /* SUM  */
+    AVG = 271,                     /* AVG  */
+    GROUP = 272,                   /* GROUP  */
+    INT = 273,                     /* INT  */
+    BOOL = 274,                    /* BOOL  */
+    BPLUSTREE = 275,               /* BPLUSTREE  */
+    CREATE = 276,                  /* CREATE  */
+    DOUBLE = 277,                  /* DOUBLE  */
+    STRING = 278,                  /* STRING  */
+    ON = 279,                      /* ON  */
+    TABLE = 280,                   /* TABLE  */
+    WITH = 281,                    /* WITH  */
+    IN = 282,                      /* IN  */
+    LIKE = 283,                    /* LIKE  */
+    ORDER = 284,                   /* ORDER  */
+    LIMIT = 285,                   /* LIMIT  */
+    ASC = 286,                     /* ASC  */
+    DESC = 287,                    /* DESC  */
+    DISTINCT = 288                 /* DISTINCT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define INTEGER 258
-#define IDENTIFIER 259
-#define DBL 260
-#define STR 261
-#define SELECT 262
-#define FROM 263
-#define WHERE 264
-#define AS 265
-#define BY 266
-#define AND 267
-#define OR 268
-#define NOT 269
-#define SUM 270
-#define AVG 271
-#define GROUP 272
-#define INT 273
-#define BOOL 274
-#define BPLUSTREE 275
-#define CREATE 276
-#define DOUBLE 277
-#define STRING 278
-#define ON 279
-#define TABLE 280
-
-
-
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 13 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.y"
+union YYSTYPE
 {
+#line 13 "Parser.y"
+
 	struct SQLStatement *myStatement;
 	struct SFWQuery *mySelectQuery;
 	struct CreateTable *myCreateTable;
 	struct FromList *myFromList;
 	struct AttList *myAttList;
+	struct TableOptions *myTableOptions;
 	struct Value *myValue;
 	struct ValueList *allValues;
+	struct OrderList *myOrderList;
 	struct CNF *myCNF;	
 	int myInt;
 	char *myChar;
 	double myDouble;
-}
-/* Line 1529 of yacc.c.  */
-#line 113 "/Users/Rena7ssance/Desktop/RiceSp2018/COMP530/Assignment/A7/A7/Main/SQL/source/Parser.h"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 113 "Parser.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
 
 
+
+int yyparse (void *scanner, struct SQLStatement **myStatement);
+
+
+#endif /* !YY_YY_PARSER_H_INCLUDED  */
@@ -16,8 +16,10 @@
 	struct CreateTable *myCreateTable;
 	struct FromList *myFromList;
 	struct AttList *myAttList;
+	struct TableOptions *myTableOptions;
 	struct Value *myValue;
 	struct ValueList *allValues;
+	struct OrderList *myOrderList;
 	struct CNF *myCNF;	
 	int myInt;
 	char *myChar;
@@ -52,6 +54,14 @@
 %token STRING
 %token ON
 %token TABLE
+%token WITH
+%token IN
+%token LIKE
+%token ORDER
+%token LIMIT
+%token ASC
+%token DESC
+%token DISTINCT
 
 %type <myValue> Value
 %type <myValue> MultExp
@@ -64,8 +74,13 @@
 %type <myCreateTable> CreateTable
 %type <myAttList> AttList
 %type <myAttList> Att
+%type <myTableOptions> OptionList
 %type <myFromList> FromList
 %type <mySelectQuery> SelectQuery 
+%type <mySelectQuery> SelectFromWhere
+%type <myOrderList> OrderList
+%type <myOrderList> SortKey
+%type <myInt> OptDistinct
 
 %start SQLStatement
 
@@ -98,12 +113,29 @@ CreateTable: CREATE TABLE IDENTIFIER '('
 	$$ = makeTableRegular ($3, $5);	
 }
 
+| CREATE TABLE IDENTIFIER '(' 
+		AttList ')' WITH OptionList
+{
+	$$ = makeTableRegularWithOptions ($3, $5, $8);	
+}
+
 | CREATE TABLE IDENTIFIER '(' 
 		AttList ')' AS BPLUSTREE ON IDENTIFIER 
 {
 	$$ = makeTableBPlusTree ($3, $5, $10);
 }
 
+OptionList : OptionList ',' IDENTIFIER
+{
+	$$ = appendTableOptions ($1, $3);
+}
+
+| IDENTIFIER
+{
+	$$ = makeTableOptions ($1);
+}
+;
+
 AttList : AttList ',' Att 
 {
 	$$ = appendAttList ($1, $3);
@@ -135,27 +167,86 @@ Att : IDENTIFIER INT
 	$$ = makeAttList ($1, BOOL);
 }
 
-//********* SELECT-FROM-WHERE Query
+//********* SELECT-FROM-WHERE Query, with an optional ORDER BY and LIMIT
+
+SelectQuery: SelectFromWhere
+{
+	$$ = $1;
+}
+
+| SelectFromWhere ORDER BY OrderList
+{
+	$$ = addOrderBy ($1, $4);
+}
+
+| SelectFromWhere LIMIT INTEGER
+{
+	$$ = addLimit ($1, $3);
+}
 
-SelectQuery: SELECT ValueList
+| SelectFromWhere ORDER BY OrderList LIMIT INTEGER
+{
+	$$ = addLimit (addOrderBy ($1, $4), $6);
+}
+;
+
+SelectFromWhere: SELECT OptDistinct ValueList
              FROM FromList
 	     WHERE CNF
 	     GROUP BY ValueList
 {
-	$$ = makeQueryWithGroupBy ($2, $4, $6, $9);
+	$$ = addDistinct (makeQueryWithGroupBy ($3, $5, $7, $10), $2);
 }
 
-| SELECT ValueList
+| SELECT OptDistinct ValueList
              FROM FromList
 	     WHERE CNF
 {
-	$$ = makeQuery ($2, $4, $6);
+	$$ = addDistinct (makeQuery ($3, $5, $7), $2);
 }
 
-| SELECT ValueList
+| SELECT OptDistinct ValueList
   FROM FromList
 {
-	$$ = makeQueryNoWhere ($2, $4);
+	$$ = addDistinct (makeQueryNoWhere ($3, $5), $2);
+}
+;
+
+OptDistinct: DISTINCT
+{
+	$$ = 1;
+}
+
+| /* empty */
+{
+	$$ = 0;
+}
+;
+
+OrderList: OrderList ',' SortKey
+{
+	$$ = appendOrderList ($1, $3);
+}
+
+| SortKey
+{
+	$$ = $1;
+}
+;
+
+SortKey: Value
+{
+	$$ = makeOrderList ($1, 0);
+}
+
+| Value ASC
+{
+	$$ = makeOrderList ($1, 0);
+}
+
+| Value DESC
+{
+	$$ = makeOrderList ($1, 1);
 }
 ;
 
@@ -222,6 +313,21 @@ Comparison: Value '>' Value
 	$$ = eq ($1, $3);
 }
 
+| Value IN '(' ValueList ')'
+{
+	$$ = isIn ($1, $4);
+}
+
+| Value LIKE STR
+{
+	$$ = like ($1, $3);
+}
+
+| Value NOT LIKE STR
+{
+	$$ = nott (like ($1, $4));
+}
+
 | NOT Comparison
 {
 	$$ = nott ($2);
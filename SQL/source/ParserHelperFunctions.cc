@@ -140,6 +140,21 @@ struct Value *eq (struct Value *lhs, struct Value *rhs) {
 	return lhs;
 }
 
+struct Value *isIn (struct Value *lhs, struct ValueList *rhs) {
+	ExprTreePtr checkMe = lhs->myVal;
+	lhs->myVal = make_shared <EqOp> (checkMe, rhs->valuesToCompute[0]);
+	for (size_t i = 1; i < rhs->valuesToCompute.size (); i++)
+		lhs->myVal = make_shared <OrOp> (lhs->myVal, make_shared <EqOp> (checkMe, rhs->valuesToCompute[i]));
+	delete rhs;
+	return lhs;
+}
+
+struct Value *like (struct Value *lhs, char *pattern) {
+	lhs->myVal = make_shared <LikeOp> (lhs->myVal, make_shared <StringLiteral> (pattern));
+	free (pattern);
+	return lhs;
+}
+
 struct Value *neq (struct Value *lhs, struct Value *rhs) {
 	lhs->myVal = make_shared <NeqOp> (lhs->myVal, rhs->myVal);
 	delete rhs;	
@@ -207,6 +222,36 @@ struct SFWQuery *makeQuery (struct ValueList *selectClause, struct FromList *fro
 	return returnVal;
 }
 
+struct SFWQuery *addOrderBy (struct SFWQuery *addToMe, struct OrderList *ordering) {
+	addToMe->orderingClauses = ordering->sortKeys;
+	delete ordering;
+	return addToMe;
+}
+
+struct SFWQuery *addLimit (struct SFWQuery *addToMe, int limit) {
+	addToMe->limit = limit;
+	return addToMe;
+}
+
+struct SFWQuery *addDistinct (struct SFWQuery *addToMe, int distinct) {
+	addToMe->distinct = (distinct != 0);
+	return addToMe;
+}
+
+struct OrderList *makeOrderList (struct Value *sortOn, int descending) {
+	auto returnVal = new OrderList (sortOn, descending != 0);
+	delete sortOn;
+	return returnVal;
+}
+
+struct OrderList *appendOrderList (struct OrderList *appendToMe, struct OrderList *appendMe) {
+	for (auto a : appendMe->sortKeys) {
+		appendToMe->sortKeys.push_back (a);
+	}
+	delete appendMe;
+	return appendToMe;
+}
+
 struct CreateTable *makeTableRegular (char *tableName, struct AttList *fromMe) {
 	auto returnVal = new CreateTable (string (tableName), fromMe->atts);
 	free (tableName);
@@ -214,6 +259,27 @@ struct CreateTable *makeTableRegular (char *tableName, struct AttList *fromMe) {
 	return returnVal;
 }
 
+struct CreateTable *makeTableRegularWithOptions (char *tableName, struct AttList *fromMe, struct TableOptions *options) {
+	auto returnVal = new CreateTable (string (tableName), fromMe->atts);
+	returnVal->options = options->options;
+	free (tableName);
+	delete fromMe;
+	delete options;
+	return returnVal;
+}
+
+struct TableOptions *makeTableOptions (char *optionName) {
+	auto returnVal = new TableOptions (string (optionName));
+	free (optionName);
+	return returnVal;
+}
+
+struct TableOptions *appendTableOptions (struct TableOptions *appendToMe, char *optionName) {
+	appendToMe->options.push_back (string (optionName));
+	free (optionName);
+	return appendToMe;
+}
+
 struct CreateTable *makeTableBPlusTree (char *tableName, struct AttList *fromMe, char *attName) {
 	auto returnVal = new CreateTable (string (tableName), fromMe->atts, string (attName));
 	free (tableName);
@@ -1,6 +1,7 @@
 #ifndef RELATIONAL_ALGEBRA_EXPRESSIONS_CC
 #define RELATIONAL_ALGEBRA_EXPRESSIONS_CC
 
+#include "MyDB_PageReaderWriter.h"
 #include "RelAlgExpr.h"
 #include <vector>
 
@@ -12,9 +13,41 @@
 	initialized the static variables
 */
 
+// a predicate that accepts everything
+static MyDB_CompNodePtr acceptAll () {
+	return MyDB_CompNode :: makeConstant (MyDB_Value :: fromBool (true), make_shared <MyDB_BoolAttType> ());
+}
+
+// the conjunction of all of the disjunctions, lowered straight into a computation; it is
+// built from the back, so that the disjunctions are run in the order they were written in
+// (an earlier one may be what keeps a later one from dividing by zero)
+static MyDB_CompNodePtr getPredicate (vector <ExprTreePtr> &allDisjunctions) {
+	MyDB_CompNodePtr res = acceptAll ();
+	for (auto a = allDisjunctions.rbegin (); a != allDisjunctions.rend (); a++) {
+		res = MyDB_CompNode :: makeOp ("&&", {(*a)->getComp (), res});
+	}
+	return res;
+}
+
+// about how many bytes a record of the table takes up, judged from its first page
+static size_t bytesPerRecord (MyDB_TableReaderWriterPtr table) {
+	size_t recsOnFirstPage = 0;
+	if (table->getNumPages() > 0) {
+		MyDB_RecordPtr rec = table->getEmptyRecord();
+		MyDB_RecordIteratorAltPtr temp = (*table)[0].getIteratorAlt();
+		while (temp->advance()) {
+			temp->getCurrent(rec);
+			recsOnFirstPage++;
+		}
+	}
+	return table->getBufferMgr()->getPageSize() / max (recsOnFirstPage, (size_t) 1);
+}
+
 vector <int> RelAlgExpr :: availableIds;
 int RelAlgExpr :: tableId = 0;
 int RelAlgExpr :: maxTableId = 0;
+bool RelAlgExpr :: nativeMode = false;
+int RelAlgExpr :: numThreads = 1;
 
 
 int RelAlgExpr :: getId() {
@@ -45,14 +78,14 @@ MyDB_TableReaderWriterPtr Table :: run() {
 
 	// define the output record format
 	MyDB_SchemaPtr schemaOut = make_shared <MyDB_Schema> ();
-	vector <string> projections;
+	vector <MyDB_CompNodePtr> projections;
 	for (auto a : table->getTable()->getSchema()->getAtts()) {
 		if (tableAlais != "") {
 			schemaOut->appendAtt(make_pair(tableAlais + "_" + a.first, a.second));
 		} else {
 			schemaOut->appendAtt(make_pair(a.first, a.second));
 		}
-		projections.push_back("[" + a.first + "]");
+		projections.push_back(MyDB_CompNode :: makeAtt (a.first));
 	}
 
 	// get the current output table name
@@ -64,7 +97,7 @@ MyDB_TableReaderWriterPtr Table :: run() {
 	MyDB_TableReaderWriterPtr output = 
 		make_shared <MyDB_TableReaderWriter> (tableOut, table->getBufferMgr());
 
-	RegularSelection op (table, output, "bool[true]", projections);
+	RegularSelection op (table, output, acceptAll (), projections);
 	op.run();
 
 	return output;
@@ -74,6 +107,34 @@ string Table :: toString() {
 	return "Re [" + table->getTable ()->getName () + "]" ;
 }
 
+MyDB_TableReaderWriterPtr Table :: getBaseTable() {
+	return table;
+}
+
+string Table :: toBaseAtts(string computation) {
+	if (tableAlais == "") {
+		return computation;
+	}
+
+	// rename in the parsed computation, so that only attribute names are touched
+	return toBaseAtts(MyDB_CompNode :: parse(computation))->toString();
+}
+
+MyDB_CompNodePtr Table :: toBaseAtts(MyDB_CompNodePtr computation) {
+	if (tableAlais == "") {
+		return computation;
+	}
+
+	// [alias_att] becomes [att]
+	string prefix = tableAlais + "_";
+	return computation->renameAtts([prefix] (string name) {
+		if (name.compare(0, prefix.length(), prefix) == 0) {
+			return name.substr(prefix.length());
+		}
+		return name;
+	});
+}
+
 /*
 	---------------
 	SingleSelection
@@ -86,20 +147,29 @@ SingleSelection :: SingleSelection(RelAlgExprPtr tableIn,
 	table = tableIn;
 	valuesToSelect = valuesToSelectIn;
 	allDisjunctions = allDisjunctionsIn;
+	limit = -1;
 }
 
+void SingleSelection :: setLimit (int limitIn) {
+	limit = limitIn;
+}
 
 MyDB_TableReaderWriterPtr SingleSelection :: run() {
 
 	cout << "RelAlgExpr.cc : SingleSelection.run()" << endl;
 	cout << table->toString() << endl;
 
-	// get the input table
-	MyDB_TableReaderWriterPtr input = table->run();
+	MyDB_CompNodePtr selectionPredicate = getPredicate (allDisjunctions);
 
-	string selectionPredicate = "bool[true]";
-	for (auto a : allDisjunctions) {
-		selectionPredicate = "&& (" + a->toString() + ", " + selectionPredicate + ")";
+	// if we are selecting straight out of a stored table, scan it directly instead of
+	// copying it first... this way the zone maps stored with the table can be used
+	shared_ptr <Table> baseTable = dynamic_pointer_cast <Table> (table);
+	MyDB_TableReaderWriterPtr input;
+	if (baseTable != nullptr) {
+		input = baseTable->getBaseTable();
+		selectionPredicate = baseTable->toBaseAtts(selectionPredicate);
+	} else {
+		input = table->run();
 	}
 
 	// cout << "RelAlgExpr.cc : SingleSelection.run() CNF clauses are" << endl;
@@ -146,14 +216,28 @@ MyDB_TableReaderWriterPtr SingleSelection :: run() {
 		make_shared <MyDB_TableReaderWriter> (tableOut, input->getBufferMgr());
 
 
-	vector <string> projections;
+	// the computations come straight from the expressions, and the attributes that they
+	// use are looked up once, here
+	vector <MyDB_CompNodePtr> projections;
 	for (auto a : valuesToSelect) {
-		projections.push_back(a->toString());
+		if (baseTable != nullptr) {
+			projections.push_back(baseTable->toBaseAtts(a->getComp()));
+		} else {
+			projections.push_back(a->getComp());
+		}
+		projections.back()->resolve(input->getTable()->getSchema());
 	}
+	selectionPredicate->resolve(input->getTable()->getSchema());
 
 	// selection run
 	RegularSelection op (input, output, selectionPredicate, projections);
+	op.setBatchMode (true);
+	op.setNativeMode (nativeMode);
+	op.setNumThreads (numThreads);
+	op.setLimit (limit);
 	op.run();
+	cout << "SingleSelection.run() : the zone maps skipped " << op.getNumPagesSkipped () << " of " << 
+		input->getNumPages () << " pages" << endl;
 
 	// retur
 	return output;
@@ -167,6 +251,190 @@ string SingleSelection :: toString() {
 	return "SELECT (" + table->toString () + ") WHERE (" + selectionPredicate + ");";
 }
 
+/*
+	---------------
+	Order by (and limit)
+	---------------
+*/
+OrderBySelection :: OrderBySelection(RelAlgExprPtr tableIn,
+		vector <ExprTreePtr> valuesToSelectIn,
+		vector <pair <ExprTreePtr, bool>> sortKeysIn,
+		int limitIn) {
+	table = tableIn;
+	valuesToSelect = valuesToSelectIn;
+	sortKeys = sortKeysIn;
+	limit = limitIn;
+}
+
+MyDB_TableReaderWriterPtr OrderBySelection :: run() {
+
+	cout << "RelAlgExpr.cc : OrderBySelection.run()" << endl;
+	cout << table->toString() << endl;
+
+	// as for a selection, a stored table is read directly instead of being copied first
+	shared_ptr <Table> baseTable = dynamic_pointer_cast <Table> (table);
+	MyDB_TableReaderWriterPtr input;
+	if (baseTable != nullptr) {
+		input = baseTable->getBaseTable();
+	} else {
+		input = table->run();
+	}
+
+	// get the current output table name
+	string tableOutName = "table" + to_string(RelAlgExpr :: getId());
+
+	// define the output record format
+	MyDB_SchemaPtr schemaOut = make_shared <MyDB_Schema> ();
+	int i = 0;
+	for (auto a : valuesToSelect) {
+		MyDB_AttTypePtr type = a->getAttType();
+		if (type == nullptr) {
+			cout << "RelAlgExpr.cc : Error to get " << a->toString() << " MyDB_AttTypePtr"  << endl;
+			exit(-1);
+		}
+
+		string colName = "";
+		if (a->isIdentifierAtt()) {
+			string name = a->toString();
+			colName = name.substr(1, name.length()-2);
+		} else {
+			colName = tableOutName + "_att_" + to_string(i++);
+		}
+		schemaOut->appendAtt(make_pair(colName, type));
+	}
+
+	MyDB_TablePtr tableOut = 
+		make_shared <MyDB_Table> (tableOutName, tableOutName + ".bin", schemaOut);
+	MyDB_TableReaderWriterPtr output = 
+		make_shared <MyDB_TableReaderWriter> (tableOut, input->getBufferMgr());
+
+	// look up the attributes once, here
+	vector <MyDB_CompNodePtr> projections;
+	for (auto a : valuesToSelect) {
+		projections.push_back(baseTable != nullptr ? baseTable->toBaseAtts(a->getComp()) : a->getComp());
+		projections.back()->resolve(input->getTable()->getSchema());
+	}
+	vector <pair <MyDB_CompNodePtr, bool>> keys;
+	for (auto a : sortKeys) {
+		keys.push_back(make_pair(baseTable != nullptr ? baseTable->toBaseAtts(a.first->getComp()) : a.first->getComp(), 
+			a.second));
+		keys.back().first->resolve(input->getTable()->getSchema());
+	}
+
+	// the records that the limit keeps are held in RAM by a TopN, so there must be room for them
+	bool useHeap = false;
+	if (limit >= 0) {
+		MyDB_BufferManagerPtr mgr = input->getBufferMgr();
+		useHeap = (size_t) limit * bytesPerRecord (input) <= mgr->getPageSize() * mgr->getNumPages() / 2;
+	}
+
+	if (useHeap) {
+		cout << "OrderBySelection.run() : keeping the first " << limit << " records in a heap" << endl;
+		TopN op (input, output, keys, projections, limit);
+		op.run();
+	} else {
+		cout << "OrderBySelection.run() : sorting the whole input" << endl;
+		OrderBy op (input, output, keys, projections);
+		op.setLimit (limit);
+		op.run();
+	}
+
+	return output;
+}
+
+string OrderBySelection :: toString() {
+	string keyStr = "";
+	for (auto a : sortKeys) {
+		keyStr += a.first->toString () + (a.second ? " DESC" : " ASC") + "|";
+	}
+	return "ORDER (" + table->toString () + ") BY " + keyStr + (limit >= 0 ? " LIMIT " + to_string (limit) : "");
+}
+
+/*
+	---------------
+	Distinct
+	---------------
+*/
+DistinctSelection :: DistinctSelection(RelAlgExprPtr tableIn,
+		vector <ExprTreePtr> valuesToSelectIn,
+		double numDistinctIn) {
+	table = tableIn;
+	valuesToSelect = valuesToSelectIn;
+	numDistinct = numDistinctIn;
+}
+
+MyDB_TableReaderWriterPtr DistinctSelection :: run() {
+
+	cout << "RelAlgExpr.cc : DistinctSelection.run()" << endl;
+	cout << table->toString() << endl;
+
+	// as for a selection, a stored table is read directly instead of being copied first
+	shared_ptr <Table> baseTable = dynamic_pointer_cast <Table> (table);
+	MyDB_TableReaderWriterPtr input;
+	if (baseTable != nullptr) {
+		input = baseTable->getBaseTable();
+	} else {
+		input = table->run();
+	}
+
+	// get the current output table name
+	string tableOutName = "table" + to_string(RelAlgExpr :: getId());
+
+	// define the output record format
+	MyDB_SchemaPtr schemaOut = make_shared <MyDB_Schema> ();
+	int i = 0;
+	for (auto a : valuesToSelect) {
+		MyDB_AttTypePtr type = a->getAttType();
+		if (type == nullptr) {
+			cout << "RelAlgExpr.cc : Error to get " << a->toString() << " MyDB_AttTypePtr"  << endl;
+			exit(-1);
+		}
+
+		string colName = "";
+		if (a->isIdentifierAtt()) {
+			string name = a->toString();
+			colName = name.substr(1, name.length()-2);
+		} else {
+			colName = tableOutName + "_att_" + to_string(i++);
+		}
+		schemaOut->appendAtt(make_pair(colName, type));
+	}
+
+	MyDB_TablePtr tableOut = 
+		make_shared <MyDB_Table> (tableOutName, tableOutName + ".bin", schemaOut);
+	MyDB_TableReaderWriterPtr output = 
+		make_shared <MyDB_TableReaderWriter> (tableOut, input->getBufferMgr());
+
+	// look up the attributes once, here
+	vector <MyDB_CompNodePtr> projections;
+	for (auto a : valuesToSelect) {
+		projections.push_back(baseTable != nullptr ? baseTable->toBaseAtts(a->getComp()) : a->getComp());
+		projections.back()->resolve(input->getTable()->getSchema());
+	}
+
+	// the hash table holds one copy of every distinct record, so there must be room for them
+	MyDB_BufferManagerPtr mgr = input->getBufferMgr();
+	if (numDistinct * bytesPerRecord (input) <= (double) mgr->getPageSize() * mgr->getNumPages() / 2) {
+		cout << "DistinctSelection.run() : about " << (size_t) numDistinct << " distinct records; using a hash table" << endl;
+		HashDistinct op (input, output, projections);
+		op.run();
+	} else {
+		cout << "DistinctSelection.run() : about " << (size_t) numDistinct << " distinct records; sorting" << endl;
+		SortDistinct op (input, output, projections);
+		op.run();
+	}
+
+	return output;
+}
+
+string DistinctSelection :: toString() {
+	string selectionStr = "";
+	for (auto a : valuesToSelect) {
+		selectionStr += a->toString () + "|";
+	}
+	return "DISTINCT (" + table->toString () + ") SELECT " + selectionStr;
+}
+
 /*
 	---------------
 	Join and selection
@@ -196,13 +464,10 @@ MyDB_TableReaderWriterPtr JoinSelection :: run() {
     rightInput->writeIntoTextFile(RIGHT_OUTPUT_PATH);
 
 
-	string selectionPredicate = "bool[true]";
-	for (auto a : allDisjunctions) {
-		selectionPredicate = "&& (" + a->toString() + ", " + selectionPredicate + ")";
-	}
+	MyDB_CompNodePtr selectionPredicate = getPredicate (allDisjunctions);
 
 	cout << "RelAlgExpr.cc : JoinSelection.run() CNF clauses are" << endl;
-	cout << selectionPredicate << endl;
+	cout << selectionPredicate->toString() << endl;
 	cout << endl;
 
 
@@ -247,12 +512,12 @@ MyDB_TableReaderWriterPtr JoinSelection :: run() {
 		make_shared <MyDB_TableReaderWriter> (tableOut, leftInput->getBufferMgr());
 
 
-	vector <string> projections;
+	vector <MyDB_CompNodePtr> projections;
 	for (auto a : valuesToSelect) {
-		projections.push_back(a->toString());
+		projections.push_back(a->getComp());
 	}
 
-	vector <pair <string, string>> equalityChecks;
+	vector <pair <MyDB_CompNodePtr, MyDB_CompNodePtr>> equalityChecks;
 	for (auto a : allDisjunctions) {
 		if (a->isEqOp()) {
 			ExprTreePtr lhs = a->getLhs();
@@ -270,28 +535,59 @@ MyDB_TableReaderWriterPtr JoinSelection :: run() {
 			}
 
 			if (referToLeft) {
-				equalityChecks.push_back(make_pair(lhs2Str, rhs2Str));
+				equalityChecks.push_back(make_pair(lhs->getComp(), rhs->getComp()));
 			} else {
-				equalityChecks.push_back(make_pair(rhs2Str, lhs2Str));
+				equalityChecks.push_back(make_pair(rhs->getComp(), lhs->getComp()));
 			}
 		}
 	}
 
 	for (auto a : projections) {
-		cout << a << endl;
+		cout << a->toString() << endl;
 	}
 	for (auto e : equalityChecks) {
-		cout << e.first + "==" + e.second << endl;
+		cout << e.first->toString() + "==" + e.second->toString() << endl;
 	}
 	cout << "----------" << endl;
 
-	ScanJoin op (leftInput, rightInput,
-		output, selectionPredicate,
-		projections,
-		equalityChecks,
-		"bool[true]",
-		"bool[true]");
-	op.run();
+	// look up the attributes once, here: each side of an equality check is run over its
+	// own input, and everything else over the two inputs put together (the positions that
+	// are found are only hints, so it does not matter that some nodes are shared)
+	MyDB_SchemaPtr combinedSchema = make_shared <MyDB_Schema> ();
+	for (auto &p : leftInput->getTable()->getSchema()->getAtts())
+		combinedSchema->appendAtt(p);
+	for (auto &p : rightInput->getTable()->getSchema()->getAtts())
+		combinedSchema->appendAtt(p);
+	selectionPredicate->resolve(combinedSchema);
+	for (auto a : projections) {
+		a->resolve(combinedSchema);
+	}
+	for (auto e : equalityChecks) {
+		e.first->resolve(leftInput->getTable()->getSchema());
+		e.second->resolve(rightInput->getTable()->getSchema());
+	}
+
+	// the ScanJoin pins every page of the smaller input, so it is only used if they fit
+	MyDB_BufferManagerPtr mgr = leftInput->getBufferMgr();
+	if (min (leftInput->getNumPages(), rightInput->getNumPages()) <= (int) mgr->getNumPages() / 2) {
+		ScanJoin op (leftInput, rightInput,
+			output, selectionPredicate,
+			projections,
+			equalityChecks,
+			acceptAll (),
+			acceptAll ());
+		op.setBatchMode (true);
+		op.run();
+	} else {
+		cout << "JoinSelection.run() : the smaller input does not fit in the buffer, so it is partitioned" << endl;
+		HybridHashJoin op (leftInput, rightInput,
+			output, selectionPredicate,
+			projections,
+			equalityChecks,
+			acceptAll (),
+			acceptAll ());
+		op.run();
+	}
 
 	// return
 	return output;
@@ -309,7 +605,7 @@ string JoinSelection :: toString() {
 	---------------
 */
 AggregateSelection :: AggregateSelection(RelAlgExprPtr tableIn,
- 		vector <pair< pair<MyDB_AggType, string>, MyDB_AttTypePtr>> aggsToComputeIn,
+ 		vector <pair< pair<MyDB_AggType, ExprTreePtr>, MyDB_AttTypePtr>> aggsToComputeIn,
  		vector <ExprTreePtr> groupingClausesIn) {
 	table = tableIn;
 	aggsToCompute = aggsToComputeIn;
@@ -321,8 +617,8 @@ MyDB_TableReaderWriterPtr AggregateSelection :: run() {
 	cout << "RelAlgExpr.cc : AggregationSelection.run()" << endl;
 	cout << endl;
 
-	vector <pair<MyDB_AggType, string>> newAggsToCompute;
-	vector <string> newGroupingClauses;
+	vector <pair<MyDB_AggType, MyDB_CompNodePtr>> newAggsToCompute;
+	vector <MyDB_CompNodePtr> newGroupingClauses;
 
 	// get the current output table name
 	string tableOutName = "table" + to_string(RelAlgExpr :: getId());
@@ -332,7 +628,7 @@ MyDB_TableReaderWriterPtr AggregateSelection :: run() {
 	int i = 0;
 	for (auto a : groupingClauses) {
 
-		newGroupingClauses.push_back(a->toString());
+		newGroupingClauses.push_back(a->getComp());
 
 		MyDB_AttTypePtr type = a->getAttType();
 		if (type == nullptr) {
@@ -360,7 +656,7 @@ MyDB_TableReaderWriterPtr AggregateSelection :: run() {
 	cout << endl;
 
 	for (auto a : aggsToCompute) {
-		newAggsToCompute.push_back(a.first);
+		newAggsToCompute.push_back(make_pair(a.first.first, a.first.second->getComp()));
 		schemaOut->appendAtt(make_pair(tableOutName + "_att_" + to_string(i++), a.second));
 	}
 
@@ -376,7 +672,16 @@ MyDB_TableReaderWriterPtr AggregateSelection :: run() {
 	MyDB_TableReaderWriterPtr output = 
 		make_shared <MyDB_TableReaderWriter> (tableOut, input->getBufferMgr());
 
-	Aggregate op (input, output, newAggsToCompute, newGroupingClauses, "bool[true]");
+	// look up the attributes once, here
+	for (auto a : newGroupingClauses) {
+		a->resolve(input->getTable()->getSchema());
+	}
+	for (auto a : newAggsToCompute) {
+		a.second->resolve(input->getTable()->getSchema());
+	}
+
+	Aggregate op (input, output, newAggsToCompute, newGroupingClauses, acceptAll ());
+	op.setBatchMode (true);
 	op.run();
 
 	return output;
@@ -389,7 +694,7 @@ string AggregateSelection :: toString() {
 			selectionStr += a->toString () + "|";
 		}
 		for (auto p : aggsToCompute) {
-			selectionStr += p.first.second + "| ";
+			selectionStr += p.first.second->toString() + "| ";
 		}
 	return "AGGREGATE (" + table->toString () + ") SELECT " + selectionStr;
 }
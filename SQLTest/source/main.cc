@@ -113,6 +113,22 @@ int main (int numArgs, char **args) {
 					return 0;
 				}
 
+				// see if we got a "native on" or "native off"; this says whether selections are
+				// compiled to native code
+				if (tokens.size () == 2 && toLower (tokens[0]) == "native" && 
+					(toLower (tokens[1]) == "on" || toLower (tokens[1]) == "off")) {
+					RelAlgExpr :: nativeMode = (toLower (tokens[1]) == "on");
+					cout << "OK, native code is " << toLower (tokens[1]) << ".\n";
+					break;
+				}
+
+				// see if we got a "threads n"; this says how many threads each selection is run on
+				if (tokens.size () == 2 && toLower (tokens[0]) == "threads" && atoi (tokens[1].c_str ()) > 0) {
+					RelAlgExpr :: numThreads = atoi (tokens[1].c_str ());
+					cout << "OK, selections will use " << RelAlgExpr :: numThreads << " threads.\n";
+					break;
+				}
+
 				// see if we got a "load soandso from afile"
 				if (tokens.size () == 4 && toLower(tokens[0]) == "load" && toLower(tokens[2]) == "from") {
 
@@ -199,7 +215,10 @@ int main (int numArgs, char **args) {
 							final->getSFWQuery().getValuesToSelect(),
 							final->getSFWQuery().getTablesToProcess(),
 							final->getSFWQuery().getAllDisjunctions(),
-							final->getSFWQuery().getGroupingClause()
+							final->getSFWQuery().getGroupingClause(),
+							final->getSFWQuery().getOrderingClauses(),
+							final->getSFWQuery().getLimit(),
+							final->getSFWQuery().isDistinct()
 							);	
 
 						clock_t t1, t2;
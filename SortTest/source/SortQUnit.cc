@@ -12,7 +12,11 @@
 #include "MyDB_TableReaderWriter.h"
 #include "MyDB_Schema.h"
 #include "QUnit.h"
+#include "MyDB_NormalizedKey.h"
+#include "MyDB_RunQueueIteratorAlt.h"
 #include "Sorting.h"
+#include <chrono>
+#include <queue>
 #include <iostream>
 
 
@@ -21,7 +25,7 @@ int main (int argc, char *argv[]) {
 	//Get 
 	int start = 1;
 	if (argc > 1 && argv[1][0] >= '0' && argv[1][0] <= '9') {
-		start = argv[1][0] - '0';
+		start = atoi (argv[1]);
 	}
 	
 	QUnit::UnitTest qunit(cerr, QUnit::normal);
@@ -1044,6 +1048,450 @@ int main (int argc, char *argv[]) {
 	else {
 		cout << endl << endl << "***FAIL****" << endl << endl << flush;
 	}		
+
+	case 11:
+	cout << endl << "Test 11: Sort on several threads:" << endl << flush;
+	countCorrect = 0;
+	cout << "Initialization.." << flush;
+	{
+		// create a catalog
+		MyDB_CatalogPtr myCatalog = make_shared <MyDB_Catalog> ("catFile");
+
+		// now make a schema
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("suppkey", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("name", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("address", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("nationkey", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("phone", make_shared <MyDB_StringAttType> ()));
+		mySchema->appendAtt (make_pair ("acctbal", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("comment", make_shared <MyDB_StringAttType> ()));
+
+		// use the schema to create a table
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("parSupplier", "parSupplier.bin", mySchema);
+		MyDB_BufferManagerPtr myMgr = make_shared <MyDB_BufferManager> (131072, 128, "tempFile");
+		MyDB_TableReaderWriter supplierTable (myTable, myMgr);
+
+		// load it from a text file
+		supplierTable.loadFromTextFile ("supplierBig.tbl");
+
+		// put the supplier table into the catalog
+		myTable->putInCatalog (myCatalog);
+	}
+
+	cout << "Sort a table on 1, 2, 4, and 8 threads.." << endl << flush;
+	{
+		// load up the table supplier table from the catalog
+		MyDB_CatalogPtr myCatalog = make_shared <MyDB_Catalog> ("catFile");
+		map <string, MyDB_TablePtr> allTables = MyDB_Table :: getAllTables (myCatalog);
+		MyDB_BufferManagerPtr myMgr = make_shared <MyDB_BufferManager> (131072, 128, "tempFile");
+		MyDB_TableReaderWriter supplierTable (allTables["parSupplier"], myMgr);
+
+		int numThreads[] = {1, 2, 4, 8};
+		int numSorted = 0;
+		for (int which = 0; which < 4; which++) {
+
+			// use the schema to create a table
+			string outName = "parSupplierSorted" + to_string (numThreads[which]);
+			MyDB_TablePtr outTable = make_shared <MyDB_Table> (outName, outName + ".bin", allTables["parSupplier"]->getSchema ());
+			MyDB_TableReaderWriter outputTable (outTable, myMgr);
+
+			// and sort
+			auto start = chrono :: steady_clock :: now ();
+			sort (numThreads[which], 16, supplierTable, outputTable, "[acctbal]");
+			double time = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			cout << "\t" << numThreads[which] << " threads: " << 320000 / time / 1e6 << " million records per second" << endl << flush;
+
+			// there should be 320000 records, each no smaller than the last
+			MyDB_RecordPtr rec1 = outputTable.getEmptyRecord ();
+			MyDB_RecordPtr rec2 = outputTable.getEmptyRecord ();
+			function <bool ()> myComp = buildRecordComparator (rec1, rec2, "[acctbal]");
+			MyDB_RecordIteratorAltPtr myIter = outputTable.getIteratorAlt ();
+			int counter = 0;
+			bool inOrder = true;
+			while (myIter->advance ()) {
+				myIter->getCurrent (rec1);
+				if (counter > 0 && myComp ())
+					inOrder = false;
+				myIter->getCurrent (rec2);
+				counter++;
+			}
+
+			//Check?
+			if (counter == 320000 && inOrder) {
+				numSorted++;
+			}
+		}
+
+		if (numSorted == 4) {
+			countCorrect++;
+		}
+	}
+
+	QUNIT_IS_EQUAL (countCorrect, 1);
+	if (countCorrect == 1) {
+		cout << "PASS" << endl << flush;
+	}
+	else {
+		cout << endl << endl << "***FAIL****" << endl << endl << flush;
+	}		
+
+	case 12:
+	cout << endl << "Test 12: Merge many runs:" << endl << flush;
+	countCorrect = 0;
+	{
+		// the runs are made directly on anonymous pages; run i gets the keys that are i mod k,
+		// so that every run takes its turn at having the smallest record
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("index", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("value", make_shared <MyDB_DoubleAttType> ()));
+		MyDB_BufferManagerPtr myMgr = make_shared <MyDB_BufferManager> (8192, 4096, "tempFile");
+		MyDB_RecordPtr rec1 = make_shared <MyDB_Record> (mySchema);
+		MyDB_RecordPtr rec2 = make_shared <MyDB_Record> (mySchema);
+		function <bool ()> myComp = buildRecordComparator (rec1, rec2, "[index]");
+
+		int numRecs = 256000;
+		int numRuns[] = {16, 128, 1024};
+		int numMerged = 0;
+		for (int which = 0; which < 3; which++) {
+
+			int k = numRuns[which];
+			vector <vector <MyDB_PageReaderWriter>> runs (k);
+			for (int i = 0; i < k; i++) {
+				runs[i].push_back (MyDB_PageReaderWriter (*myMgr));
+				for (int j = i; j < numRecs; j += k) {
+					rec1->getAtt (0)->fromInt (j);
+					rec1->getAtt (1)->fromValue (MyDB_Value :: fromDouble (j / 2.0));
+					rec1->recordContentHasChanged ();
+					if (!runs[i].back ().append (rec1)) {
+						runs[i].push_back (MyDB_PageReaderWriter (*myMgr));
+						runs[i].back ().append (rec1);
+					}
+				}
+			}
+
+			// a priority queue of iterators (the way the runs used to be merged), and then a
+			// tournament tree that compares with a comparator, and one that keeps the keys
+			double times[3];
+			for (int how = 0; how < 3; how++) {
+
+				auto start = chrono :: steady_clock :: now ();
+				MyDB_RecordIteratorAltPtr myIter;
+				priority_queue <MyDB_RecordIteratorAltPtr, vector <MyDB_RecordIteratorAltPtr>, IteratorComparator>
+					pq (IteratorComparator (myComp, rec1, rec2));
+				MyDB_RunQueueIteratorAltPtr tree;
+				if (how == 0) {
+					for (int i = 0; i < k; i++) {
+						MyDB_RecordIteratorAltPtr temp = getIteratorAlt (runs[i]);
+						if (temp->advance ())
+							pq.push (temp);
+					}
+				} else {
+					if (how == 1)
+						tree = make_shared <MyDB_RunQueueIteratorAlt> (myComp, rec1, rec2);
+					else
+						tree = make_shared <MyDB_RunQueueIteratorAlt> (mySchema, "[index]");
+					for (int i = 0; i < k; i++) {
+						MyDB_RecordIteratorAltPtr temp = getIteratorAlt (runs[i]);
+						if (temp->advance ())
+							tree->addRun (temp);
+					}
+				}
+
+				// every key should come out, in order
+				int next = 0;
+				MyDB_RecordPtr out = make_shared <MyDB_Record> (mySchema);
+				while (true) {
+					if (how == 0) {
+						if (pq.empty ())
+							break;
+						MyDB_RecordIteratorAltPtr top = pq.top ();
+						pq.pop ();
+						top->getCurrent (out);
+						if (top->advance ())
+							pq.push (top);
+					} else {
+						if (!tree->advance ())
+							break;
+						tree->getCurrent (out);
+					}
+					if (out->getAtt (0)->toInt () != next)
+						break;
+					next++;
+				}
+				times[how] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+				if (next == numRecs)
+					numMerged++;
+			}
+
+			cout << "\t" << k << " runs (ns per record, priority queue vs. tournament tree vs. tournament tree with kept keys): "
+				<< times[0] * 1e9 / numRecs << " vs. " << times[1] * 1e9 / numRecs << " vs. " << times[2] * 1e9 / numRecs << endl << flush;
+		}
+
+		if (numMerged == 9) {
+			countCorrect++;
+		}
+	}
+
+	QUNIT_IS_EQUAL (countCorrect, 1);
+	if (countCorrect == 1) {
+		cout << "PASS" << endl << flush;
+	}
+	else {
+		cout << endl << endl << "***FAIL****" << endl << endl << flush;
+	}		
+	
+	case 13:
+	cout << endl << "Test 13: Sort pages on normalized keys:" << endl << flush;
+	countCorrect = 0;
+	{
+		// the same pages are sorted with the comparator and with normalized keys; the results
+		// should match byte for byte, since both sorts keep equal records in the order they were in
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("index", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("value", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("name", make_shared <MyDB_StringAttType> ()));
+		MyDB_BufferManagerPtr myMgr = make_shared <MyDB_BufferManager> (8192, 1024, "tempFile");
+		MyDB_RecordPtr rec1 = make_shared <MyDB_Record> (mySchema);
+		MyDB_RecordPtr rec2 = make_shared <MyDB_Record> (mySchema);
+
+		// the names all start with the same eight characters half of the time, so that many
+		// of the ties between string keys have to be broken with the comparator
+		int numPages = 256;
+		srand48 (530);
+		vector <MyDB_PageReaderWriter> pages;
+		for (int i = 0; i < numPages; i++) {
+			pages.push_back (MyDB_PageReaderWriter (*myMgr));
+			pages.back ().clear ();
+			while (true) {
+				rec1->getAtt (0)->fromInt ((int) (lrand48 () % 100000) - 50000);
+				rec1->getAtt (1)->fromValue (MyDB_Value :: fromDouble ((drand48 () - 0.5) * 1e6));
+				string name = (lrand48 () % 2 == 0 ? "Customer#" : "") + to_string (lrand48 () % 100000);
+				rec1->getAtt (2)->fromString (name);
+				rec1->recordContentHasChanged ();
+				if (!pages.back ().append (rec1))
+					break;
+			}
+		}
+
+		int numMatched = 0;
+		for (string sortOn : {"[index]", "[value]", "[name]"}) {
+			function <bool ()> myComp = buildRecordComparator (rec1, rec2, sortOn);
+			MyDB_NormalizedKeyPtr key = MyDB_NormalizedKey :: build (rec1, sortOn);
+			vector <MyDB_PageReaderWriter> byComp, byKey;
+			for (int i = 0; i < numPages; i++) {
+				byComp.push_back (MyDB_PageReaderWriter (*myMgr));
+				byComp.back ().copyFrom (pages[i]);
+				byKey.push_back (MyDB_PageReaderWriter (*myMgr));
+				byKey.back ().copyFrom (pages[i]);
+			}
+
+			auto start = chrono :: steady_clock :: now ();
+			for (int i = 0; i < numPages; i++)
+				byComp[i].sortInPlace (myComp, rec1, rec2);
+			double compTime = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			start = chrono :: steady_clock :: now ();
+			for (int i = 0; i < numPages; i++)
+				byKey[i].sortInPlace (key, myComp, rec1, rec2);
+			double keyTime = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+
+			bool same = true;
+			for (int i = 0; i < numPages; i++)
+				same = same && memcmp (byComp[i].getBytes (), byKey[i].getBytes (), byKey[i].getPageSize ()) == 0;
+			if (same)
+				numMatched++;
+			cout << "\tsorting on " << sortOn << " (us per page, comparator vs. normalized keys): " 
+				<< compTime * 1e6 / numPages << " vs. " << keyTime * 1e6 / numPages << endl << flush;
+		}
+
+		if (numMatched == 3) {
+			countCorrect++;
+		}
+	}
+
+	QUNIT_IS_EQUAL (countCorrect, 1);
+	if (countCorrect == 1) {
+		cout << "PASS" << endl << flush;
+	}
+	else {
+		cout << endl << endl << "***FAIL****" << endl << endl << flush;
+	}		
+	
+	case 14:
+	cout << endl << "Test 14: Make runs by replacement selection:" << endl << flush;
+	countCorrect = 0;
+	{
+		// the same records, in sorted, random, and reverse sorted order, sorted with runs of 16
+		// pages, and with runs made by a heap in 16 pages
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("index", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("value", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("name", make_shared <MyDB_StringAttType> ()));
+		MyDB_BufferManagerPtr myMgr = make_shared <MyDB_BufferManager> (4096, 256, "tempFile");
+		MyDB_RecordPtr rec1 = make_shared <MyDB_Record> (mySchema);
+		MyDB_RecordPtr rec2 = make_shared <MyDB_Record> (mySchema);
+
+		int numRecs = 200000;
+		vector <int> keys;
+		for (int i = 0; i < numRecs; i++)
+			keys.push_back (i);
+		srand48 (530);
+		string orders[] = {"sorted", "random", "reverse sorted"};
+		int numSorted = 0;
+		for (int order = 0; order < 3; order++) {
+
+			if (order == 1)
+				random_shuffle (keys.begin (), keys.end (), [] (int n) {return (int) (lrand48 () % n);});
+			if (order == 2)
+				std :: sort (keys.begin (), keys.end (), [] (int a, int b) {return a > b;});
+
+			string name = "replacementInput" + to_string (order);
+			MyDB_TablePtr myTable = make_shared <MyDB_Table> (name, name + ".bin", mySchema);
+			MyDB_TableReaderWriter inputTable (myTable, myMgr);
+			for (int i : keys) {
+				rec1->getAtt (0)->fromInt (i);
+				rec1->getAtt (1)->fromValue (MyDB_Value :: fromDouble (i / 2.0));
+				string recName = "record number " + to_string (i);
+				rec1->getAtt (2)->fromString (recName);
+				rec1->recordContentHasChanged ();
+				inputTable.append (rec1);
+			}
+
+			int numRuns[2];
+			double times[2];
+			for (int how = 0; how < 2; how++) {
+
+				// every record should come out, in order
+				auto start = chrono :: steady_clock :: now ();
+				vector <vector <MyDB_PageReaderWriter>> runs = buildSortedRuns (16, inputTable, "[index]", rec1, rec2,
+					"bool[true]", how == 1);
+				numRuns[how] = runs.size ();
+				MyDB_RecordIteratorAltPtr myIter = mergeSortedRuns (runs, 16, inputTable, "[index]", rec1, rec2);
+				int next = 0;
+				while (myIter->advance ()) {
+					myIter->getCurrent (rec1);
+					if (rec1->getAtt (0)->toInt () != next)
+						break;
+					next++;
+				}
+				times[how] = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+				if (next == numRecs)
+					numSorted++;
+			}
+
+			cout << "\t" << orders[order] << " (runs, and ns per record; 16 page runs vs. replacement selection): " 
+				<< numRuns[0] << ", " << times[0] * 1e9 / numRecs << " vs. " << numRuns[1] << ", " 
+				<< times[1] * 1e9 / numRecs << endl << flush;
+
+			// sorted input makes one run, and random input makes runs that are twice as long (or close to it)
+			if (order == 0 && numRuns[1] == 1)
+				numSorted++;
+			if (order == 1 && numRuns[1] * 1.7 < numRuns[0])
+				numSorted++;
+		}
+
+		if (numSorted == 8) {
+			countCorrect++;
+		}
+	}
+
+	QUNIT_IS_EQUAL (countCorrect, 1);
+	if (countCorrect == 1) {
+		cout << "PASS" << endl << flush;
+	}
+	else {
+		cout << endl << endl << "***FAIL****" << endl << endl << flush;
+	}		
+	
+	case 15:
+	cout << endl << "Test 15: Merge more runs than there are pages in the buffer:" << endl << flush;
+	countCorrect = 0;
+	{
+		// 125 runs of 16 pages, with 64 pages in the buffer; they are merged all at once, the way
+		// that they used to be, and then in passes of a bounded fan-in
+		MyDB_SchemaPtr mySchema = make_shared <MyDB_Schema> ();
+		mySchema->appendAtt (make_pair ("index", make_shared <MyDB_IntAttType> ()));
+		mySchema->appendAtt (make_pair ("value", make_shared <MyDB_DoubleAttType> ()));
+		mySchema->appendAtt (make_pair ("name", make_shared <MyDB_StringAttType> ()));
+		MyDB_BufferManagerPtr myMgr = make_shared <MyDB_BufferManager> (4096, 64, "tempFile");
+		MyDB_RecordPtr rec1 = make_shared <MyDB_Record> (mySchema);
+		MyDB_RecordPtr rec2 = make_shared <MyDB_Record> (mySchema);
+
+		int numRecs = 200000;
+		vector <int> keys;
+		for (int i = 0; i < numRecs; i++)
+			keys.push_back (i);
+		srand48 (530);
+		random_shuffle (keys.begin (), keys.end (), [] (int n) {return (int) (lrand48 () % n);});
+
+		MyDB_TablePtr myTable = make_shared <MyDB_Table> ("mergeInput", "mergeInput.bin", mySchema);
+		MyDB_TableReaderWriter inputTable (myTable, myMgr);
+		for (int i : keys) {
+			rec1->getAtt (0)->fromInt (i);
+			rec1->getAtt (1)->fromValue (MyDB_Value :: fromDouble (i / 2.0));
+			string recName = "record number " + to_string (i);
+			rec1->getAtt (2)->fromString (recName);
+			rec1->recordContentHasChanged ();
+			inputTable.append (rec1);
+		}
+
+		// a fan-in of 0 means all of the runs at once
+		int fanIns[] = {0, 4, 8, 16, 31};
+		int numSorted = 0;
+		for (int fanIn : fanIns) {
+
+			vector <vector <MyDB_PageReaderWriter>> runs = buildSortedRuns (16, inputTable, "[index]", rec1, rec2,
+				"bool[true]", false);
+			int numRuns = runs.size ();
+			int numPasses = 1;
+			for (int left = numRuns; fanIn > 0 && left > fanIn; left = (left + fanIn - 1) / fanIn)
+				numPasses++;
+
+			auto start = chrono :: steady_clock :: now ();
+			MyDB_RecordIteratorAltPtr myIter;
+			if (fanIn == 0) {
+				MyDB_RunQueueIteratorAltPtr allAtOnce = make_shared <MyDB_RunQueueIteratorAlt> (mySchema, "[index]");
+				for (vector <MyDB_PageReaderWriter> &run : runs) {
+					MyDB_RecordIteratorAltPtr temp = getIteratorAlt (run);
+					if (temp->advance ())
+						allAtOnce->addRun (temp);
+				}
+				myIter = allAtOnce;
+			} else {
+				myIter = mergeSortedRuns (runs, fanIn, inputTable, "[index]", rec1, rec2);
+			}
+
+			int next = 0;
+			while (myIter->advance ()) {
+				myIter->getCurrent (rec1);
+				if (rec1->getAtt (0)->toInt () != next)
+					break;
+				next++;
+			}
+			double time = chrono :: duration <double> (chrono :: steady_clock :: now () - start).count ();
+			if (next == numRecs)
+				numSorted++;
+
+			cout << "\t" << numRuns << " runs, ";
+			if (fanIn == 0)
+				cout << "all at once";
+			else
+				cout << "fan-in of " << fanIn << " (" << numPasses << " passes)";
+			cout << ": " << time * 1e9 / numRecs << " ns per record" << endl << flush;
+		}
+
+		if (numSorted == 5) {
+			countCorrect++;
+		}
+	}
+
+	QUNIT_IS_EQUAL (countCorrect, 1);
+	if (countCorrect == 1) {
+		cout << "PASS" << endl << flush;
+	}
+	else {
+		cout << endl << endl << "***FAIL****" << endl << endl << flush;
+	}		
 	
 	default:
 		break;